@@ -77,6 +77,15 @@ namespace etherkitten::controller
 		return result;
 	}
 
+	std::vector<std::reference_wrapper<const datatypes::CycleStatistic>>
+	EtherKittenBusInfoSupplier::getCycleStatistics()
+	{
+		const std::vector<datatypes::CycleStatistic>& statistics
+		    = etherKitten.getCycleStatistics();
+		return std::vector<std::reference_wrapper<const datatypes::CycleStatistic>>(
+		    statistics.begin(), statistics.end());
+	}
+
 	unsigned int EtherKittenBusInfoSupplier::getSlaveCount() { return etherKitten.getSlaveCount(); }
 
 	const datatypes::SlaveInfo& EtherKittenBusInfoSupplier::getSlaveInfo(unsigned int slaveID)
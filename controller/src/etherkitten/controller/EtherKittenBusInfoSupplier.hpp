@@ -56,6 +56,9 @@ namespace etherkitten::controller
 		//! \copydoc gui::BusInfoSupplier::getErrorStatistics()
 		std::vector<std::reference_wrapper<const datatypes::ErrorStatistic>>
 		getErrorStatistics() override;
+		//! \copydoc gui::BusInfoSupplier::getCycleStatistics()
+		std::vector<std::reference_wrapper<const datatypes::CycleStatistic>>
+		getCycleStatistics() override;
 		//! \copydoc gui::BusInfoSupplier::getSlaveCount()
 		unsigned int getSlaveCount() override;
 		//! \copydoc gui::BusInfoSupplier::getSlaveInfo()
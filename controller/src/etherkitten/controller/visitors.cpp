@@ -42,6 +42,10 @@ namespace etherkitten::controller
 	{
 		newestValueView = etherKitten.getNewest(statistic);
 	}
+	void NewestValueViewVisitor::handleCycleStatistic(const datatypes::CycleStatistic& statistic)
+	{
+		newestValueView = etherKitten.getNewest(statistic);
+	}
 	void NewestValueViewVisitor::handleRegister(const datatypes::Register& reg)
 	{
 		newestValueView = etherKitten.getNewest(reg);
@@ -77,6 +81,10 @@ namespace etherkitten::controller
 	{
 		dataView = etherKitten.getView(statistic, timeSeries);
 	}
+	void DataViewVisitor::handleCycleStatistic(const datatypes::CycleStatistic& statistic)
+	{
+		dataView = etherKitten.getView(statistic, timeSeries);
+	}
 	void DataViewVisitor::handleRegister(const datatypes::Register& reg)
 	{
 		dataView = etherKitten.getView(reg, timeSeries);
@@ -109,6 +117,7 @@ namespace etherkitten::controller
 		etherKitten.setPDOValue(object, std::move(dataPoint));
 	}
 	void WriteVisitor::handleErrorStatistic(const datatypes::ErrorStatistic& stat) { (void)stat; }
+	void WriteVisitor::handleCycleStatistic(const datatypes::CycleStatistic& stat) { (void)stat; }
 	void WriteVisitor::handleRegister(const datatypes::Register& reg) { (void)reg; }
 
 	/*!
@@ -48,6 +48,8 @@ namespace etherkitten::controller
 		void handlePDO(const datatypes::PDO& object) override;
 		//! \copydoc datatypes::DataObjectVisitor::handleErrorStatistic()
 		void handleErrorStatistic(const datatypes::ErrorStatistic& statistic) override;
+		//! \copydoc datatypes::DataObjectVisitor::handleCycleStatistic()
+		void handleCycleStatistic(const datatypes::CycleStatistic& statistic) override;
 		//! \copydoc datatypes::DataObjectVisitor::handleRegister()
 		void handleRegister(const datatypes::Register& reg) override;
 		/**
@@ -95,6 +97,8 @@ namespace etherkitten::controller
 		void handlePDO(const datatypes::PDO& object) override;
 		//! \copydoc datatypes::DataObjectVisitor::handleErrorStatistic()
 		void handleErrorStatistic(const datatypes::ErrorStatistic& statistic) override;
+		//! \copydoc datatypes::DataObjectVisitor::handleCycleStatistic()
+		void handleCycleStatistic(const datatypes::CycleStatistic& statistic) override;
 		//! \copydoc datatypes::DataObjectVisitor::handleRegister()
 		void handleRegister(const datatypes::Register& reg) override;
 		/**
@@ -149,6 +153,11 @@ namespace etherkitten::controller
 		 * \details Does nothing.
 		 */
 		void handleErrorStatistic(const datatypes::ErrorStatistic& statistic) override;
+		/*!
+		 * \copydoc datatypes::DataObjectVisitor::handleCycleStatistic()
+		 * \details Does nothing.
+		 */
+		void handleCycleStatistic(const datatypes::CycleStatistic& statistic) override;
 		/*!
 		 * \copydoc datatypes::DataObjectVisitor::handleRegister()
 		 * \details Does nothing.
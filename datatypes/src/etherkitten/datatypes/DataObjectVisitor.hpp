@@ -28,6 +28,7 @@ namespace etherkitten::datatypes
 	class PDO;
 	class CoEObject;
 	class ErrorStatistic;
+	class CycleStatistic;
 	class Register;
 
 	/*!
@@ -60,6 +61,12 @@ namespace etherkitten::datatypes
 		 */
 		virtual void handleErrorStatistic(const ErrorStatistic& statistic) = 0;
 
+		/*!
+		 * \brief Handle a CycleStatistic.
+		 * \param statistic the CycleStatistic to handle
+		 */
+		virtual void handleCycleStatistic(const CycleStatistic& statistic) = 0;
+
 		/*!
 		 * \brief Handle a Register.
 		 * \param reg the Register to handle
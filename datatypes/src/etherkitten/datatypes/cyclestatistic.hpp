@@ -0,0 +1,95 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+/*!
+ * \file
+ * \brief Defines the CycleStatistic, a data object that represents a timing metric of the
+ * cycles the master runs on the EtherCAT bus.
+ */
+
+#include <limits>
+#include <string>
+#include <unordered_map>
+
+#include "DataObject.hpp"
+
+namespace etherkitten::datatypes
+{
+	/*!
+	 * \brief The CycleStatisticType enum encodes the metrics recorded for every cycle of the
+	 * realtime loop.
+	 *
+	 * Durations are measured in nanoseconds.
+	 */
+	enum class CycleStatisticType
+	{
+		SEND_TIME, /*!< The time it took to send the process data frames */
+		RECEIVE_LATENCY, /*!< The time from sending to receiving the process data frames */
+		REGISTER_FRAME_COUNT, /*!< The number of register frames exchanged */
+		LOOP_DURATION, /*!< The time the cycle spent working before waiting for the next */
+		CYCLE_PERIOD, /*!< The time from the start of the previous cycle to this one */
+		DEADLINE_MISS, /*!< 1 if the cycle took longer than the cycle time, 0 otherwise */
+	};
+
+	/*!
+	 * \brief The number of CycleStatisticTypes.
+	 */
+	static constexpr size_t cycleStatisticTypeCount
+	    = static_cast<size_t>(CycleStatisticType::DEADLINE_MISS) + 1;
+
+	/*!
+	 * \brief Holds the names of the CycleStatisticTypes.
+	 */
+	// clang-format off
+const std::unordered_map<CycleStatisticType, std::string> cycleStatisticMap = {
+    { CycleStatisticType::SEND_TIME, "Cycle send time" },
+    { CycleStatisticType::RECEIVE_LATENCY, "Cycle receive latency" },
+    { CycleStatisticType::REGISTER_FRAME_COUNT, "Cycle register frame count" },
+    { CycleStatisticType::LOOP_DURATION, "Cycle loop duration" },
+    { CycleStatisticType::CYCLE_PERIOD, "Cycle period" },
+    { CycleStatisticType::DEADLINE_MISS, "Cycle deadline miss" },
+};
+	// clang-format on
+
+	/*!
+	 * \brief The CycleStatistic class represents a timing metric of the cycles of the master.
+	 *
+	 * CycleStatistics are not associated with a slave, so their slave ID is always
+	 * `std::numeric_limits<unsigned int>::max()`.
+	 */
+	class CycleStatistic : public DataObject
+	{
+	public:
+		/*!
+		 * \brief Construct a new CycleStatistic of the given type.
+		 * \param type the metric identified by this CycleStatistic
+		 */
+		explicit CycleStatistic(CycleStatisticType type);
+
+		void acceptVisitor(DataObjectVisitor& visitor) const override;
+
+		/*!
+		 * \brief Get the type of this statistic.
+		 * \return the type of this statistic
+		 */
+		CycleStatisticType getStatisticType() const;
+
+	private:
+		CycleStatisticType type;
+	};
+} // namespace etherkitten::datatypes
@@ -22,6 +22,7 @@
  */
 
 #include "coe.hpp"
+#include "cyclestatistic.hpp"
 #include "errorstatistic.hpp"
 #include "pdo.hpp"
 #include "register.hpp"
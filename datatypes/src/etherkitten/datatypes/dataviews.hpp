@@ -22,6 +22,8 @@
  * in arbitrary containers in a type-agnostic way.
  */
 
+#include <cstddef>
+
 #include "datapoints.hpp"
 #include "time.hpp"
 
@@ -78,6 +80,30 @@ namespace etherkitten::datatypes
 		 * \exception std::out_of_range iff isEmpty() would return true
 		 */
 		virtual TimeStamp getTime() = 0;
+
+		/*!
+		 * \brief Move this AbstractDataView forward over up to max values and copy them.
+		 *
+		 * Equivalent to repeatedly applying ++ and reading getTime() and asDouble() while
+		 * `hasNext()` returns true, but implementations may copy a run of values at once.
+		 * Afterwards, this AbstractDataView points to the last copied value.
+		 * \param values the array to copy the values to, must hold at least max elements
+		 * \param times the array to copy the TimeStamps to, must hold at least max elements
+		 * \param max the maximum number of values to copy
+		 * \return the number of values that were copied
+		 */
+		virtual size_t readBatch(double* values, TimeStamp* times, size_t max)
+		{
+			size_t read = 0;
+			while (read < max && hasNext())
+			{
+				++(*this);
+				values[read] = asDouble();
+				times[read] = getTime();
+				++read;
+			}
+			return read;
+		}
 	};
 
 	/*!
@@ -27,6 +27,7 @@ using namespace etherkitten::datatypes;
 bool correctPDO = false;
 bool correctCoE = false;
 bool correctStatistic = false;
+bool correctCycleStatistic = false;
 bool correctRegister = false;
 
 class MockVisitor : public DataObjectVisitor
@@ -49,6 +50,12 @@ public:
 		correctStatistic = handedStatistic.getType() == statistic.getType();
 	}
 
+	void handleCycleStatistic(const CycleStatistic& handedStatistic)
+	{
+		correctCycleStatistic
+		    = handedStatistic.getStatisticType() == CycleStatisticType::LOOP_DURATION;
+	}
+
 	void handleRegister(const Register& handedReg)
 	{
 		correctRegister = handedReg.getType() == reg.getType();
@@ -62,7 +69,7 @@ private:
 };
 
 SCENARIO("DataObjects have to store and provide object specific information and accept a visitor",
-    "[DataObject], [CoEObject], [ErrorStatistic], [PDO], [Register], "
+    "[DataObject], [CoEObject], [ErrorStatistic], [CycleStatistic], [PDO], [Register], "
     "[DataObjectVisitor]")
 {
 	GIVEN("The DataObjects and a DataObjectVisitor")
@@ -71,6 +78,7 @@ SCENARIO("DataObjects have to store and provide object specific information and
 		ErrorStatistic errorStatistic(2, ErrorStatisticType::FREQ_SLAVE_MALFORMAT_FRAME_ERROR);
 		PDO pdo(3, "PDO", EtherCATDataTypeEnum::TIME_OF_DAY, 5, PDODirection::OUTPUT);
 		Register reg(4, RegisterEnum::DLS_USER_R8);
+		CycleStatistic cycleStatistic(CycleStatisticType::LOOP_DURATION);
 
 		MockVisitor visitor(pdo, coe, errorStatistic, reg);
 		WHEN("I request the data for a CoEObject")
@@ -113,6 +121,16 @@ SCENARIO("DataObjects have to store and provide object specific information and
 				REQUIRE(statisticType == ErrorStatisticType::FREQ_SLAVE_MALFORMAT_FRAME_ERROR);
 			}
 		}
+		WHEN("I request the data for a CycleStatistic")
+		{
+			THEN("It is consistent with the data from construction")
+			{
+				REQUIRE(cycleStatistic.getName() == "Cycle loop duration");
+				REQUIRE(cycleStatistic.getSlaveID() == std::numeric_limits<unsigned int>::max());
+				REQUIRE(cycleStatistic.getType() == EtherCATDataTypeEnum::UNSIGNED32);
+				REQUIRE(cycleStatistic.getStatisticType() == CycleStatisticType::LOOP_DURATION);
+			}
+		}
 		WHEN("I request the data for a PDO")
 		{
 			PDODirection direction = pdo.getDirection();
@@ -151,12 +169,14 @@ SCENARIO("DataObjects have to store and provide object specific information and
 			errorStatistic.acceptVisitor(visitor);
 			pdo.acceptVisitor(visitor);
 			reg.acceptVisitor(visitor);
+			cycleStatistic.acceptVisitor(visitor);
 			THEN("The visitor gets the correct type")
 			{
 				REQUIRE(correctCoE);
 				REQUIRE(correctPDO);
 				REQUIRE(correctRegister);
 				REQUIRE(correctStatistic);
+				REQUIRE(correctCycleStatistic);
 			}
 		}
 	}
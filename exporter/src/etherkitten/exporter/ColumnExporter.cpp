@@ -0,0 +1,343 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ColumnExporter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include <etherkitten/reader/LogCache.hpp>
+#include <etherkitten/reader/LogChunkCache.hpp>
+#include <etherkitten/reader/LogSlaveInformant.hpp>
+
+namespace etherkitten::exporter
+{
+	namespace
+	{
+		/*!
+		 * \brief Call a function for every index below a count on several threads.
+		 *
+		 * The calling thread is one of them. If a call throws, the remaining indices are
+		 * skipped and the exception is rethrown once all threads are done.
+		 * \param count the number of indices
+		 * \param workerCount the number of threads
+		 * \param function the function to call with every index
+		 */
+		template<typename F>
+		void forEachInParallel(size_t count, unsigned int workerCount, F&& function)
+		{
+			std::atomic<size_t> next = 0;
+			std::exception_ptr error;
+			std::mutex errorMutex;
+			auto work = [&]() {
+				for (size_t i = next++; i < count; i = next++)
+				{
+					try
+					{
+						function(i);
+					}
+					catch (...)
+					{
+						std::lock_guard lock(errorMutex);
+						if (!error)
+							error = std::current_exception();
+						next = count;
+					}
+				}
+			};
+			std::vector<std::thread> threads;
+			for (size_t i = 1; i < std::min<size_t>(workerCount, count); ++i)
+			{
+				threads.emplace_back(work);
+			}
+			work();
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+			if (error)
+				std::rethrow_exception(error);
+		}
+
+		std::string toFileName(const std::string& name)
+		{
+			std::string fileName = name;
+			for (char& c : fileName)
+			{
+				if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '.')
+					c = '_';
+			}
+			return fileName;
+		}
+
+		std::string toCSVField(const std::string& text)
+		{
+			std::string field = "\"";
+			for (char c : text)
+			{
+				if (c == '"')
+					field += '"';
+				field += c;
+			}
+			return field + "\"";
+		}
+	} // namespace
+
+	ColumnExporter::ColumnExporter(
+	    std::filesystem::path logFile, std::filesystem::path outputDirectory)
+	    : ColumnExporter(std::move(logFile), std::move(outputDirectory), 0)
+	{
+	}
+
+	ColumnExporter::ColumnExporter(std::filesystem::path logFile,
+	    std::filesystem::path outputDirectory, unsigned int workerCount)
+	    : logFile(std::move(logFile))
+	    , outputDirectory(std::move(outputDirectory))
+	    , workerCount(
+	          workerCount != 0 ? workerCount : std::max(1u, std::thread::hardware_concurrency()))
+	{
+	}
+
+	std::vector<ExportedSignal> ColumnExporter::exportLog()
+	{
+		return exportLog([](int, std::string) {});
+	}
+
+	std::vector<ExportedSignal> ColumnExporter::exportLog(
+	    std::function<void(int, std::string)> progressFunction)
+	{
+		skippedChunks = 0;
+		readBytes = 0;
+		progressFunction(0, "Reading log header");
+		reader::LogSlaveInformant informant{ logFile };
+		reader::LogCache logCache;
+		reader::LogReader logReader{ logFile, informant, logCache, [](int, std::string) {},
+			reader::LogLoading::WINDOWED, workerCount };
+		for (auto& path : logReader.getLogFiles())
+		{
+			readBytes += std::filesystem::file_size(path);
+		}
+
+		std::filesystem::create_directories(outputDirectory);
+		std::vector<Signal> signals = collectSignals(informant, logReader);
+		if (logReader.getChunkCache())
+		{
+			exportChunks(logReader, signals, progressFunction);
+		}
+		else
+		{
+			exportViews(logReader, signals, progressFunction);
+		}
+
+		std::vector<ExportedSignal> exported;
+		for (auto& signal : signals)
+		{
+			if (!signal.file)
+				continue;
+			const datatypes::DataObject& object = std::visit(
+			    [](const auto& o) -> const datatypes::DataObject& { return o; }, signal.object);
+			exported.push_back({ object.getSlaveID(), object.getName(), object.getType(),
+			    signal.path, signal.file->getRowCount() });
+			signal.file.reset();
+		}
+		writeSignalList(exported);
+		progressFunction(100, "Finished exporting");
+		return exported;
+	}
+
+	std::vector<ColumnExporter::Signal> ColumnExporter::collectSignals(
+	    reader::LogSlaveInformant& informant, reader::LogReader& logReader)
+	{
+		std::vector<Signal> signals;
+		for (unsigned int i = 1; i <= informant.getSlaveCount(); ++i)
+		{
+			const datatypes::SlaveInfo& info = informant.getSlaveInfo(i);
+			std::string prefix = "slave" + std::to_string(i) + "_";
+			for (auto& pdo : info.getPDOs())
+			{
+				try
+				{
+					signals.push_back({ pdo, logReader.makeSeries(pdo),
+					    outputDirectory
+					        / (prefix + "pdo" + std::to_string(pdo.getIndex()) + "_"
+					            + toFileName(pdo.getName()) + ".ekc"),
+					    nullptr });
+				}
+				catch (const std::out_of_range& e)
+				{
+					// Strings have no column representation
+				}
+			}
+			for (auto& reg : info.getRegisters())
+			{
+				try
+				{
+					signals.push_back({ reg, logReader.makeSeries(reg),
+					    outputDirectory
+					        / (prefix + "reg" + std::to_string(static_cast<int>(reg.getRegister()))
+					            + "_" + toFileName(reg.getName()) + ".ekc"),
+					    nullptr });
+				}
+				catch (const std::out_of_range& e)
+				{
+					// Strings have no column representation
+				}
+			}
+		}
+		return signals;
+	}
+
+	void ColumnExporter::exportChunks(reader::LogReader& logReader, std::vector<Signal>& signals,
+	    const std::function<void(int, std::string)>& progressFunction)
+	{
+		reader::LogChunkCache& cache = *logReader.getChunkCache();
+		// The batch holds on to its chunks itself
+		cache.setMaximumMemory(0);
+		const std::vector<reader::ChunkEntryBlock>& chunks = cache.getIndex().getChunks();
+		datatypes::TimeStamp startTime = logReader.getStartTime();
+		constexpr uint8_t exportedKinds
+		    = reader::ChunkEntryBlock::processDataKind | reader::ChunkEntryBlock::registerKind;
+		std::atomic<size_t> skipped = 0;
+
+		size_t first = 0;
+		while (first < chunks.size())
+		{
+			// Decode a round of chunks at a time until the batch is large enough
+			std::vector<std::shared_ptr<const reader::DecodedChunk>> batch;
+			std::atomic<size_t> batchMemory = 0;
+			size_t end = first;
+			while (end < chunks.size() && batchMemory < maximumMemory)
+			{
+				size_t roundEnd = std::min(chunks.size(), end + workerCount);
+				batch.resize(roundEnd - first);
+				forEachInParallel(roundEnd - end, workerCount, [&, end](size_t i) {
+					if ((chunks[end + i].blockKinds & exportedKinds) == 0)
+						return;
+					try
+					{
+						auto chunk = cache.getChunk(end + i);
+						batchMemory += chunk->getMemoryUsage();
+						batch[end + i - first] = std::move(chunk);
+					}
+					catch (const std::runtime_error& e)
+					{
+						++skipped;
+					}
+				});
+				end = roundEnd;
+			}
+
+			// Each signal is written by one thread, so its values stay in order
+			forEachInParallel(signals.size(), workerCount, [&](size_t s) {
+				Signal& signal = signals[s];
+				for (size_t i = 0; i < batch.size(); ++i)
+				{
+					if (!batch[i] || !signal.series->mayBeIn(chunks[first + i]))
+						continue;
+					const reader::DecodedChunk& chunk = *batch[i];
+					const std::vector<datatypes::TimeStamp>& times = signal.series->getTimes(chunk);
+					for (size_t k = 0; k < times.size(); ++k)
+					{
+						append(signal, startTime, times[k], signal.series->asDouble(chunk, k));
+					}
+				}
+				if (signal.file)
+					signal.file->finishRowGroup();
+			});
+
+			first = end;
+			progressFunction(static_cast<int>(first * 100 / chunks.size()), "Exporting chunks");
+		}
+		skippedChunks = skipped;
+	}
+
+	void ColumnExporter::exportViews(reader::LogReader& logReader, std::vector<Signal>& signals,
+	    const std::function<void(int, std::string)>& progressFunction)
+	{
+		// Logs without a chunk index can only be read completely
+		progressFunction(0, "Reading log without chunk index");
+		uint32_t seenData = 0;
+		while (!logReader.hasFinishedReading())
+		{
+			seenData = logReader.waitForNewData(seenData, std::chrono::milliseconds(100));
+		}
+
+		datatypes::TimeStamp startTime = logReader.getStartTime();
+		std::atomic<size_t> done = 0;
+		// The progressFunction need not be thread-safe
+		std::mutex progressMutex;
+		forEachInParallel(signals.size(), workerCount, [&](size_t s) {
+			Signal& signal = signals[s];
+			std::shared_ptr<datatypes::AbstractDataView> view = std::visit(
+			    [&](const auto& object) {
+				    return logReader.getView(
+				        object, { datatypes::TimeStamp(), std::chrono::seconds(0) });
+			    },
+			    signal.object);
+			if (!view->isEmpty())
+			{
+				append(signal, startTime, view->getTime(), view->asDouble());
+				while (view->hasNext())
+				{
+					++(*view);
+					append(signal, startTime, view->getTime(), view->asDouble());
+				}
+			}
+			if (signal.file)
+				signal.file->finishRowGroup();
+			std::lock_guard lock(progressMutex);
+			progressFunction(static_cast<int>(++done * 100 / signals.size()), "Exporting signals");
+		});
+	}
+
+	void ColumnExporter::append(Signal& signal, datatypes::TimeStamp startTime,
+	    datatypes::TimeStamp time, double value)
+	{
+		if (!signal.file)
+		{
+			std::visit(
+			    [&](const auto& object) {
+				    signal.file = std::make_unique<ColumnFileWriter>(
+				        signal.path, object.getName(), object.getType(), startTime);
+			    },
+			    signal.object);
+		}
+		signal.file->append(time, value);
+		if (signal.file->getPendingRowCount() >= maximumRowGroupSize)
+			signal.file->finishRowGroup();
+	}
+
+	void ColumnExporter::writeSignalList(const std::vector<ExportedSignal>& exported)
+	{
+		std::filesystem::path path = outputDirectory / "signals.csv";
+		std::ofstream list(path, std::ios::out | std::ios::trunc);
+		list << "file,slave,name,type,rows\n";
+		for (auto& signal : exported)
+		{
+			list << toCSVField(signal.file.filename().string()) << "," << signal.slave << ","
+			     << toCSVField(signal.name) << "," << static_cast<int>(signal.type) << ","
+			     << signal.rowCount << "\n";
+		}
+		if (!list.flush())
+			throw std::runtime_error("cannot write the signal list " + path.string());
+	}
+} // namespace etherkitten::exporter
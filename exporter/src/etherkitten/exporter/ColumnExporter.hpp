@@ -0,0 +1,187 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+/*!
+ * \file
+ * \brief Defines the ColumnExporter, which converts a log into one column file per signal.
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <etherkitten/datatypes/dataobjects.hpp>
+#include <etherkitten/reader/LogReader.hpp>
+#include <etherkitten/reader/LogSeriesView.hpp>
+
+#include "ColumnFile.hpp"
+
+namespace etherkitten::exporter
+{
+	/*!
+	 * \brief A signal of a log that was written to a column file.
+	 */
+	struct ExportedSignal
+	{
+		/*!
+		 * \brief The id of the slave of the signal.
+		 */
+		unsigned int slave;
+
+		/*!
+		 * \brief The name of the PDO or register.
+		 */
+		std::string name;
+
+		/*!
+		 * \brief The data type of the PDO or register.
+		 */
+		datatypes::EtherCATDataTypeEnum type;
+
+		/*!
+		 * \brief The column file of the signal.
+		 */
+		std::filesystem::path file;
+
+		/*!
+		 * \brief The number of values in the column file.
+		 */
+		uint64_t rowCount;
+	};
+
+	/*!
+	 * \brief The ColumnExporter converts the PDOs and registers of a log into column files,
+	 * see ColumnFileWriter.
+	 *
+	 * Logs with a chunk index are streamed through the LogChunkCache of a LogReader:
+	 * a batch of chunks is decoded in parallel, then the values of every signal are taken
+	 * from the batch in parallel and written as a row group. Only one batch is kept in memory.
+	 * Logs without a chunk index are loaded completely and then written per signal in parallel.
+	 *
+	 * Signals without values and signals of string types are left out. The output directory
+	 * also receives a signals.csv that lists the column files.
+	 */
+	class ColumnExporter
+	{
+	public:
+		/*!
+		 * \brief The memory the decoded chunks of a batch may take up unless told otherwise.
+		 */
+		static constexpr size_t defaultMaximumMemory = 256 * 1024 * 1024;
+
+		/*!
+		 * \brief The number of rows after which a row group is written even if the batch
+		 * holds more values of its signal.
+		 */
+		static constexpr size_t maximumRowGroupSize = 1 << 16;
+
+		/*!
+		 * \brief Create a ColumnExporter that uses one thread per hardware thread.
+		 * \param logFile the log file or manifest to export
+		 * \param outputDirectory the directory to write the column files to
+		 */
+		ColumnExporter(std::filesystem::path logFile, std::filesystem::path outputDirectory);
+
+		/*!
+		 * \brief Create a ColumnExporter.
+		 * \param logFile the log file or manifest to export
+		 * \param outputDirectory the directory to write the column files to
+		 * \param workerCount the number of threads that decode and write,
+		 * 0 for one per hardware thread
+		 */
+		ColumnExporter(std::filesystem::path logFile, std::filesystem::path outputDirectory,
+		    unsigned int workerCount);
+
+		/*!
+		 * \brief Set how much memory the decoded chunks of a batch may take up.
+		 *
+		 * A batch always holds at least one chunk per thread.
+		 * \param size the memory limit in bytes
+		 */
+		void setMaximumMemory(size_t size) { maximumMemory = size; }
+
+		/*!
+		 * \brief Export the log.
+		 * \return the signals that were written
+		 * \exception reader::SlaveInformantError iff the log cannot be read
+		 * \exception std::runtime_error iff a column file cannot be written
+		 */
+		std::vector<ExportedSignal> exportLog();
+
+		/*!
+		 * \brief Export the log and report the progress by calling the progressFunction
+		 * with an integer between 0 and 100 and a message.
+		 * \param progressFunction a function that is called to report the progress
+		 * \return the signals that were written
+		 * \exception reader::SlaveInformantError iff the log cannot be read
+		 * \exception std::runtime_error iff a column file cannot be written
+		 */
+		std::vector<ExportedSignal> exportLog(
+		    std::function<void(int, std::string)> progressFunction);
+
+		/*!
+		 * \brief Get the number of chunks that could not be decoded in the last export.
+		 *
+		 * Their values are missing from the column files.
+		 * \return the number of skipped chunks
+		 */
+		size_t getSkippedChunkCount() const { return skippedChunks; }
+
+		/*!
+		 * \brief Get the size of the files that were read in the last export.
+		 *
+		 * For a log that is split into segments, these are the segments, not the manifest.
+		 * \return the size of the log files in bytes
+		 */
+		uint64_t getReadByteCount() const { return readBytes; }
+
+	private:
+		/*!
+		 * \brief A PDO or register that is exported.
+		 */
+		struct Signal
+		{
+			std::variant<datatypes::PDO, datatypes::Register> object;
+			std::shared_ptr<const reader::LogSeries> series;
+			std::filesystem::path path;
+			// Created with the first value of the signal
+			std::unique_ptr<ColumnFileWriter> file;
+		};
+
+		const std::filesystem::path logFile;
+		const std::filesystem::path outputDirectory;
+		const unsigned int workerCount;
+		size_t maximumMemory = defaultMaximumMemory;
+		size_t skippedChunks = 0;
+		uint64_t readBytes = 0;
+
+		std::vector<Signal> collectSignals(reader::LogSlaveInformant& informant,
+		    reader::LogReader& logReader);
+		void exportChunks(reader::LogReader& logReader, std::vector<Signal>& signals,
+		    const std::function<void(int, std::string)>& progressFunction);
+		void exportViews(reader::LogReader& logReader, std::vector<Signal>& signals,
+		    const std::function<void(int, std::string)>& progressFunction);
+		void append(Signal& signal, datatypes::TimeStamp startTime, datatypes::TimeStamp time,
+		    double value);
+		void writeSignalList(const std::vector<ExportedSignal>& exported);
+	};
+} // namespace etherkitten::exporter
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ColumnFile.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#include <etherkitten/reader/endianness.hpp>
+
+namespace etherkitten::exporter
+{
+	ColumnFileWriter::ColumnFileWriter(const std::filesystem::path& path,
+	    const std::string& name, datatypes::EtherCATDataTypeEnum type,
+	    datatypes::TimeStamp startTime)
+	    : path(path)
+	    , file(path, std::ios::out | std::ios::binary | std::ios::trunc)
+	{
+		if (!file)
+			throw std::runtime_error("cannot create the column file " + path.string());
+		uint64_t header[] = { reader::flipBytesIfBigEndianHost(magic) };
+		writeChecked(header, sizeof(header));
+		uint16_t versionAndType[] = { reader::flipBytesIfBigEndianHost(version),
+			reader::flipBytesIfBigEndianHost(static_cast<uint16_t>(type)) };
+		writeChecked(versionAndType, sizeof(versionAndType));
+		uint64_t start = reader::flipBytesIfBigEndianHost(datatypes::timeStampToInt(startTime));
+		writeChecked(&start, sizeof(start));
+		uint16_t nameLength = reader::flipBytesIfBigEndianHost(static_cast<uint16_t>(name.size()));
+		writeChecked(&nameLength, sizeof(nameLength));
+		writeChecked(name.data(), static_cast<uint16_t>(name.size()));
+	}
+
+	void ColumnFileWriter::append(datatypes::TimeStamp time, double value)
+	{
+		int64_t micros = static_cast<int64_t>(datatypes::timeStampToInt(time));
+		times.push_back(reader::flipBytesIfBigEndianHost(micros));
+		uint64_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		bits = reader::flipBytesIfBigEndianHost(bits);
+		memcpy(&value, &bits, sizeof(bits));
+		values.push_back(value);
+	}
+
+	void ColumnFileWriter::finishRowGroup()
+	{
+		if (times.empty())
+			return;
+		uint64_t rows = reader::flipBytesIfBigEndianHost(static_cast<uint64_t>(times.size()));
+		writeChecked(&rows, sizeof(rows));
+		writeChecked(times.data(), times.size() * sizeof(int64_t));
+		writeChecked(values.data(), values.size() * sizeof(double));
+		rowCount += times.size();
+		times.clear();
+		values.clear();
+	}
+
+	void ColumnFileWriter::writeChecked(const void* data, size_t length)
+	{
+		file.write(static_cast<const char*>(data), static_cast<std::streamsize>(length));
+		if (!file)
+			throw std::runtime_error("cannot write to the column file " + path.string());
+	}
+} // namespace etherkitten::exporter
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+/*!
+ * \file
+ * \brief Defines the ColumnFileWriter, which writes the values of one signal of a log
+ * to a columnar file.
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <etherkitten/datatypes/ethercatdatatypes.hpp>
+#include <etherkitten/datatypes/time.hpp>
+
+namespace etherkitten::exporter
+{
+	/*
+	 * Some information about the column files:
+	 * ========================================
+	 *
+	 * A column file holds the values of one PDO or register of a log. It starts with a
+	 * header that names the signal and is followed by row groups. Every row group holds
+	 * a column with the TimeStamps of its values in microseconds, like in the log,
+	 * followed by a column with the values converted to doubles. Integers with more than
+	 * 53 significant bits are rounded by that conversion.
+	 *
+	 * Since the columns of a row group are stored contiguously, they can be read by
+	 * mapping the file or with numpy.fromfile() without parsing every value.
+	 *
+	 * header:
+	 * *-------*---------*-----------*------------*-------------*------*
+	 * | magic | version | data type | start time | name length | name |
+	 * *-------*---------*-----------*------------*-------------*------*
+	 * |  64   |   16    |    16     |     64     |     16      |      |
+	 * *-------*---------*-----------*------------*-------------*------*
+	 *
+	 * row group:
+	 * *-----------*-----------------------*-----------------------*
+	 * | row count |      timestamps       |        values         |
+	 * *-----------*-----------------------*-----------------------*
+	 * |    64     | row count * 64 (int)  | row count * 64 (IEEE) |
+	 * *-----------*-----------------------*-----------------------*
+	 * second line contains the length in bits
+	 *
+	 * The data type is the value of the EtherCATDataTypeEnum of the signal and the start time
+	 * is the start time of the log. The column file uses little endian byte order.
+	 */
+
+	/*!
+	 * \brief The ColumnFileWriter writes the values of one signal to a column file.
+	 *
+	 * The values are collected in memory until a row group is finished.
+	 */
+	class ColumnFileWriter
+	{
+	public:
+		/*!
+		 * \brief The first eight bytes of every column file.
+		 */
+		static constexpr uint64_t magic = 0x314C4F434B45; // "EKCOL1" in little endian
+
+		/*!
+		 * \brief The version of the column files that are written.
+		 */
+		static constexpr uint16_t version = 1;
+
+		/*!
+		 * \brief Create a column file and write its header.
+		 * \param path the path of the column file
+		 * \param name the name of the signal
+		 * \param type the data type of the signal
+		 * \param startTime the start time of the log
+		 * \exception std::runtime_error iff the file cannot be written
+		 */
+		ColumnFileWriter(const std::filesystem::path& path, const std::string& name,
+		    datatypes::EtherCATDataTypeEnum type, datatypes::TimeStamp startTime);
+
+		/*!
+		 * \brief Add a value to the current row group.
+		 * \param time the TimeStamp of the value
+		 * \param value the value
+		 */
+		void append(datatypes::TimeStamp time, double value);
+
+		/*!
+		 * \brief Write the values added since the last row group as a row group.
+		 *
+		 * Does nothing if there are none.
+		 * \exception std::runtime_error iff the file cannot be written
+		 */
+		void finishRowGroup();
+
+		/*!
+		 * \brief Get the number of values added to the file.
+		 * \return the number of rows
+		 */
+		uint64_t getRowCount() const { return rowCount; }
+
+		/*!
+		 * \brief Get the number of values that are not written to a row group yet.
+		 * \return the number of rows in memory
+		 */
+		size_t getPendingRowCount() const { return times.size(); }
+
+	private:
+		std::filesystem::path path;
+		std::ofstream file;
+		std::vector<int64_t> times;
+		std::vector<double> values;
+		uint64_t rowCount = 0;
+
+		void writeChecked(const void* data, size_t length);
+	};
+} // namespace etherkitten::exporter
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ * \brief Defines the entry point of etherkitten-export, which writes a log to column files
+ * without a GUI.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <etherkitten/reader/SlaveInformant.hpp>
+
+#include "ColumnExporter.hpp"
+
+namespace
+{
+	void printUsage(const char* program)
+	{
+		std::cerr << "Usage: " << program << " [-j workers] [-m memoryMiB] <log> <directory>\n"
+		          << "Writes every PDO and register of an EtherKITten log or manifest to a\n"
+		          << "column file in the directory.\n"
+		          << "  -j workers    the number of threads to use, 0 for one per core\n"
+		          << "  -m memoryMiB  the memory decoded chunks may take up at a time\n";
+	}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	using namespace etherkitten;
+
+	unsigned int workerCount = 0;
+	size_t maximumMemory = exporter::ColumnExporter::defaultMaximumMemory;
+	std::vector<std::string> arguments;
+	try
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string argument = argv[i];
+			if ((argument == "-j" || argument == "-m") && i + 1 < argc)
+			{
+				unsigned long value = std::stoul(argv[++i]);
+				if (argument == "-j")
+					workerCount = static_cast<unsigned int>(value);
+				else
+					maximumMemory = value * 1024 * 1024;
+			}
+			else
+			{
+				arguments.push_back(argument);
+			}
+		}
+	}
+	catch (const std::logic_error& e)
+	{
+		printUsage(argv[0]);
+		return EXIT_FAILURE;
+	}
+	if (arguments.size() != 2)
+	{
+		printUsage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	try
+	{
+		exporter::ColumnExporter columnExporter{ arguments[0], arguments[1], workerCount };
+		columnExporter.setMaximumMemory(maximumMemory);
+		auto start = std::chrono::steady_clock::now();
+		auto signals = columnExporter.exportLog([](int progress, std::string message) {
+			std::cerr << "\r" << progress << "% " << message << "\033[K" << std::flush;
+		});
+		std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+		std::cerr << "\n";
+
+		uint64_t rows = 0;
+		for (auto& signal : signals)
+		{
+			rows += signal.rowCount;
+		}
+		double mebibytes = columnExporter.getReadByteCount() / (1024.0 * 1024.0);
+		std::cout << "Exported " << signals.size() << " signals with " << rows << " values in "
+		          << seconds.count() << " s (" << mebibytes / seconds.count() << " MiB/s)\n";
+		if (columnExporter.getSkippedChunkCount() > 0)
+		{
+			std::cerr << "Skipped " << columnExporter.getSkippedChunkCount()
+			          << " chunks that could not be decoded\n";
+		}
+	}
+	catch (const reader::SlaveInformantError& e)
+	{
+		std::cerr << "The log cannot be read: " << e.what() << "\n";
+		return EXIT_FAILURE;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "The export failed: " << e.what() << "\n";
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
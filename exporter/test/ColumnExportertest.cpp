@@ -0,0 +1,256 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <etherkitten/datatypes/dataobjects.hpp>
+#include <etherkitten/exporter/ColumnExporter.hpp>
+#include <etherkitten/reader/LogCache.hpp>
+#include <etherkitten/reader/LogManifest.hpp>
+#include <etherkitten/reader/log/header.hpp>
+#include <etherkitten/reader/logger.hpp>
+
+#include "DataReaderMock.hpp"
+#include "SlaveInformantMock.hpp"
+
+using namespace etherkitten::exporter;
+using namespace etherkitten::reader;
+using namespace etherkitten::datatypes;
+
+namespace
+{
+	/*!
+	 * \brief Get a TimeStamp ten minutes after the epoch.
+	 *
+	 * The minute index of a SearchList does not handle values from the first minute.
+	 */
+	TimeStamp at(uint64_t micros) { return intToTimeStamp(600000000 + micros); }
+
+	struct Column
+	{
+		uint16_t type;
+		std::string name;
+		std::vector<int64_t> times;
+		std::vector<double> values;
+		size_t rowGroupCount = 0;
+	};
+
+	template<typename T>
+	T readValue(std::ifstream& in)
+	{
+		T value;
+		in.read(reinterpret_cast<char*>(&value), sizeof(value));
+		return value;
+	}
+
+	Column readColumn(const std::filesystem::path& path)
+	{
+		std::ifstream in(path, std::ios::in | std::ios::binary);
+		Column column;
+		REQUIRE(readValue<uint64_t>(in) == ColumnFileWriter::magic);
+		REQUIRE(readValue<uint16_t>(in) == ColumnFileWriter::version);
+		column.type = readValue<uint16_t>(in);
+		// The start time of the log is when the Logger started
+		REQUIRE(readValue<uint64_t>(in) > 0);
+		column.name.resize(readValue<uint16_t>(in));
+		in.read(column.name.data(), column.name.size());
+		while (in.peek() != std::ifstream::traits_type::eof())
+		{
+			uint64_t rows = readValue<uint64_t>(in);
+			size_t first = column.times.size();
+			column.times.resize(first + rows);
+			column.values.resize(first + rows);
+			in.read(reinterpret_cast<char*>(&column.times[first]), rows * sizeof(int64_t));
+			in.read(reinterpret_cast<char*>(&column.values[first]), rows * sizeof(double));
+			REQUIRE(in);
+			++column.rowGroupCount;
+		}
+		return column;
+	}
+
+	std::string readText(const std::filesystem::path& path)
+	{
+		std::ifstream in(path);
+		return std::string(std::istreambuf_iterator<char>(in), {});
+	}
+
+	void requireValues(const Column& column, uint64_t offset, uint64_t factor)
+	{
+		REQUIRE(column.times.size() == 200);
+		for (uint64_t i = 0; i < 200; ++i)
+		{
+			REQUIRE(column.times[i] == static_cast<int64_t>(timeStampToInt(at(1000 * i + offset))));
+			REQUIRE(column.values[i] == factor * i);
+		}
+	}
+} // namespace
+
+SCENARIO("A ColumnExporter writes every signal of a log to its own column file", "[Exporter]")
+{
+	GIVEN("A log with a PDO and a register")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 1, 2 } };
+		PDO pdo = PDO(1, "Position \"X\"", EtherCATDataTypeEnum::INTEGER16, 0,
+		    PDODirection::INPUT);
+		reader.slaveInformant.feedSlaveInfo(1,
+		    SlaveInfo(1, "Slave1", std::vector<PDO>{ pdo }, {}, ESIData{}, {},
+		        std::array<unsigned int, 4>{ 0, 0, 0, 0 }));
+		reader.appendPDOToIOMap(pdo);
+		Register reg = Register(1, RegisterEnum::BUILD);
+		for (uint64_t i = 0; i < 200; ++i)
+		{
+			reader.feedPDOData({ { pdo, i } }, at(1000 * i + 500));
+			reader.feedRegister(reg, at(1000 * i + 700), 3 * i);
+		}
+		{
+			LogCache errorCache;
+			Logger logger{ reader.slaveInformant, reader, errorCache.getErrors(),
+				"Exportlog.ekl" };
+			logger.setChunkSize(256);
+			logger.setEncodeChunks(true);
+			logger.startLog(at(0));
+			std::this_thread::sleep_for(std::chrono::milliseconds(200));
+			logger.stopLog();
+		}
+		std::filesystem::remove_all("Exported");
+
+		WHEN("The log is exported in batches of a few chunks")
+		{
+			ColumnExporter exporter{ "Exportlog.ekl", "Exported", 3 };
+			exporter.setMaximumMemory(1);
+			int lastProgress = -1;
+			auto signals = exporter.exportLog([&](int progress, std::string) {
+				REQUIRE(progress >= lastProgress);
+				lastProgress = progress;
+			});
+
+			THEN("Every signal with values has a column file with all of them")
+			{
+				REQUIRE(lastProgress == 100);
+				REQUIRE(exporter.getSkippedChunkCount() == 0);
+				REQUIRE(exporter.getReadByteCount() == std::filesystem::file_size("Exportlog.ekl"));
+				REQUIRE(signals.size() == 2);
+				REQUIRE(signals[0].name == "Position \"X\"");
+				REQUIRE(signals[0].rowCount == 200);
+				REQUIRE(signals[1].type == reg.getType());
+				REQUIRE(signals[1].rowCount == 200);
+
+				Column pdoColumn = readColumn(signals[0].file);
+				REQUIRE(pdoColumn.name == "Position \"X\"");
+				REQUIRE(pdoColumn.type == static_cast<uint16_t>(EtherCATDataTypeEnum::INTEGER16));
+				REQUIRE(pdoColumn.rowGroupCount > 1);
+				requireValues(pdoColumn, 500, 1);
+				requireValues(readColumn(signals[1].file), 700, 3);
+			}
+
+			THEN("The signals are listed next to the column files")
+			{
+				std::string list = readText("Exported/signals.csv");
+				REQUIRE(list.rfind("file,slave,name,type,rows\n", 0) == 0);
+				REQUIRE(list.find("\"slave1_pdo0_Position__X_.ekc\",1,\"Position \"\"X\"\"\",")
+				    != std::string::npos);
+				REQUIRE(std::count(list.begin(), list.end(), '\n') == 3);
+			}
+		}
+
+		WHEN("A log without a chunk index is exported")
+		{
+			// A version 1 log is a version 2 log with the shorter header and without the index
+			std::ifstream in("Exportlog.ekl", std::ios::in | std::ios::binary);
+			std::string log(std::istreambuf_iterator<char>(in), {});
+			Serialized headerSer = Serialized::wrap(log.data(), 48);
+			SlaveInformantMock si{ 0, 8 };
+			LogBusInfo bi;
+			ParsingContext pc(si, bi);
+			LogHeaderBlock header = LogHeaderBlock::serializer.parseSerialized(headerSer, pc);
+			uint64_t shift = 48 - 40;
+			LogHeaderBlock v1Header{ 1, header.pdoDescOffset - shift, header.dataOffset - shift,
+				header.ioMapSize, header.startTime, 0 };
+			{
+				std::ofstream out("Exportlogv1.ekl", std::ios::binary);
+				Serialized v1HeaderSer = v1Header.getSerializer().serialize(v1Header);
+				out.write(v1HeaderSer.data, v1HeaderSer.length);
+				out.write(log.data() + 48, header.indexOffset - 48);
+			}
+			ColumnExporter exporter{ "Exportlogv1.ekl", "Exported", 2 };
+			auto signals = exporter.exportLog();
+
+			THEN("The column files hold the same values")
+			{
+				REQUIRE(signals.size() == 2);
+				requireValues(readColumn(signals[0].file), 500, 1);
+				requireValues(readColumn(signals[1].file), 700, 3);
+			}
+		}
+
+		WHEN("A log that is split into segments is exported")
+		{
+			{
+				LogCache errorCache;
+				Logger logger{ reader.slaveInformant, reader, errorCache.getErrors(),
+					"Exportrotated.ekl" };
+				logger.setChunkSize(256);
+				logger.setEncodeChunks(true);
+				logger.setRotation(0, std::chrono::milliseconds(20));
+				logger.startLog(at(0));
+				std::this_thread::sleep_for(std::chrono::milliseconds(200));
+				logger.stopLog();
+			}
+			ColumnExporter exporter{ "Exportrotated.ekl", "Exported", 2 };
+			auto signals = exporter.exportLog();
+
+			THEN("The values of all segments are exported")
+			{
+				REQUIRE(signals.size() == 2);
+				requireValues(readColumn(signals[0].file), 500, 1);
+				requireValues(readColumn(signals[1].file), 700, 3);
+			}
+
+			THEN("The size of the segments is counted instead of the manifest")
+			{
+				std::vector<std::filesystem::path> segments
+				    = LogManifest::getLogFiles("Exportrotated.ekl");
+				REQUIRE(segments.size() > 1);
+				uint64_t size = 0;
+				for (auto& segment : segments)
+				{
+					size += std::filesystem::file_size(segment);
+				}
+				REQUIRE(exporter.getReadByteCount() == size);
+			}
+		}
+
+		WHEN("The log does not exist")
+		{
+			ColumnExporter exporter{ "Missinglog.ekl", "Exported" };
+
+			THEN("Nothing is exported")
+			{
+				REQUIRE_THROWS_AS(exporter.exportLog(), SlaveInformantError);
+				REQUIRE_FALSE(std::filesystem::exists("Exported/signals.csv"));
+			}
+		}
+	}
+}
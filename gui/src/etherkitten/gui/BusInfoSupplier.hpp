@@ -65,6 +65,13 @@ namespace etherkitten::gui
 		virtual std::vector<std::reference_wrapper<const datatypes::ErrorStatistic>>
 		getErrorStatistics() = 0;
 
+		/*!
+		 * \brief Return the statistics of the cycles of the realtime loop.
+		 * \return the statistics of the cycles of the realtime loop
+		 */
+		virtual std::vector<std::reference_wrapper<const datatypes::CycleStatistic>>
+		getCycleStatistics() = 0;
+
 		/*!
 		 * \brief Return the number of slaves for the currently attached bus.
 		 * \return the number of slaves for the currently attached bus.
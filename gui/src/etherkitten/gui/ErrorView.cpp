@@ -217,6 +217,7 @@ namespace etherkitten::gui
 			}
 			statisticList->addTopLevelItem(item);
 		}
+		setupCycleStatistics();
 		startTime = busInfo.getStartTime();
 		errorIterator = busInfo.getErrorLog();
 		/* get the first message in case it exists */
@@ -225,6 +226,25 @@ namespace etherkitten::gui
 		updateStatistics();
 	}
 
+	void ErrorView::setupCycleStatistics()
+	{
+		QTreeWidgetItem* section = new QTreeWidgetItem(statisticList);
+		section->setText(0, "Realtime loop");
+		section->setText(1, "Newest value");
+		for (const datatypes::CycleStatistic& obj : busInfo.getCycleStatistics())
+		{
+			QTreeWidgetItem* item = new QTreeWidgetItem(section);
+			item->setText(
+			    0, QString::fromStdString(datatypes::cycleStatisticMap.at(obj.getStatisticType())));
+			statistics.emplace_back(
+			    obj, dataAdapter.getNewestValueView(obj), 1, item, datatypes::TimeStamp());
+			obj.acceptVisitor(tooltipFormatter);
+			item->setToolTip(1, tooltipFormatter.getTooltip());
+		}
+		statisticList->addTopLevelItem(section);
+		section->setExpanded(true);
+	}
+
 	void ErrorView::clear()
 	{
 		errorLog->clear();
@@ -106,10 +106,14 @@ namespace etherkitten::gui
 		 * \param data The error message to handle.
 		 */
 		void handleErrorMessage(const datatypes::DataPoint<datatypes::ErrorMessage>&& data);
+		/*!
+		 * \brief Add the statistics of the cycles of the realtime loop to the statistic list.
+		 */
+		void setupCycleStatistics();
 
 		struct Statistic
 		{
-			Statistic(const datatypes::ErrorStatistic& statistic,
+			Statistic(const datatypes::DataObject& statistic,
 			    std::unique_ptr<datatypes::AbstractNewestValueView> view, int column,
 			    QTreeWidgetItem* item, datatypes::TimeStamp lastTime)
 			    : statistic(statistic)
@@ -119,7 +123,7 @@ namespace etherkitten::gui
 			    , lastTime(lastTime)
 			{
 			}
-			std::reference_wrapper<const datatypes::ErrorStatistic> statistic;
+			std::reference_wrapper<const datatypes::DataObject> statistic;
 			std::unique_ptr<datatypes::AbstractNewestValueView> view;
 			int column;
 			QTreeWidgetItem* item;
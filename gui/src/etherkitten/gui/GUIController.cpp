@@ -62,6 +62,13 @@ namespace etherkitten::gui
 		plots = true;
 	}
 
+	void GUIController::DataVisitor::handleCycleStatistic(const datatypes::CycleStatistic& stat)
+	{
+		(void)stat;
+		watchlist = true;
+		plots = true;
+	}
+
 	bool GUIController::DataVisitor::canAddToPlots() const { return plots; }
 
 	bool GUIController::DataVisitor::canAddToWatchlist() const { return watchlist; }
@@ -301,6 +301,7 @@ namespace etherkitten::gui
 			void handleCoE(const datatypes::CoEObject& obj) override;
 			void handleRegister(const datatypes::Register& reg) override;
 			void handleErrorStatistic(const datatypes::ErrorStatistic& stat) override;
+			void handleCycleStatistic(const datatypes::CycleStatistic& stat) override;
 			bool canAddToWatchlist() const;
 			bool canAddToPlots() const;
 
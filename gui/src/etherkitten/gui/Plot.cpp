@@ -17,6 +17,7 @@
 
 #include "Plot.hpp"
 #include <QString>
+#include <array>
 #include <chrono>
 
 namespace etherkitten::gui
@@ -100,20 +101,27 @@ namespace etherkitten::gui
 				continue;
 			auto d = graph(static_cast<int>(i))->data();
 			QCPGraphData gd;
-			while (view->hasNext())
+			std::array<double, READ_BATCH_SIZE> values;
+			std::array<datatypes::TimeStamp, READ_BATCH_SIZE> times;
+			size_t read = 0;
+			while ((read = view->readBatch(values.data(), times.data(), READ_BATCH_SIZE)) > 0)
 			{
-				++(*view);
-				tmp = timeConverter.timeToMilli(view->getTime());
-				if (tmp < dataList[i].lastTime + timeStep)
-					continue;
-				dataList[i].lastTime = tmp;
-				gd.key = static_cast<double>(tmp) / 1000;
-				gd.value = view->asDouble();
-				d->add(gd);
-				if (gd.value > maxValue)
-					maxValue = gd.value;
-				if (gd.value < minValue)
-					minValue = gd.value;
+				for (size_t j = 0; j < read; j++)
+				{
+					tmp = timeConverter.timeToMilli(times[j]);
+					/* views already keep timeStep between their points, except for coarse
+					 * views that show the minimum and maximum of every step */
+					if (tmp < dataList[i].lastTime)
+						continue;
+					dataList[i].lastTime = tmp;
+					gd.key = static_cast<double>(tmp) / 1000;
+					gd.value = values[j];
+					d->add(gd);
+					if (gd.value > maxValue)
+						maxValue = gd.value;
+					if (gd.value < minValue)
+						minValue = gd.value;
+				}
 			}
 		}
 		cacheEnd = maxLocalDuration;
@@ -181,17 +189,25 @@ namespace etherkitten::gui
 			tmp = timeConverter.timeToMilli(view->getTime());
 			QCPGraphData gd(static_cast<double>(tmp) / 1000, view->asDouble());
 			d->add(gd);
-			while (view->hasNext() && gd.key < cacheEndSeconds)
+			/* the points of a batch that end up behind the cache are kept, since the view
+			 * has already moved past them */
+			std::array<double, READ_BATCH_SIZE> values;
+			std::array<datatypes::TimeStamp, READ_BATCH_SIZE> times;
+			size_t read = 0;
+			while (gd.key < cacheEndSeconds
+			    && (read = view->readBatch(values.data(), times.data(), READ_BATCH_SIZE)) > 0)
 			{
-				++(*view);
-				tmp = timeConverter.timeToMilli(view->getTime());
-				gd.key = static_cast<double>(tmp) / 1000;
-				gd.value = view->asDouble();
-				d->add(gd);
-				if (gd.value > maxValue)
-					maxValue = gd.value;
-				if (gd.value < minValue)
-					minValue = gd.value;
+				for (size_t j = 0; j < read; j++)
+				{
+					tmp = timeConverter.timeToMilli(times[j]);
+					gd.key = static_cast<double>(tmp) / 1000;
+					gd.value = values[j];
+					d->add(gd);
+					if (gd.value > maxValue)
+						maxValue = gd.value;
+					if (gd.value < minValue)
+						minValue = gd.value;
+				}
 			}
 			dataList[i].lastTime = tmp;
 			if (tmp > maxLocalDuration)
@@ -148,6 +148,10 @@ namespace etherkitten::gui
 		 * \brief The minimum number of pixels between data points.
 		 */
 		static const int MIN_PIXELS_PER_POINT = 2;
+		/*!
+		 * \brief The maximum number of data points read from a view at once.
+		 */
+		static const size_t READ_BATCH_SIZE = 1024;
 
 	public slots:
 		/*!
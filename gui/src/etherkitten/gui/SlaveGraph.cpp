@@ -23,6 +23,7 @@
 #include <QVBoxLayout>
 #include <QWheelEvent>
 #include <QtMath>
+#include <array>
 #include <chrono>
 #include <etherkitten/datatypes/EtherCATTypeParser.hpp>
 #include <etherkitten/datatypes/EtherCATTypeStringFormatter.hpp>
@@ -93,10 +94,12 @@ namespace etherkitten::gui
 			NodeMetadata& nm = nodes[i];
 			/* show errors for error statistic frequencies */
 			double totalErrorFreq = 0;
+			std::array<double, readBatchSize> values;
+			std::array<datatypes::TimeStamp, readBatchSize> times;
 			for (auto& view : nm.statViews)
 			{
-				while (view->hasNext())
-					++(*view);
+				while (view->readBatch(values.data(), times.data(), readBatchSize) == readBatchSize)
+					;
 				if (view->isEmpty())
 					continue;
 				double freq = view->asDouble();
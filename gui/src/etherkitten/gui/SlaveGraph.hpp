@@ -159,6 +159,8 @@ namespace etherkitten::gui
 		                                                  a low error is shown for the slave */
 		static constexpr double highErrorFreq = 100; /* when combined error frequency is >= this, a
 		                                                high error is shown for the slave */
+		static constexpr size_t readBatchSize = 64; /* how many values to skip over at once when
+		                                               moving a view to its newest value */
 		BusInfoSupplier& busInfo;
 		DataModelAdapter& dataAdapter;
 		QGraphicsScene* scene;
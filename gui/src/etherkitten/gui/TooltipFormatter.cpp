@@ -120,6 +120,31 @@ namespace etherkitten::gui
 		}
 	}
 
+	void TooltipFormatter::handleCycleStatistic(const datatypes::CycleStatistic& statistic)
+	{
+		switch (statistic.getStatisticType())
+		{
+		case datatypes::CycleStatisticType::SEND_TIME:
+			tooltip = "Time in nanoseconds it took to send the process data frames";
+			break;
+		case datatypes::CycleStatisticType::RECEIVE_LATENCY:
+			tooltip = "Time in nanoseconds from sending to receiving the process data frames";
+			break;
+		case datatypes::CycleStatisticType::REGISTER_FRAME_COUNT:
+			tooltip = "Number of register frames read in the cycle";
+			break;
+		case datatypes::CycleStatisticType::LOOP_DURATION:
+			tooltip = "Time in nanoseconds the cycle spent working";
+			break;
+		case datatypes::CycleStatisticType::CYCLE_PERIOD:
+			tooltip = "Time in nanoseconds from the start of the cycle to the start of the next";
+			break;
+		case datatypes::CycleStatisticType::DEADLINE_MISS:
+			tooltip = "1 if the cycle took longer than the cycle time, 0 otherwise";
+			break;
+		}
+	}
+
 	void TooltipFormatter::handleRegister(const datatypes::Register& reg)
 	{
 		switch (reg.getRegister())
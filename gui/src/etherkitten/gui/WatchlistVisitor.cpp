@@ -106,6 +106,17 @@ namespace etherkitten::gui
 		};
 	}
 
+	void WatchlistVisitor::handleCycleStatistic(const datatypes::CycleStatistic& statistic)
+	{
+		(void)statistic;
+		entry = nullptr;
+		generator = [](QMenu* menu, const datatypes::DataObject& obj, bool busLive) {
+			(void)menu;
+			(void)obj;
+			(void)busLive;
+		};
+	}
+
 	void WatchlistVisitor::handleRegister(const datatypes::Register& reg)
 	{
 		(void)reg;
@@ -71,6 +71,7 @@ namespace etherkitten::gui
 		void handlePDO(const datatypes::PDO& object) override;
 		void handleCoE(const datatypes::CoEObject& object) override;
 		void handleErrorStatistic(const datatypes::ErrorStatistic& statistic) override;
+		void handleCycleStatistic(const datatypes::CycleStatistic& statistic) override;
 		void handleRegister(const datatypes::Register& reg) override;
 
 	private:
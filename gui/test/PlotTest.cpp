@@ -163,6 +163,12 @@ namespace etherkitten::gui_test
 		return std::vector<std::reference_wrapper<const datatypes::ErrorStatistic>>();
 	}
 
+	std::vector<std::reference_wrapper<const datatypes::CycleStatistic>>
+	DummyBusInfoSupplier::getCycleStatistics()
+	{
+		return std::vector<std::reference_wrapper<const datatypes::CycleStatistic>>();
+	}
+
 	unsigned int DummyBusInfoSupplier::getSlaveCount() { return 0; }
 
 	const datatypes::SlaveInfo& DummyBusInfoSupplier::getSlaveInfo(unsigned int slaveID)
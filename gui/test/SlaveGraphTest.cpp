@@ -88,6 +88,12 @@ namespace etherkitten::gui_test
 		throw std::runtime_error("not implemented");
 	}
 
+	std::vector<std::reference_wrapper<const datatypes::CycleStatistic>>
+	DummyBusInfoSupplier::getCycleStatistics()
+	{
+		return std::vector<std::reference_wrapper<const datatypes::CycleStatistic>>();
+	}
+
 	unsigned int DummyBusInfoSupplier::getSlaveCount() { return numSlaves; }
 
 	datatypes::SlaveInfo& DummyBusInfoSupplier::getSlaveInfo(unsigned int slaveID)
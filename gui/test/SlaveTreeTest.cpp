@@ -65,6 +65,12 @@ namespace etherkitten::slave_tree_test
 		return std::vector<std::reference_wrapper<const datatypes::ErrorStatistic>>();
 	}
 
+	std::vector<std::reference_wrapper<const datatypes::CycleStatistic>>
+	DummyBusInfoSupplier::getCycleStatistics()
+	{
+		return std::vector<std::reference_wrapper<const datatypes::CycleStatistic>>();
+	}
+
 	unsigned int DummyBusInfoSupplier::getSlaveCount() { return numSlaves; }
 
 	datatypes::SlaveInfo& DummyBusInfoSupplier::getSlaveInfo(unsigned int slaveID)
@@ -40,6 +40,8 @@ namespace etherkitten::slave_tree_test
 		std::shared_ptr<datatypes::ErrorIterator> getErrorLog() override;
 		std::vector<std::reference_wrapper<const datatypes::ErrorStatistic>>
 		getErrorStatistics() override;
+		std::vector<std::reference_wrapper<const datatypes::CycleStatistic>>
+		getCycleStatistics() override;
 		unsigned int getSlaveCount() override;
 		datatypes::SlaveInfo& getSlaveInfo(unsigned int slaveID) override;
 		datatypes::BusMode getBusMode() override;
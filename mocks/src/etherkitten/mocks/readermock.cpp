@@ -67,11 +67,31 @@ namespace etherkitten::reader
 		return regSearchLists[reg].getView(time, false);
 	}
 
-	std::shared_ptr<DataView<std::unique_ptr<IOMap>, MockReader::nodeSize, IOMap*>>
+	std::unique_ptr<datatypes::AbstractNewestValueView> MockReader::getNewest(
+	    const datatypes::CycleStatistic& statistic)
+	{
+		return std::make_unique<reader::NewestValueView<uint32_t, nodeSize>>(
+		    cycleStatisticLists.at(static_cast<size_t>(statistic.getStatisticType())), 0, 0,
+		    false);
+	}
+
+	std::shared_ptr<datatypes::AbstractDataView> MockReader::getView(
+	    const datatypes::CycleStatistic& statistic, datatypes::TimeSeries time)
+	{
+		return cycleStatisticLists.at(static_cast<size_t>(statistic.getStatisticType()))
+		    .getView(time, false);
+	}
+
+	const CycleHistogram& MockReader::getCycleHistogram(datatypes::CycleStatisticType type)
+	{
+		return cycleHistograms.at(static_cast<size_t>(type));
+	}
+
+	std::shared_ptr<DataView<IOMapSlab, MockReader::nodeSize, IOMap*>>
 	MockReader::getIOMapView(datatypes::TimeStamp startTime)
 	{
 		(void)startTime;
-		std::shared_ptr<DataView<std::unique_ptr<IOMap>, nodeSize, IOMap*>> result;
+		std::shared_ptr<DataView<IOMapSlab, nodeSize, IOMap*>> result;
 		return result;
 	}
 
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <array>
 #include <map>
 #include <memory>
 #include <random>
@@ -93,7 +94,15 @@ namespace etherkitten::reader
 		std::shared_ptr<datatypes::AbstractDataView> getView(
 		    const datatypes::Register& reg, datatypes::TimeSeries time);
 
-		std::shared_ptr<DataView<std::unique_ptr<IOMap>, nodeSize, IOMap*>> getIOMapView(
+		std::unique_ptr<datatypes::AbstractNewestValueView> getNewest(
+		    const datatypes::CycleStatistic& statistic) override;
+
+		std::shared_ptr<datatypes::AbstractDataView> getView(
+		    const datatypes::CycleStatistic& statistic, datatypes::TimeSeries time) override;
+
+		const CycleHistogram& getCycleHistogram(datatypes::CycleStatisticType type) override;
+
+		std::shared_ptr<DataView<IOMapSlab, nodeSize, IOMap*>> getIOMapView(
 		    datatypes::TimeStamp startTime);
 
 		std::shared_ptr<datatypes::AbstractDataView> getRegisterRawDataView(
@@ -137,6 +146,9 @@ namespace etherkitten::reader
 		std::unordered_map<datatypes::Register, SearchList<uint8_t, nodeSize>, RegisterHash,
 		    RegisterEqual>
 		    regSearchLists;
+		std::array<SearchList<uint32_t, nodeSize>, datatypes::cycleStatisticTypeCount>
+		    cycleStatisticLists;
+		std::array<CycleHistogram, datatypes::cycleStatisticTypeCount> cycleHistograms;
 
 		bool destructing = false;
 
@@ -0,0 +1,239 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ * \brief Compares stepping a DataView through a large list with the linear stepping
+ * the DataView used before it could skip nodes via the SearchList's minute index,
+ * and reading a DataView one value at a time with reading it in batches.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <etherkitten/datatypes/time.hpp>
+#include <etherkitten/reader/DataView.hpp>
+#include <etherkitten/reader/LLNode.hpp>
+#include <etherkitten/reader/SearchList.hpp>
+
+using namespace etherkitten::reader;
+using namespace etherkitten::datatypes;
+
+namespace
+{
+	constexpr size_t nodeSize = 1000;
+	constexpr size_t sampleCount = 10000000;
+	constexpr std::chrono::milliseconds sampleInterval(1);
+
+	/*!
+	 * \brief Holds the samples both as a SearchList and as a bare list of LLNodes
+	 * for the linear stepping.
+	 */
+	struct Samples
+	{
+		TimeStamp start;
+		SearchList<double, nodeSize> list;
+		LLNode<double, nodeSize>* head = nullptr;
+
+		Samples()
+		    : start(now())
+		{
+			LLNode<double, nodeSize>* tail = nullptr;
+			for (size_t i = 0; i < sampleCount; ++i)
+			{
+				TimeStamp time = start + i * sampleInterval;
+				list.append(static_cast<double>(i), time);
+				if (tail == nullptr || tail->count == nodeSize)
+				{
+					auto* node
+					    = new LLNode<double, nodeSize>(static_cast<double>(i), time, nullptr);
+					if (tail == nullptr)
+					{
+						head = node;
+					}
+					else
+					{
+						tail->next = node;
+					}
+					tail = node;
+				}
+				else
+				{
+					tail->values[tail->count] = static_cast<double>(i);
+					tail->times[tail->count] = time;
+					++tail->count;
+				}
+			}
+		}
+
+		Samples(const Samples&) = delete;
+
+		~Samples()
+		{
+			while (head != nullptr)
+			{
+				LLNode<double, nodeSize>* next = head->next;
+				delete head; // NOLINT
+				head = next;
+			}
+		}
+	};
+
+	Samples& getSamples()
+	{
+		static Samples samples;
+		return samples;
+	}
+
+	/*!
+	 * \brief Drop the views of the previous iterations from the SearchList.
+	 *
+	 * A SearchList holds on to every view it hands out until it removes nodes, so
+	 * without this every iteration would add to the views the later ones run beside.
+	 */
+	void releaseViews(Samples& samples)
+	{
+		// Removing no nodes still lets go of the views that are not used anymore
+		samples.list.removeOldest(0);
+	}
+
+	/*!
+	 * \brief Find the next location the way DataView::findNextLocation did before
+	 * it used the minute index and binary searches.
+	 */
+	ListLocation<double, nodeSize> findNextLocationLinear(
+	    ListLocation<double, nodeSize> location, TimeStep timeStep)
+	{
+		LLNode<double, nodeSize>* temp = location.node;
+		size_t tempCount = location.index;
+		TimeStamp oldTime = location.node->times[location.index];
+		auto* nextNode = temp->next.load(std::memory_order_acquire);
+		while (nextNode != nullptr && nextNode->times[0] <= oldTime + timeStep)
+		{
+			temp = nextNode;
+			tempCount = 0;
+			nextNode = nextNode->next.load(std::memory_order_acquire);
+		}
+		while (temp->times[tempCount] < oldTime + timeStep
+		    && tempCount < temp->count.load(std::memory_order_acquire) - 1)
+		{
+			++tempCount;
+		}
+		if (tempCount == nodeSize - 1 && nextNode != nullptr
+		    && temp->times[tempCount] < oldTime + timeStep)
+		{
+			temp = nextNode;
+			tempCount = 0;
+		}
+		return { temp, tempCount };
+	}
+
+	/*!
+	 * \brief Whether the linear stepping can advance, mirroring DataView::hasNext.
+	 */
+	bool hasNextLinear(ListLocation<double, nodeSize> location, TimeStep timeStep)
+	{
+		ListLocation<double, nodeSize> next = findNextLocationLinear(location, timeStep);
+		return (next.node->times[next.index] - location.node->times[location.index])
+		    >= timeStep;
+	}
+
+	void linearStepping(benchmark::State& state)
+	{
+		Samples& samples = getSamples();
+		TimeStep timeStep = std::chrono::milliseconds(state.range(0));
+		size_t steps = 0;
+		for (auto _ : state)
+		{
+			ListLocation<double, nodeSize> location{ samples.head, 0 };
+			while (hasNextLinear(location, timeStep))
+			{
+				location = findNextLocationLinear(location, timeStep);
+				benchmark::DoNotOptimize(location.node->values[location.index]);
+				++steps;
+			}
+		}
+		state.counters["steps"] = benchmark::Counter(steps, benchmark::Counter::kIsRate);
+	}
+
+	void indexedStepping(benchmark::State& state)
+	{
+		Samples& samples = getSamples();
+		TimeStep timeStep = std::chrono::milliseconds(state.range(0));
+		size_t steps = 0;
+		for (auto _ : state)
+		{
+			releaseViews(samples);
+			auto view = samples.list.getView({ samples.start, timeStep }, false);
+			while (view->hasNext())
+			{
+				++(*view);
+				benchmark::DoNotOptimize(view->asDouble());
+				++steps;
+			}
+		}
+		state.counters["steps"] = benchmark::Counter(steps, benchmark::Counter::kIsRate);
+	}
+
+	void readOneByOne(benchmark::State& state)
+	{
+		Samples& samples = getSamples();
+		size_t count = state.range(0);
+		for (auto _ : state)
+		{
+			releaseViews(samples);
+			auto view = samples.list.getView({ samples.start, TimeStep(0) }, false);
+			for (size_t i = 1; i < count && view->hasNext(); ++i)
+			{
+				++(*view);
+				benchmark::DoNotOptimize(view->getTime());
+				benchmark::DoNotOptimize(view->asDouble());
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+
+	void readInBatches(benchmark::State& state)
+	{
+		Samples& samples = getSamples();
+		std::vector<double> values(state.range(0));
+		std::vector<TimeStamp> times(state.range(0));
+		for (auto _ : state)
+		{
+			releaseViews(samples);
+			auto view = samples.list.getView({ samples.start, TimeStep(0) }, false);
+			while (view->readBatch(values.data(), times.data(), values.size()) > 0)
+			{
+				benchmark::DoNotOptimize(values.data());
+				benchmark::DoNotOptimize(times.data());
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * sampleCount);
+	}
+} // namespace
+
+// Step sizes in milliseconds: a few samples, a few nodes, and more than a minute
+BENCHMARK(linearStepping)->Arg(10)->Arg(5000)->Arg(90000)->Unit(benchmark::kMillisecond);
+BENCHMARK(indexedStepping)->Arg(10)->Arg(5000)->Arg(90000)->Unit(benchmark::kMillisecond);
+
+// Reading one value at a time, with the number of values to read
+BENCHMARK(readOneByOne)->Arg(1000000)->Arg(sampleCount)->Unit(benchmark::kMillisecond);
+// Reading every value, with the batch size for readBatch
+BENCHMARK(readInBatches)->Arg(64)->Arg(1024)->Unit(benchmark::kMillisecond);
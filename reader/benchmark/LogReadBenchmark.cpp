@@ -0,0 +1,237 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \file
+ * \brief Compares parsing the data blocks of a synthetic log the way the LogReader did
+ * before it mapped logs into memory, reading each block into buffers of its own, with
+ * parsing the blocks in place in the mapped log.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <etherkitten/datatypes/dataobjects.hpp>
+#include <etherkitten/reader/LogSlaveInformant.hpp>
+#include <etherkitten/reader/MappedFile.hpp>
+#include <etherkitten/reader/log/LogBusInfo.hpp>
+#include <etherkitten/reader/log/ParsingContext.hpp>
+#include <etherkitten/reader/log/Serialized.hpp>
+#include <etherkitten/reader/log/chunkindex.hpp>
+#include <etherkitten/reader/log/esi.hpp>
+#include <etherkitten/reader/log/header.hpp>
+#include <etherkitten/reader/log/neighbors.hpp>
+#include <etherkitten/reader/log/processdata.hpp>
+#include <etherkitten/reader/log/registerdata.hpp>
+#include <etherkitten/reader/log/slave.hpp>
+#include <etherkitten/reader/log/slavedetails.hpp>
+
+using namespace etherkitten::reader;
+using namespace etherkitten::datatypes;
+
+namespace
+{
+	constexpr uint64_t ioMapSize = 64;
+	constexpr uint64_t mebibyte = 1024 * 1024;
+
+	/*!
+	 * \brief A synthetic log with one slave whose data blocks are mostly register values
+	 * and a ProcessDataBlock for every ten of them.
+	 *
+	 * The log is removed when the SyntheticLog is destroyed.
+	 */
+	struct SyntheticLog
+	{
+		std::filesystem::path path;
+		uint64_t dataOffset;
+
+		explicit SyntheticLog(uint64_t size)
+		    : path(std::filesystem::temp_directory_path()
+		          / ("etherkitten-benchmark-" + std::to_string(size) + ".ekl"))
+		{
+			std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+			LogHeaderBlock placeholder{ LogHeaderBlock::currentVersion, 0, 0, ioMapSize, 0, 0 };
+			Serialized header = placeholder.getSerializer().serialize(placeholder);
+			out.write(header.data, header.length);
+
+			uint16_t id = 1;
+			std::string name = "Slave1";
+			std::vector<PDOBlock> pdos;
+			std::vector<CoEEntryBlock> coes;
+			ESIBlock esi(std::vector<std::byte>{});
+			NeighborsBlock neighbors(std::array<unsigned int, 4>{ 0, 0, 0, 0 });
+			SlaveBlock slave(id, name, pdos, coes, esi, neighbors);
+			Serialized slaveSer = slave.getSerializer().serialize(slave);
+			out.write(slaveSer.data, slaveSer.length);
+			uint64_t pdoDescOffset = out.tellp();
+
+			std::vector<PDODetailsBlock> pdoDetails;
+			SlaveDetailsBlock details(id, pdoDetails);
+			Serialized detailsSer = details.getSerializer().serialize(details);
+			out.write(detailsSer.data, detailsSer.length);
+			dataOffset = out.tellp();
+
+			static constexpr std::array<RegisterEnum, 4> registers{ RegisterEnum::BUILD,
+				RegisterEnum::CONFIGURED_STATION_ADDRESS, RegisterEnum::STATUS,
+				RegisterEnum::REVISION };
+			uint64_t written = dataOffset;
+			for (uint64_t i = 0; written < size; ++i)
+			{
+				uint64_t time = 600000000 + i * 10;
+				if (i % 10 == 0)
+				{
+					ProcessDataBlock block{ time, Serialized(ioMapSize) };
+					memset(block.data.data, static_cast<int>(i), ioMapSize);
+					Serialized ser = block.getSerializer().serialize(block);
+					out.write(ser.data, ser.length);
+					written += ser.length;
+				}
+				RegisterDataBlock block{ static_cast<uint16_t>(registers[i % registers.size()]),
+					id, time, i };
+				Serialized ser = block.getSerializer().serialize(block);
+				out.write(ser.data, ser.length);
+				written += ser.length;
+			}
+
+			LogHeaderBlock final{ LogHeaderBlock::currentVersion, pdoDescOffset, dataOffset,
+				ioMapSize, 0, 0 };
+			Serialized finalHeader = final.getSerializer().serialize(final);
+			out.seekp(0);
+			out.write(finalHeader.data, finalHeader.length);
+		}
+
+		SyntheticLog(const SyntheticLog&) = delete;
+
+		~SyntheticLog() { std::filesystem::remove(path); }
+	};
+
+	SyntheticLog& getLog(uint64_t size)
+	{
+		static std::map<uint64_t, std::unique_ptr<SyntheticLog>> logs;
+		auto& log = logs[size];
+		if (!log)
+		{
+			log = std::make_unique<SyntheticLog>(size);
+		}
+		return *log;
+	}
+
+	/*!
+	 * \brief Parse the data blocks the way LogReader::readDataBlocks did before it mapped
+	 * the log: every block is read from a stream into buffers allocated for it.
+	 */
+	uint64_t parseWithStream(SyntheticLog& log, ParsingContext& parsingContext)
+	{
+		uint64_t checksum = 0;
+		std::ifstream fin(log.path, std::ios::in | std::ios::binary);
+		fin.seekg(log.dataOffset);
+		while (fin.good())
+		{
+			Serialized tmp(4);
+			fin.read(tmp.data, 4);
+			if (!fin.good())
+				break;
+			uint32_t ident = tmp.read<uint32_t>(0);
+			if (ChunkEntryBlock::getKindOf(ident) == ChunkEntryBlock::processDataKind)
+			{
+				Serialized ser(12 + ioMapSize);
+				memcpy(ser.data, tmp.data, 4);
+				fin.read(ser.data + 4, ser.length - 4);
+				ProcessDataBlock block
+				    = ProcessDataBlock::serializer.parseSerialized(ser, parsingContext);
+				// The block used to own a copy of the IOMap
+				Serialized copy(block.data);
+				checksum += block.timestamp + static_cast<uint8_t>(copy.data[0]);
+			}
+			else
+			{
+				uint64_t length = getRegisterByteLength(
+				    static_cast<RegisterEnum>((ident & 0xFFFF0000) >> 16));
+				Serialized ser(12 + length);
+				memcpy(ser.data, tmp.data, 4);
+				fin.read(ser.data + 4, 12 + length - 4);
+				RegisterDataBlock block
+				    = RegisterDataBlock::serializer.parseSerialized(ser, parsingContext);
+				checksum += block.timestamp + block.data;
+			}
+		}
+		return checksum;
+	}
+
+	/*!
+	 * \brief Parse the data blocks in place in the mapped log, like LogReader::readDataBlocks.
+	 */
+	uint64_t parseMapped(SyntheticLog& log, ParsingContext& parsingContext)
+	{
+		uint64_t checksum = 0;
+		MappedFile file(log.path);
+		Serialized data = file.getSerialized();
+		uint64_t off = log.dataOffset;
+		while (data.length - off >= 4)
+		{
+			uint32_t ident = data.read<uint32_t>(off);
+			if (ChunkEntryBlock::getKindOf(ident) == ChunkEntryBlock::processDataKind)
+			{
+				Serialized ser = data.getAt(off, 12 + ioMapSize);
+				ProcessDataBlock block
+				    = ProcessDataBlock::serializer.parseSerialized(ser, parsingContext);
+				checksum += block.timestamp + static_cast<uint8_t>(block.data.data[0]);
+				off += ser.length;
+			}
+			else
+			{
+				uint64_t length = 12
+				    + getRegisterByteLength(
+				        static_cast<RegisterEnum>((ident & 0xFFFF0000) >> 16));
+				Serialized ser = data.getAt(off, length);
+				RegisterDataBlock block
+				    = RegisterDataBlock::serializer.parseSerialized(ser, parsingContext);
+				checksum += block.timestamp + block.data;
+				off += length;
+			}
+		}
+		return checksum;
+	}
+
+	template<uint64_t (*parse)(SyntheticLog&, ParsingContext&)>
+	void parseLog(benchmark::State& state)
+	{
+		SyntheticLog& log = getLog(state.range(0) * mebibyte);
+		LogSlaveInformant slaveInformant(log.path);
+		LogBusInfo busInfo{};
+		busInfo.ioMapUsedSize = ioMapSize;
+		ParsingContext parsingContext(slaveInformant, busInfo);
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(parse(log, parsingContext));
+		}
+		state.SetBytesProcessed(
+		    state.iterations() * (std::filesystem::file_size(log.path) - log.dataOffset));
+	}
+} // namespace
+
+// The size of the synthetic log in MiB
+BENCHMARK_TEMPLATE(parseLog, parseWithStream)->Arg(1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(parseLog, parseMapped)->Arg(1024)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+#
+# Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+#
+# This file is part of EtherKITten.
+#
+# EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, either version 3 of
+# the License, or (at your option) any later version.
+#
+# EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+# without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with EtherKITten.
+# If not, see <https://www.gnu.org/licenses/>.
+
+"""Compare the results of reader_benchmark with the baseline results.
+
+Both files are written by reader_benchmark with --benchmark_out_format=json. With
+repetitions, the median of every benchmark is compared, otherwise its single run.
+The script exits with 1 iff a benchmark of the baseline is missing from the results
+or its real time is longer than in the baseline by more than the tolerance.
+"""
+
+import argparse
+import json
+import sys
+
+# Factors to convert the time units of Google Benchmark to nanoseconds
+UNITS = {"ns": 1, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def read_times(path):
+    """Read the real time of every benchmark in nanoseconds, by the name of the benchmark."""
+    with open(path) as file:
+        benchmarks = json.load(file)["benchmarks"]
+    times = {}
+    for benchmark in benchmarks:
+        if benchmark.get("run_type") == "aggregate":
+            if benchmark["aggregate_name"] != "median":
+                continue
+        elif benchmark["run_name"] in times:
+            # A repetition without aggregates; the first run is kept
+            continue
+        times[benchmark["run_name"]] = benchmark["real_time"] * UNITS[benchmark["time_unit"]]
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline", help="the JSON file with the baseline results")
+    parser.add_argument("results", help="the JSON file with the results to compare")
+    parser.add_argument("--tolerance", type=float, default=20,
+                        help="how much slower a benchmark may be, in percent (default: 20)")
+    arguments = parser.parse_args()
+
+    baseline = read_times(arguments.baseline)
+    results = read_times(arguments.results)
+    failed = False
+    print(f"{'Benchmark':<40} {'Baseline':>14} {'Result':>14} {'Change':>9}")
+    for name, base_time in baseline.items():
+        if name not in results:
+            print(f"{name:<40} {base_time:>11.0f} ns {'missing':>14}")
+            failed = True
+            continue
+        change = (results[name] - base_time) / base_time * 100
+        slower = change > arguments.tolerance
+        failed = failed or slower
+        print(f"{name:<40} {base_time:>11.0f} ns {results[name]:>11.0f} ns {change:>+8.1f}%"
+              + (" SLOWER" if slower else ""))
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,288 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+/*!
+ * \file
+ * \brief Defines the Aggregate of the values in a time bucket and the AggregateDataView,
+ * which steps over such Aggregates.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#include <etherkitten/datatypes/dataviews.hpp>
+#include <etherkitten/datatypes/time.hpp>
+
+#include "Converter.hpp"
+#include "DataView.hpp"
+
+namespace etherkitten::reader
+{
+	/*!
+	 * \brief The Aggregate struct summarizes the values that fall into one time bucket.
+	 *
+	 * The buckets are aligned to powers of two of microseconds. Each level of buckets is
+	 * twice as wide as the level below it, starting at `2^baseShift` microseconds.
+	 */
+	struct Aggregate
+	{
+		/*!
+		 * \brief The number of bucket levels.
+		 */
+		static constexpr size_t levelCount = 16;
+
+		/*!
+		 * \brief The width of the finest buckets is `2^baseShift` microseconds.
+		 *
+		 * About 65ms, so that the Aggregates take up little memory next to the values.
+		 */
+		static constexpr unsigned int baseShift = 16;
+
+		/*!
+		 * \brief The size of the LLNodes Aggregates are stored in.
+		 */
+		static constexpr size_t nodeSize = 64;
+
+		/*!
+		 * \brief The smallest value in the bucket.
+		 */
+		double min = 0;
+
+		/*!
+		 * \brief The largest value in the bucket.
+		 */
+		double max = 0;
+
+		/*!
+		 * \brief The sum of all values in the bucket.
+		 */
+		double sum = 0;
+
+		/*!
+		 * \brief The number of values in the bucket.
+		 */
+		size_t count = 0;
+
+		/*!
+		 * \brief The TimeStamp of the first occurrence of the smallest value.
+		 */
+		datatypes::TimeStamp minTime;
+
+		/*!
+		 * \brief The TimeStamp of the first occurrence of the largest value.
+		 */
+		datatypes::TimeStamp maxTime;
+
+		/*!
+		 * \brief Get the mean of the values in the bucket.
+		 * \return the mean of the values
+		 */
+		double mean() const { return sum / count; }
+
+		/*!
+		 * \brief Add a single value to this Aggregate.
+		 * \param value the value to add
+		 * \param time the TimeStamp of the value
+		 */
+		void add(double value, datatypes::TimeStamp time)
+		{
+			if (count == 0 || value < min)
+			{
+				min = value;
+				minTime = time;
+			}
+			if (count == 0 || value > max)
+			{
+				max = value;
+				maxTime = time;
+			}
+			sum += value;
+			++count;
+		}
+
+		/*!
+		 * \brief Add all values of a later Aggregate to this one.
+		 * \param other the Aggregate to add
+		 */
+		void merge(const Aggregate& other)
+		{
+			if (count == 0 || other.min < min)
+			{
+				min = other.min;
+				minTime = other.minTime;
+			}
+			if (count == 0 || other.max > max)
+			{
+				max = other.max;
+				maxTime = other.maxTime;
+			}
+			sum += other.sum;
+			count += other.count;
+		}
+
+		/*!
+		 * \brief Get the width of the buckets of a level.
+		 * \param level the level of the buckets
+		 * \return the width of the buckets
+		 */
+		static constexpr datatypes::TimeStep bucketWidth(size_t level)
+		{
+			return datatypes::TimeStep(static_cast<int64_t>(1) << (baseShift + level));
+		}
+
+		/*!
+		 * \brief Get the number of the bucket of a level that contains the given time.
+		 * \param time the time to find the bucket for
+		 * \param level the level of the bucket
+		 * \return the number of the bucket
+		 */
+		static uint64_t bucketOf(datatypes::TimeStamp time, size_t level)
+		{
+			return datatypes::timeStampToInt(time) >> (baseShift + level);
+		}
+
+		/*!
+		 * \brief Get the start of the bucket of a level that contains the given time.
+		 * \param time the time to find the bucket for
+		 * \param level the level of the bucket
+		 * \return the earliest time in the bucket
+		 */
+		static datatypes::TimeStamp bucketStart(datatypes::TimeStamp time, size_t level)
+		{
+			return datatypes::intToTimeStamp(bucketOf(time, level) << (baseShift + level));
+		}
+
+		/*!
+		 * \brief Check whether a step is wide enough to be served from Aggregates.
+		 * \param step the step between data points
+		 * \retval true iff at least one level has buckets that are not wider than step
+		 */
+		static constexpr bool isCoarse(datatypes::TimeStep step) { return step >= bucketWidth(0); }
+
+		/*!
+		 * \brief Get the coarsest level whose buckets are not wider than the given step.
+		 * \param step the step between data points, must be coarse
+		 * \return the level to use for the step
+		 */
+		static constexpr size_t levelFor(datatypes::TimeStep step)
+		{
+			size_t level = 0;
+			while (level + 1 < levelCount && bucketWidth(level + 1) <= step)
+			{
+				++level;
+			}
+			return level;
+		}
+	};
+
+	template<>
+	class Converter<Aggregate, Aggregate>
+	{
+	public:
+		static Aggregate shiftAndConvert(
+		    Aggregate input, size_t bitOffset, size_t bitLength, bool flipBytes)
+		{
+			(void)bitOffset;
+			(void)bitLength;
+			(void)flipBytes;
+
+			return input;
+		}
+	};
+
+	/*!
+	 * \brief The AggregateDataView steps over the Aggregates of one bucket level.
+	 *
+	 * For each bucket, it first points to whichever of the smallest and the largest value
+	 * occurred first and then to the other one, each with the TimeStamp it occurred at.
+	 * This keeps single outliers visible however coarse the buckets are.
+	 * If both extremes are the same data point, it is only pointed to once.
+	 * Only buckets that are complete are visible to the AggregateDataView.
+	 */
+	class AggregateDataView : public datatypes::AbstractDataView
+	{
+	public:
+		/*!
+		 * \brief Construct a new AggregateDataView.
+		 * \param buckets a DataView over the Aggregates to step over with a TimeStep of 0
+		 */
+		explicit AggregateDataView(
+		    std::shared_ptr<DataView<Aggregate, Aggregate::nodeSize, Aggregate>> buckets)
+		    : buckets(std::move(buckets))
+		    , atSecondExtreme(false)
+		{
+		}
+
+		double asDouble() const override
+		{
+			Aggregate aggregate = **buckets;
+			return atSecondExtreme == (aggregate.minTime <= aggregate.maxTime) ? aggregate.max
+			                                                                   : aggregate.min;
+		}
+
+		AggregateDataView& operator++() override
+		{
+			if (!atSecondExtreme && !buckets->isEmpty() && hasSecondExtreme(**buckets))
+			{
+				atSecondExtreme = true;
+			}
+			else
+			{
+				++(*buckets);
+				atSecondExtreme = false;
+			}
+			return *this;
+		}
+
+		bool hasNext() const override
+		{
+			if (!atSecondExtreme && !buckets->isEmpty() && hasSecondExtreme(**buckets))
+			{
+				return true;
+			}
+			return buckets->hasNext();
+		}
+
+		bool isEmpty() const override { return buckets->isEmpty(); }
+
+		datatypes::TimeStamp getTime() override
+		{
+			Aggregate aggregate = **buckets;
+			return atSecondExtreme == (aggregate.minTime <= aggregate.maxTime) ? aggregate.maxTime
+			                                                                   : aggregate.minTime;
+		}
+
+		/*!
+		 * \brief Get the Aggregate of the bucket that is currently pointed to.
+		 * \return the Aggregate of the current bucket
+		 * \exception std::out_of_range iff isEmpty() would return true
+		 */
+		Aggregate operator*() const { return **buckets; }
+
+	private:
+		std::shared_ptr<DataView<Aggregate, Aggregate::nodeSize, Aggregate>> buckets;
+		bool atSecondExtreme;
+
+		static bool hasSecondExtreme(const Aggregate& aggregate)
+		{
+			return aggregate.minTime != aggregate.maxTime;
+		}
+	};
+} // namespace etherkitten::reader
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+/*!
+ * \file
+ * \brief Defines BusOptions, which switch the ways of reading the bus that the BusReader
+ * may use.
+ */
+
+namespace etherkitten::reader
+{
+	/*!
+	 * \brief The BusOptions struct switches the ways of reading the bus that save frames
+	 * or round trips but change how the BusReader uses the slaves.
+	 *
+	 * All of them are off by default.
+	 */
+	struct BusOptions
+	{
+		/*!
+		 * \brief Whether to send the process data in the same frame as the first register
+		 * frame of every cycle.
+		 *
+		 * This saves a frame round trip per cycle and gives the registers in that frame the
+		 * time stamp of the process data. It only takes effect if the process data fits into
+		 * a single LRW PDU and the bus does not use distributed clocks.
+		 */
+		bool piggybackRegisters = false;
+
+		/*!
+		 * \brief Whether to map the error counters of every slave with an unused FMMU into
+		 * the logical address space, so that a few LRD PDUs read them from all of these slaves.
+		 *
+		 * This takes up an FMMU of each of these slaves and the mapping is set up with
+		 * blocking reads and writes before the first cycle. Slaves without an unused FMMU
+		 * keep being read with FPRD PDUs. If one slave of an LRD PDU does not answer,
+		 * the working counter cannot tell which one is missing, so the blocks of all
+		 * slaves in that PDU are read with FPRD PDUs for that round.
+		 */
+		bool mapErrorCounters = false;
+	};
+} // namespace etherkitten::reader
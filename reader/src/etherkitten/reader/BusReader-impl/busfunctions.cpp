@@ -17,6 +17,8 @@
 
 #include "busfunctions.hpp"
 
+#include <new>
+
 #include "../endianness.hpp"
 
 namespace etherkitten::reader::bReader
@@ -32,7 +34,116 @@ namespace etherkitten::reader::bReader
 		return configuredAddresses;
 	}
 
-	std::pair<int, int> sendAndReceiveEtherCATFrame(const EtherCATFrame* frame, size_t frameLength,
+	/*!
+	 * \brief Create the FMMU configuration that maps the block of a slave.
+	 * \param block the block to map
+	 * \param slave the index of the slave in the slaves of the block
+	 * \return the FMMU configuration as it is written to the slave
+	 */
+	static ec_fmmut createRegisterBlockFMMU(const MappedRegisterBlock& block, size_t slave)
+	{
+		static constexpr uint8_t fmmuTypeRead = 1;
+		static constexpr uint8_t lastBitOfByte = 7;
+		uint16_t blockLength = block.end - block.start;
+		ec_fmmut fmmu{};
+		fmmu.LogStart = flipBytesIfBigEndianHost(
+		    static_cast<uint32_t>(block.logicalAddress + slave * blockLength));
+		fmmu.LogLength = flipBytesIfBigEndianHost(blockLength);
+		fmmu.LogEndbit = lastBitOfByte;
+		fmmu.PhysStart = flipBytesIfBigEndianHost(static_cast<uint16_t>(block.start));
+		fmmu.FMMUtype = fmmuTypeRead;
+		fmmu.FMMUactive = 1;
+		return fmmu;
+	}
+
+	MappedRegisterBlock mapRegisterBlock(int start, int end, uint32_t logicalAddress)
+	{
+		static constexpr uint16_t fmmuCountRegister = 0x0004;
+		MappedRegisterBlock block{ start, end, logicalAddress, {}, {} };
+		for (int i = 1; i <= ec_slavecount; ++i)
+		{
+			ec_slavet& slave = ec_slave[i]; // NOLINT
+			uint8_t fmmuCount = 0;
+			if (ec_FPRD(slave.configadr, fmmuCountRegister, sizeof(fmmuCount), &fmmuCount,
+			        EC_TIMEOUTRET)
+			        <= 0
+			    || slave.FMMUunused >= fmmuCount)
+			{
+				continue;
+			}
+
+			ec_fmmut fmmu = createRegisterBlockFMMU(block, block.slaveConfiguredAddresses.size());
+			if (ec_FPWR(slave.configadr, ECT_REG_FMMU0 + sizeof(ec_fmmut) * slave.FMMUunused,
+			        sizeof(fmmu), &fmmu, EC_TIMEOUTRET3)
+			    <= 0)
+			{
+				continue;
+			}
+			block.slaveConfiguredAddresses.push_back(slave.configadr);
+			block.fmmus.push_back(slave.FMMUunused);
+			++slave.FMMUunused;
+		}
+		return block;
+	}
+
+	std::optional<bool> restoreRegisterBlockMapping(const MappedRegisterBlock& block, size_t slave)
+	{
+		uint16_t configuredAddress = block.slaveConfiguredAddresses[slave];
+		uint16_t fmmuAddress = ECT_REG_FMMU0 + sizeof(ec_fmmut) * block.fmmus[slave];
+		ec_fmmut expected = createRegisterBlockFMMU(block, slave);
+		ec_fmmut actual{};
+		if (ec_FPRD(configuredAddress, fmmuAddress, sizeof(actual), &actual, EC_TIMEOUTRET) <= 0)
+		{
+			return {};
+		}
+		if (std::memcmp(&actual, &expected, sizeof(ec_fmmut)) == 0)
+		{
+			return false;
+		}
+		if (ec_FPWR(configuredAddress, fmmuAddress, sizeof(expected), &expected, EC_TIMEOUTRET3)
+		    <= 0)
+		{
+			return {};
+		}
+		return true;
+	}
+
+	void unmapRegisterBlock(const MappedRegisterBlock& block)
+	{
+		for (size_t i = 0; i < block.slaveConfiguredAddresses.size(); ++i)
+		{
+			uint16_t configuredAddress = block.slaveConfiguredAddresses[i];
+			ec_fmmut inactive{};
+			if (ec_FPWR(configuredAddress, ECT_REG_FMMU0 + sizeof(ec_fmmut) * block.fmmus[i],
+			        sizeof(inactive), &inactive, EC_TIMEOUTRET3)
+			    <= 0)
+			{
+				continue;
+			}
+			for (int j = 1; j <= ec_slavecount; ++j)
+			{
+				ec_slavet& slave = ec_slave[j]; // NOLINT
+				// The FMMU can only be handed back if no later one was taken after it
+				if (slave.configadr == configuredAddress && slave.FMMUunused == block.fmmus[i] + 1)
+				{
+					--slave.FMMUunused;
+				}
+			}
+		}
+	}
+
+	MailboxInfo getMailboxInfo(unsigned int slave)
+	{
+		ec_slavet& info = ec_slave[slave]; // NOLINT
+		return { info.configadr, info.mbx_wo, info.mbx_l, info.mbx_ro, info.mbx_rl,
+			&info.mbx_cnt };
+	}
+
+	/*!
+	 * \brief Copy an EtherCAT frame into a free SOEM tx buffer.
+	 * \return the index of the SOEM buffer the frame was placed in
+	 */
+	static int placeEtherCATFrame(const EtherCATFrame* frame, size_t frameLength,
 	    uint16_t slaveConfiguredAddress, const std::vector<size_t>& slaveAddressOffsets)
 	{
 		int bufferIndex = ecx_getindex(ecx_context.port);
@@ -52,14 +163,127 @@ namespace etherkitten::reader::bReader
 		}
 
 		ecx_context.port->txbuflength[bufferIndex] = ETH_HEADERSIZE + frameLength; // NOLINT
+		return bufferIndex;
+	}
+
+	static constexpr int registerTimeoutus = 100;
+
+	std::pair<int, int> sendAndReceiveEtherCATFrame(const EtherCATFrame* frame, size_t frameLength,
+	    uint16_t slaveConfiguredAddress, const std::vector<size_t>& slaveAddressOffsets)
+	{
+		int bufferIndex
+		    = placeEtherCATFrame(frame, frameLength, slaveConfiguredAddress, slaveAddressOffsets);
 
-		static constexpr int registerTimeoutus = 100;
 		// This is blocking, which seems good enough for now
 		int workingCounter = ecx_srconfirm(ecx_context.port, bufferIndex, registerTimeoutus);
 
 		return { workingCounter, bufferIndex };
 	}
 
+	bool readRegisterBlock(uint16_t slaveConfiguredAddress, int start, int end, void* destination)
+	{
+		return ec_FPRD(slaveConfiguredAddress, static_cast<uint16_t>(start),
+		           static_cast<uint16_t>(end - start), destination, registerTimeoutus)
+		    > 0;
+	}
+
+	int sendEtherCATFrame(const EtherCATFrame* frame, size_t frameLength)
+	{
+		int bufferIndex = placeEtherCATFrame(frame, frameLength, 0, {});
+		if (ecx_outframe_red(ecx_context.port, bufferIndex) <= 0)
+		{
+			ecx_setbufstat(ecx_context.port, bufferIndex, EC_BUF_EMPTY);
+			return EC_NOFRAME;
+		}
+		return bufferIndex;
+	}
+
+	int receiveEtherCATFrame(int bufferIndex)
+	{
+		return ecx_waitinframe(ecx_context.port, bufferIndex, registerTimeoutus);
+	}
+
+	size_t getProcessDataPDULength()
+	{
+		const ec_groupt& group = ec_group[0]; // NOLINT
+		size_t dataLength = group.Obytes + group.Ibytes;
+		if (group.nsegments != 1 || group.hasdc || group.blockLRW || dataLength == 0
+		    || group.inputs != group.outputs + group.Obytes) // NOLINT
+		{
+			return 0;
+		}
+		return pduOverhead + dataLength;
+	}
+
+	int sendEtherCATFrameWithProcessData(const EtherCATFrame* frame, size_t frameLength)
+	{
+		static constexpr uint16_t hasNextPDU = 1 << 15;
+		static constexpr uint16_t dataLengthMask = 0x07ff;
+		static constexpr uint16_t frameTypePDUs = 0x1000;
+		static constexpr int halfShift = 16;
+		const ec_groupt& group = ec_group[0]; // NOLINT
+
+		int bufferIndex = placeEtherCATFrame(frame, frameLength, 0, {});
+		EtherCATFrame* framePlacement = reinterpret_cast<EtherCATFrame*>( // NOLINT
+		    &(ecx_context.port->txbuf[bufferIndex][ETH_HEADERSIZE])); // NOLINT
+
+		// Find the end of the last register PDU and let it announce the LRW PDU
+		size_t pduEnd = 0;
+		while (true)
+		{
+			EtherCATPDU* pdu
+			    = reinterpret_cast<EtherCATPDU*>(framePlacement->pduArea + pduEnd); // NOLINT
+			uint16_t dataLengthAndNext = flipBytesIfBigEndianHost(pdu->dataLengthAndNext);
+			pduEnd += pduOverhead + (dataLengthAndNext & dataLengthMask);
+			if ((dataLengthAndNext & hasNextPDU) == 0)
+			{
+				pdu->dataLengthAndNext = flipBytesIfBigEndianHost(
+				    static_cast<uint16_t>(dataLengthAndNext | hasNextPDU));
+				break;
+			}
+		}
+
+		uint16_t dataLength = group.Obytes + group.Ibytes;
+		EtherCATPDU* lrw = new (framePlacement->pduArea + pduEnd) EtherCATPDU; // NOLINT
+		lrw->commandType = lrwCommandType;
+		lrw->index = bufferIndex;
+		lrw->slaveConfiguredAddress = flipBytesIfBigEndianHost(
+		    static_cast<uint16_t>(group.logstartaddr));
+		lrw->registerAddress = flipBytesIfBigEndianHost(
+		    static_cast<uint16_t>(group.logstartaddr >> halfShift));
+		lrw->dataLengthAndNext = flipBytesIfBigEndianHost(dataLength);
+		std::memcpy(lrw->data, group.outputs, dataLength); // NOLINT
+		std::memset(lrw->data + dataLength, 0, sizeof(uint16_t)); // NOLINT
+		pduEnd += pduOverhead + dataLength;
+
+		framePlacement->lengthAndType
+		    = flipBytesIfBigEndianHost(static_cast<uint16_t>(pduEnd | frameTypePDUs));
+		ecx_context.port->txbuflength[bufferIndex] // NOLINT
+		    = ETH_HEADERSIZE + sizeof(uint16_t) + pduEnd;
+
+		if (ecx_outframe_red(ecx_context.port, bufferIndex) <= 0)
+		{
+			ecx_setbufstat(ecx_context.port, bufferIndex, EC_BUF_EMPTY);
+			return EC_NOFRAME;
+		}
+		return bufferIndex;
+	}
+
+	int receiveEtherCATFrameWithProcessData(int bufferIndex, size_t frameLength)
+	{
+		const ec_groupt& group = ec_group[0]; // NOLINT
+		// SOEM returns the working counter at the end of the frame, which is the LRW PDU's
+		int workingCounter = receiveEtherCATFrame(bufferIndex);
+		if (workingCounter != EC_NOFRAME)
+		{
+			// The outputs came back unchanged, so only the inputs are copied
+			const uint8_t* data = &(ecx_context.port->rxbuf[bufferIndex][0]) // NOLINT
+			    + frameLength + sizeof(EtherCATPDU) - 1;
+			std::memcpy(group.inputs, data + group.Obytes, group.Ibytes); // NOLINT
+		}
+		return workingCounter;
+	}
+
 	std::optional<datatypes::ErrorMessage> convertECErrorToMessage()
 	{
 		std::string message = ec_elist2string();
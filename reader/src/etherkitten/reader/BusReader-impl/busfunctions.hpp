@@ -26,6 +26,7 @@
  * \brief Defines helper methods for the implementation of the BusReader.
  */
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <functional>
@@ -44,6 +45,7 @@ extern "C"
 #include <etherkitten/datatypes/ethercatdatatypes.hpp>
 
 #include "../EtherCATFrame.hpp"
+#include "../MailboxEngine.hpp"
 
 namespace etherkitten::reader::bReader
 {
@@ -56,6 +58,58 @@ namespace etherkitten::reader::bReader
 	 */
 	std::vector<uint16_t> getSlaveConfiguredAddresses();
 
+	/*!
+	 * \brief Map a block of registers of every slave that has an unused FMMU into the
+	 * logical address space, so that LRD PDUs can read the block from all of them.
+	 *
+	 * The blocks of the slaves are mapped one after the other, starting at the given
+	 * logical address. Slaves without an unused FMMU are left out.
+	 * \param start the first register address of the block
+	 * \param end the register address after the block
+	 * \param logicalAddress the logical address to map the block of the first slave to
+	 * \return the mapped block with the slaves whose blocks are mapped
+	 */
+	MappedRegisterBlock mapRegisterBlock(int start, int end, uint32_t logicalAddress);
+
+	/*!
+	 * \brief Map the block of a slave again if its FMMU no longer maps it.
+	 *
+	 * A slave that was initialized again, e.g. after it lost power, has forgotten the
+	 * mapping. This blocks for a read and possibly a write of the FMMU.
+	 * \param block the mapped block
+	 * \param slave the index of the slave in the slaves of the block
+	 * \return whether the block had to be mapped again, or nothing if the slave did not
+	 * answer
+	 */
+	std::optional<bool> restoreRegisterBlockMapping(const MappedRegisterBlock& block, size_t slave);
+
+	/*!
+	 * \brief Release the FMMUs that map a block of registers.
+	 *
+	 * The FMMUs are deactivated with blocking writes. Slaves that do not answer are skipped.
+	 * \param block the mapped block
+	 */
+	void unmapRegisterBlock(const MappedRegisterBlock& block);
+
+	/*!
+	 * \brief Read a block of registers of a slave with a blocking FPRD PDU.
+	 *
+	 * This waits as long for the slave as for the frames of registers of a cycle.
+	 * \param slaveConfiguredAddress the configured address of the slave
+	 * \param start the first register address of the block
+	 * \param end the register address after the block
+	 * \param destination where to write the block to
+	 * \retval true iff the slave answered
+	 */
+	bool readRegisterBlock(uint16_t slaveConfiguredAddress, int start, int end, void* destination);
+
+	/*!
+	 * \brief Get the mailbox configuration SOEM determined for a slave.
+	 * \param slave the index of the slave
+	 * \return the mailboxes of the slave
+	 */
+	MailboxInfo getMailboxInfo(unsigned int slave);
+
 	/*!
 	 * \brief Sends an EtherCAT frame over the EtherCAT bus, receives it and returns the
 	 * index of the SOEM buffer the resulting frame was placed in along with the working
@@ -76,6 +130,63 @@ namespace etherkitten::reader::bReader
 	std::pair<int, int> sendAndReceiveEtherCATFrame(const EtherCATFrame* frame, size_t frameLength,
 	    uint16_t slaveConfiguredAddress, const std::vector<size_t>& slaveAddressOffsets);
 
+	/*!
+	 * \brief Sends an EtherCAT frame over the EtherCAT bus without waiting for it to return.
+	 *
+	 * Several frames may be on the bus at once, each in its own SOEM buffer.
+	 * Collect the result with receiveEtherCATFrame().
+	 * \param frame the EtherCAT frame to send over the bus
+	 * \param frameLength the length of the EtherCAT frame in bytes
+	 * \return the index of the SOEM buffer the frame was sent from, or EC_NOFRAME
+	 * if it could not be sent
+	 */
+	int sendEtherCATFrame(const EtherCATFrame* frame, size_t frameLength);
+
+	/*!
+	 * \brief Waits for a frame sent with sendEtherCATFrame() to return from the bus.
+	 *
+	 * The received frame is placed in the rx buffer with the given index,
+	 * which the caller has to release afterwards.
+	 * \param bufferIndex the index of the SOEM buffer the frame was sent from
+	 * \return the working counter of the frame as returned by SOEM
+	 */
+	int receiveEtherCATFrame(int bufferIndex);
+
+	/*!
+	 * \brief Get the length of the LRW PDU that exchanges the process data of the bus.
+	 *
+	 * Only process data that SOEM exchanges with a single LRW PDU and without distributed
+	 * clocks can be sent along with other PDUs.
+	 * \return the length of the PDU including its header and working counter, or 0 if
+	 * the process data cannot be sent along with other PDUs
+	 */
+	size_t getProcessDataPDULength();
+
+	/*!
+	 * \brief Sends an EtherCAT frame over the EtherCAT bus with an LRW PDU appended that
+	 * exchanges the process data, without waiting for it to return.
+	 *
+	 * This replaces ec_send_processdata() for the cycle. The frame must leave
+	 * getProcessDataPDULength() bytes free.
+	 * \param frame the EtherCAT frame to send over the bus
+	 * \param frameLength the length of the EtherCAT frame in bytes, without the LRW PDU
+	 * \return the index of the SOEM buffer the frame was sent from, or EC_NOFRAME
+	 * if it could not be sent
+	 */
+	int sendEtherCATFrameWithProcessData(const EtherCATFrame* frame, size_t frameLength);
+
+	/*!
+	 * \brief Waits for a frame sent with sendEtherCATFrameWithProcessData() to return
+	 * from the bus and copies the received inputs into the IOMap.
+	 *
+	 * This replaces ec_receive_processdata() for the cycle. The received frame is placed
+	 * in the rx buffer with the given index, which the caller has to release afterwards.
+	 * \param bufferIndex the index of the SOEM buffer the frame was sent from
+	 * \param frameLength the length of the EtherCAT frame in bytes, without the LRW PDU
+	 * \return the working counter of the LRW PDU, or EC_NOFRAME if the frame did not return
+	 */
+	int receiveEtherCATFrameWithProcessData(int bufferIndex, size_t frameLength);
+
 	/*!
 	 * \brief Pop a SOEM error from the error stack and convert it to an ErrorMessage.
 	 * \return an error message, or nothing if the SOEM stack was empty
@@ -146,118 +257,89 @@ namespace etherkitten::reader::bReader
 	};
 
 	/*!
-	 * \brief Reads a CoE Object from the bus and saves the data in the given AbstractDataPoint.
+	 * \brief Converts the raw data of a CoE Object read from a slave and saves it in the given
+	 * AbstractDataPoint.
 	 *
 	 * To be used with the dataTypeMaps.
 	 * \tparam E the type of the CoE Object and the data point
 	 */
 	template<datatypes::EtherCATDataTypeEnum E, typename...>
-	class CoEReadRequestHandler
+	class CoEValueDecoder
 	{
 	public:
-		using product_t = std::function<bool(
-		    const datatypes::CoEObject&, datatypes::AbstractDataPoint&, size_t)>;
+		using product_t
+		    = std::function<void(const std::vector<uint8_t>&, datatypes::AbstractDataPoint&)>;
 
 		static product_t eval()
 		{
-			return [](const datatypes::CoEObject& object, datatypes::AbstractDataPoint& point,
-			           size_t bitLength) -> bool {
+			return [](const std::vector<uint8_t>& data, datatypes::AbstractDataPoint& point) {
 				using T = typename datatypes::TypeMap<E>::type;
-				size_t byteLength = 0;
-				if (bitLength < byteSize)
-				{
-					byteLength = 1;
-				}
-				byteLength = bitLength / byteSize;
-				std::unique_ptr<uint8_t[]> buffer // NOLINT
-				    = std::make_unique<uint8_t[]>(byteLength); // NOLINT
-				std::memset(buffer.get(), 0, byteLength);
-				int bufferSize = byteLength;
-				if (ec_SDOread(object.getSlaveID(), object.getIndex(), object.getSubIndex(),
-				        (boolean) false, &bufferSize, buffer.get(), EC_TIMEOUTRXM)
-				    != 1)
-				{
-					return false;
-				}
 				T result;
 				if constexpr (std::is_same<T, std::string>())
 				{
-					if (*(buffer.get() + byteLength - 1) == '\0')
-					{
-						result = std::string(reinterpret_cast<char*>(buffer.get())); // NOLINT
-					}
-					else
-					{
-						result.insert(result.end(), buffer.get(), buffer.get() + bufferSize);
-					}
+					auto end = std::find(data.begin(), data.end(), '\0');
+					result = std::string(data.begin(), end);
 				}
 				else if constexpr (std::is_same<T, std::vector<uint8_t>>())
 				{
-					result.insert(result.end(), buffer.get(), buffer.get() + bufferSize);
+					result = data;
 				}
 				else
 				{
 					uint64_t resultAsUInt = 0;
-					std::memcpy(&resultAsUInt, buffer.get(), bufferSize);
+					std::memcpy(&resultAsUInt, data.data(), std::min(data.size(), sizeof(uint64_t)));
 					result = T(resultAsUInt);
 				}
 				datatypes::DataPoint<T>& realPoint = dynamic_cast<datatypes::DataPoint<T>&>(point);
 				realPoint = datatypes::DataPoint<T>(result, datatypes::now());
-				return true;
 			};
 		}
 	};
 
 	/*!
-	 * \brief Writes a CoE Object to a slave from the given AbstractDataPoint.
+	 * \brief Converts the value in the given AbstractDataPoint to the raw data of a CoE Object
+	 * that can be written to a slave.
 	 *
 	 * To be used with the dataTypeMaps.
 	 * \tparam E the type of the CoE Object and the data point
 	 */
 	template<datatypes::EtherCATDataTypeEnum E, typename...>
-	class CoEWriteRequestHandler
+	class CoEValueEncoder
 	{
 	public:
-		using product_t = std::function<bool(
-		    const datatypes::CoEObject&, const datatypes::AbstractDataPoint&, size_t)>;
+		using product_t = std::function<std::vector<uint8_t>(
+		    const datatypes::AbstractDataPoint&, size_t)>;
 
 		static product_t eval()
 		{
-			return [](const datatypes::CoEObject& object, const datatypes::AbstractDataPoint& point,
-			           size_t bitLength) -> bool {
+			return [](const datatypes::AbstractDataPoint& point,
+			           size_t bitLength) -> std::vector<uint8_t> {
 				using T = typename datatypes::TypeMap<E>::type;
 				T value = dynamic_cast<const datatypes::DataPoint<T>&>(point).getValue();
-				size_t byteLength = 0;
-				if (bitLength < byteSize)
-				{
-					byteLength = 1;
-				}
-				byteLength = bitLength / byteSize;
-				std::unique_ptr<uint8_t[]> buffer // NOLINT
-				    = std::make_unique<uint8_t[]>(byteLength); // NOLINT
-				int bufferSize = byteLength;
 				if constexpr (std::is_same<T, std::string>())
 				{
-					std::memcpy(buffer.get(), value.c_str(), value.size());
-					bufferSize = value.size();
+					return std::vector<uint8_t>(value.begin(), value.end());
 				}
 				else if constexpr (std::is_same<T, std::vector<uint8_t>>())
 				{
-					std::memcpy(buffer.get(), value.data(), value.size());
-					bufferSize = value.size();
-				}
-				else if constexpr (datatypes::is_bitset<T>())
-				{
-					uint64_t valueAsUInt = value.to_ulong();
-					std::memcpy(buffer.get(), &valueAsUInt, byteLength);
+					return value;
 				}
 				else
 				{
-					std::memcpy(buffer.get(), &value, byteLength);
+					size_t byteLength = std::max<size_t>((bitLength + byteSize - 1) / byteSize, 1);
+					std::vector<uint8_t> data(byteLength);
+					if constexpr (datatypes::is_bitset<T>())
+					{
+						uint64_t valueAsUInt = value.to_ulong();
+						std::memcpy(data.data(), &valueAsUInt,
+						    std::min(byteLength, sizeof(uint64_t)));
+					}
+					else
+					{
+						std::memcpy(data.data(), &value, std::min(byteLength, sizeof(T)));
+					}
+					return data;
 				}
-				return ec_SDOwrite(object.getSlaveID(), object.getIndex(), object.getSubIndex(),
-				           (boolean) false, bufferSize, buffer.get(), EC_TIMEOUTRXM)
-				    == 1;
 			};
 		}
 	};
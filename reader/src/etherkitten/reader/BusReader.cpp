@@ -17,6 +17,8 @@
 
 #include "BusReader.hpp"
 
+#include <array>
+
 extern "C"
 {
 #include <ethercat.h>
@@ -31,13 +33,24 @@ namespace etherkitten::reader
 	using namespace bReader;
 
 	BusReader::BusReader(BusSlaveInformant& slaveInformant, BusQueues& queues,
-	    std::unordered_map<datatypes::RegisterEnum, bool>& registers)
+	    std::unordered_map<datatypes::RegisterEnum, bool>& registers,
+	    CycleSchedule cycleSchedule, BusOptions options, datatypes::TimeStep maxStorageLatency)
 	    : SearchListReader(getSlaveConfiguredAddresses(), slaveInformant.getBusInfo().ioMapUsedSize,
 			datatypes::now())
 	    , slaveInformant(slaveInformant)
 	    , busInfo(slaveInformant.getBusInfo())
-	    , registerScheduler(slaveConfiguredAddresses, registers)
+	    , cycleSchedule(cycleSchedule.validate())
+	    , options(options)
+	    , mappedBlock(options.mapErrorCounters
+	              ? mapRegisterBlock(
+	                  static_cast<int>(datatypes::RegisterEnum::FRAME_ERROR_COUNTER_PORT_0),
+	                  static_cast<int>(datatypes::RegisterEnum::LOST_LINK_COUNTER_PORT_3) + 1,
+	                  registerBlockLogicalAddress)
+	              : MappedRegisterBlock())
+	    , registerScheduler(
+	          slaveConfiguredAddresses, registers, getDefaultRegisterRates(), mappedBlock)
 	    , queues(queues)
+	    , maxStorageLatency(maxStorageLatency)
 	    , desiredBusMode(datatypes::BusMode::READ_WRITE_OP)
 	    , actualBusMode(busInfo.statusAfterInit == datatypes::BusStatus::OP
 	              ? datatypes::BusMode::READ_WRITE_OP
@@ -49,9 +62,12 @@ namespace etherkitten::reader
 
 	BusReader::~BusReader()
 	{
-		ec_close();
 		shouldHalt.store(true, std::memory_order_release);
+		storageSignal.signal();
+		// The realtime loop has to stop before the FMMUs are released over the bus
 		realtimeThread->join();
+		unmapRegisterBlock(mappedBlock);
+		ec_close();
 		dataStorageThread->join();
 	}
 
@@ -61,6 +77,12 @@ namespace etherkitten::reader
 		registerScheduler.changeRegisterSettings(toRead);
 	}
 
+	void BusReader::changeRegisterRates(
+	    const std::unordered_map<datatypes::RegisterEnum, RegisterRate>& rates)
+	{
+		registerScheduler.changeRegisterRates(rates);
+	}
+
 	void BusReader::toggleBusSafeOp()
 	{
 		if (actualBusMode.load(std::memory_order_acquire) == datatypes::BusMode::READ_WRITE_OP)
@@ -78,7 +100,11 @@ namespace etherkitten::reader
 		return actualBusMode.load(std::memory_order_acquire);
 	}
 
-	void BusReader::messageHalt() { shouldHalt.store(true, std::memory_order_release); }
+	void BusReader::messageHalt()
+	{
+		shouldHalt.store(true, std::memory_order_release);
+		storageSignal.signal();
+	}
 
 	/*!
 	 * \brief Initialize and start the data storage loop of this BusReader.
@@ -110,9 +136,12 @@ namespace etherkitten::reader
 	/*!
 	 * \brief The main realtime loop of this BusReader.
 	 *
-	 * It will target a frequency of 1 / desiredPDOTimeStep, and will adjust how
-	 * many registers it reads per round dynamically.
+	 * It will run one round per cycle of its CycleSchedule, and will adjust how
+	 * many registers it reads per round dynamically so that the rounds fit into the cycles.
+	 * The RegisterScheduler fills that budget with the register frames that are due.
 	 * It communicates with the data storage loop via triple buffers.
+	 * It measures the timing of every round and hands the measurements to the
+	 * data storage loop as well.
 	 * It will stop if messageHalt() has been signaled to the BusQueues.
 	 */
 	void BusReader::readerLoop()
@@ -124,34 +153,81 @@ namespace etherkitten::reader
 		int registersPerRound = 1;
 		size_t currentIOMapBufferIndex = 0;
 		size_t currentRegisterBufferIndex = 0;
+		size_t currentCycleBufferIndex = 0;
+		CycleMeasurement measurement{};
+		CycleTimer cycleTimer(cycleSchedule);
+
+		// Sending the process data along with registers needs room in every register frame
+		const size_t processDataPDULength
+		    = options.piggybackRegisters ? getProcessDataPDULength() : 0;
+		const bool piggybackRegisters = processDataPDULength != 0
+		    && processDataPDULength <= RegisterScheduler::maxReservedFrameSpace;
+		if (piggybackRegisters)
+		{
+			registerScheduler.reserveFrameSpace(processDataPDULength);
+		}
 
 		while (true)
 		{
 			lastLoopStart = datatypes::now();
+			EtherCATFrameIterator it
+			    = registerScheduler.getNextFrames(registersPerRound, lastLoopStart);
+			uint32_t registerFrameCount = 0;
 
 			static const int timeoutus = 500;
-			if (ec_send_processdata() <= 0)
+			datatypes::TimeStamp sendEnd;
+			datatypes::TimeStamp receiveEnd;
+			int actualWKC = EC_NOFRAME;
+			if (piggybackRegisters && !it.atEnd())
 			{
-				queues.postError(
-				    { "Failed to transmit process data frames.", datatypes::ErrorSeverity::LOW });
+				EtherCATFrameMetaData* metaData = (*it).second;
+				bool completedLoop = it.hasCompletedLoop();
+				int bufferIndex
+				    = sendEtherCATFrameWithProcessData((*it).first, metaData->lengthOfFrame);
+				sendEnd = datatypes::now();
+				if (bufferIndex == EC_NOFRAME)
+				{
+					queues.postError({ "Failed to transmit process data frames.",
+					    datatypes::ErrorSeverity::LOW });
+				}
+				else
+				{
+					actualWKC
+					    = receiveEtherCATFrameWithProcessData(bufferIndex, metaData->lengthOfFrame);
+					receiveEnd = datatypes::now();
+					if (actualWKC != EC_NOFRAME)
+					{
+						storeRegisterFrame(bufferIndex, metaData, completedLoop, receiveEnd,
+						    currentRegisterBufferIndex);
+					}
+					ecx_setbufstat(ecx_context.port, bufferIndex, EC_BUF_EMPTY);
+				}
+				++it;
+				++registerFrameCount;
+			}
+			else
+			{
+				if (ec_send_processdata() <= 0)
+				{
+					queues.postError({ "Failed to transmit process data frames.",
+					    datatypes::ErrorSeverity::LOW });
+				}
+				sendEnd = datatypes::now();
+				actualWKC = ec_receive_processdata(timeoutus);
+				receiveEnd = datatypes::now();
 			}
-			int actualWKC = ec_receive_processdata(timeoutus);
 
 			// write IOMap in triple buffer
 			if (actualWKC >= expectedWKC)
 			{
 				auto* buffer = ioMapBuffer.getProducerSlot(currentIOMapBufferIndex);
 				std::memcpy(&buffer->value, busInfo.ioMap.data(), busInfo.ioMapUsedSize);
-				buffer->time = datatypes::now();
+				buffer->time = receiveEnd;
 				buffer->valid = true;
-				if (currentIOMapBufferIndex == tripleBufferSize - 1)
-				{
-					ioMapBuffer.swapProducer();
-					currentIOMapBufferIndex = 0;
-				}
-				else
+				++currentIOMapBufferIndex;
+				if (currentIOMapBufferIndex == tripleBufferSize)
 				{
-					++currentIOMapBufferIndex;
+					publishProducerBuffer(ioMapBuffer, currentIOMapBufferIndex);
 				}
 			}
 			else
@@ -164,15 +240,17 @@ namespace etherkitten::reader
 			}
 
 			handleRequests();
+			exchangeMailboxFrame();
 
-			// Read registers
-			for (EtherCATFrameIterator it = registerScheduler.getNextFrames(registersPerRound);
-			     !it.atEnd(); ++it)
+			// Read the remaining registers
+			while (!it.atEnd())
 			{
-				readRegisterFrame(
-				    (*it).first, (*it).second, currentRegisterBufferIndex, it.hasCompletedLoop());
+				registerFrameCount += readRegisterFrames(it, currentRegisterBufferIndex);
 			}
 
+			publishStaleProducerBuffer(ioMapBuffer, currentIOMapBufferIndex);
+			publishStaleProducerBuffer(registerBuffer, currentRegisterBufferIndex);
+
 			if (shouldHalt.load(std::memory_order_acquire))
 			{
 				desiredBusMode.store(datatypes::BusMode::READ_ONLY, std::memory_order_release);
@@ -182,39 +260,48 @@ namespace etherkitten::reader
 
 			handleBusMode();
 
-			// Adjust loop length
+			// Adjust the number of registers per round
 			datatypes::TimeStamp currentLoopEnd(datatypes::now());
 			auto loopDuration = currentLoopEnd - lastLoopStart;
-			if (loopDuration > desiredPDOTimeStep && registersPerRound > 1)
+			measurement[static_cast<size_t>(datatypes::CycleStatisticType::SEND_TIME)]
+			    = toCycleValue(sendEnd - lastLoopStart);
+			measurement[static_cast<size_t>(datatypes::CycleStatisticType::RECEIVE_LATENCY)]
+			    = toCycleValue(receiveEnd - sendEnd);
+			measurement[static_cast<size_t>(datatypes::CycleStatisticType::REGISTER_FRAME_COUNT)]
+			    = registerFrameCount;
+			measurement[static_cast<size_t>(datatypes::CycleStatisticType::LOOP_DURATION)]
+			    = toCycleValue(loopDuration);
+			measurement[static_cast<size_t>(datatypes::CycleStatisticType::DEADLINE_MISS)]
+			    = loopDuration > cycleSchedule.cycleTime ? 1 : 0;
+			if (loopDuration > cycleSchedule.cycleTime && registersPerRound > 1)
 			{
 				--registersPerRound;
 			}
-			else if (loopDuration < registerFramePerRoundIncrementThreshold * desiredPDOTimeStep)
+			else if (loopDuration < registerFramePerRoundIncrementThreshold * cycleSchedule.cycleTime
+			    && registersPerRound < maxRegisterCyclesPerRound * registerScheduler.getFrameCount())
 			{
-				if (registersPerRound
-				    < maxRegisterCyclesPerRound * registerScheduler.getFrameCount())
-				{
-					++registersPerRound;
-				}
-				else
-				{
-					while (datatypes::now() - lastLoopStart < desiredPDOTimeStep - 50us)
-					{
-						// Busy waiting because we don't want to give up the CPU
-					}
-				}
+				++registersPerRound;
 			}
+
+			cycleTimer.waitForNextCycle();
+
+			// The period includes the waiting, so it is only known at the very end
+			measurement[static_cast<size_t>(datatypes::CycleStatisticType::CYCLE_PERIOD)]
+			    = toCycleValue(datatypes::now() - lastLoopStart);
+			publishCycleMeasurement(measurement, lastLoopStart, currentCycleBufferIndex);
 		}
 	}
 
 	/*!
 	 * \brief The loop responsible for storing read data in data structures.
 	 *
-	 * It communicates with the reader loop via triple buffers.
+	 * It communicates with the reader loop via triple buffers and sleeps until the
+	 * reader loop signals that it has swapped one of them.
 	 * It will stop if shouldHalt() has been messaged to the BusQueues.
 	 */
 	void BusReader::dataStorageLoop()
 	{
+		uint32_t seenSignal = storageSignal.getSequence();
 		while (true)
 		{
 			ioMapBuffer.swapConsumer();
@@ -227,10 +314,8 @@ namespace etherkitten::reader
 				{
 					break;
 				}
-				std::unique_ptr<IOMap> ptr(
-				    new (busInfo.ioMapUsedSize) IOMap{ busInfo.ioMapUsedSize, {} });
-				std::memcpy(ptr->ioMap, buffer->value.data(), busInfo.ioMapUsedSize); // NOLINT
-				insertIOMap(std::move(ptr), datatypes::TimeStamp(buffer->time));
+				insertIOMap(buffer->value.data(), busInfo.ioMapUsedSize,
+				    datatypes::TimeStamp(buffer->time));
 				buffer->valid = false;
 			}
 
@@ -252,58 +337,176 @@ namespace etherkitten::reader
 				buffer->valid = false;
 			}
 
+			cycleBuffer.swapConsumer();
+
+			// write cycle measurements in lists
+			for (size_t index = 0; index < tripleBufferSize; ++index)
+			{
+				auto* buffer = cycleBuffer.getConsumerSlot(index);
+				if (!buffer->valid)
+				{
+					break;
+				}
+				insertCycleMeasurement(buffer->value, buffer->time);
+				buffer->valid = false;
+			}
+
+			signalNewData();
 			freeMemoryIfNecessary();
 
 			if (shouldHalt.load(std::memory_order_acquire))
 			{
 				break;
 			}
+
+			seenSignal = storageSignal.waitFor(seenSignal, storageWakeupInterval);
 		}
 	}
 
 	/*!
-	 * \brief Send an EtherCATFrame of registers over the bus and place it in the triple buffer.
-	 * \param frame the frame to send
-	 * \param metaData the metadata to place in the triple buffer
-	 * \param registerBufferIndex the index in the triple buffer to place the frame in
-	 * \param saveTimeStamp whether to set the saving of the TimeStamp in the triple buffer
+	 * \brief Hand the producer side of a triple buffer to the data storage loop.
+	 *
+	 * If the buffer is not full, the slot after the last written one is marked invalid
+	 * so that the data storage loop does not read stale data from an earlier round.
+	 * \param buffer the triple buffer to swap
+	 * \param index the index of the next slot to write, will be reset to 0
 	 */
-	void BusReader::readRegisterFrame(EtherCATFrame* frame, EtherCATFrameMetaData* metaData,
-	    size_t& registerBufferIndex, bool saveTimeStamp)
+	template<typename T>
+	void BusReader::publishProducerBuffer(TripleBuffer<T, tripleBufferSize>& buffer, size_t& index)
 	{
-		auto [workingCounter, bufferIndex]
-		    = sendAndReceiveEtherCATFrame(frame, metaData->lengthOfFrame, 0, {});
-		if (workingCounter != EC_NOFRAME)
+		if (index < tripleBufferSize)
 		{
-			auto* tripleBuffer = registerBuffer.getProducerSlot(registerBufferIndex);
-			// SOEM strips the Ethernet header for us in rxbuf, so we don't need
-			// to account for it.
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wclass-memaccess" // NOLINT
-			std::memcpy(&(tripleBuffer->value.frame),
-			    &(ecx_context.port->rxbuf[bufferIndex]), // NOLINT
-			    metaData->lengthOfFrame);
-#pragma GCC diagnostic pop
-			tripleBuffer->value.metaData = metaData;
-			tripleBuffer->value.completedLoop = saveTimeStamp;
-			tripleBuffer->time = datatypes::now();
-			tripleBuffer->valid = true;
+			buffer.getProducerSlot(index)->valid = false;
+		}
+		buffer.swapProducer();
+		index = 0;
+		storageSignal.signal();
+	}
+
+	/*!
+	 * \brief Hand the producer side of a triple buffer to the data storage loop if its
+	 * oldest data has waited for maxStorageLatency.
+	 * \param buffer the triple buffer to check
+	 * \param index the index of the next slot to write, will be reset to 0 on a swap
+	 */
+	template<typename T>
+	void BusReader::publishStaleProducerBuffer(
+	    TripleBuffer<T, tripleBufferSize>& buffer, size_t& index)
+	{
+		if (index > 0 && datatypes::now() - buffer.getProducerSlot(0)->time >= maxStorageLatency)
+		{
+			publishProducerBuffer(buffer, index);
+		}
+	}
 
-			if (registerBufferIndex == tripleBufferSize - 1)
+	/*!
+	 * \brief Place the measurements of a round in the triple buffer.
+	 * \param measurement the measurements to place in the triple buffer
+	 * \param time the start of the round
+	 * \param cycleBufferIndex the index in the triple buffer to place the measurements in
+	 */
+	void BusReader::publishCycleMeasurement(const CycleMeasurement& measurement,
+	    datatypes::TimeStamp time, size_t& cycleBufferIndex)
+	{
+		auto* buffer = cycleBuffer.getProducerSlot(cycleBufferIndex);
+		buffer->value = measurement;
+		buffer->time = time;
+		buffer->valid = true;
+		++cycleBufferIndex;
+		if (cycleBufferIndex == tripleBufferSize)
+		{
+			publishProducerBuffer(cycleBuffer, cycleBufferIndex);
+		}
+		else
+		{
+			publishStaleProducerBuffer(cycleBuffer, cycleBufferIndex);
+		}
+	}
+
+	/*!
+	 * \brief Send the next EtherCATFrames of registers over the bus and place them
+	 * in the triple buffer.
+	 *
+	 * Up to maxRegisterFramesInFlight frames are sent back to back before the first
+	 * one is waited for, so their round trips on the bus overlap.
+	 * \param it the iterator over the frames to send, advanced past the sent frames
+	 * \param registerBufferIndex the index in the triple buffer to place the frames in
+	 * \return the number of frames that were sent
+	 */
+	uint32_t BusReader::readRegisterFrames(EtherCATFrameIterator& it, size_t& registerBufferIndex)
+	{
+		struct InFlightFrame
+		{
+			int bufferIndex;
+			EtherCATFrameMetaData* metaData;
+			bool completedLoop;
+		};
+		std::array<InFlightFrame, maxRegisterFramesInFlight> inFlight{};
+		size_t inFlightCount = 0;
+		uint32_t frameCount = 0;
+		for (; !it.atEnd() && inFlightCount < inFlight.size(); ++it)
+		{
+			++frameCount;
+			EtherCATFrameMetaData* metaData = (*it).second;
+			int bufferIndex = sendEtherCATFrame((*it).first, metaData->lengthOfFrame);
+			if (bufferIndex == EC_NOFRAME)
+			{
+				queues.postError(
+				    { "Failed to send register frame.", datatypes::ErrorSeverity::LOW });
+				continue;
+			}
+			inFlight[inFlightCount++] = { bufferIndex, metaData, it.hasCompletedLoop() };
+		}
+
+		for (size_t i = 0; i < inFlightCount; ++i)
+		{
+			const InFlightFrame& frame = inFlight[i];
+			int workingCounter = receiveEtherCATFrame(frame.bufferIndex);
+			if (workingCounter != EC_NOFRAME)
 			{
-				registerBuffer.swapProducer();
-				registerBufferIndex = 0;
+				storeRegisterFrame(frame.bufferIndex, frame.metaData, frame.completedLoop,
+				    datatypes::now(), registerBufferIndex);
 			}
 			else
 			{
-				++registerBufferIndex;
+				queues.postError(
+				    { "Failed to receive register frame.", datatypes::ErrorSeverity::LOW });
 			}
+			ecx_setbufstat(ecx_context.port, frame.bufferIndex, EC_BUF_EMPTY);
 		}
-		else
+		return frameCount;
+	}
+
+	/*!
+	 * \brief Place a received EtherCATFrame of registers in the triple buffer.
+	 * \param bufferIndex the index of the SOEM rx buffer the frame was received in
+	 * \param metaData the metadata to place in the triple buffer
+	 * \param completedLoop whether to set the saving of the TimeStamp in the triple buffer
+	 * \param time the time the frame was received at
+	 * \param registerBufferIndex the index in the triple buffer to place the frame in
+	 */
+	void BusReader::storeRegisterFrame(int bufferIndex, EtherCATFrameMetaData* metaData,
+	    bool completedLoop, datatypes::TimeStamp time, size_t& registerBufferIndex)
+	{
+		auto* tripleBuffer = registerBuffer.getProducerSlot(registerBufferIndex);
+		// SOEM strips the Ethernet header for us in rxbuf, so we don't need
+		// to account for it.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wclass-memaccess" // NOLINT
+		std::memcpy(&(tripleBuffer->value.frame), &(ecx_context.port->rxbuf[bufferIndex]), // NOLINT
+		    metaData->lengthOfFrame);
+#pragma GCC diagnostic pop
+		tripleBuffer->value.metaData = metaData;
+		tripleBuffer->value.completedLoop = completedLoop;
+		rereadShortBlocks(tripleBuffer->value);
+		tripleBuffer->time = time;
+		tripleBuffer->valid = true;
+
+		++registerBufferIndex;
+		if (registerBufferIndex == tripleBufferSize)
 		{
-			queues.postError({ "Failed to send register frame.", datatypes::ErrorSeverity::LOW });
+			publishProducerBuffer(registerBuffer, registerBufferIndex);
 		}
-		ecx_setbufstat(ecx_context.port, bufferIndex, EC_BUF_EMPTY);
 	}
 
 	/*!
@@ -330,40 +533,78 @@ namespace etherkitten::reader
 		}
 	}
 
+	/*!
+	 * \brief Start the SDO transfer for a CoE request.
+	 *
+	 * The transfer is carried out by exchangeMailboxFrame() over the following cycles.
+	 * \param request the request to start the transfer for
+	 */
 	void BusReader::handleCoERequest(std::shared_ptr<CoEUpdateRequest>&& request)
 	{
-		size_t bitLength = busInfo.coeInfos.at(*request->getObject()).bitLength;
-		bool errorOccured = false;
-		std::string action;
-		if (request->isReadRequest())
+		const datatypes::CoEObject& object = *request->getObject();
+		std::optional<std::vector<uint8_t>> data;
+		if (!request->isReadRequest())
 		{
-			errorOccured = !datatypes::dataTypeMapWithStrings<CoEReadRequestHandler>.at(
-			    request->getObject()->getType())(
-			    *request->getObject(), *request->getValue(), bitLength);
-			action = "read";
+			size_t bitLength = busInfo.coeInfos.at(object).bitLength;
+			data = datatypes::dataTypeMapWithStrings<CoEValueEncoder>.at(object.getType())(
+			    *request->getValue(), bitLength);
 		}
-		else
+		SDOTransfer transfer(getMailboxInfo(object.getSlaveID()), object.getIndex(),
+		    object.getSubIndex(), std::move(data), sdoTimeout, datatypes::now());
+		mailboxEngine.submit(std::move(request), std::move(transfer));
+	}
+
+	/*!
+	 * \brief Exchange a single frame for the current SDO transfer, if there is one,
+	 * and reply to the CoE requests whose transfers have finished.
+	 */
+	void BusReader::exchangeMailboxFrame()
+	{
+		size_t frameLength = mailboxEngine.prepareFrame(mailboxFrame, datatypes::now());
+		if (frameLength > 0)
 		{
-			errorOccured = !datatypes::dataTypeMapWithStrings<CoEWriteRequestHandler>.at(
-			    request->getObject()->getType())(
-			    *request->getObject(), *request->getValue(), bitLength);
-			action = "write";
+			auto [workingCounter, bufferIndex]
+			    = sendAndReceiveEtherCATFrame(&mailboxFrame, frameLength, 0, {});
+			if (workingCounter != EC_NOFRAME)
+			{
+				// SOEM strips the Ethernet header for us in rxbuf
+				mailboxEngine.handleReply(*reinterpret_cast<EtherCATFrame*>( // NOLINT
+				                              &(ecx_context.port->rxbuf[bufferIndex])), // NOLINT
+				    workingCounter, datatypes::now());
+			}
+			ecx_setbufstat(ecx_context.port, bufferIndex, EC_BUF_EMPTY);
 		}
-		if (errorOccured)
+
+		std::optional<MailboxEngine::MailboxJob> job;
+		while ((job = mailboxEngine.takeFinished()).has_value())
+		{
+			finishCoERequest(std::move(job.value()));
+		}
+	}
+
+	/*!
+	 * \brief Store the result of a finished SDO transfer in its CoE request and reply to it.
+	 * \param job the CoE request with its finished transfer
+	 */
+	void BusReader::finishCoERequest(MailboxEngine::MailboxJob&& job)
+	{
+		std::shared_ptr<CoEUpdateRequest>& request = job.request;
+		if (job.transfer.hasFailed())
 		{
 			std::stringstream sstream;
-			sstream << "Failed to " << action << " CoE object at index "
-			        << request->getObject()->getIndex() << " and subindex "
-			        << request->getObject()->getSubIndex();
+			sstream << "Failed to " << (request->isReadRequest() ? "read" : "write")
+			        << " CoE object at index " << request->getObject()->getIndex()
+			        << " and subindex " << request->getObject()->getSubIndex() << ": "
+			        << job.transfer.getError();
 			queues.postError({ sstream.str(), request->getObject()->getSlaveID(),
 			    datatypes::ErrorSeverity::MEDIUM });
-			std::optional<datatypes::ErrorMessage> soemError;
-			while ((soemError = convertECErrorToMessage()).has_value())
-			{
-				queues.postError(std::move(soemError.value()));
-			}
 			request->setFailed();
 		}
+		else if (request->isReadRequest())
+		{
+			datatypes::dataTypeMapWithStrings<CoEValueDecoder>.at(
+			    request->getObject()->getType())(job.transfer.getData(), *request->getValue());
+		}
 		queues.postCoERequestReply(std::move(request));
 	}
 
@@ -459,6 +700,87 @@ namespace etherkitten::reader
 		}
 	}
 
+	/*!
+	 * \brief Read the working counter of a PDU from a received frame.
+	 * \param frameData the received frame
+	 * \param meta the metadata of the PDU
+	 * \return the working counter of the PDU
+	 */
+	static uint16_t readWorkingCounter(const uint8_t* frameData, const PDUMetaData& meta)
+	{
+		uint16_t workingCounter = 0;
+		std::memcpy(
+		    &workingCounter, frameData + meta.workingCounterOffset, sizeof(uint16_t)); // NOLINT
+		return flipBytesIfBigEndianHost(workingCounter);
+	}
+
+	/*!
+	 * \brief Read the blocks of the slaves of the LRD PDUs in a received frame that came
+	 * back short with FPRD PDUs instead.
+	 *
+	 * The working counter of an LRD PDU cannot tell which of its slaves did not answer,
+	 * so the blocks of all of them are read on their own for this round and written into
+	 * the frame. This blocks for a register timeout per slave that does not answer.
+	 * At most once per mappingCheckInterval, the slaves that answer have their mapping
+	 * checked as well, see restoreMapping().
+	 * \param frameWMetaData the received frame and its metadata
+	 */
+	void BusReader::rereadShortBlocks(EtherCATFrameWithMetaData& frameWMetaData)
+	{
+		frameWMetaData.reread.reset();
+		uint8_t* frameData = reinterpret_cast<uint8_t*>(&frameWMetaData.frame); // NOLINT
+		const std::vector<PDUMetaData>& pdus = frameWMetaData.metaData->pdus;
+		bool checkMapping = false;
+		for (size_t i = 0; i < pdus.size(); ++i)
+		{
+			const PDUMetaData& meta = pdus[i];
+			if (!meta.blockPart.has_value()
+			    || readWorkingCounter(frameData, meta) >= meta.expectedWorkingCounter)
+			{
+				continue;
+			}
+			const BlockPart& part = meta.blockPart.value();
+			if (readRegisterBlock(meta.slaveConfiguredAddress, part.start, part.end,
+			        frameData + part.dataOffset)) // NOLINT
+			{
+				frameWMetaData.reread.set(i);
+				if (!checkMapping && datatypes::now() >= nextMappingCheck)
+				{
+					checkMapping = true;
+					nextMappingCheck = datatypes::now() + mappingCheckInterval;
+				}
+				if (checkMapping)
+				{
+					restoreMapping(meta.slaveConfiguredAddress);
+				}
+			}
+		}
+	}
+
+	/*!
+	 * \brief Map the block of a slave again if it answers but lost the mapping.
+	 *
+	 * A slave that was initialized again has forgotten its FMMU configuration,
+	 * so the LRD PDUs would keep missing it.
+	 * \param slaveConfiguredAddress the configured address of the slave
+	 */
+	void BusReader::restoreMapping(uint16_t slaveConfiguredAddress)
+	{
+		const std::vector<uint16_t>& mapped = mappedBlock.slaveConfiguredAddresses;
+		size_t index = std::find(mapped.begin(), mapped.end(), slaveConfiguredAddress)
+		    - mapped.begin();
+		if (index < mapped.size()
+		    && restoreRegisterBlockMapping(mappedBlock, index).value_or(false))
+		{
+			unsigned int slave = std::find(slaveConfiguredAddresses.begin(),
+			                         slaveConfiguredAddresses.end(), slaveConfiguredAddress)
+			    - slaveConfiguredAddresses.begin() + 1;
+			queues.postError({ "Mapped the error counters again after the slave lost its FMMU "
+			                   "configuration.",
+			    slave, datatypes::ErrorSeverity::LOW });
+		}
+	}
+
 	/*!
 	 * \brief Write the register data contained in the parameters to the SearchLists.
 	 * \param frameWMetaData the frame to get the registers from, and the metadata to get them with
@@ -468,13 +790,13 @@ namespace etherkitten::reader
 	    EtherCATFrameWithMetaData frameWMetaData, datatypes::TimeStamp time)
 	{
 		uint8_t* frameData = reinterpret_cast<uint8_t*>(&frameWMetaData.frame); // NOLINT
-		for (const PDUMetaData& meta : frameWMetaData.metaData->pdus)
+		const std::vector<PDUMetaData>& pdus = frameWMetaData.metaData->pdus;
+		for (size_t i = 0; i < pdus.size(); ++i)
 		{
-			uint16_t workingCounter = 0;
-			std::memcpy(
-			    &workingCounter, frameData + meta.workingCounterOffset, sizeof(uint16_t)); // NOLINT
-			workingCounter = flipBytesIfBigEndianHost(workingCounter);
-			if (workingCounter == 0)
+			const PDUMetaData& meta = pdus[i];
+			// The slaves of a short LRD PDU were read on their own, see rereadShortBlocks()
+			if (readWorkingCounter(frameData, meta) < meta.expectedWorkingCounter
+			    && !frameWMetaData.reread.test(i))
 			{
 				continue;
 			}
@@ -22,16 +22,22 @@
  */
 
 #include <atomic>
+#include <bitset>
 #include <memory>
 #include <thread>
 
 #include <etherkitten/datatypes/SlaveInfo.hpp>
 #include <etherkitten/datatypes/dataobjects.hpp>
 
+#include "BusOptions.hpp"
 #include "BusQueues.hpp"
 #include "BusSlaveInformant.hpp"
+#include "CycleTimer.hpp"
 #include "EtherCATFrame.hpp"
+#include "EventSignal.hpp"
 #include "IOMap.hpp"
+#include "MailboxEngine.hpp"
+#include "RegisterRate.hpp"
 #include "RegisterScheduler.hpp"
 #include "RingBuffer.hpp"
 #include "SearchList.hpp"
@@ -62,6 +68,11 @@ namespace etherkitten::reader
 	 * The BusReader reads a user-specified set of registers from the EtherCAT bus while ignoring
 	 * the others. The user can change which registers are read while the BusReader is running.
 	 * Reading fewer registers will be faster and lead to slower accumulation of memory usage.
+	 * The registers are read at the rates of getDefaultRegisterRates() until the user
+	 * changes them. If the BusOptions ask for it, the error counters are mapped into
+	 * the logical address space by an unused FMMU of each slave, so that they are read from
+	 * all of these slaves at once. The mapping is restored for slaves that lost it and
+	 * released when the BusReader is destroyed.
 	 */
 	class BusReader : public SearchListReader
 	{
@@ -76,13 +87,27 @@ namespace etherkitten::reader
 		 * The BusReader will use the BusQueues-specific end of the queues to communicate with
 		 * the user. After this method has been called, those methods may no longer be used.
 		 *
+		 * The realtime loop hands read data to the data storage loop in batches. A batch is
+		 * handed over once it is full or once its oldest data is maxStorageLatency old,
+		 * whichever comes first. The data storage loop sleeps until a batch arrives.
+		 *
+		 * The realtime loop runs one round per cycle of the given CycleSchedule and reads
+		 * the bus in the ways the given BusOptions allow.
+		 *
 		 * This constructor is non-blocking.
 		 * \param slaveInformant the BusSlaveInformant to get slave and bus information from
 		 * \param queues the BusQueues to communicate over
 		 * \param registers the registers to read from the start
+		 * \param cycleSchedule the schedule of the realtime loop
+		 * \param options the ways of reading the bus the realtime loop may use
+		 * \param maxStorageLatency the longest time read data may wait before it is stored
+		 * \exception std::invalid_argument iff the cycleSchedule is invalid, see
+		 * CycleSchedule::validate(). The slaves are left unchanged then.
 		 */
 		BusReader(BusSlaveInformant& slaveInformant, BusQueues& queues,
-		    std::unordered_map<datatypes::RegisterEnum, bool>& registers);
+		    std::unordered_map<datatypes::RegisterEnum, bool>& registers,
+		    CycleSchedule cycleSchedule = CycleSchedule(), BusOptions options = BusOptions(),
+		    datatypes::TimeStep maxStorageLatency = defaultMaxStorageLatency);
 
 		// These constructors are deleted because implementing them properly would be
 		// a lot of work (and would be kind of pointless).
@@ -101,16 +126,41 @@ namespace etherkitten::reader
 		void changeRegisterSettings(
 		    const std::unordered_map<datatypes::RegisterEnum, bool>& toRead) override;
 
+		/*!
+		 * \brief Change how often the selected registers are read.
+		 * \param rates the rates of the registers, registers without one are read
+		 * as often as the cycles leave room for
+		 * \exception std::invalid_argument iff a frequency is negative or not finite
+		 */
+		void changeRegisterRates(
+		    const std::unordered_map<datatypes::RegisterEnum, RegisterRate>& rates);
+
 		void toggleBusSafeOp() override;
 
 		datatypes::BusMode getBusMode() override;
 
 		void messageHalt() override;
 
+		/*!
+		 * \brief The default for the longest time read data may wait before it is stored.
+		 *
+		 * This is how long it takes to fill a batch at the desired PDO frequency.
+		 */
+		static constexpr datatypes::TimeStep defaultMaxStorageLatency = 20ms;
+
 	private:
 		BusSlaveInformant& slaveInformant;
 		BusInfo& busInfo;
 
+		// Validated before the error counters are mapped for the RegisterScheduler
+		const CycleSchedule cycleSchedule;
+		const BusOptions options;
+
+		const MappedRegisterBlock mappedBlock;
+		// The FMMUs of the mapped block are checked after a short LRD PDU from then on
+		datatypes::TimeStamp nextMappingCheck;
+		static constexpr datatypes::TimeStep mappingCheckInterval = 1s;
+
 		RegisterScheduler registerScheduler;
 		BusQueues& queues;
 
@@ -118,12 +168,27 @@ namespace etherkitten::reader
 		{
 			EtherCATFrameMetaData* metaData = nullptr;
 			bool completedLoop = false;
+			// The PDUs whose blocks were read with FPRD PDUs after a short LRD PDU,
+			// by their index in the metadata. A frame holds fewer PDUs than bytes.
+			std::bitset<maxTotalPDULength> reread;
 			EtherCATFrame frame;
 		};
 
 		static constexpr size_t tripleBufferSize = 20;
 		TripleBuffer<std::array<uint8_t, ioMapSize>, tripleBufferSize> ioMapBuffer;
 		TripleBuffer<EtherCATFrameWithMetaData, tripleBufferSize> registerBuffer;
+		TripleBuffer<CycleMeasurement, tripleBufferSize> cycleBuffer;
+
+		const datatypes::TimeStep maxStorageLatency;
+		// Signaled whenever a triple buffer is swapped by the producer or the reader halts
+		EventSignal storageSignal;
+		// The data storage loop also wakes up this often if it has not been signaled
+		static constexpr datatypes::TimeStep storageWakeupInterval = 100ms;
+
+		MailboxEngine mailboxEngine;
+		EtherCATFrame mailboxFrame;
+		// The time a slave may take to answer a single SDO request, like EC_TIMEOUTRXM
+		static constexpr datatypes::TimeStep sdoTimeout = 700ms;
 
 		std::atomic<datatypes::BusMode> desiredBusMode;
 		std::atomic<datatypes::BusMode> actualBusMode;
@@ -136,26 +201,47 @@ namespace etherkitten::reader
 
 		std::atomic<bool> shouldHalt = false;
 
-		static constexpr datatypes::TimeStep desiredPDOTimeStep = 1ms;
-
-		// If the time for a round is smaller than this * desiredPDOTimeStep,
+		// If the time for a round is smaller than this * the cycle time,
 		// read more registers unless you are already reading the maximum number.
 		static constexpr double registerFramePerRoundIncrementThreshold = 0.9;
 		static constexpr uint64_t maxRegisterCyclesPerRound = 2;
 
+		// SOEM has EC_MAXBUF buffers shared with the process data and mailbox frames,
+		// so keep enough of them free while register frames are on the bus.
+		static constexpr size_t maxRegisterFramesInFlight = 8;
+
+		// The error counters of all slaves are mapped here, far behind the IOMap
+		static constexpr uint32_t registerBlockLogicalAddress = 0x10000000;
+
 		void initRealtimeThread();
 		void initDataStorageThread();
 		void readerLoop();
 		void dataStorageLoop();
 
-		void readRegisterFrame(EtherCATFrame* frame, EtherCATFrameMetaData* metaData,
-		    size_t& registerBufferIndex, bool saveTimeStamp);
+		uint32_t readRegisterFrames(EtherCATFrameIterator& it, size_t& registerBufferIndex);
+
+		void storeRegisterFrame(int bufferIndex, EtherCATFrameMetaData* metaData,
+		    bool completedLoop, datatypes::TimeStamp time, size_t& registerBufferIndex);
+
+		template<typename T>
+		void publishProducerBuffer(TripleBuffer<T, tripleBufferSize>& buffer, size_t& index);
+
+		template<typename T>
+		void publishStaleProducerBuffer(TripleBuffer<T, tripleBufferSize>& buffer, size_t& index);
+
+		void publishCycleMeasurement(const CycleMeasurement& measurement,
+		    datatypes::TimeStamp time, size_t& cycleBufferIndex);
+
+		void rereadShortBlocks(EtherCATFrameWithMetaData& frameWMetaData);
+		void restoreMapping(uint16_t slaveConfiguredAddress);
 
 		void writeRegistersToLists(
 		    EtherCATFrameWithMetaData frameWMetaData, datatypes::TimeStamp time);
 
 		void handleRequests();
 		void handleCoERequest(std::shared_ptr<CoEUpdateRequest>&& request);
+		void exchangeMailboxFrame();
+		void finishCoERequest(MailboxEngine::MailboxJob&& job);
 		void handlePDOWriteRequest(std::shared_ptr<PDOWriteRequest>&& request);
 		void handleRegisterResetRequest(unsigned int slave);
 
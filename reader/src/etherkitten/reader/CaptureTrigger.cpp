@@ -0,0 +1,88 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "CaptureTrigger.hpp"
+
+#include <etherkitten/datatypes/register.hpp>
+
+namespace etherkitten::reader
+{
+	CaptureTrigger::CaptureTrigger(CaptureTriggerType type, datatypes::ErrorSeverity severity,
+	    datatypes::TimeStep gap, uint16_t slave, uint16_t regAddr, size_t bitOffset,
+	    size_t bitLength, uint64_t threshold)
+	    : type(type)
+	    , severity(severity)
+	    , gap(gap)
+	    , slave(slave)
+	    , regAddr(regAddr)
+	    , bitOffset(bitOffset)
+	    , bitLength(bitLength)
+	    , threshold(threshold)
+	{
+	}
+
+	CaptureTrigger CaptureTrigger::onError(datatypes::ErrorSeverity severity)
+	{
+		return CaptureTrigger(
+		    CaptureTriggerType::ERROR, severity, datatypes::TimeStep(0), 0, 0, 0, 0, 0);
+	}
+
+	CaptureTrigger CaptureTrigger::onProcessDataGap(datatypes::TimeStep gap)
+	{
+		return CaptureTrigger(CaptureTriggerType::PROCESS_DATA_GAP, datatypes::ErrorSeverity::LOW,
+		    gap, 0, 0, 0, 0, 0);
+	}
+
+	CaptureTrigger CaptureTrigger::onRegisterAbove(datatypes::Register reg, uint64_t threshold)
+	{
+		// Bit fields carry their bit offset above the address of their byte-aligned register
+		static constexpr int twoByteMask = 0xFFFF;
+		static constexpr int twoByteSize = 16;
+		int registerAsInt = static_cast<int>(reg.getRegister());
+		return CaptureTrigger(CaptureTriggerType::REGISTER_ABOVE, datatypes::ErrorSeverity::LOW,
+		    datatypes::TimeStep(0), static_cast<uint16_t>(reg.getSlaveID()),
+		    static_cast<uint16_t>(registerAsInt & twoByteMask), registerAsInt >> twoByteSize,
+		    datatypes::registerMap.at(reg.getRegister()).bitLength, threshold);
+	}
+
+	bool CaptureTrigger::firesOnError(datatypes::ErrorSeverity severity) const
+	{
+		return type == CaptureTriggerType::ERROR
+		    && static_cast<int>(severity) >= static_cast<int>(this->severity);
+	}
+
+	bool CaptureTrigger::firesOnProcessDataGap(datatypes::TimeStep gap) const
+	{
+		return type == CaptureTriggerType::PROCESS_DATA_GAP && gap > this->gap;
+	}
+
+	bool CaptureTrigger::firesOnRegister(uint16_t slave, uint16_t regAddr, uint64_t value) const
+	{
+		if (type != CaptureTriggerType::REGISTER_ABOVE || slave != this->slave
+		    || regAddr != this->regAddr)
+		{
+			return false;
+		}
+		static constexpr size_t valueBits = 64;
+		uint64_t field = value >> bitOffset;
+		if (bitLength < valueBits)
+		{
+			field &= (static_cast<uint64_t>(1) << bitLength) - 1;
+		}
+		return field > threshold;
+	}
+} // namespace etherkitten::reader
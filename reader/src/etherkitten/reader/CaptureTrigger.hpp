@@ -0,0 +1,154 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/*!
+ * \file
+ * \brief Defines the CaptureTrigger and the CaptureSettings, which tell a capturing Logger
+ * when to write its recent data to a file.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <etherkitten/datatypes/dataobjects.hpp>
+#include <etherkitten/datatypes/errors.hpp>
+#include <etherkitten/datatypes/time.hpp>
+
+namespace etherkitten::reader
+{
+	/*!
+	 * \brief The kinds of events a CaptureTrigger fires on.
+	 */
+	enum class CaptureTriggerType
+	{
+		ERROR, /*!< \brief An error message with at least a given severity. */
+		PROCESS_DATA_GAP, /*!< \brief No process data for longer than a given time. */
+		REGISTER_ABOVE, /*!< \brief A register value above a given threshold. */
+	};
+
+	/*!
+	 * \brief A CaptureTrigger decides whether an event in the data of a Reader is an
+	 * incident that a capturing Logger writes to a file.
+	 *
+	 * The BusReader only stores process data whose working counter is complete,
+	 * so a drop of the working counter shows up as a process data gap.
+	 */
+	class CaptureTrigger
+	{
+	public:
+		/*!
+		 * \brief Create a CaptureTrigger that fires on error messages.
+		 * \param severity the minimum severity of the error messages
+		 * \return the CaptureTrigger
+		 */
+		static CaptureTrigger onError(datatypes::ErrorSeverity severity);
+
+		/*!
+		 * \brief Create a CaptureTrigger that fires when there is no process data for
+		 * longer than the given time.
+		 * \param gap the longest time between two process data values that is not an incident
+		 * \return the CaptureTrigger
+		 */
+		static CaptureTrigger onProcessDataGap(datatypes::TimeStep gap);
+
+		/*!
+		 * \brief Create a CaptureTrigger that fires when a register has a value above the
+		 * given threshold.
+		 *
+		 * Registers that are bit fields of a byte-aligned register are compared by the
+		 * value of their bits alone.
+		 * \param reg the register to watch
+		 * \param threshold the highest value of the register that is not an incident
+		 * \return the CaptureTrigger
+		 */
+		static CaptureTrigger onRegisterAbove(datatypes::Register reg, uint64_t threshold);
+
+		/*!
+		 * \brief Get the kind of events this CaptureTrigger fires on.
+		 * \return the kind of events
+		 */
+		CaptureTriggerType getType() const { return type; }
+
+		/*!
+		 * \brief Check whether this CaptureTrigger fires on an error message.
+		 * \param severity the severity of the error message
+		 * \retval true iff this CaptureTrigger fires on the error message
+		 */
+		bool firesOnError(datatypes::ErrorSeverity severity) const;
+
+		/*!
+		 * \brief Check whether this CaptureTrigger fires on the time between two process
+		 * data values.
+		 * \param gap the time between the process data values
+		 * \retval true iff this CaptureTrigger fires on the gap
+		 */
+		bool firesOnProcessDataGap(datatypes::TimeStep gap) const;
+
+		/*!
+		 * \brief Check whether this CaptureTrigger fires on a register value.
+		 * \param slave the slave the value was read from
+		 * \param regAddr the address of the byte-aligned register
+		 * \param value the raw value of the byte-aligned register
+		 * \retval true iff this CaptureTrigger fires on the value
+		 */
+		bool firesOnRegister(uint16_t slave, uint16_t regAddr, uint64_t value) const;
+
+	private:
+		CaptureTrigger(CaptureTriggerType type, datatypes::ErrorSeverity severity,
+		    datatypes::TimeStep gap, uint16_t slave, uint16_t regAddr, size_t bitOffset,
+		    size_t bitLength, uint64_t threshold);
+
+		CaptureTriggerType type;
+		datatypes::ErrorSeverity severity;
+		datatypes::TimeStep gap;
+		uint16_t slave;
+		uint16_t regAddr;
+		// The bits of the byte-aligned register that hold the watched register
+		size_t bitOffset;
+		size_t bitLength;
+		uint64_t threshold;
+	};
+
+	/*!
+	 * \brief The CaptureSettings tell a Logger how much data to write around an incident
+	 * and which events are incidents.
+	 */
+	struct CaptureSettings
+	{
+		/*!
+		 * \brief The time of data in front of an incident that is written to its file.
+		 */
+		datatypes::TimeStep preTrigger;
+
+		/*!
+		 * \brief The time of data after an incident that is written to its file.
+		 *
+		 * Another incident within this time extends the file instead of starting a new one.
+		 */
+		datatypes::TimeStep postTrigger;
+
+		/*!
+		 * \brief The triggers that detect incidents.
+		 *
+		 * Without triggers, incidents are only triggered manually.
+		 */
+		std::vector<CaptureTrigger> triggers;
+	};
+} // namespace etherkitten::reader
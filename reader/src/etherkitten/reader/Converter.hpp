@@ -217,4 +217,29 @@ namespace etherkitten::reader
 			}
 		}
 	};
+
+	/*!
+	 * \brief Extract a value of type Output from an IOMap and convert it to a double.
+	 * \tparam Output the type of the value in the IOMap
+	 * \param ioMap the IOMap to extract the value from
+	 * \param bitOffset the bit offset of the value in the IOMap
+	 * \param bitLength the bit length of the value in the IOMap
+	 * \param flipBytes whether to flip the bytes of the value on big endian hosts
+	 * \return the extracted value as a double
+	 */
+	template<typename Output>
+	double convertIOMapToDouble(IOMap* ioMap, size_t bitOffset, size_t bitLength, bool flipBytes)
+	{
+		if constexpr (datatypes::is_bitset<Output>())
+		{
+			return static_cast<double>(
+			    Converter<IOMap*, Output>::shiftAndConvert(ioMap, bitOffset, bitLength, flipBytes)
+			        .to_ulong());
+		}
+		else
+		{
+			return static_cast<double>(
+			    Converter<IOMap*, Output>::shiftAndConvert(ioMap, bitOffset, bitLength, flipBytes));
+		}
+	}
 } // namespace etherkitten::reader
@@ -0,0 +1,217 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+/*!
+ * \file
+ * \brief Defines the CycleHistogram, a lock-free histogram with a bounded relative error.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+namespace etherkitten::reader
+{
+	/*!
+	 * \brief The CycleHistogram class counts non-negative integer values in buckets whose width
+	 * grows with the values they hold, in the manner of an HDR histogram.
+	 *
+	 * Values below `2^subBucketBits` each have their own bucket. Above that, every power of
+	 * two is split into `2^(subBucketBits - 1)` buckets, so the relative error of any value
+	 * reported by the CycleHistogram is below `2^(1 - subBucketBits)`, about 3%.
+	 * Values that do not fit into 32 bits are counted in the topmost bucket.
+	 *
+	 * A single thread may record values while any number of threads read the CycleHistogram.
+	 * Readers never block the writer, but may see a value in the count before they see it
+	 * in its bucket.
+	 */
+	class CycleHistogram
+	{
+	public:
+		/*!
+		 * \brief The number of bits of precision of the buckets.
+		 */
+		static constexpr unsigned int subBucketBits = 6;
+
+		/*!
+		 * \brief The number of buckets in the CycleHistogram.
+		 */
+		static constexpr size_t bucketCount = (1 << subBucketBits)
+		    + (32 - subBucketBits) * (1 << (subBucketBits - 1));
+
+		CycleHistogram() = default;
+
+		CycleHistogram(const CycleHistogram&) = delete;
+
+		CycleHistogram& operator=(const CycleHistogram&) = delete;
+
+		/*!
+		 * \brief Count a value.
+		 *
+		 * Must only be called by one thread at a time.
+		 * \param value the value to count
+		 */
+		void record(uint64_t value)
+		{
+			value = std::min<uint64_t>(value, std::numeric_limits<uint32_t>::max());
+			buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+			sum.store(sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+			if (value < min.load(std::memory_order_relaxed))
+			{
+				min.store(value, std::memory_order_relaxed);
+			}
+			if (value > max.load(std::memory_order_relaxed))
+			{
+				max.store(value, std::memory_order_relaxed);
+			}
+			count.fetch_add(1, std::memory_order_release);
+		}
+
+		/*!
+		 * \brief Get the number of values counted.
+		 * \return the number of values
+		 */
+		uint64_t getCount() const { return count.load(std::memory_order_acquire); }
+
+		/*!
+		 * \brief Get the smallest value counted.
+		 * \return the smallest value, or 0 if no value has been counted
+		 */
+		uint64_t getMin() const { return getCount() == 0 ? 0 : min.load(std::memory_order_relaxed); }
+
+		/*!
+		 * \brief Get the largest value counted.
+		 * \return the largest value, or 0 if no value has been counted
+		 */
+		uint64_t getMax() const { return max.load(std::memory_order_relaxed); }
+
+		/*!
+		 * \brief Get the mean of the values counted.
+		 * \return the mean, or 0 if no value has been counted
+		 */
+		double getMean() const
+		{
+			uint64_t currentCount = getCount();
+			if (currentCount == 0)
+			{
+				return 0;
+			}
+			return static_cast<double>(sum.load(std::memory_order_relaxed)) / currentCount;
+		}
+
+		/*!
+		 * \brief Get the value below which the given percentage of the values counted lie.
+		 *
+		 * The result is the largest value that shares a bucket with the exact percentile,
+		 * but never larger than getMax().
+		 * \param percentile the percentage of values, between 0 and 100
+		 * \return the value at the percentile, or 0 if no value has been counted
+		 */
+		uint64_t getValueAtPercentile(double percentile) const
+		{
+			uint64_t currentCount = getCount();
+			if (currentCount == 0)
+			{
+				return 0;
+			}
+			percentile = std::clamp(percentile, 0.0, 100.0);
+			uint64_t wanted = std::max<uint64_t>(
+			    static_cast<uint64_t>(percentile / 100 * currentCount + 0.5), 1); // NOLINT
+			uint64_t seen = 0;
+			for (size_t bucket = 0; bucket < bucketCount; ++bucket)
+			{
+				seen += buckets[bucket].load(std::memory_order_relaxed);
+				if (seen >= wanted)
+				{
+					return std::min(highestValueIn(bucket), getMax());
+				}
+			}
+			return getMax();
+		}
+
+		/*!
+		 * \brief Get the number of values counted in a bucket.
+		 * \param bucket the index of the bucket
+		 * \return the number of values in the bucket
+		 */
+		uint64_t getBucketCount(size_t bucket) const
+		{
+			return buckets.at(bucket).load(std::memory_order_relaxed);
+		}
+
+		/*!
+		 * \brief Get the index of the bucket a value is counted in.
+		 * \param value the value, at most `2^32 - 1`
+		 * \return the index of the bucket
+		 */
+		static constexpr size_t bucketOf(uint64_t value)
+		{
+			constexpr uint64_t linearLimit = 1 << subBucketBits;
+			if (value < linearLimit)
+			{
+				return value;
+			}
+			unsigned int shift = mostSignificantBit(value) - subBucketBits + 1;
+			constexpr uint64_t halfLimit = linearLimit / 2;
+			return linearLimit + (shift - 1) * halfLimit + ((value >> shift) - halfLimit);
+		}
+
+		/*!
+		 * \brief Get the smallest value that is counted in a bucket.
+		 * \param bucket the index of the bucket
+		 * \return the smallest value in the bucket
+		 */
+		static constexpr uint64_t lowestValueIn(size_t bucket)
+		{
+			constexpr uint64_t linearLimit = 1 << subBucketBits;
+			if (bucket < linearLimit)
+			{
+				return bucket;
+			}
+			constexpr uint64_t halfLimit = linearLimit / 2;
+			unsigned int shift = (bucket - linearLimit) / halfLimit + 1;
+			return (halfLimit + (bucket - linearLimit) % halfLimit) << shift;
+		}
+
+		/*!
+		 * \brief Get the largest value that is counted in a bucket.
+		 * \param bucket the index of the bucket
+		 * \return the largest value in the bucket
+		 */
+		static constexpr uint64_t highestValueIn(size_t bucket)
+		{
+			return bucket + 1 < bucketCount ? lowestValueIn(bucket + 1) - 1
+			                                : std::numeric_limits<uint32_t>::max();
+		}
+
+	private:
+		std::array<std::atomic<uint64_t>, bucketCount> buckets{};
+		std::atomic<uint64_t> count = 0;
+		std::atomic<uint64_t> sum = 0;
+		std::atomic<uint64_t> min = std::numeric_limits<uint64_t>::max();
+		std::atomic<uint64_t> max = 0;
+
+		static constexpr unsigned int mostSignificantBit(uint64_t value)
+		{
+			return std::numeric_limits<unsigned long long>::digits - 1 // NOLINT
+			    - __builtin_clzll(value);
+		}
+	};
+} // namespace etherkitten::reader
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+/*!
+ * \file
+ * \brief Defines the CycleTimer class, which lets the realtime loop wait for the start of
+ * its next cycle, and the CycleSchedule it follows.
+ */
+
+#include <cerrno>
+#include <chrono>
+#include <stdexcept>
+
+#include <time.h>
+
+#include <etherkitten/datatypes/time.hpp>
+
+namespace etherkitten::reader
+{
+	/*!
+	 * \brief The CycleSchedule struct describes how often the realtime loop runs and how
+	 * it waits between its cycles.
+	 */
+	struct CycleSchedule
+	{
+		/*!
+		 * \brief The time from the start of one cycle to the start of the next.
+		 */
+		datatypes::TimeStep cycleTime = std::chrono::milliseconds(1);
+
+		/*!
+		 * \brief How long before the start of a cycle to stop sleeping and busy wait instead.
+		 *
+		 * Waking up from sleep takes a moment, so busy waiting for the last few microseconds
+		 * makes the cycles start more precisely at the cost of CPU time.
+		 * With a spin tail as long as the cycle time, the loop never sleeps.
+		 */
+		datatypes::TimeStep spinTail = datatypes::TimeStep(0);
+
+		/*!
+		 * \brief Check whether this CycleSchedule can be followed.
+		 * \return this CycleSchedule
+		 * \exception std::invalid_argument iff the cycle time is not positive or the spin tail
+		 * is negative or longer than the cycle time
+		 */
+		const CycleSchedule& validate() const
+		{
+			if (cycleTime <= datatypes::TimeStep(0))
+			{
+				throw std::invalid_argument("The cycle time must be positive");
+			}
+			if (spinTail < datatypes::TimeStep(0) || spinTail > cycleTime)
+			{
+				throw std::invalid_argument(
+				    "The spin tail must not be negative or longer than the cycle time");
+			}
+			return *this;
+		}
+	};
+
+	/*!
+	 * \brief The CycleTimer class schedules cycles at absolute deadlines.
+	 *
+	 * The cycles start at fixed multiples of the cycle time after the start of the
+	 * CycleTimer, so the time spent in a cycle does not delay the following ones and
+	 * the long-term rate of the cycles is exact.
+	 * If a cycle overruns its deadline, the next one starts immediately. If it overruns by
+	 * more than a whole cycle, the missed cycles are skipped instead of being caught up on
+	 * in a burst.
+	 */
+	class CycleTimer
+	{
+	public:
+		/*!
+		 * \brief Create a new CycleTimer whose first cycle starts now.
+		 * \param schedule the schedule to follow
+		 * \exception std::invalid_argument iff the schedule is invalid, see
+		 * CycleSchedule::validate()
+		 */
+		explicit CycleTimer(CycleSchedule schedule)
+		    : schedule(schedule)
+		    , nextDeadline(datatypes::now())
+		{
+			schedule.validate();
+			nextDeadline += schedule.cycleTime;
+		}
+
+		/*!
+		 * \brief Wait until the next cycle starts.
+		 * \return the number of cycles that were skipped because the current one overran
+		 */
+		size_t waitForNextCycle()
+		{
+			datatypes::TimeStamp current = datatypes::now();
+			if (current >= nextDeadline)
+			{
+				size_t skipped = (current - nextDeadline) / schedule.cycleTime;
+				nextDeadline += (skipped + 1) * schedule.cycleTime;
+				return skipped;
+			}
+			datatypes::TimeStamp wakeUp = nextDeadline - schedule.spinTail;
+			if (current < wakeUp)
+			{
+				sleepUntil(wakeUp);
+			}
+			while (datatypes::now() < nextDeadline)
+			{
+				// Busy waiting for the spin tail
+			}
+			nextDeadline += schedule.cycleTime;
+			return 0;
+		}
+
+		/*!
+		 * \brief Get the schedule this CycleTimer follows.
+		 * \return the schedule
+		 */
+		const CycleSchedule& getSchedule() const { return schedule; }
+
+	private:
+		const CycleSchedule schedule;
+		datatypes::TimeStamp nextDeadline;
+
+		static void sleepUntil(datatypes::TimeStamp time)
+		{
+			// TimeStamps are taken from CLOCK_MONOTONIC, see datatypes::now()
+			auto sinceEpoch = time.time_since_epoch();
+			auto seconds = std::chrono::duration_cast<std::chrono::seconds>(sinceEpoch);
+			timespec deadline{ static_cast<time_t>(seconds.count()),
+				static_cast<long>(
+				    std::chrono::duration_cast<std::chrono::nanoseconds>(sinceEpoch - seconds)
+				        .count()) };
+			// clock_nanosleep returns the error instead of setting errno
+			while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR)
+			{
+			}
+		}
+	};
+} // namespace etherkitten::reader
@@ -21,11 +21,14 @@
  * \brief Defines the DataView, an iterator-like class that steps over a list of LLNodes.
  */
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstring>
 #include <memory>
-#include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <utility>
 #include <variant>
 
 #include <etherkitten/datatypes/datapoints.hpp>
@@ -50,9 +53,50 @@ namespace etherkitten::reader
 		size_t index;
 	};
 
+	/*!
+	 * \brief An index over a list of LLNodes that allows skipping to a point in time
+	 * without walking the list.
+	 * \tparam Type the type of data contained in the list
+	 * \tparam NodeSize the size of the LLNodes
+	 */
+	template<typename Type, size_t NodeSize = 1>
+	class ListIndex
+	{
+	public:
+		virtual ~ListIndex() = default;
+
+		/*!
+		 * \brief Find the location of the first data point in the same minute as the given time.
+		 * \param time the time whose minute to look up
+		 * \return the location of the first data point in that minute, or nothing if the index
+		 * does not know any data point in that minute
+		 */
+		virtual std::optional<ListLocation<Type, NodeSize>> findMinuteStart(
+		    datatypes::TimeStamp time)
+		    = 0;
+
+		/*!
+		 * \brief Find the time the run of equal values that begins at the given location was
+		 * last seen at while its end is not stored yet.
+		 * \param location the location of a data point
+		 * \return the time the run was last seen at, or nothing if the data point is not the
+		 * newest one or its run is not ongoing
+		 */
+		virtual std::optional<datatypes::TimeStamp> findRunEnd(
+		    ListLocation<Type, NodeSize> location)
+		    = 0;
+	};
+
 	/*!
 	 * \brief Implements the AbstractDataView interface for a specific EtherCATDataType.
 	 *
+	 * A DataView must only be moved and read by the thread that owns it. The only exception
+	 * is getTime(), which any thread may call without locking, e.g. to find out which parts
+	 * of a list are still in use.
+	 * A DataView that reaches the newest data point of a list whose run of equal values is
+	 * ongoing, see SearchList::appendChange(), steps to the time that run was last seen at
+	 * next, with the value of the run. So the values it presents reach the newest time the
+	 * list was sampled at.
 	 * Note that Converter<Type, Output> must be a valid instantiation of Converter for
 	 * the type combination to compile.
 	 * \tparam Type the type that the related DataPoints have
@@ -90,15 +134,20 @@ namespace etherkitten::reader
 		 * \param bitLength the length of the desired output in the values
 		 * \param flipBytes whether to flip the bytes of the input for the output on big endian
 		 * hosts
+		 * \param listIndex an index over the list to skip through it with, or nullptr
 		 */
 		DataView(ListLocation<Type, NodeSize> location, datatypes::TimeStep timeStep,
-		    size_t bitOffset, size_t bitLength, bool flipBytes)
+		    size_t bitOffset, size_t bitLength, bool flipBytes,
+		    ListIndex<Type, NodeSize>* listIndex = nullptr)
 		    : node(location.node)
 		    , index(location.index)
+		    , currentTime(location.node->times[location.index])
+		    , locationTime(location.node->times[location.index])
 		    , timeStep(timeStep)
 		    , bitOffset(bitOffset)
 		    , bitLength(bitLength)
 		    , flipBytes(flipBytes)
+		    , listIndex(listIndex)
 		{
 		}
 
@@ -127,15 +176,20 @@ namespace etherkitten::reader
 		 * \param bitLength the length of the desired output in the values
 		 * \param flipBytes whether to flip the bytes of the input for the output on big endian
 		 * hosts
+		 * \param listIndex an index over the list to skip through it with, or nullptr
 		 */
 		DataView(std::atomic<LLNode<Type, NodeSize>*>* head, datatypes::TimeStep timeStep,
-		    size_t bitOffset, size_t bitLength, bool flipBytes)
+		    size_t bitOffset, size_t bitLength, bool flipBytes,
+		    ListIndex<Type, NodeSize>* listIndex = nullptr)
 		    : node(head)
 		    , index(0)
+		    , currentTime(emptyTime)
+		    , locationTime(datatypes::TimeStamp::max())
 		    , timeStep(timeStep)
 		    , bitOffset(bitOffset)
 		    , bitLength(bitLength)
 		    , flipBytes(flipBytes)
+		    , listIndex(listIndex)
 		{
 		}
 
@@ -146,37 +200,11 @@ namespace etherkitten::reader
 				throw std::out_of_range("This DataView is empty");
 			}
 
-			// This fails on bitsets (or does it? further testing required)
-			if constexpr (std::is_arithmetic_v<Type>)
-			{
-				return Converter<Type, double>::shiftAndConvert(
-				    std::get<1>(node)->values[index], bitOffset, bitLength, flipBytes);
-			}
-			else if constexpr (std::is_same<Type, std::unique_ptr<IOMap>>())
-			{
-				if constexpr (datatypes::is_bitset<Output>())
-				{
-					return static_cast<double>(Converter<IOMap*, Output>::shiftAndConvert(
-					    std::get<1>(node)->values[index].get(), bitOffset, bitLength, flipBytes)
-					                               .to_ulong());
-				}
-				else if constexpr (std::is_same<Output, IOMap*>())
-				{
-					return Converter<IOMap*, double>::shiftAndConvert(
-					    std::get<1>(node)->values[index].get(), bitOffset, bitLength, flipBytes);
-				}
-				else
-				{
-					return static_cast<double>(Converter<IOMap*, Output>::shiftAndConvert(
-					    std::get<1>(node)->values[index].get(), bitOffset, bitLength, flipBytes));
-				}
-			}
-			return NAN;
+			return valueAt(std::get<1>(node), index);
 		}
 
 		DataView& operator++() override
 		{
-			std::lock_guard guard(timeMutex);
 			if (node.index() == 0)
 			{
 				LLNode<Type, NodeSize>* cachedPointer
@@ -185,13 +213,23 @@ namespace etherkitten::reader
 				{
 					return *this;
 				}
-				node = cachedPointer;
-				index = 0;
+				moveTo({ cachedPointer, 0 });
 				return *this;
 			}
-			ListLocation next = findNextLocation();
-			node = next.node;
-			index = next.index;
+			auto [from, fromTime] = getPosition();
+			ListLocation<Type, NodeSize> next = findNextLocation(from, fromTime);
+			if (advancesTo(next, from, fromTime))
+			{
+				moveTo(next);
+			}
+			else if (std::optional<datatypes::TimeStamp> runEnd = findRunEnd(next, fromTime))
+			{
+				moveToRunEnd(next, runEnd.value());
+			}
+			else if (!atRunEnd)
+			{
+				moveTo(next);
+			}
 			return *this;
 		}
 
@@ -201,25 +239,99 @@ namespace etherkitten::reader
 			{
 				return (*std::get<0>(node)).load(std::memory_order_acquire) != nullptr;
 			}
-			ListLocation next = findNextLocation();
-			if (timeStep == datatypes::TimeStep(0))
+			auto [from, fromTime] = getPosition();
+			ListLocation<Type, NodeSize> next = findNextLocation(from, fromTime);
+			return advancesTo(next, from, fromTime) || findRunEnd(next, fromTime).has_value();
+		}
+
+		size_t readBatch(double* values, datatypes::TimeStamp* times, size_t max) override
+		{
+			size_t read = 0;
+			if (node.index() == 0)
 			{
-				return (next.node != std::get<1>(node) || next.index != index);
+				LLNode<Type, NodeSize>* cachedPointer
+				    = (*std::get<0>(node)).load(std::memory_order_acquire);
+				if (max == 0 || cachedPointer == nullptr)
+				{
+					return 0;
+				}
+				moveTo({ cachedPointer, 0 });
+				values[read] = valueAt(cachedPointer, 0);
+				times[read] = cachedPointer->times[0];
+				++read;
 			}
-			return (next.node->times[next.index] - std::get<1>(node)->times[index]) >= timeStep;
+			while (read < max)
+			{
+				LLNode<Type, NodeSize>* current = std::get<1>(node);
+				if (timeStep == datatypes::TimeStep(0) && !atRunEnd)
+				{
+					// Copy the rest of the current node in one go
+					size_t count = current->count.load(std::memory_order_acquire);
+					size_t run = std::min(count - 1 - index, max - read);
+					for (size_t i = index + 1; i <= index + run; ++i)
+					{
+						values[read] = valueAt(current, i);
+						times[read] = current->times[i];
+						++read;
+					}
+					if (run > 0)
+					{
+						moveTo({ current, index + run });
+						continue;
+					}
+				}
+				auto [from, fromTime] = getPosition();
+				ListLocation<Type, NodeSize> next = findNextLocation(from, fromTime);
+				if (advancesTo(next, from, fromTime))
+				{
+					moveTo(next);
+				}
+				else if (std::optional<datatypes::TimeStamp> runEnd = findRunEnd(next, fromTime))
+				{
+					moveToRunEnd(next, runEnd.value());
+				}
+				else
+				{
+					break;
+				}
+				values[read] = valueAt(next.node, next.index);
+				times[read] = currentTime.load(std::memory_order_relaxed);
+				++read;
+			}
+			return read;
 		}
 
 		bool isEmpty() const override { return node.index() == 0; }
 
+		/*!
+		 * \brief Get the TimeStamp of the value that is currently pointed to.
+		 *
+		 * Unlike the other methods, this may be called from any thread without locking.
+		 * \return the TimeStamp of the value
+		 * \exception std::out_of_range iff isEmpty() would return true
+		 */
 		datatypes::TimeStamp getTime() override
 		{
-			std::lock_guard guard(timeMutex);
-			if (node.index() == 0)
+			datatypes::TimeStamp time = currentTime.load(std::memory_order_acquire);
+			if (time == emptyTime)
 			{
 				throw std::out_of_range("This DataView is empty");
 			}
 
-			return std::get<1>(node)->times[index];
+			return time;
+		}
+
+		/*!
+		 * \brief Get the TimeStamp of the data point this DataView points into.
+		 *
+		 * It is earlier than getTime() while the DataView is on the end of a run that is not
+		 * stored yet. Like getTime(), this may be called from any thread without locking.
+		 * \return the TimeStamp of the data point, or the maximum TimeStamp if the DataView
+		 * does not point into the list yet
+		 */
+		datatypes::TimeStamp getLocationTime() const
+		{
+			return locationTime.load(std::memory_order_acquire);
 		}
 
 		/*!
@@ -234,10 +346,10 @@ namespace etherkitten::reader
 				throw std::out_of_range("This DataView is empty");
 			}
 
-			if constexpr (std::is_same<Type, std::unique_ptr<IOMap>>())
+			if constexpr (isIOMapStorage)
 			{
 				return Converter<IOMap*, Output>::shiftAndConvert(
-				    std::get<1>(node)->values[index].get(), bitOffset, bitLength, flipBytes);
+				    ioMapAt(std::get<1>(node), index), bitOffset, bitLength, flipBytes);
 			}
 			else
 			{
@@ -247,70 +359,254 @@ namespace etherkitten::reader
 		}
 
 	private:
+		static constexpr bool isIOMapStorage
+		    = std::is_same<Type, std::unique_ptr<IOMap>>() || std::is_same<Type, IOMapSlab>();
+
 		std::variant<std::atomic<LLNode<Type, NodeSize>*>*, LLNode<Type, NodeSize>*> node;
 		size_t index;
+		static constexpr datatypes::TimeStamp emptyTime = datatypes::TimeStamp::min();
+		std::atomic<datatypes::TimeStamp> currentTime;
+		// Differs from currentTime iff the DataView is on the end of an ongoing run
+		std::atomic<datatypes::TimeStamp> locationTime;
+		// Whether the DataView is on the end of the run that begins at its location
+		bool atRunEnd = false;
 		datatypes::TimeStep timeStep;
-		std::mutex timeMutex;
 		size_t bitOffset;
 		size_t bitLength;
 		bool flipBytes;
+		ListIndex<Type, NodeSize>* listIndex;
 
 		/*!
-		 * \brief Find the next location in the list that this DataView would move to.
+		 * \brief Move this DataView to the given location and publish its TimeStamp
+		 * for getTime().
+		 * \param location the location to move to
+		 */
+		void moveTo(ListLocation<Type, NodeSize> location)
+		{
+			node = location.node;
+			index = location.index;
+			atRunEnd = false;
+			locationTime.store(location.node->times[location.index], std::memory_order_release);
+			currentTime.store(location.node->times[location.index], std::memory_order_release);
+		}
+
+		/*!
+		 * \brief Move this DataView to the end of the ongoing run that begins at the given
+		 * location and publish the time of the end for getTime().
 		 *
-		 * If TimeStep is 0, returns the same location it is currently on if there is no next.
-		 * If TimeStep is >0, returns the earliest location after `currentTime + timeStep` if
-		 * available, or the latest location in the list if not.
+		 * The location stays what keeps the list from removing the data point, see
+		 * getLocationTime().
+		 * \param location the location the run begins at
+		 * \param time the time the run was last seen at
+		 */
+		void moveToRunEnd(ListLocation<Type, NodeSize> location, datatypes::TimeStamp time)
+		{
+			node = location.node;
+			index = location.index;
+			atRunEnd = true;
+			locationTime.store(location.node->times[location.index], std::memory_order_release);
+			currentTime.store(time, std::memory_order_release);
+		}
+
+		/*!
+		 * \brief Get the location that follows the given one in the list.
+		 * \param location the location
+		 * \return the following location, or the given one if it is the newest
+		 */
+		static ListLocation<Type, NodeSize> successorOf(ListLocation<Type, NodeSize> location)
+		{
+			if (location.index < location.node->count.load(std::memory_order_acquire) - 1)
+			{
+				return { location.node, location.index + 1 };
+			}
+			LLNode<Type, NodeSize>* nextNode = location.node->next.load(std::memory_order_acquire);
+			return nextNode != nullptr ? ListLocation<Type, NodeSize>{ nextNode, 0 } : location;
+		}
+
+		/*!
+		 * \brief Get the location to search the next one from and the time of the current value.
+		 *
+		 * Once a run that the DataView is on the end of has ended, its last data point follows
+		 * the location of the DataView. If it was last seen at the time of the DataView,
+		 * the DataView is on that data point.
 		 * Must not be called if `node.index() == 0`.
-		 * \return the next location, or the current one, or the latest location (see description)
-		 * \exception std::bad_variant_access if called when `node.index() == 0`.
+		 * \return the location to search from and the time of the current value
 		 */
-		ListLocation<Type, NodeSize> findNextLocation() const
+		std::pair<ListLocation<Type, NodeSize>, datatypes::TimeStamp> getPosition() const
 		{
-			ListLocation<Type, NodeSize> resultLocation{ std::get<1>(node), index };
-			if (timeStep == datatypes::TimeStep(0)
-			    && (index < std::get<1>(node)->count.load(std::memory_order_acquire) - 1
-			           || std::get<1>(node)->next != nullptr))
+			ListLocation<Type, NodeSize> location{ std::get<1>(node), index };
+			if (!atRunEnd)
 			{
-				if (index < std::get<1>(node)->count.load(std::memory_order_acquire) - 1)
-				{
-					++resultLocation.index;
-				}
-				else
-				{
-					resultLocation = { std::get<1>(node)->next.load(std::memory_order_acquire), 0 };
-				}
+				return { location, location.node->times[location.index] };
+			}
+			datatypes::TimeStamp time = currentTime.load(std::memory_order_relaxed);
+			ListLocation<Type, NodeSize> stored = successorOf(location);
+			if ((stored.node != location.node || stored.index != location.index)
+			    && stored.node->times[stored.index] == time)
+			{
+				return { stored, time };
+			}
+			return { location, time };
+		}
+
+		/*!
+		 * \brief Check whether moving to a location found by findNextLocation() advances
+		 * this DataView.
+		 * \param next the location that was found
+		 * \param from the location it was searched from
+		 * \param fromTime the time of the current value
+		 * \retval true iff the DataView advances by moving to next
+		 */
+		bool advancesTo(ListLocation<Type, NodeSize> next, ListLocation<Type, NodeSize> from,
+		    datatypes::TimeStamp fromTime) const
+		{
+			if (timeStep == datatypes::TimeStep(0))
+			{
+				return next.node != from.node || next.index != from.index;
+			}
+			return next.node->times[next.index] - fromTime >= timeStep;
+		}
+
+		/*!
+		 * \brief Find the end of the ongoing run that begins at a location if this DataView
+		 * can step to it.
+		 * \param location the location the run would begin at
+		 * \param fromTime the time of the current value
+		 * \return the time the run was last seen at, or nothing if there is no ongoing run
+		 * or it was not last seen a TimeStep after fromTime
+		 */
+		std::optional<datatypes::TimeStamp> findRunEnd(
+		    ListLocation<Type, NodeSize> location, datatypes::TimeStamp fromTime) const
+		{
+			if (listIndex == nullptr)
+			{
+				return {};
+			}
+			std::optional<datatypes::TimeStamp> runEnd = listIndex->findRunEnd(location);
+			if (!runEnd.has_value() || runEnd.value() <= fromTime
+			    || runEnd.value() - fromTime < timeStep)
+			{
+				return {};
+			}
+			return runEnd;
+		}
+
+		/*!
+		 * \brief Get the IOMap at the given location.
+		 *
+		 * Must only be called if Type stores IOMaps.
+		 * \param at the node the IOMap is in
+		 * \param atIndex the index of the IOMap in the node
+		 * \return a pointer to the IOMap
+		 */
+		static IOMap* ioMapAt(LLNode<Type, NodeSize>* at, size_t atIndex)
+		{
+			if constexpr (std::is_same<Type, IOMapSlab>())
+			{
+				return at->at(atIndex);
 			}
 			else
 			{
-				LLNode<Type, NodeSize>* temp = std::get<1>(node);
-				size_t tempCount = index;
-				datatypes::TimeStamp oldTime = std::get<1>(node)->times[index];
-				auto* nextNode = temp->next.load(std::memory_order_acquire);
-				// Jump nodes until we hit the one that may contain our TimeStamp
-				while (nextNode != nullptr && nextNode->times[0] <= oldTime + timeStep)
+				return at->values[atIndex].get();
+			}
+		}
+
+		/*!
+		 * \brief Get the value at the given location converted to a double.
+		 * \param at the node the value is in
+		 * \param atIndex the index of the value in the node
+		 * \return the value as a double, or NAN if it cannot be converted
+		 */
+		double valueAt(LLNode<Type, NodeSize>* at, size_t atIndex) const
+		{
+			// This fails on bitsets (or does it? further testing required)
+			if constexpr (std::is_arithmetic_v<Type>)
+			{
+				return Converter<Type, double>::shiftAndConvert(
+				    at->values[atIndex], bitOffset, bitLength, flipBytes);
+			}
+			else if constexpr (isIOMapStorage)
+			{
+				if constexpr (std::is_same<Output, IOMap*>())
 				{
-					temp = nextNode;
-					tempCount = 0;
-					nextNode = nextNode->next.load(std::memory_order_acquire);
+					return Converter<IOMap*, double>::shiftAndConvert(
+					    ioMapAt(at, atIndex), bitOffset, bitLength, flipBytes);
 				}
-				// Find largest index in node that is smaller than our TimeStamp
-				while (temp->times[tempCount] < oldTime + timeStep
-				    && tempCount < std::get<1>(node)->count.load(std::memory_order_acquire) - 1)
+				else
 				{
-					++tempCount;
+					return convertIOMapToDouble<Output>(
+					    ioMapAt(at, atIndex), bitOffset, bitLength, flipBytes);
 				}
-				// The first TimeStamp larger than ours may be in the next node
-				if (tempCount == NodeSize - 1 && nextNode != nullptr
-				    && temp->times[tempCount] < oldTime + timeStep)
+			}
+			return NAN;
+		}
+
+		/*!
+		 * \brief Find the next location in the list that this DataView would move to.
+		 *
+		 * If TimeStep is 0, returns the same location it is currently on if there is no next.
+		 * If TimeStep is >0, returns the earliest location after `currentTime + timeStep` if
+		 * available, or the latest location in the list if not.
+		 * Nodes are skipped via the ListIndex if the target lies in a later minute,
+		 * and the target is searched for within a node with an exponential search.
+		 * \param from the location to search from, see getPosition()
+		 * \param fromTime the time of the current value
+		 * \return the next location, or the current one, or the latest location (see description)
+		 */
+		ListLocation<Type, NodeSize> findNextLocation(
+		    ListLocation<Type, NodeSize> from, datatypes::TimeStamp fromTime) const
+		{
+			if (timeStep == datatypes::TimeStep(0))
+			{
+				return successorOf(from);
+			}
+
+			LLNode<Type, NodeSize>* temp = from.node;
+			size_t tempIndex = from.index;
+			datatypes::TimeStamp targetTime = fromTime + timeStep;
+			// Skip straight to the minute of our TimeStamp if it is not the current one
+			if (listIndex != nullptr
+			    && std::chrono::floor<std::chrono::minutes>(targetTime)
+			        > std::chrono::floor<std::chrono::minutes>(from.node->times[from.index]))
+			{
+				std::optional<ListLocation<Type, NodeSize>> minuteStart
+				    = listIndex->findMinuteStart(targetTime);
+				if (minuteStart.has_value())
 				{
-					temp = nextNode;
-					tempCount = 0;
+					temp = minuteStart->node;
+					tempIndex = minuteStart->index;
 				}
-				resultLocation = { temp, tempCount };
 			}
-
-			return resultLocation;
+			auto* nextNode = temp->next.load(std::memory_order_acquire);
+			// Jump nodes until we hit the one that may contain our TimeStamp
+			while (nextNode != nullptr && nextNode->times[0] <= targetTime)
+			{
+				temp = nextNode;
+				tempIndex = 0;
+				nextNode = nextNode->next.load(std::memory_order_acquire);
+			}
+			// Find the first TimeStamp in the node that is not smaller than ours.
+			// Small steps are common, so gallop ahead before searching in the found range.
+			size_t tempCount = temp->count.load(std::memory_order_acquire);
+			size_t lower = tempIndex;
+			size_t upper = tempIndex + 1;
+			while (upper < tempCount && temp->times[upper] < targetTime)
+			{
+				lower = upper;
+				upper = tempIndex + (upper - tempIndex) * 2;
+			}
+			auto* found = std::lower_bound(temp->times.data() + lower,
+			    temp->times.data() + std::min(upper + 1, tempCount), targetTime);
+			if (found != temp->times.data() + tempCount)
+			{
+				return { temp, static_cast<size_t>(found - temp->times.data()) };
+			}
+			// The first TimeStamp larger than ours may be in the next node
+			if (nextNode != nullptr)
+			{
+				return { nextNode, 0 };
+			}
+			return { temp, tempCount - 1 };
 		}
 	};
 } // namespace etherkitten::reader
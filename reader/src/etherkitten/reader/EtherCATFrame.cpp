@@ -20,30 +20,31 @@
 
 namespace etherkitten::reader
 {
-	EtherCATFrameIterator::EtherCATFrameIterator(
-	    EtherCATFrameList* list, size_t startIndex, size_t count)
+	EtherCATFrameIterator::EtherCATFrameIterator(EtherCATFrameList* list)
 	    : list(list)
-	    , nextIndex(startIndex)
-	    , remaining(count)
 	{
 	}
 
 	std::pair<EtherCATFrame*, EtherCATFrameMetaData*> EtherCATFrameIterator::operator*() const
 	{
-		return { &list->list[nextIndex].first, &list->list[nextIndex].second };
+		size_t index = list->selection[position];
+		return { &list->list[index].first, &list->list[index].second };
 	}
 
-	bool EtherCATFrameIterator::hasCompletedLoop() const { return nextIndex == 0; }
+	bool EtherCATFrameIterator::hasCompletedLoop() const
+	{
+		size_t loopStart = list->schedules.size() < list->list.size() ? list->schedules.size() : 0;
+		return list->selection[position] == loopStart;
+	}
 
 	EtherCATFrameIterator& EtherCATFrameIterator::operator++()
 	{
-		if (remaining > 0)
+		if (position < list->selection.size())
 		{
-			nextIndex = (nextIndex + 1) % list->list.size();
-			--remaining;
+			++position;
 		}
 		return *this;
 	}
 
-	bool EtherCATFrameIterator::atEnd() const { return remaining == 0; }
+	bool EtherCATFrameIterator::atEnd() const { return position >= list->selection.size(); }
 } // namespace etherkitten::reader
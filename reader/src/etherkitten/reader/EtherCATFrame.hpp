@@ -23,11 +23,13 @@
 
 #include <array>
 #include <cstdint>
+#include <optional>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include <etherkitten/datatypes/dataobjects.hpp>
+#include <etherkitten/datatypes/time.hpp>
 
 namespace etherkitten::reader
 {
@@ -61,6 +63,9 @@ namespace etherkitten::reader
 	};
 
 	static constexpr uint8_t fprdCommandType = 0x04; /*!< The type specifier for an FPRD PDU */
+	static constexpr uint8_t fpwrCommandType = 0x05; /*!< The type specifier for an FPWR PDU */
+	static constexpr uint8_t lrdCommandType = 0x0A; /*!< The type specifier for an LRD PDU */
+	static constexpr uint8_t lrwCommandType = 0x0C; /*!< The type specifier for an LRW PDU */
 
 	/*!
 	 * \brief This is a placeholder index - SOEM uses the index field of the first PDU to sort
@@ -72,7 +77,9 @@ namespace etherkitten::reader
 	/*!
 	 * \brief The EtherCATPDU struct represents an EtherCAT PDU according to the EtherCAT spec.
 	 *
-	 * See the EtherCAT standard, part 4, page 32 (we only use FPRD PDUs here)
+	 * See the EtherCAT standard, part 4, page 32 (we only use FPRD and LRD PDUs here).
+	 * For LRD PDUs, the slave address and the register address hold the lower and the upper
+	 * half of the logical address.
 	 */
 	struct EtherCATPDU
 	{
@@ -98,10 +105,23 @@ namespace etherkitten::reader
 	 */
 	static constexpr int pduOverhead = sizeof(EtherCATPDU) - sizeof(uint8_t) + sizeof(uint16_t);
 
+	/*!
+	 * \brief The BlockPart struct describes the part of the data of an LRD PDU that holds
+	 * the register block of one of its slaves.
+	 */
+	struct BlockPart
+	{
+		int start; /*!< The first register address of the block */
+		int end; /*!< The register address after the block */
+		size_t dataOffset; /*!< The offset of the part relative to the start of the frame */
+	};
+
 	/*!
 	 * \brief The PDUMetaData struct holds information about the structure of a PDU.
 	 *
 	 * We need this if we don't want to reparse the frames once we receive to get the data out.
+	 * An LRD PDU that reads from several slaves has one PDUMetaData per slave, which share
+	 * the working counter.
 	 */
 	struct PDUMetaData
 	{
@@ -118,6 +138,42 @@ namespace etherkitten::reader
 		 * the EtherCAT frame.
 		 */
 		size_t workingCounterOffset;
+
+		/*!
+		 * \brief The working counter the PDU returns with if all of its slaves answered.
+		 */
+		uint16_t expectedWorkingCounter = 1;
+
+		/*!
+		 * \brief For each slave of an LRD PDU, the part of the data that holds its block,
+		 * so that the block can be read with an FPRD PDU instead.
+		 */
+		std::optional<BlockPart> blockPart;
+	};
+
+	/*!
+	 * \brief The MappedRegisterBlock struct describes a block of registers that an FMMU of
+	 * each of some slaves maps into the logical address space, so that a single LRD PDU
+	 * reads the block from all of them.
+	 *
+	 * The blocks of the slaves follow each other in the logical address space.
+	 */
+	struct MappedRegisterBlock
+	{
+		int start = 0; /*!< The first register address of the block */
+		int end = 0; /*!< The register address after the block */
+		uint32_t logicalAddress = 0; /*!< Where the block of the first slave is mapped to */
+
+		/*!
+		 * \brief The configured addresses of the slaves whose blocks are mapped,
+		 * in the order of their blocks.
+		 */
+		std::vector<uint16_t> slaveConfiguredAddresses;
+
+		/*!
+		 * \brief The index of the FMMU that maps the block of each of these slaves.
+		 */
+		std::vector<uint8_t> fmmus;
 	};
 
 	/*!
@@ -130,34 +186,47 @@ namespace etherkitten::reader
 		std::vector<PDUMetaData> pdus;
 	};
 
+	/*!
+	 * \brief The FrameSchedule struct holds when a frame of registers with a fixed rate
+	 * is read next.
+	 */
+	struct FrameSchedule
+	{
+		datatypes::TimeStep period; /*!< The time between two reads of the frame */
+		datatypes::TimeStamp nextRead; /*!< The time from which on the frame is due */
+	};
+
 	/*!
 	 * \brief The EtherCATFrameList struct holds a list of EtherCAT frames that can be
-	 * scheduled in round-robin-style.
+	 * scheduled.
+	 *
+	 * The first frames of the list read registers with a fixed rate and have a schedule each,
+	 * ordered by the priority of their registers. The remaining frames are scheduled in
+	 * round-robin-style.
 	 */
 	struct EtherCATFrameList
 	{
-		size_t nextIndex = 0; /*!< The next frame in the RR scheduler */
+		size_t nextIndex = 0; /*!< The next frame in the RR scheduler, after the scheduled ones */
 		std::vector<std::pair<EtherCATFrame, EtherCATFrameMetaData>> list;
+		std::vector<FrameSchedule> schedules; /*!< The schedules of the first frames */
+		std::vector<size_t> selection; /*!< The indices of the frames the last iterator visits */
 	};
 
 	/*!
-	 * \brief The EtherCATFrameIterator class iterates over a set range of EtherCAT frames
-	 * once.
+	 * \brief The EtherCATFrameIterator class iterates over the selected EtherCAT frames
+	 * of a list once.
 	 */
 	class EtherCATFrameIterator
 	{
 	public:
 		/*!
-		 * \brief Construct a new EtherCATFrameIterator that iterates over the given
-		 * range of EtherCAT frames.
+		 * \brief Construct a new EtherCATFrameIterator that iterates over the frames
+		 * in the selection of the given list.
 		 *
-		 * If `startIndex + count > list->list.size()`, the iterator will wrap around
-		 * to the start fo the list.
+		 * The selection must not change while the iterator is used.
 		 * \param list the list to iterate over
-		 * \param startIndex the index to start iterating on
-		 * \param count the number of frames to iterate over (including the first)
 		 */
-		EtherCATFrameIterator(EtherCATFrameList* list, size_t startIndex, size_t count);
+		explicit EtherCATFrameIterator(EtherCATFrameList* list);
 
 		/*!
 		 * \brief Get the EtherCAT frame this iterator is on with metadata.
@@ -166,12 +235,12 @@ namespace etherkitten::reader
 		std::pair<EtherCATFrame*, EtherCATFrameMetaData*> operator*() const;
 
 		/*!
-		 * \brief Check if this iterator points to the first available register frame.
+		 * \brief Check if this iterator points to the first register frame of the
+		 * round-robin schedule, or to the first frame if all frames have a fixed rate.
 		 *
 		 * This indicates that all registers have been read by sequential iterators.
 		 * \retval true iff this iterator points to the first register frame
 		 * \retval false iff this iterator does not point to the first register frame
-		 * \exception
 		 */
 		bool hasCompletedLoop() const;
 
@@ -192,8 +261,7 @@ namespace etherkitten::reader
 
 	private:
 		EtherCATFrameList* list;
-		size_t nextIndex;
-		size_t remaining;
+		size_t position = 0;
 	};
 
 } // namespace etherkitten::reader
@@ -70,6 +70,16 @@ namespace etherkitten::reader
 		return errorStatistician->getNewest(errorStatistic);
 	}
 
+	std::unique_ptr<datatypes::AbstractNewestValueView> EtherKitten::getNewest(
+	    const datatypes::CycleStatistic& statistic)
+	{
+		if (!reader)
+		{
+			throw std::logic_error("There is no reader available to get a NewestValueView from");
+		}
+		return reader->getNewest(statistic);
+	}
+
 	std::shared_ptr<datatypes::AbstractDataView> EtherKitten::getView(
 	    const datatypes::PDO& pdo, datatypes::TimeSeries time)
 	{
@@ -101,6 +111,25 @@ namespace etherkitten::reader
 		return errorStatistician->getView(errorStatistic, time);
 	}
 
+	std::shared_ptr<datatypes::AbstractDataView> EtherKitten::getView(
+	    const datatypes::CycleStatistic& statistic, datatypes::TimeSeries time)
+	{
+		if (!reader)
+		{
+			throw std::logic_error("There is no reader available to get a DataView from");
+		}
+		return reader->getView(statistic, time);
+	}
+
+	const CycleHistogram& EtherKitten::getCycleHistogram(datatypes::CycleStatisticType type)
+	{
+		if (!reader)
+		{
+			throw std::logic_error("There is no reader available to get a histogram from");
+		}
+		return reader->getCycleHistogram(type);
+	}
+
 	double EtherKitten::getPDOFrequency()
 	{
 		if (!reader)
@@ -197,6 +226,11 @@ namespace etherkitten::reader
 		return errorStatistician->getErrorStatistic(type, slaveId);
 	}
 
+	const std::vector<datatypes::CycleStatistic>& EtherKitten::getCycleStatistics() const
+	{
+		return cycleStatistics;
+	}
+
 	void EtherKitten::startLogging(std::filesystem::path logFile, datatypes::TimeStamp time)
 	{
 		startLogging(logFile, time, [](int, std::string) {});
@@ -211,6 +245,30 @@ namespace etherkitten::reader
 			    "There is no reader or slave informant available to start a logger with");
 		}
 		logger = std::make_unique<Logger>(*slaveInfo, *reader, getErrors(), std::move(logFile), std::move(progressFunction));
+		logger->setEncodeChunks(true);
+		logger->startLog(time);
+	}
+
+	void EtherKitten::startRotatingLog(std::filesystem::path logFile, datatypes::TimeStamp time,
+	    uint64_t maximumSegmentSize, datatypes::TimeStep maximumSegmentDuration)
+	{
+		startRotatingLog(std::move(logFile), time, maximumSegmentSize, maximumSegmentDuration,
+		    [](int, std::string) {});
+	}
+
+	void EtherKitten::startRotatingLog(std::filesystem::path logFile, datatypes::TimeStamp time,
+	    uint64_t maximumSegmentSize, datatypes::TimeStep maximumSegmentDuration,
+	    std::function<void(int, std::string)> progressFunction)
+	{
+		if (!reader || !slaveInfo)
+		{
+			throw std::logic_error(
+			    "There is no reader or slave informant available to start a logger with");
+		}
+		logger = std::make_unique<Logger>(
+		    *slaveInfo, *reader, getErrors(), std::move(logFile), std::move(progressFunction));
+		logger->setEncodeChunks(true);
+		logger->setRotation(maximumSegmentSize, maximumSegmentDuration);
 		logger->startLog(time);
 	}
 
@@ -223,6 +281,36 @@ namespace etherkitten::reader
 		logger->stopLog();
 	}
 
+	void EtherKitten::startCapture(std::filesystem::path logFile, CaptureSettings settings)
+	{
+		startCapture(std::move(logFile), std::move(settings), [](int, std::string) {});
+	}
+
+	void EtherKitten::startCapture(std::filesystem::path logFile, CaptureSettings settings,
+	    std::function<void(int, std::string)> progressFunction)
+	{
+		if (!reader || !slaveInfo)
+		{
+			throw std::logic_error(
+			    "There is no reader or slave informant available to start a capture with");
+		}
+		logger = std::make_unique<Logger>(
+		    *slaveInfo, *reader, getErrors(), std::move(logFile), std::move(progressFunction));
+		logger->setEncodeChunks(true);
+		// Data older than the time in front of an incident is never written
+		datatypes::TimeStamp start = datatypes::now() - settings.preTrigger;
+		logger->startCapture(start, std::move(settings));
+	}
+
+	void EtherKitten::triggerCapture()
+	{
+		if (!logger)
+		{
+			throw std::logic_error("There is no capture available to trigger");
+		}
+		logger->trigger();
+	}
+
 	void EtherKitten::clearMembers()
 	{
 		errorStatistician.reset();
@@ -273,10 +361,22 @@ namespace etherkitten::reader
 			queues->postError(std::move(error));
 		}
 		reader = std::make_unique<BusReader>(dynamic_cast<BusSlaveInformant&>(*slaveInfo),
-		    dynamic_cast<BusQueues&>(*queues), toRead);
+		    dynamic_cast<BusQueues&>(*queues), toRead, cycleSchedule, busOptions);
 		messageProxy = std::make_unique<QueueCacheProxy>(std::move(queues));
 		errorStatistician = std::make_unique<ErrorStatistician>(*slaveInfo, *reader);
 		setMaximumMemory(maxMemorySize);
+		reader->setRegisterRunLengthStorage(registerRunLengthStorage);
+	}
+
+	std::vector<datatypes::CycleStatistic> EtherKitten::createCycleStatistics()
+	{
+		std::vector<datatypes::CycleStatistic> statistics;
+		statistics.reserve(datatypes::cycleStatisticTypeCount);
+		for (size_t i = 0; i < datatypes::cycleStatisticTypeCount; ++i)
+		{
+			statistics.emplace_back(static_cast<datatypes::CycleStatisticType>(i));
+		}
+		return statistics;
 	}
 
 #ifdef ENABLE_MOCKS
@@ -313,6 +413,32 @@ namespace etherkitten::reader
 	void EtherKitten::loadLog(std::filesystem::path logFile,
 	    std::function<void(int, std::string)> initializationProgressFunction,
 	    std::function<void(int, std::string)> readingProgressFunction)
+	{
+		openLog(logFile, std::move(initializationProgressFunction),
+		    std::move(readingProgressFunction), LogLoading::WINDOWED);
+	}
+
+	void EtherKitten::replayLog(std::filesystem::path logFile,
+	    std::function<void(int, std::string)> initializationProgressFunction,
+	    std::function<void(int, std::string)> readingProgressFunction)
+	{
+		openLog(logFile, std::move(initializationProgressFunction),
+		    std::move(readingProgressFunction), LogLoading::REPLAY);
+	}
+
+	ReplayClock& EtherKitten::getReplayClock()
+	{
+		auto* logReader = dynamic_cast<LogReader*>(reader.get());
+		if (!logReader || logReader->getLoading() != LogLoading::REPLAY)
+		{
+			throw std::logic_error("There is no log that is replayed");
+		}
+		return logReader->getReplayClock();
+	}
+
+	void EtherKitten::openLog(std::filesystem::path logFile,
+	    std::function<void(int, std::string)> initializationProgressFunction,
+	    std::function<void(int, std::string)> readingProgressFunction, LogLoading loading)
 	{
 		clearMembers();
 		slaveInfo = std::make_unique<LogSlaveInformant>(
@@ -324,9 +450,10 @@ namespace etherkitten::reader
 			logCache->postError(std::move(errorMessage));
 		}
 		reader = std::make_unique<LogReader>(logFile, dynamic_cast<LogSlaveInformant&>(*slaveInfo),
-		    dynamic_cast<LogCache&>(*logCache), std::move(readingProgressFunction));
+		    dynamic_cast<LogCache&>(*logCache), std::move(readingProgressFunction), loading);
 		errorStatistician = std::make_unique<ErrorStatistician>(*slaveInfo, *reader);
 		setMaximumMemory(maxMemorySize);
+		reader->setRegisterRunLengthStorage(registerRunLengthStorage);
 	}
 
 	void EtherKitten::stopReadingLog()
@@ -349,6 +476,17 @@ namespace etherkitten::reader
 		reader->changeRegisterSettings(toRead);
 	}
 
+	void EtherKitten::changeRegisterRates(
+	    const std::unordered_map<datatypes::RegisterEnum, RegisterRate>& rates)
+	{
+		auto* busReader = dynamic_cast<BusReader*>(reader.get());
+		if (!busReader)
+		{
+			throw std::logic_error("There is no bus connected to change the register rates of");
+		}
+		busReader->changeRegisterRates(rates);
+	}
+
 	void EtherKitten::toggleBusSafeOp()
 	{
 		if (!reader)
@@ -367,6 +505,17 @@ namespace etherkitten::reader
 		return reader->getBusMode();
 	}
 
+	void EtherKitten::setCycleSchedule(CycleSchedule schedule)
+	{
+		cycleSchedule = schedule.validate();
+	}
+
+	CycleSchedule EtherKitten::getCycleSchedule() const { return cycleSchedule; }
+
+	void EtherKitten::setBusOptions(BusOptions options) { busOptions = options; }
+
+	BusOptions EtherKitten::getBusOptions() const { return busOptions; }
+
 	void EtherKitten::setMaximumMemory(size_t size)
 	{
 		maxMemorySize = size;
@@ -378,6 +527,15 @@ namespace etherkitten::reader
 		}
 	}
 
+	void EtherKitten::setRegisterRunLengthStorage(bool enabled)
+	{
+		registerRunLengthStorage = enabled;
+		if (reader)
+		{
+			reader->setRegisterRunLengthStorage(enabled);
+		}
+	}
+
 	void EtherKitten::updateCoEObject(const datatypes::CoEObject& object,
 	    std::shared_ptr<datatypes::AbstractDataPoint>&& value, bool readRequest)
 	{
@@ -27,8 +27,10 @@
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include <etherkitten/datatypes/SlaveInfo.hpp>
+#include <etherkitten/datatypes/dataobjects.hpp>
 #include <etherkitten/datatypes/datapoints.hpp>
 #include <etherkitten/datatypes/dataviews.hpp>
 #include <etherkitten/datatypes/errors.hpp>
@@ -40,9 +42,12 @@
 #include <etherkitten/mocks/slaveinformantmock.hpp>
 #endif
 
+#include "BusOptions.hpp"
 #include "BusQueues.hpp"
 #include "BusReader.hpp"
 #include "BusSlaveInformant.hpp"
+#include "CycleHistogram.hpp"
+#include "CycleTimer.hpp"
 #include "ErrorStatistician.hpp"
 #include "LogCache.hpp"
 #include "LogReader.hpp"
@@ -100,6 +105,15 @@ namespace etherkitten::reader
 		std::unique_ptr<datatypes::AbstractNewestValueView> getNewest(
 		    const datatypes::ErrorStatistic& errorStatistic);
 
+		/*!
+		 * \brief Get a view of the newest known value of the given cycle statistic
+		 * \param statistic is the object to which the value relates
+		 * \return a view of the newest known value of the given cycle statistic
+		 * \exception std::logic_error iff no bus or log is currently available
+		 */
+		std::unique_ptr<datatypes::AbstractNewestValueView> getNewest(
+		    const datatypes::CycleStatistic& statistic);
+
 		/*!
 		 * \brief Get a view of the given PDO object which follows the given time step
 		 * \param pdo is the object to which the view relates
@@ -130,6 +144,27 @@ namespace etherkitten::reader
 		std::shared_ptr<datatypes::AbstractDataView> getView(
 		    const datatypes::ErrorStatistic& errorStatistic, datatypes::TimeSeries time);
 
+		/*!
+		 * \brief Get a view of the given cycle statistic which follows the given time step
+		 * \param statistic is the object to which the view relates
+		 * \param time is the time step which the view follows
+		 * \return a view of the given cycle statistic which follows the given time step
+		 * \exception std::logic_error iff no bus or log is currently available
+		 */
+		std::shared_ptr<datatypes::AbstractDataView> getView(
+		    const datatypes::CycleStatistic& statistic, datatypes::TimeSeries time);
+
+		/*!
+		 * \brief Get the histogram of all values of the given cycle statistic type
+		 *
+		 * The histogram can be used to get percentiles of the timing of the cycles,
+		 * e.g. the worst-case jitter, over the whole time the bus has been read.
+		 * \param type is the type of the cycle statistic
+		 * \return the histogram of the values of the given type
+		 * \exception std::logic_error iff no bus or log is currently available
+		 */
+		const CycleHistogram& getCycleHistogram(datatypes::CycleStatisticType type);
+
 		/*!
 		 * \brief Get the frequency (in Hz) at which the PDO objects are currently being read
 		 * \return the frequency (in Hz) at which the PDO objects are currently being read
@@ -222,8 +257,19 @@ namespace etherkitten::reader
 		datatypes::ErrorStatistic& getErrorStatistic(
 		    datatypes::ErrorStatisticType type, unsigned int slaveId);
 
+		/*!
+		 * \brief Get the CycleStatistics, one of every CycleStatisticType.
+		 *
+		 * They are ordered by their type and stay the same for the whole lifetime
+		 * of this EtherKitten, even if no bus or log is available.
+		 * \return the CycleStatistics of the realtime loop
+		 */
+		const std::vector<datatypes::CycleStatistic>& getCycleStatistics() const;
+
 		/*!
 		 * \brief Start the logging of all available data after the given time in the given file.
+		 *
+		 * The log is written with encoded chunks, see LogHeaderBlock.
 		 * \param logFile is the path of the file where the data is written to
 		 * \param time is the TimeStamp starting at which the data will be logged
 		 * \exception std::logic_error iff no bus or log is currently available
@@ -244,6 +290,40 @@ namespace etherkitten::reader
 		void startLogging(std::filesystem::path logFile, datatypes::TimeStamp time,
 		    std::function<void(int, std::string)> progressFunction);
 
+		/*!
+		 * \brief Start logging like startLogging() but split the log into segments, so it can
+		 * be written for a long time without attendance.
+		 *
+		 * The given file becomes a manifest that lists the segments and can be opened like
+		 * a log, see Logger::setRotation().
+		 * \param logFile is the path of the manifest, from which the paths of the segments
+		 * are derived
+		 * \param time is the TimeStamp starting at which the data will be logged
+		 * \param maximumSegmentSize the size of a segment in bytes, 0 for no limit
+		 * \param maximumSegmentDuration the time span of the data in a segment, 0 for no limit
+		 * \exception std::logic_error iff no bus or log is currently available
+		 * \exception std::invalid_argument iff maximumSegmentDuration is negative
+		 */
+		void startRotatingLog(std::filesystem::path logFile, datatypes::TimeStamp time,
+		    uint64_t maximumSegmentSize, datatypes::TimeStep maximumSegmentDuration);
+
+		/*!
+		 * \brief Start a rotating log like startRotatingLog() and report the progress
+		 * and the failures of writing the log by calling the progressFunction
+		 * with an integer between 0 and 100 and a message.
+		 * \param logFile is the path of the manifest, from which the paths of the segments
+		 * are derived
+		 * \param time is the TimeStamp starting at which the data will be logged
+		 * \param maximumSegmentSize the size of a segment in bytes, 0 for no limit
+		 * \param maximumSegmentDuration the time span of the data in a segment, 0 for no limit
+		 * \param progressFunction a function that is called to report progress and failures
+		 * \exception std::logic_error iff no bus or log is currently available
+		 * \exception std::invalid_argument iff maximumSegmentDuration is negative
+		 */
+		void startRotatingLog(std::filesystem::path logFile, datatypes::TimeStamp time,
+		    uint64_t maximumSegmentSize, datatypes::TimeStep maximumSegmentDuration,
+		    std::function<void(int, std::string)> progressFunction);
+
 		/*!
 		 * \brief Stop logging.
 		 *
@@ -253,6 +333,37 @@ namespace etherkitten::reader
 		 */
 		void stopLogging();
 
+		/*!
+		 * \brief Start capturing incidents instead of logging all data.
+		 *
+		 * Every incident is written to its own log next to the given file,
+		 * see Logger::startCapture(). The capture is stopped with stopLogging().
+		 * \param logFile is the path from which the paths of the logs of the incidents
+		 * are derived
+		 * \param settings how much data to write around which incidents
+		 * \exception std::logic_error iff no bus or log is currently available
+		 */
+		void startCapture(std::filesystem::path logFile, CaptureSettings settings);
+
+		/*!
+		 * \brief Start capturing incidents like startCapture() and report the progress
+		 * and the failures of writing the logs by calling the progressFunction
+		 * with an integer between 0 and 100 and a message.
+		 * \param logFile is the path from which the paths of the logs of the incidents
+		 * are derived
+		 * \param settings how much data to write around which incidents
+		 * \param progressFunction a function that is called to report progress and failures
+		 * \exception std::logic_error iff no bus or log is currently available
+		 */
+		void startCapture(std::filesystem::path logFile, CaptureSettings settings,
+		    std::function<void(int, std::string)> progressFunction);
+
+		/*!
+		 * \brief Capture an incident now.
+		 * \exception std::logic_error iff no capture has been started
+		 */
+		void triggerCapture();
+
 		/*!
 		 * \brief Start the operation of the library with the bus that is connected to the given
 		 * network interface.
@@ -337,6 +448,8 @@ namespace etherkitten::reader
 		 * integer between 0 and 100 representing its percentual progress and a string message
 		 * containing more detailed information on the current progress.
 		 *
+		 * Logs with a chunk index are loaded windowed, see LogLoading.
+		 *
 		 * \param logFile the logfile path
 		 * \param initializationProgressFunction a function that is called to report progress
 		 * \param readingProgressFunction a function that is called to report progress
@@ -346,6 +459,27 @@ namespace etherkitten::reader
 		    std::function<void(int, std::string)> initializationProgressFunction,
 		    std::function<void(int, std::string)> readingProgressFunction);
 
+		/*!
+		 * \brief Start the operation of the library with the given log like loadLog(), but
+		 * replay its data at the pace it was recorded at, like the data of a bus.
+		 *
+		 * The replay is controlled with getReplayClock().
+		 * \param logFile the logfile path
+		 * \param initializationProgressFunction a function that is called to report progress
+		 * \param readingProgressFunction a function that is called to report progress
+		 * \exception SlaveInformantError if an unrecoverable error occurs while loading the log
+		 */
+		void replayLog(std::filesystem::path logFile,
+		    std::function<void(int, std::string)> initializationProgressFunction,
+		    std::function<void(int, std::string)> readingProgressFunction);
+
+		/*!
+		 * \brief Get the ReplayClock of the log that is replayed.
+		 * \exception std::logic_error iff no log is currently replayed
+		 * \return the ReplayClock
+		 */
+		ReplayClock& getReplayClock();
+
 		/*!
 		 * \brief Stop reading the currently open log.
 		 * \exception std::logic_error iff no log is currently available
@@ -359,6 +493,18 @@ namespace etherkitten::reader
 		 */
 		void changeRegisterSettings(std::unordered_map<datatypes::RegisterEnum, bool>& toRead);
 
+		/*!
+		 * \brief Change how often the registers are read from the bus.
+		 *
+		 * Until this is called, the rates of getDefaultRegisterRates() are used.
+		 * \param rates the rates of the registers, registers without one are read
+		 * as often as the cycles leave room for
+		 * \exception std::logic_error iff no bus is currently connected
+		 * \exception std::invalid_argument iff a frequency is negative or not finite
+		 */
+		void changeRegisterRates(
+		    const std::unordered_map<datatypes::RegisterEnum, RegisterRate>& rates);
+
 		/*!
 		 * \brief Force all the slaves of the connected bus to toggle their bus status from either
 		 * OP to SafeOp or the other way around related to their current status.
@@ -378,6 +524,46 @@ namespace etherkitten::reader
 		 */
 		void setMaximumMemory(size_t size);
 
+		/*!
+		 * \brief Set whether registers are stored as runs of equal values.
+		 *
+		 * Only the first and the last sample of every run are kept then, which lets the
+		 * memory hold a much longer history of registers that rarely change.
+		 * This applies to the current and all future readers.
+		 * \param enabled whether to store runs of register values
+		 */
+		void setRegisterRunLengthStorage(bool enabled);
+
+		/*!
+		 * \brief Set the schedule that the realtime loop follows when reading from a bus.
+		 *
+		 * The schedule takes effect the next time a bus is connected.
+		 * \param schedule the cycle time and spin tail of the realtime loop
+		 * \exception std::invalid_argument iff the schedule is invalid, see
+		 * CycleSchedule::validate()
+		 */
+		void setCycleSchedule(CycleSchedule schedule);
+
+		/*!
+		 * \brief Get the schedule that the realtime loop follows when reading from a bus.
+		 * \return the schedule of the realtime loop
+		 */
+		CycleSchedule getCycleSchedule() const;
+
+		/*!
+		 * \brief Set the ways of reading a bus that the realtime loop may use.
+		 *
+		 * The options take effect the next time a bus is connected.
+		 * \param options the ways of reading the bus to use
+		 */
+		void setBusOptions(BusOptions options);
+
+		/*!
+		 * \brief Get the ways of reading a bus that the realtime loop may use.
+		 * \return the ways of reading the bus
+		 */
+		BusOptions getBusOptions() const;
+
 		/*!
 		 * \brief Get a TimeStamp that is earlier than all DataPoints offered by this Reader.
 		 *
@@ -390,12 +576,18 @@ namespace etherkitten::reader
 	private:
 		void clearMembers();
 
+		void openLog(std::filesystem::path logFile,
+		    std::function<void(int, std::string)> initializationProgressFunction,
+		    std::function<void(int, std::string)> readingProgressFunction, LogLoading loading);
+
 		void updateCoEObject(const datatypes::CoEObject& object,
 		    std::shared_ptr<datatypes::AbstractDataPoint>&& value, bool readRequest);
 
 		void connectCommonBusComponents(std::unordered_map<datatypes::RegisterEnum, bool>& toRead,
 		    std::vector<datatypes::ErrorMessage> errors);
 
+		static std::vector<datatypes::CycleStatistic> createCycleStatistics();
+
 		static constexpr float errorStatisticianMemoryProportion = 0.10;
 
 		std::unique_ptr<SlaveInformant> slaveInfo;
@@ -406,5 +598,9 @@ namespace etherkitten::reader
 		std::unique_ptr<Logger> logger;
 		std::unique_ptr<ErrorStatistician> errorStatistician;
 		size_t maxMemorySize = 0;
+		bool registerRunLengthStorage = false;
+		CycleSchedule cycleSchedule;
+		BusOptions busOptions;
+		const std::vector<datatypes::CycleStatistic> cycleStatistics = createCycleStatistics();
 	};
 } // namespace etherkitten::reader
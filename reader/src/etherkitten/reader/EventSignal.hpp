@@ -0,0 +1,108 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+/*!
+ * \file
+ * \brief Defines the EventSignal class, which lets one thread sleep until another one
+ * signals it.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <etherkitten/datatypes/time.hpp>
+
+namespace etherkitten::reader
+{
+	/*!
+	 * \brief The EventSignal class lets a single waiting thread sleep until any number of
+	 * other threads signal it.
+	 *
+	 * Signaling never blocks and only enters the kernel if the waiting thread is actually
+	 * asleep, so it is safe to use from a realtime thread.
+	 * Each signal increments a sequence number. A waiting thread remembers the last
+	 * sequence number it has seen and sleeps until it changes, so no signal can be missed.
+	 */
+	class EventSignal
+	{
+	public:
+		/*!
+		 * \brief Get the current sequence number of this EventSignal.
+		 *
+		 * Everything that happened before a signal with a smaller sequence number
+		 * is visible after this call.
+		 * \return the current sequence number
+		 */
+		uint32_t getSequence() const { return sequence.load(std::memory_order_acquire); }
+
+		/*!
+		 * \brief Signal the waiting thread.
+		 */
+		void signal()
+		{
+			sequence.fetch_add(1, std::memory_order_seq_cst);
+			if (sleeping.load(std::memory_order_seq_cst))
+			{
+				syscall(SYS_futex, futexWord(), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+			}
+		}
+
+		/*!
+		 * \brief Sleep until the sequence number differs from the given one or the timeout
+		 * has passed.
+		 *
+		 * Only one thread may wait on an EventSignal at a time.
+		 * The wait may also end early, e.g. if the thread is interrupted.
+		 * \param seen the last sequence number the caller has seen
+		 * \param timeout the maximum time to sleep for
+		 * \return the current sequence number
+		 */
+		uint32_t waitFor(uint32_t seen, datatypes::TimeStep timeout)
+		{
+			sleeping.store(true, std::memory_order_seq_cst);
+			if (sequence.load(std::memory_order_seq_cst) == seen)
+			{
+				auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+				timespec relativeTimeout{ static_cast<time_t>(seconds.count()),
+					static_cast<long>(
+					    std::chrono::duration_cast<std::chrono::nanoseconds>(timeout - seconds)
+					        .count()) };
+				syscall(SYS_futex, futexWord(), FUTEX_WAIT_PRIVATE, seen, &relativeTimeout,
+				    nullptr, 0);
+			}
+			sleeping.store(false, std::memory_order_relaxed);
+			return getSequence();
+		}
+
+	private:
+		static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t)
+		        && std::atomic<uint32_t>::is_always_lock_free,
+		    "The futex syscall needs a plain 32 bit word");
+
+		std::atomic<uint32_t> sequence = 0;
+		std::atomic<bool> sleeping = false;
+
+		uint32_t* futexWord() { return reinterpret_cast<uint32_t*>(&sequence); } // NOLINT
+	};
+} // namespace etherkitten::reader
@@ -21,6 +21,7 @@
  * \brief Defines the IOMap struct used to hold an instance of SOEM's IOMap.
  */
 
+#include <cstddef>
 #include <cstdint>
 
 namespace etherkitten::reader
@@ -64,4 +65,36 @@ namespace etherkitten::reader
 		void operator delete(void* ptr) { delete[] reinterpret_cast<uint8_t*>(ptr); } // NOLINT
 	};
 
+	/*!
+	 * \brief Tag type for SearchLists that store their IOMaps in contiguous slabs.
+	 *
+	 * An LLNode<IOMapSlab, Size> keeps the data of all of its Size IOMaps in a single buffer
+	 * instead of allocating every IOMap on its own. The IOMaps are laid out back to back
+	 * as proper IOMap structs, so they can be handed out as IOMap* pointing into the slab.
+	 */
+	struct IOMapSlab
+	{
+		/*!
+		 * \brief The number of bytes a slab is allocated with beyond its last IOMap.
+		 *
+		 * The Converter reads IOMaps in 8-byte words plus one overhanging byte, so the end of the
+		 * last IOMap in a slab must be followed by that many readable bytes.
+		 */
+		static constexpr std::size_t padding = sizeof(uint64_t) + 1;
+
+		/*!
+		 * \brief Get the number of bytes one IOMap with the given ioMapSize occupies in a slab.
+		 *
+		 * This includes the ioMapSize header and the padding needed to keep the next IOMap
+		 * in the slab aligned.
+		 * \param ioMapSize the size of the ioMap data area
+		 * \return the size of one slot in a slab
+		 */
+		static constexpr std::size_t getSlotSize(std::size_t ioMapSize)
+		{
+			std::size_t unpadded = offsetof(IOMap, ioMap) + ioMapSize;
+			return (unpadded + alignof(IOMap) - 1) / alignof(IOMap) * alignof(IOMap);
+		}
+	};
+
 } // namespace etherkitten::reader
@@ -23,10 +23,15 @@
 
 #include <array>
 #include <atomic>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
 
 #include <etherkitten/datatypes/datapoints.hpp>
 #include <etherkitten/datatypes/time.hpp>
 
+#include "IOMap.hpp"
+
 namespace etherkitten::reader
 {
 	/*!
@@ -89,4 +94,94 @@ namespace etherkitten::reader
 		{
 		}
 	};
+
+	/*!
+	 * \brief A node of an unrolled singly linked list which stores IOMaps in a single slab.
+	 *
+	 * Instead of an array of separately allocated IOMaps, this node owns one buffer that holds
+	 * all of its IOMaps back to back. All IOMaps in one node must have the same ioMapSize.
+	 * \tparam Size the number of IOMaps to store in one node of the list.
+	 */
+	template<size_t Size>
+	struct LLNode<IOMapSlab, Size>
+	{
+	public:
+		/*!
+		 * \brief The size of the data area of every IOMap in this node.
+		 */
+		const size_t ioMapSize;
+
+		/*!
+		 * \brief The distance in bytes between two consecutive IOMaps in the slab.
+		 */
+		const size_t slotSize;
+
+		/*!
+		 * \brief The buffer holding the IOMaps stored in this node.
+		 */
+		std::unique_ptr<uint8_t[]> slab; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+
+		/*!
+		 * \brief The TimeStamps stored in this node.
+		 */
+		std::array<datatypes::TimeStamp, Size> times;
+
+		/*!
+		 * \brief The next node in the list.
+		 */
+		std::atomic<LLNode<IOMapSlab, Size>*> next{ nullptr };
+
+		/*!
+		 * \brief How many array slots are occupied in this node.
+		 */
+		std::atomic_size_t count;
+
+		/*!
+		 * \brief Construct a new node with a copy of the given IOMap data, timestamp, and successor.
+		 * \param ioMapData the IOMap data to store at position 0 in the node
+		 * \param ioMapSize the size of the IOMap data in bytes
+		 * \param time the TimeStamp to store at position 0 in the node
+		 * \param next the node that should follow this one in the list
+		 */
+		LLNode(const uint8_t* ioMapData, size_t ioMapSize, datatypes::TimeStamp time, LLNode* next)
+		    : ioMapSize(ioMapSize)
+		    , slotSize(IOMapSlab::getSlotSize(ioMapSize))
+		    , slab(new uint8_t[Size * slotSize + IOMapSlab::padding]) // NOLINT
+		    , times({ time })
+		    , next(next)
+		    , count(1)
+		{
+			store(0, ioMapData, ioMapSize);
+		}
+
+		LLNode(const LLNode<IOMapSlab, Size>& other) = delete;
+
+		/*!
+		 * \brief Get the IOMap at the given position in this node.
+		 * \param index the position of the IOMap
+		 * \return a pointer to the IOMap in the slab
+		 */
+		IOMap* at(size_t index) const
+		{
+			return reinterpret_cast<IOMap*>(slab.get() + index * slotSize); // NOLINT
+		}
+
+		/*!
+		 * \brief Copy the given IOMap data into the given position in this node.
+		 * \param index the position to store the IOMap at
+		 * \param ioMapData the IOMap data to copy
+		 * \param ioMapSize the size of the IOMap data in bytes
+		 * \exception std::invalid_argument iff ioMapSize differs from the ioMapSize of this node
+		 */
+		void store(size_t index, const uint8_t* ioMapData, size_t ioMapSize)
+		{
+			if (ioMapSize != this->ioMapSize)
+			{
+				throw std::invalid_argument("All IOMaps in a slab must have the same size");
+			}
+			IOMap* ioMap = at(index);
+			ioMap->ioMapSize = ioMapSize;
+			std::memcpy(ioMap->ioMap, ioMapData, ioMapSize); // NOLINT
+		}
+	};
 } // namespace etherkitten::reader
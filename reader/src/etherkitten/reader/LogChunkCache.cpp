@@ -0,0 +1,263 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "LogChunkCache.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <etherkitten/datatypes/ethercatdatatypes.hpp>
+#include <etherkitten/datatypes/register.hpp>
+
+#include "log/cyclestatistic.hpp"
+#include "log/encodedchunk.hpp"
+#include "log/processdata.hpp"
+
+namespace etherkitten::reader
+{
+	DecodedChunk::DecodedChunk(Serialized& data, size_t ioMapSize)
+	    : ioMapSlotSize(IOMapSlab::getSlotSize(ioMapSize) / sizeof(uint64_t))
+	{
+		decodeBlocks(data, ioMapSize);
+
+		// Converting values from the last IOMap may read a few bytes past it
+		ioMaps.resize(ioMaps.size() + (IOMapSlab::padding + 7) / sizeof(uint64_t));
+		ioMaps.shrink_to_fit();
+		ioMapTimes.shrink_to_fit();
+		memoryUsage = ioMaps.size() * sizeof(uint64_t)
+		    + ioMapTimes.size() * sizeof(datatypes::TimeStamp);
+		for (auto& [key, series] : registers)
+		{
+			series.times.shrink_to_fit();
+			series.values.shrink_to_fit();
+			memoryUsage += sizeof(std::pair<uint32_t, RegisterSeries>)
+			    + series.times.size() * (sizeof(datatypes::TimeStamp) + sizeof(uint64_t));
+		}
+	}
+
+	void DecodedChunk::decodeBlocks(Serialized& data, size_t ioMapSize)
+	{
+		uint64_t offset = 0;
+		while (offset < data.length)
+		{
+			uint32_t ident = data.read<uint32_t>(offset);
+			datatypes::TimeStamp time = datatypes::intToTimeStamp(data.read<uint64_t>(offset + 4));
+			switch (ChunkEntryBlock::getKindOf(ident))
+			{
+			case ChunkEntryBlock::processDataKind:
+			{
+				Serialized block = data.getAt(offset, ProcessDataBlock::headerSize + ioMapSize);
+				size_t slot = ioMaps.size();
+				ioMaps.resize(slot + ioMapSlotSize);
+				IOMap* ioMap = reinterpret_cast<IOMap*>(ioMaps.data() + slot); // NOLINT
+				ioMap->ioMapSize = ioMapSize;
+				memcpy(ioMap->ioMap, block.data + ProcessDataBlock::headerSize, ioMapSize);
+				ioMapTimes.push_back(time);
+				offset += block.length;
+				break;
+			}
+			case ChunkEntryBlock::registerKind:
+			{
+				uint16_t address = (ident & 0xFFFF0000) >> 16;
+				uint16_t slave = ident & 0xFFFF;
+				uint64_t value;
+				auto reg = datatypes::registerMap.find(static_cast<datatypes::RegisterEnum>(address));
+				if (reg == datatypes::registerMap.end())
+				{
+					throw std::runtime_error("unknown register " + std::to_string(address));
+				}
+				size_t byteLength = datatypes::getRegisterByteLength(reg->first);
+				switch (byteLength)
+				{
+				case 1:
+					value = data.read<uint8_t>(offset + 12);
+					break;
+				case 2:
+					value = data.read<uint16_t>(offset + 12);
+					break;
+				case 4:
+					value = data.read<uint32_t>(offset + 12);
+					break;
+				case 8:
+					value = data.read<uint64_t>(offset + 12);
+					break;
+				default:
+					throw std::runtime_error("unexpected register length");
+				}
+				RegisterSeries& series = registers[getRegisterKey(slave, address)];
+				series.times.push_back(time);
+				series.values.push_back(value);
+				offset += 12 + byteLength;
+				break;
+			}
+			case ChunkEntryBlock::cycleStatisticKind:
+				// Cycle statistics are not part of a DecodedChunk
+				offset += CycleStatisticBlock::size;
+				break;
+			case ChunkEntryBlock::encodedChunkKind:
+			{
+				Serialized block = data.getAt(offset, data.read<uint64_t>(offset + 12));
+				Serialized blocks = EncodedChunkBlock::decode(block, ioMapSize);
+				decodeBlocks(blocks, ioMapSize);
+				offset += block.length;
+				break;
+			}
+			default:
+			{
+				// CoE and error blocks store their length after their timestamp
+				uint64_t length = data.read<uint64_t>(offset + 12);
+				if (length < 20)
+				{
+					throw std::runtime_error("unexpected block length");
+				}
+				offset += length;
+				break;
+			}
+			}
+		}
+	}
+
+	const RegisterSeries& DecodedChunk::getRegister(uint32_t key) const
+	{
+		static const RegisterSeries empty;
+		auto series = registers.find(key);
+		return series != registers.end() ? series->second : empty;
+	}
+
+	IOMap* DecodedChunk::getIOMap(size_t index) const
+	{
+		// The IOMaps are only handed out for reading
+		uint64_t* slot = const_cast<uint64_t*>(ioMaps.data()) + index * ioMapSlotSize; // NOLINT
+		return reinterpret_cast<IOMap*>(slot); // NOLINT
+	}
+
+	LogChunkCache::LogChunkCache(
+	    std::filesystem::path logFile, ChunkIndexBlock index, size_t ioMapSize)
+	    : LogChunkCache({ { logFile, std::move(index) } }, ioMapSize)
+	{
+		// A single file is mapped right away, so it is known early whether it can be read
+		segments.front().file = std::make_unique<const MappedFile>(segments.front().path);
+	}
+
+	LogChunkCache::LogChunkCache(
+	    std::vector<std::pair<std::filesystem::path, ChunkIndexBlock>> segments,
+	    size_t ioMapSize)
+	    : index(joinIndices(segments))
+	    , ioMapSize(ioMapSize)
+	{
+		for (size_t i = 0; i < segments.size(); ++i)
+		{
+			chunkSegments.insert(chunkSegments.end(), segments[i].second.getChunks().size(), i);
+			this->segments.push_back({ std::move(segments[i].first), nullptr });
+		}
+	}
+
+	ChunkIndexBlock LogChunkCache::joinIndices(
+	    const std::vector<std::pair<std::filesystem::path, ChunkIndexBlock>>& segments)
+	{
+		std::vector<ChunkEntryBlock> chunks;
+		for (auto& segment : segments)
+		{
+			const std::vector<ChunkEntryBlock>& segmentChunks = segment.second.getChunks();
+			chunks.insert(chunks.end(), segmentChunks.begin(), segmentChunks.end());
+		}
+		return ChunkIndexBlock(std::move(chunks));
+	}
+
+	std::shared_ptr<const DecodedChunk> LogChunkCache::getChunk(size_t chunk)
+	{
+		const char* begin;
+		uint64_t length;
+		{
+			std::lock_guard guard(mutex);
+			auto found = cached.find(chunk);
+			if (found != cached.end())
+			{
+				recentlyUsed.splice(recentlyUsed.begin(), recentlyUsed, found->second.second);
+				return found->second.first;
+			}
+
+			const ChunkEntryBlock& entry = index.getChunks().at(chunk);
+			Segment& segment = segments.at(chunkSegments.at(chunk));
+			if (!segment.file)
+			{
+				segment.file = std::make_unique<const MappedFile>(segment.path);
+			}
+			const MappedFile& file = *segment.file;
+			if (entry.offset > file.getSize() || entry.length > file.getSize() - entry.offset)
+			{
+				throw std::runtime_error("chunk cannot be read from the log");
+			}
+			begin = file.getData() + entry.offset;
+			length = entry.length;
+		}
+
+		// The mapped files stay valid, so chunks are decoded without holding the mutex
+		Serialized data = Serialized::wrap(begin, length);
+		auto decoded = std::make_shared<const DecodedChunk>(data, ioMapSize);
+
+		std::lock_guard guard(mutex);
+		auto found = cached.find(chunk);
+		if (found != cached.end())
+		{
+			// Another thread decoded the same chunk in the meantime
+			recentlyUsed.splice(recentlyUsed.begin(), recentlyUsed, found->second.second);
+			return found->second.first;
+		}
+		recentlyUsed.push_front(chunk);
+		cached.emplace(chunk, std::make_pair(decoded, recentlyUsed.begin()));
+		memoryUsage += decoded->getMemoryUsage();
+		evict();
+		return decoded;
+	}
+
+	void LogChunkCache::setMaximumMemory(size_t size)
+	{
+		std::lock_guard guard(mutex);
+		maximumMemory = size;
+		evict();
+	}
+
+	size_t LogChunkCache::getMemoryUsage()
+	{
+		std::lock_guard guard(mutex);
+		return memoryUsage;
+	}
+
+	size_t LogChunkCache::getCachedChunkCount()
+	{
+		std::lock_guard guard(mutex);
+		return cached.size();
+	}
+
+	/*!
+	 * \brief Drop the least recently used chunks until the memory limit is kept.
+	 *
+	 * The mutex must be held by the caller.
+	 */
+	void LogChunkCache::evict()
+	{
+		while (memoryUsage > maximumMemory && recentlyUsed.size() > 1)
+		{
+			auto leastRecent = cached.find(recentlyUsed.back());
+			memoryUsage -= leastRecent->second.first->getMemoryUsage();
+			cached.erase(leastRecent);
+			recentlyUsed.pop_back();
+		}
+	}
+} // namespace etherkitten::reader
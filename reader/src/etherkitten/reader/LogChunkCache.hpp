@@ -0,0 +1,248 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+/*!
+ * \file
+ * \brief Defines the DecodedChunk, the data of one chunk of a log, and the LogChunkCache,
+ * which decodes chunks from a log file on demand and keeps the recently used ones.
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <etherkitten/datatypes/time.hpp>
+
+#include "IOMap.hpp"
+#include "MappedFile.hpp"
+#include "log/chunkindex.hpp"
+
+namespace etherkitten::reader
+{
+	/*!
+	 * \brief The values of one register of one slave in a DecodedChunk, in the order
+	 * of their TimeStamps.
+	 */
+	struct RegisterSeries
+	{
+		/*!
+		 * \brief The TimeStamps of the values.
+		 */
+		std::vector<datatypes::TimeStamp> times;
+
+		/*!
+		 * \brief The raw values of the register.
+		 */
+		std::vector<uint64_t> values;
+	};
+
+	/*!
+	 * \brief The register values and IOMaps of one chunk of a log.
+	 *
+	 * CoE and error blocks are not decoded, since the LogReader reads them all up front.
+	 * The data blocks of EncodedChunkBlocks are decoded like plain ones.
+	 * A DecodedChunk is not changed after it was decoded.
+	 */
+	class DecodedChunk
+	{
+	public:
+		/*!
+		 * \brief Decode the data blocks of a chunk.
+		 * \param data the data blocks of the chunk
+		 * \param ioMapSize the size of the IOMaps in the ProcessDataBlocks
+		 * \exception std::runtime_error iff the data blocks are malformed
+		 */
+		DecodedChunk(Serialized& data, size_t ioMapSize);
+
+		/*!
+		 * \brief Get the key a RegisterSeries is stored under.
+		 * \param slave the id of the slave of the register
+		 * \param address the address of the register
+		 * \return the key of the RegisterSeries
+		 */
+		static uint32_t getRegisterKey(uint16_t slave, uint16_t address)
+		{
+			return static_cast<uint32_t>(slave) << 16 | address;
+		}
+
+		/*!
+		 * \brief Get the values of a register in this chunk.
+		 * \param key the key of the register, see getRegisterKey()
+		 * \return the values of the register, which are empty iff there are none in this chunk
+		 */
+		const RegisterSeries& getRegister(uint32_t key) const;
+
+		/*!
+		 * \brief Get the values of all registers in this chunk.
+		 * \return the RegisterSeries by their keys, see getRegisterKey()
+		 */
+		const std::unordered_map<uint32_t, RegisterSeries>& getRegisters() const
+		{
+			return registers;
+		}
+
+		/*!
+		 * \brief Get the TimeStamps of the IOMaps in this chunk.
+		 * \return the TimeStamps of the IOMaps
+		 */
+		const std::vector<datatypes::TimeStamp>& getIOMapTimes() const { return ioMapTimes; }
+
+		/*!
+		 * \brief Get an IOMap of this chunk.
+		 * \param index the index of the IOMap in getIOMapTimes()
+		 * \return the IOMap, which must not be written to
+		 */
+		IOMap* getIOMap(size_t index) const;
+
+		/*!
+		 * \brief Get the approximate amount of memory this DecodedChunk takes up.
+		 * \return the memory usage in bytes
+		 */
+		size_t getMemoryUsage() const { return memoryUsage; }
+
+	private:
+		std::unordered_map<uint32_t, RegisterSeries> registers;
+		std::vector<datatypes::TimeStamp> ioMapTimes;
+		// The IOMaps are stored in slots, like in the nodes of a SearchList of IOMapSlab
+		std::vector<uint64_t> ioMaps;
+		size_t ioMapSlotSize;
+		size_t memoryUsage = 0;
+
+		void decodeBlocks(Serialized& data, size_t ioMapSize);
+	};
+
+	/*!
+	 * \brief The LogChunkCache decodes the chunks of an indexed log on demand
+	 * and keeps the least recently used ones up to a memory limit.
+	 *
+	 * The log file is mapped into memory, so chunks are decoded without copying them first.
+	 * A log that is split into segments is seen as one log whose index holds the chunks of
+	 * all segments. A segment is only mapped once one of its chunks is needed.
+	 * The DecodedChunks are handed out as shared pointers, so a chunk that is still in use
+	 * stays valid after it was dropped from the cache.
+	 * All methods may be called from any thread.
+	 */
+	class LogChunkCache
+	{
+	public:
+		/*!
+		 * \brief The memory limit unless a different one is set.
+		 */
+		static constexpr size_t defaultMaximumMemory = 256 * 1024 * 1024;
+
+		/*!
+		 * \brief Create a LogChunkCache for a log.
+		 * \param logFile the log file to read the chunks from
+		 * \param index the ChunkIndexBlock of the log
+		 * \param ioMapSize the size of the IOMaps in the log
+		 * \exception std::runtime_error iff the log file cannot be mapped into memory
+		 */
+		LogChunkCache(std::filesystem::path logFile, ChunkIndexBlock index, size_t ioMapSize);
+
+		/*!
+		 * \brief Create a LogChunkCache for a log that is split into segments.
+		 *
+		 * The chunks of the segments are indexed in the given order.
+		 * \param segments the file and the ChunkIndexBlock of every segment
+		 * \param ioMapSize the size of the IOMaps in the log
+		 */
+		LogChunkCache(std::vector<std::pair<std::filesystem::path, ChunkIndexBlock>> segments,
+		    size_t ioMapSize);
+
+		/*!
+		 * \brief Get the index of the chunks of the log.
+		 *
+		 * The offsets of the chunks are file offsets in their segments.
+		 * \return the ChunkIndexBlock
+		 */
+		const ChunkIndexBlock& getIndex() const { return index; }
+
+		/*!
+		 * \brief Get the file a chunk is stored in.
+		 * \param chunk the index of the chunk in the ChunkIndexBlock
+		 * \return the path of the segment of the chunk
+		 */
+		const std::filesystem::path& getChunkFile(size_t chunk) const
+		{
+			return segments.at(chunkSegments.at(chunk)).path;
+		}
+
+		/*!
+		 * \brief Get the decoded data of a chunk, decoding it if it is not cached.
+		 *
+		 * Several threads may decode different chunks at the same time.
+		 * \param chunk the index of the chunk in the ChunkIndexBlock
+		 * \return the decoded chunk
+		 * \exception std::runtime_error iff the chunk cannot be read
+		 */
+		std::shared_ptr<const DecodedChunk> getChunk(size_t chunk);
+
+		/*!
+		 * \brief Set the amount of memory the cached chunks may take up.
+		 *
+		 * The most recently used chunk is always kept.
+		 * \param size the memory limit in bytes
+		 */
+		void setMaximumMemory(size_t size);
+
+		/*!
+		 * \brief Get the amount of memory the cached chunks take up.
+		 * \return the memory usage in bytes
+		 */
+		size_t getMemoryUsage();
+
+		/*!
+		 * \brief Get the number of chunks that are cached.
+		 * \return the number of cached chunks
+		 */
+		size_t getCachedChunkCount();
+
+	private:
+		/*!
+		 * \brief A file of the log, which is mapped when it is first read.
+		 */
+		struct Segment
+		{
+			std::filesystem::path path;
+			std::unique_ptr<const MappedFile> file;
+		};
+
+		const ChunkIndexBlock index;
+		const size_t ioMapSize;
+		std::vector<Segment> segments;
+		// The index of the segment of every chunk in the index
+		std::vector<size_t> chunkSegments;
+		std::mutex mutex;
+		// Indices of the cached chunks, the most recently used first
+		std::list<size_t> recentlyUsed;
+		std::unordered_map<size_t,
+		    std::pair<std::shared_ptr<const DecodedChunk>, std::list<size_t>::iterator>>
+		    cached;
+		size_t maximumMemory = defaultMaximumMemory;
+		size_t memoryUsage = 0;
+
+		void evict();
+		static ChunkIndexBlock joinIndices(
+		    const std::vector<std::pair<std::filesystem::path, ChunkIndexBlock>>& segments);
+	};
+} // namespace etherkitten::reader
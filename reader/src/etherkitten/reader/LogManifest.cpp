@@ -0,0 +1,75 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "LogManifest.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+#include "MappedFile.hpp"
+#include "endianness.hpp"
+
+namespace etherkitten::reader
+{
+	bool LogManifest::isManifest(const std::filesystem::path& path)
+	{
+		std::ifstream fin(path, std::ios::in | std::ios::binary);
+		uint32_t ident = 0;
+		fin.read(reinterpret_cast<char*>(&ident), sizeof(ident)); // NOLINT
+		return fin && flipBytesIfBigEndianHost(ident) == ManifestBlock::ident;
+	}
+
+	ManifestBlock LogManifest::read(const std::filesystem::path& path)
+	{
+		MappedFile file(path);
+		Serialized ser = file.getSerialized();
+		return ManifestBlock::parse(ser);
+	}
+
+	bool LogManifest::write(const std::filesystem::path& path, const ManifestBlock& manifest)
+	{
+		std::filesystem::path temporary = path;
+		temporary += ".tmp";
+		{
+			Serialized ser = manifest.getSerializer().serialize(manifest);
+			std::ofstream fout(temporary, std::ios::out | std::ios::binary | std::ios::trunc);
+			fout.write(ser.data, ser.length);
+			if (!fout.flush())
+				return false;
+		}
+		std::error_code error;
+		std::filesystem::rename(temporary, path, error);
+		return !error;
+	}
+
+	std::vector<std::filesystem::path> LogManifest::getLogFiles(
+	    const std::filesystem::path& path)
+	{
+		if (!isManifest(path))
+			return { path };
+		ManifestBlock manifest = read(path);
+		std::vector<std::filesystem::path> files;
+		for (auto& segment : manifest.getSegments())
+		{
+			files.push_back(path.parent_path() / segment.fileName);
+		}
+		if (files.empty())
+			throw std::runtime_error("the manifest " + path.string() + " lists no segments");
+		return files;
+	}
+} // namespace etherkitten::reader
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/*!
+ * \file
+ * \brief Defines the LogManifest, which reads and writes the manifests of logs that are
+ * split into segments.
+ */
+
+#include <filesystem>
+#include <vector>
+
+#include "log/manifest.hpp"
+
+namespace etherkitten::reader
+{
+	/*!
+	 * \brief The LogManifest reads and writes manifest files.
+	 *
+	 * A manifest holds a single ManifestBlock and lists the segments of a log that the Logger
+	 * split into several files. Readers open the manifest in place of a log file
+	 * and see the data of all segments as one log.
+	 */
+	class LogManifest
+	{
+	public:
+		/*!
+		 * \brief Check whether a file is a manifest.
+		 * \param path the file to check
+		 * \retval true iff the file can be read and starts like a manifest
+		 */
+		static bool isManifest(const std::filesystem::path& path);
+
+		/*!
+		 * \brief Read a manifest.
+		 * \param path the manifest file
+		 * \return the ManifestBlock of the manifest
+		 * \exception std::runtime_error iff the file cannot be read or is not a manifest
+		 */
+		static ManifestBlock read(const std::filesystem::path& path);
+
+		/*!
+		 * \brief Write a manifest.
+		 *
+		 * The manifest is replaced at once, so readers never see a partial one.
+		 * \param path the manifest file
+		 * \param manifest the ManifestBlock to write
+		 * \retval true iff the manifest was written
+		 */
+		static bool write(const std::filesystem::path& path, const ManifestBlock& manifest);
+
+		/*!
+		 * \brief Get the files a log is stored in.
+		 * \param path a log file or a manifest
+		 * \return the segments listed by the manifest, or just the log file
+		 * \exception std::runtime_error iff the manifest cannot be read or lists no segments
+		 */
+		static std::vector<std::filesystem::path> getLogFiles(const std::filesystem::path& path);
+	};
+} // namespace etherkitten::reader
@@ -18,22 +18,44 @@
 #include "LogReader.hpp"
 
 #include <any>
-#include <fstream>
+#include <stdexcept>
+#include <string>
 
 #include <etherkitten/datatypes/datapoints.hpp>
 #include <etherkitten/datatypes/ethercatdatatypes.hpp>
+#include <etherkitten/datatypes/register.hpp>
 #include <etherkitten/datatypes/time.hpp>
 
 #include "DatatypesSerializer.hpp"
+#include "LogManifest.hpp"
+#include "MappedFile.hpp"
+#include "ParallelChunkDecoder.hpp"
 #include "log/Serialized.hpp"
 #include "log/coedata.hpp"
+#include "log/cyclestatistic.hpp"
+#include "log/encodedchunk.hpp"
 #include "log/error.hpp"
+#include "log/header.hpp"
 #include "log/processdata.hpp"
 #include "log/registerdata.hpp"
 #include "log/slavedetails.hpp"
 
 namespace etherkitten::reader
 {
+	namespace
+	{
+		constexpr uint8_t allKinds = ChunkEntryBlock::processDataKind
+		    | ChunkEntryBlock::registerKind | ChunkEntryBlock::coeKind
+		    | ChunkEntryBlock::errorKind | ChunkEntryBlock::cycleStatisticKind;
+
+		// The kinds of blocks that are not part of a DecodedChunk
+		constexpr uint8_t undecodedKinds = ChunkEntryBlock::coeKind | ChunkEntryBlock::errorKind
+		    | ChunkEntryBlock::cycleStatisticKind;
+
+		// The kinds of blocks that are read completely when loading WINDOWED
+		constexpr uint8_t windowedKinds = ChunkEntryBlock::coeKind | ChunkEntryBlock::errorKind;
+	} // namespace
+
 	LogReader::LogReader(
 	    std::filesystem::path logFile, LogSlaveInformant& slaveInformant, LogCache& logCache)
 	    : LogReader(logFile, slaveInformant, logCache, [](int, std::string) {})
@@ -42,23 +64,127 @@ namespace etherkitten::reader
 
 	LogReader::LogReader(std::filesystem::path logFile, LogSlaveInformant& slaveInformant,
 	    LogCache& logCache, std::function<void(int, std::string)> progressFunction)
+	    : LogReader(logFile, slaveInformant, logCache, progressFunction, LogLoading::COMPLETE)
+	{
+	}
+
+	LogReader::LogReader(std::filesystem::path logFile, LogSlaveInformant& slaveInformant,
+	    LogCache& logCache, std::function<void(int, std::string)> progressFunction,
+	    LogLoading loading)
+	    : LogReader(logFile, slaveInformant, logCache, progressFunction, loading, 0)
+	{
+	}
+
+	LogReader::LogReader(std::filesystem::path logFile, LogSlaveInformant& slaveInformant,
+	    LogCache& logCache, std::function<void(int, std::string)> progressFunction,
+	    LogLoading loading, unsigned int workerCount)
 	    : SearchListReader(getSlaveConfiguredAddresses(slaveInformant.getSlaveCount()),
 	          slaveInformant.getIOMapSize(), slaveInformant.getStartTime())
 	    , logFile(logFile)
 	    , logSlaveInformant(slaveInformant)
 	    , logCache(logCache)
 	    , progressFunction(progressFunction)
-	    , readerThread(new std::thread(&LogReader::initReaderThread, this))
+	    , workerCount(workerCount)
 	{
+		try
+		{
+			logFiles = LogManifest::getLogFiles(logFile);
+		}
+		catch (const std::exception& e)
+		{
+			// The reader thread reports that the log cannot be read
+			logFiles = { logFile };
+		}
+		if (loading == LogLoading::REPLAY)
+		{
+			replayClock = std::make_unique<ReplayClock>();
+		}
+		else if (loading == LogLoading::WINDOWED)
+		{
+			try
+			{
+				chunkCache = openChunkCache();
+			}
+			catch (const std::exception& e)
+			{
+				// The reader thread reports that the log cannot be read
+			}
+		}
+		readerThread = std::make_unique<std::thread>(&LogReader::initReaderThread, this);
 	}
 
 	LogReader::~LogReader()
 	{
 		shouldHalt = true;
+		if (replayClock)
+		{
+			replayClock->stop();
+		}
 		// and wait for it to finish
 		readerThread->join();
 	}
 
+	std::unique_ptr<datatypes::AbstractNewestValueView> LogReader::getNewest(
+	    const datatypes::PDO& pdo)
+	{
+		if (!chunkCache)
+		{
+			return SearchListReader::getNewest(pdo);
+		}
+		return std::make_unique<LogSeriesNewestValueView>(makeSeries(pdo), *chunkCache);
+	}
+
+	std::unique_ptr<datatypes::AbstractNewestValueView> LogReader::getNewest(
+	    const datatypes::Register& reg)
+	{
+		if (!chunkCache)
+		{
+			return SearchListReader::getNewest(reg);
+		}
+		return std::make_unique<LogSeriesNewestValueView>(makeSeries(reg), *chunkCache);
+	}
+
+	std::shared_ptr<datatypes::AbstractDataView> LogReader::getView(
+	    const datatypes::PDO& pdo, datatypes::TimeSeries time)
+	{
+		if (!chunkCache)
+		{
+			return SearchListReader::getView(pdo, time);
+		}
+		return std::make_shared<LogSeriesView>(makeSeries(pdo), *chunkCache, time);
+	}
+
+	std::shared_ptr<datatypes::AbstractDataView> LogReader::getView(
+	    const datatypes::Register& reg, datatypes::TimeSeries time)
+	{
+		if (!chunkCache)
+		{
+			return SearchListReader::getView(reg, time);
+		}
+		return std::make_shared<LogSeriesView>(makeSeries(reg), *chunkCache, time);
+	}
+
+	std::shared_ptr<datatypes::AbstractDataView> LogReader::getRegisterRawDataView(
+	    uint16_t slaveId, uint16_t regId, datatypes::TimeSeries time)
+	{
+		if (!chunkCache)
+		{
+			return SearchListReader::getRegisterRawDataView(slaveId, regId, time);
+		}
+		return std::make_shared<LogSeriesView>(
+		    std::make_shared<RegisterLogSeries<uint64_t>>(slaveId, regId, 0, 0), *chunkCache,
+		    time);
+	}
+
+	void LogReader::setMaximumMemory(size_t size)
+	{
+		SearchListReader::setMaximumMemory(size);
+		if (chunkCache)
+		{
+			chunkCache->setMaximumMemory(size);
+		}
+	}
+
 	datatypes::PDOInfo LogReader::getAbsolutePDOInfo(const datatypes::PDO& pdo)
 	{
 		return logSlaveInformant.busInfo.pdoOffsets.at(pdo);
@@ -78,7 +204,23 @@ namespace etherkitten::reader
 
 	datatypes::BusMode LogReader::getBusMode() { return datatypes::BusMode::READ_ONLY; }
 
-	void LogReader::messageHalt() { shouldHalt = true; }
+	void LogReader::messageHalt()
+	{
+		shouldHalt = true;
+		if (replayClock)
+		{
+			replayClock->stop();
+		}
+	}
+
+	ReplayClock& LogReader::getReplayClock()
+	{
+		if (!replayClock)
+		{
+			throw std::logic_error("the log is not replayed");
+		}
+		return *replayClock;
+	}
 
 	void LogReader::initReaderThread()
 	{
@@ -91,141 +233,400 @@ namespace etherkitten::reader
 			logCache.postError(datatypes::ErrorMessage(
 			    "Log cannot be read. Thread stopped.", datatypes::ErrorSeverity::FATAL));
 		}
+		finishedReading = true;
+		signalNewData();
 	}
 
 	void LogReader::readLog()
 	{
 		ParsingContext parsingContext{ logSlaveInformant, logSlaveInformant.busInfo };
-		std::ifstream fin(logFile, std::ios::in | std::ios::binary);
-		uint64_t fileSize = std::filesystem::file_size(logFile);
-		uint64_t pdoDescOffset;
-		uint64_t dataOffset;
-		{
-			/* Log header
-			 * *---------*------------------------*-------------*------------*
-			 * | Version | PDO description offset | data offset |            |
-			 * |---------|------------------------|-------------|------------|
-			 * | 0 - 7   | 8 - 16                 | 16 - 23     | 24 - 31    |
-			 * *---------*------------------------*-------------*------------*
-			 */
-			Serialized tmp(24);
-			fin.read(tmp.data, 24);
-			pdoDescOffset = tmp.read<uint64_t>(8);
-			dataOffset = tmp.read<uint64_t>(16);
-		}
-
-		fin.seekg(dataOffset);
-		uint64_t off = dataOffset;
+		for (auto& path : logFiles)
+		{
+			if (shouldHalt)
+				break;
+			readLogFile(path, parsingContext);
+		}
+
+		signalNewData();
+		progressFunction(100, "Finished reading logfile");
+	}
+
+	void LogReader::readLogFile(const std::filesystem::path& path, ParsingContext& parsingContext)
+	{
+		MappedFile file(path);
+		Serialized log = file.getSerialized();
+		LogHeaderBlock header = readHeader(log, parsingContext);
+
+		if (chunkCache)
+		{
+			// The other data is decoded from the chunks when it is viewed
+			ChunkIndexBlock index = readChunkIndex(log, header.indexOffset, parsingContext);
+			for (auto& chunk : index.getChunks())
+			{
+				if ((chunk.blockKinds & windowedKinds) != 0)
+				{
+					readDataBlocks(log, parsingContext, chunk.offset, chunk.offset + chunk.length,
+					    windowedKinds);
+				}
+			}
+		}
+		else if (replayClock)
+		{
+			// The chunks are not decoded in parallel, since their blocks must be inserted in order
+			uint64_t end = header.indexOffset == 0 ? log.length : header.indexOffset;
+			readDataBlocks(log, parsingContext, header.dataOffset, end, allKinds);
+		}
+		else if (header.indexOffset == 0)
+		{
+			// Version 1 logs and logs whose Logger did not stop properly have no index
+			readDataBlocks(log, parsingContext, header.dataOffset, log.length, allKinds);
+		}
+		else
+		{
+			ChunkIndexBlock index = readChunkIndex(log, header.indexOffset, parsingContext);
+			readChunks(file, parsingContext, index, header.ioMapSize);
+		}
+		signalNewData();
+	}
+
+	void LogReader::readChunks(const MappedFile& file, ParsingContext& parsingContext,
+	    const ChunkIndexBlock& index, size_t ioMapSize)
+	{
+		Serialized log = file.getSerialized();
+		ParallelChunkDecoder decoder(file, index, ioMapSize, workerCount);
+		for (auto& entry : index.getChunks())
+		{
+			if (shouldHalt)
+				break;
+			std::unique_ptr<const DecodedChunk> chunk = decoder.takeNext();
+			if (!chunk)
+			{
+				readDataBlocks(
+				    log, parsingContext, entry.offset, entry.offset + entry.length, allKinds);
+				continue;
+			}
+			insertChunk(*chunk);
+			if ((entry.blockKinds & undecodedKinds) != 0)
+			{
+				readDataBlocks(log, parsingContext, entry.offset, entry.offset + entry.length,
+				    undecodedKinds);
+			}
+			signalNewData();
+			progressFunction(static_cast<int>((static_cast<double>(entry.offset + entry.length)
+			                                      / log.length)
+			                     * 100.0),
+			    "Reading logfile");
+		}
+	}
+
+	void LogReader::insertChunk(const DecodedChunk& chunk)
+	{
+		const std::vector<datatypes::TimeStamp>& ioMapTimes = chunk.getIOMapTimes();
+		for (size_t i = 0; i < ioMapTimes.size(); ++i)
+		{
+			freeMemoryIfNecessary();
+			IOMap* ioMap = chunk.getIOMap(i);
+			insertIOMap(ioMap->ioMap, ioMap->ioMapSize, datatypes::TimeStamp(ioMapTimes[i]));
+		}
+
+		for (auto& [key, series] : chunk.getRegisters())
+		{
+			uint16_t slave = key >> 16;
+			datatypes::RegisterEnum regId = static_cast<datatypes::RegisterEnum>(key & 0xFFFF);
+			const datatypes::Register* reg;
+			try
+			{
+				reg = &findRegisterObject(slave, regId);
+			}
+			catch (const std::runtime_error& e)
+			{
+				logCache.postError(datatypes::ErrorMessage{
+				    "Reading Register value of unknown Register or slave from log, "
+				        + std::string(e.what()),
+				    datatypes::ErrorSeverity::LOW });
+				continue;
+			}
+			for (size_t i = 0; i < series.values.size(); ++i)
+			{
+				freeMemoryIfNecessary();
+				uint64_t value = series.values[i];
+				datatypes::TimeStamp time = series.times[i];
+				SearchListReader::insertRegister(reg->getRegister(),
+				    reinterpret_cast<uint8_t*>(&value), reg->getSlaveID(), time); // NOLINT
+			}
+		}
+	}
+
+	std::unique_ptr<LogChunkCache> LogReader::openChunkCache()
+	{
+		ParsingContext parsingContext{ logSlaveInformant, logSlaveInformant.busInfo };
+		std::vector<std::pair<std::filesystem::path, ChunkIndexBlock>> segments;
+		uint64_t ioMapSize = 0;
+		for (auto& path : logFiles)
+		{
+			MappedFile file(path);
+			Serialized log = file.getSerialized();
+			LogHeaderBlock header = readHeader(log, parsingContext);
+			if (header.indexOffset == 0)
+			{
+				// The segment that was written last is not indexed if the Logger did not stop
+				return nullptr;
+			}
+			ioMapSize = header.ioMapSize;
+			segments.emplace_back(path, readChunkIndex(log, header.indexOffset, parsingContext));
+		}
+		if (segments.size() == 1)
+		{
+			return std::make_unique<LogChunkCache>(
+			    segments.front().first, std::move(segments.front().second), ioMapSize);
+		}
+		return std::make_unique<LogChunkCache>(std::move(segments), ioMapSize);
+	}
+
+	std::shared_ptr<const LogSeries> LogReader::makeSeries(const datatypes::PDO& pdo)
+	{
+		datatypes::PDOInfo info = getAbsolutePDOInfo(pdo);
+		return datatypes::dataTypeMap<PDOLogSeriesRetriever>.at(pdo.getType())(
+		    info.bitOffset, info.bitLength);
+	}
+
+	std::shared_ptr<const LogSeries> LogReader::makeSeries(const datatypes::Register& reg)
+	{
+		static constexpr int twoByteMask = 0xFFFF;
+		static constexpr int twoByteSize = 16;
+		int registerAsInt = static_cast<int>(reg.getRegister());
+		int registerAddress = registerAsInt & twoByteMask;
+		int bitOffset = (registerAsInt - registerAddress) >> twoByteSize;
+		size_t bitLength = datatypes::registerMap.at(reg.getRegister()).bitLength;
+		return datatypes::dataTypeMap<RegisterLogSeriesRetriever>.at(reg.getType())(
+		    reg.getSlaveID(), registerAddress, bitOffset, bitLength);
+	}
+
+	LogHeaderBlock LogReader::readHeader(Serialized& log, ParsingContext& parsingContext)
+	{
+		if (log.length < 8)
+			throw std::runtime_error("the log header is not valid");
+		uint64_t headerSize = LogHeaderBlock::getSizeOfVersion(log.read<uint64_t>(0));
+		if (headerSize == 0 || headerSize > log.length)
+			throw std::runtime_error("the log header is not valid");
+		Serialized ser = log.getAt(0, headerSize);
+		return LogHeaderBlock::serializer.parseSerialized(ser, parsingContext);
+	}
+
+	ChunkIndexBlock LogReader::readChunkIndex(
+	    Serialized& log, uint64_t indexOffset, ParsingContext& parsingContext)
+	{
+		if (indexOffset > log.length || log.length - indexOffset < ChunkIndexBlock::headerSize)
+			throw std::runtime_error("the chunk index of the log is not valid");
+		uint64_t length = log.read<uint64_t>(indexOffset + 12);
+		if (length < ChunkIndexBlock::headerSize)
+			throw std::runtime_error("the chunk index of the log is not valid");
+		if (length > log.length - indexOffset)
+			throw std::runtime_error("the chunk index of the log is incomplete");
+		Serialized ser = log.getAt(indexOffset, length);
+		return ChunkIndexBlock::serializer.parseSerialized(ser, parsingContext);
+	}
+
+	void LogReader::readDataBlocks(Serialized& log, ParsingContext& parsingContext,
+	    uint64_t begin, uint64_t end, uint8_t kinds)
+	{
+		uint64_t off = begin;
 
 		/*
 		 * After the PDO descriptions the log file contains the data blocks with
-		 * the processdata, register data and CoE data
+		 * the processdata, register data and CoE data.
+		 * They are parsed in place, the log is not copied.
 		 */
-		while (fin.good() && !shouldHalt)
+		while (off < end && !shouldHalt)
 		{
 			freeMemoryIfNecessary();
-			// Buffer for 4 byte identification
-			Serialized tmp(4);
-			fin.read(tmp.data, 4);
+			signalNewData();
+
+			reportProgress(
+			    static_cast<uint64_t>((static_cast<double>(off) / log.length) * 100.0),
+			    "Reading logfile");
 
-			// If reading goes wrong or we are at the end finish
-			if (!fin.good())
+			// The last block of a log whose Logger did not stop properly may be incomplete
+			uint64_t length = getDataBlockLength(log, off, parsingContext);
+			if (length == 0)
 				break;
+			Serialized ser = log.getAt(off, length);
+			off += length;
+			insertDataBlock(ser, parsingContext, kinds);
+		}
+	}
 
-			reportProgress(static_cast<uint64_t>((static_cast<double>(off) / fileSize) * 100.0),
-			    "Reading logfile");
+	uint64_t LogReader::getDataBlockLength(
+	    Serialized& log, uint64_t off, ParsingContext& parsingContext)
+	{
+		// If the identification is incomplete we are at the end
+		if (log.length - off < 4)
+			return 0;
+
+		uint32_t ident = log.read<uint32_t>(off);
+		uint8_t kind = ChunkEntryBlock::getKindOf(ident);
+		uint64_t length;
+		uint64_t minimumLength = 12;
+		switch (kind)
+		{
+		case ChunkEntryBlock::processDataKind:
+			length = 12 + parsingContext.busInfo.ioMapUsedSize;
+			break;
+		case ChunkEntryBlock::coeKind:
+		case ChunkEntryBlock::errorKind:
+		case ChunkEntryBlock::encodedChunkKind:
+			// These blocks store their length after their timestamp
+			length = log.length - off < 20 ? 0 : log.read<uint64_t>(off + 12);
+			minimumLength = kind == ChunkEntryBlock::encodedChunkKind
+			    ? EncodedChunkBlock::headerSize
+			    : 20;
+			break;
+		case ChunkEntryBlock::cycleStatisticKind:
+			length = CycleStatisticBlock::size;
+			break;
+		default:
+		{
+			uint16_t address = (ident & 0xFFFF0000) >> 16;
+			auto reg = datatypes::registerMap.find(static_cast<datatypes::RegisterEnum>(address));
+			if (reg == datatypes::registerMap.end())
+			{
+				throw std::runtime_error("unknown register " + std::to_string(address));
+			}
+			length = 12 + datatypes::getRegisterByteLength(reg->first);
+			break;
+		}
+		}
+		if (length < minimumLength || length > log.length - off)
+			return 0;
+		return length;
+	}
 
-			uint32_t ident = tmp.read<uint32_t>(0);
-			if (((ident & 0xFF000000) >> 24) == 0x80)
+	void LogReader::insertDataBlock(Serialized& ser, ParsingContext& parsingContext, uint8_t kinds)
+	{
+		uint32_t ident = ser.read<uint32_t>(0);
+		uint8_t kind = ChunkEntryBlock::getKindOf(ident);
+		if (kind == ChunkEntryBlock::encodedChunkKind)
+		{
+			insertEncodedChunk(ser, parsingContext, kinds);
+			return;
+		}
+		if ((kinds & kind) == 0)
+			return;
+
+		if (replayClock)
+		{
+			// Announce the data inserted so far, since the next block may not be due for a while
+			signalNewData();
+			// All data blocks store their timestamp after their ident
+			if (!replayClock->waitUntil(datatypes::intToTimeStamp(ser.read<uint64_t>(4))))
+				return;
+		}
+
+		if (kind == ChunkEntryBlock::processDataKind)
+		{
+			// Parse IOMap
+			ProcessDataBlock block
+			    = ProcessDataBlock::serializer.parseSerialized(ser, parsingContext);
+			try
 			{
-				// Parse IOMap
-				uint64_t ioMapSize = parsingContext.busInfo.ioMapUsedSize;
-				Serialized ser(12 + ioMapSize);
-				memcpy(ser.data, tmp.data, 4);
-				fin.read(ser.data + 4, ser.length - 4);
-				ProcessDataBlock block
-				    = ProcessDataBlock::serializer.parseSerialized(ser, parsingContext);
-
-				std::unique_ptr<IOMap> ptr(new (ioMapSize) IOMap{ ioMapSize, {} });
-				std::memcpy(ptr->ioMap, block.data.data, ioMapSize);
-				datatypes::TimeStamp time = datatypes::intToTimeStamp(block.timestamp);
-				insertIOMap(std::move(ptr), std::move(time));
-				off += ser.length;
+				insertIOMap(reinterpret_cast<uint8_t*>(block.data.data), // NOLINT
+				    block.data.length, datatypes::intToTimeStamp(block.timestamp));
 			}
-			else if (((ident & 0xFF000000) >> 24) == 0x90)
+			catch (const std::invalid_argument& e)
 			{
-				// Parse CoE data
-				uint16_t slave = (ident & 0xFFFF);
-				Serialized tmp2(16);
-				fin.read(tmp2.data, 16);
-				uint64_t length = tmp2.read<uint64_t>(8);
-				Serialized ser(length);
-				memcpy(ser.data, tmp.data, 4);
-				memcpy(ser.data + 4, tmp2.data, 16);
-				fin.read(ser.data + 20, length - 20);
-				CoEDataBlock dataBlock
-				    = CoEDataBlock::serializer.parseSerialized(ser, parsingContext);
-				try
-				{
-					insertCoE(findCoEObject(slave, dataBlock.index, dataBlock.subIndex),
-					    dataBlock.timestamp, dataBlock.data);
-				}
-				catch (const std::runtime_error& e)
-				{
-					logCache.postError(datatypes::ErrorMessage{
-					    "Reading CoEObject of unknown CoEObject from log, " + std::string(e.what()),
-					    datatypes::ErrorSeverity::LOW });
-				}
-
-				off += length;
+				logCache.postError(datatypes::ErrorMessage{
+				    "Reading process data of the wrong size from log, " + std::string(e.what()),
+				    datatypes::ErrorSeverity::LOW });
 			}
-			else if (((ident & 0xFF000000) >> 24) == 0xA0)
+		}
+		else if (kind == ChunkEntryBlock::coeKind)
+		{
+			// Parse CoE data
+			uint16_t slave = (ident & 0xFFFF);
+			CoEDataBlock dataBlock
+			    = CoEDataBlock::serializer.parseSerialized(ser, parsingContext);
+			try
 			{
-				// Parse error message
-				Serialized tmp2(16);
-				fin.read(tmp2.data, 16);
-				uint64_t length = tmp2.read<uint64_t>(8);
-				Serialized ser(length);
-				memcpy(ser.data, tmp.data, 4);
-				memcpy(ser.data + 4, tmp2.data, 16);
-				fin.read(ser.data + 20, length - 20);
-				ErrorBlock errorBlock = ErrorBlock::serializer.parseSerialized(ser, parsingContext);
-				logCache.postError(datatypes::ErrorMessage{ std::move(errorBlock.message),
-				                       { errorBlock.getSlave1(), errorBlock.getSlave2() },
-				                       static_cast<datatypes::ErrorSeverity>(errorBlock.severity) },
-				    datatypes::intToTimeStamp(errorBlock.time));
-				off += length;
+				insertCoE(findCoEObject(slave, dataBlock.index, dataBlock.subIndex),
+				    dataBlock.timestamp, dataBlock.data);
 			}
-			else
+			catch (const std::runtime_error& e)
 			{
-				// Parse register data
-				uint16_t reg = ((ident & 0xFFFF0000) >> 16);
-				uint16_t slave = (ident & 0xFFFF);
-				datatypes::RegisterEnum regId = static_cast<datatypes::RegisterEnum>(reg);
-				uint64_t length = datatypes::getRegisterByteLength(regId);
-
-				Serialized ser(12 + length);
-				memcpy(ser.data, tmp.data, 4);
-				fin.read(ser.data + 4, 12 + length - 4);
-				RegisterDataBlock dataBlock
-				    = RegisterDataBlock::serializer.parseSerialized(ser, parsingContext);
-				try
-				{
-					insertRegister(
-					    findRegisterObject(slave, regId), dataBlock.timestamp, dataBlock.data);
-				}
-				catch (const std::runtime_error& e)
-				{
-					logCache.postError(datatypes::ErrorMessage{
-					    "Reading Register value of unknown Register or slave from log, "
-					        + std::string(e.what()),
-					    datatypes::ErrorSeverity::LOW });
-				}
-				off += length + 12;
+				logCache.postError(datatypes::ErrorMessage{
+				    "Reading CoEObject of unknown CoEObject from log, " + std::string(e.what()),
+				    datatypes::ErrorSeverity::LOW });
+			}
+		}
+		else if (kind == ChunkEntryBlock::errorKind)
+		{
+			// Parse error message
+			ErrorBlock errorBlock = ErrorBlock::serializer.parseSerialized(ser, parsingContext);
+			logCache.postError(datatypes::ErrorMessage{ std::move(errorBlock.message),
+			                       { errorBlock.getSlave1(), errorBlock.getSlave2() },
+			                       static_cast<datatypes::ErrorSeverity>(errorBlock.severity) },
+			    datatypes::intToTimeStamp(errorBlock.time));
+		}
+		else if (kind == ChunkEntryBlock::cycleStatisticKind)
+		{
+			// Parse the value of a cycle statistic
+			CycleStatisticBlock block
+			    = CycleStatisticBlock::serializer.parseSerialized(ser, parsingContext);
+			// Logs of other versions may contain types that are not known
+			if (block.type < datatypes::cycleStatisticTypeCount)
+			{
+				insertCycleStatistic(static_cast<datatypes::CycleStatisticType>(block.type),
+				    block.value, datatypes::intToTimeStamp(block.timestamp));
+			}
+		}
+		else
+		{
+			// Parse register data
+			uint16_t slave = (ident & 0xFFFF);
+			datatypes::RegisterEnum regId
+			    = static_cast<datatypes::RegisterEnum>((ident & 0xFFFF0000) >> 16);
+			RegisterDataBlock dataBlock
+			    = RegisterDataBlock::serializer.parseSerialized(ser, parsingContext);
+			try
+			{
+				insertRegister(
+				    findRegisterObject(slave, regId), dataBlock.timestamp, dataBlock.data);
+			}
+			catch (const std::runtime_error& e)
+			{
+				logCache.postError(datatypes::ErrorMessage{
+				    "Reading Register value of unknown Register or slave from log, "
+				        + std::string(e.what()),
+				    datatypes::ErrorSeverity::LOW });
 			}
 		}
+	}
 
-		progressFunction(100, "Finished reading logfile");
+	void LogReader::insertEncodedChunk(
+	    Serialized& ser, ParsingContext& parsingContext, uint8_t kinds)
+	{
+		try
+		{
+			Serialized blocks
+			    = EncodedChunkBlock::decode(ser, parsingContext.busInfo.ioMapUsedSize);
+			uint64_t off = 0;
+			while (off < blocks.length && !shouldHalt)
+			{
+				freeMemoryIfNecessary();
+				uint64_t length = getDataBlockLength(blocks, off, parsingContext);
+				if (length == 0)
+					break;
+				Serialized block = blocks.getAt(off, length);
+				off += length;
+				insertDataBlock(block, parsingContext, kinds);
+			}
+		}
+		catch (const std::runtime_error& e)
+		{
+			logCache.postError(datatypes::ErrorMessage{
+			    "Skipping the rest of a chunk of the log that cannot be decoded, "
+			        + std::string(e.what()),
+			    datatypes::ErrorSeverity::MEDIUM });
+		}
 	}
 
 	void LogReader::reportProgress(unsigned int progress, std::string text)
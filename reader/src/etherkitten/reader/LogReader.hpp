@@ -22,25 +22,71 @@
  */
 
 #include <any>
+#include <atomic>
 #include <filesystem>
 #include <map>
 #include <thread>
 #include <variant>
 
 #include "LogCache.hpp"
+#include "LogChunkCache.hpp"
+#include "LogSeriesView.hpp"
 #include "LogSlaveInformant.hpp"
+#include "MappedFile.hpp"
+#include "ReplayClock.hpp"
 #include "SearchList.hpp"
 #include "SearchListReader.hpp"
 #include "log/LogBusInfo.hpp"
+#include "log/Serialized.hpp"
+#include "log/chunkindex.hpp"
+#include "log/header.hpp"
 
 namespace etherkitten::reader
 {
+	/*!
+	 * \brief How the LogReader loads the data of a log.
+	 */
+	enum class LogLoading
+	{
+		/*!
+		 * \brief Read all data of the log into memory before it is shown.
+		 */
+		COMPLETE,
+
+		/*!
+		 * \brief Only keep the chunks of the log in memory that are currently viewed.
+		 *
+		 * Logs without a chunk index are loaded completely.
+		 */
+		WINDOWED,
+
+		/*!
+		 * \brief Insert the data of the log at the pace it was recorded at, like the data of
+		 * a bus, see ReplayClock.
+		 */
+		REPLAY,
+	};
+
 	/*!
 	 * \brief The LogReader is a Reader, similar to BusReader that reads from a logfile.
 	 *
 	 * Therefore writing data to the bus is not supported.
 	 *
 	 * The log reading is done in another thread, the reading progress is reported.
+	 *
+	 * A log that the Logger split into segments is read by passing its manifest as the log
+	 * file. The segments are then read one after another as one log.
+	 *
+	 * When loading a log with a chunk index COMPLETE, the chunks are decoded on several
+	 * threads and inserted in order by the reader thread.
+	 *
+	 * When loading a log WINDOWED, the register and process data are decoded from the
+	 * log file when they are viewed and only the chunks that were used recently are kept.
+	 * The errors and CoE values are still read completely in the background.
+	 * There are no IOMap views and no cycle statistics in this mode.
+	 *
+	 * When replaying a log, the data blocks are inserted in the order they were written in
+	 * once the ReplayClock of the LogReader reaches their TimeStamps.
 	 */
 	class LogReader : public SearchListReader
 	{
@@ -67,6 +113,36 @@ namespace etherkitten::reader
 		LogReader(std::filesystem::path logFile, LogSlaveInformant& slaveInformant,
 		    LogCache& logCache, std::function<void(int, std::string)> progressFunction);
 
+		/*!
+		 * \brief Create a new LogReader that loads the log the given way and reports
+		 * its progress like the constructor above.
+		 * \param logFile the log file to use
+		 * \param slaveInformant the slave informant to use
+		 * \param logCache the log cache to use
+		 * \param progressFunction a function that is called to report initialization progress
+		 * \param loading how to load the log
+		 */
+		LogReader(std::filesystem::path logFile, LogSlaveInformant& slaveInformant,
+		    LogCache& logCache, std::function<void(int, std::string)> progressFunction,
+		    LogLoading loading);
+
+		/*!
+		 * \brief Create a new LogReader like the constructor above that decodes the chunks
+		 * of a log that is loaded COMPLETE on the given number of threads.
+		 *
+		 * The progress is still reported from a single thread.
+		 * \param logFile the log file to use
+		 * \param slaveInformant the slave informant to use
+		 * \param logCache the log cache to use
+		 * \param progressFunction a function that is called to report initialization progress
+		 * \param loading how to load the log
+		 * \param workerCount the number of threads that decode chunks,
+		 * 0 for one per hardware thread
+		 */
+		LogReader(std::filesystem::path logFile, LogSlaveInformant& slaveInformant,
+		    LogCache& logCache, std::function<void(int, std::string)> progressFunction,
+		    LogLoading loading, unsigned int workerCount);
+
 		~LogReader();
 
 		LogReader(LogReader&) = delete;
@@ -77,6 +153,84 @@ namespace etherkitten::reader
 
 		LogReader& operator=(LogReader&&) = delete;
 
+		using SearchListReader::getNewest;
+		using SearchListReader::getView;
+
+		std::unique_ptr<datatypes::AbstractNewestValueView> getNewest(
+		    const datatypes::PDO& pdo) override;
+
+		std::unique_ptr<datatypes::AbstractNewestValueView> getNewest(
+		    const datatypes::Register& reg) override;
+
+		std::shared_ptr<datatypes::AbstractDataView> getView(
+		    const datatypes::PDO& pdo, datatypes::TimeSeries time) override;
+
+		std::shared_ptr<datatypes::AbstractDataView> getView(
+		    const datatypes::Register& reg, datatypes::TimeSeries time) override;
+
+		std::shared_ptr<datatypes::AbstractDataView> getRegisterRawDataView(
+		    uint16_t slaveId, uint16_t regId, datatypes::TimeSeries time) override;
+
+		void setMaximumMemory(size_t size) override;
+
+		/*!
+		 * \brief Get how this LogReader loads the log.
+		 *
+		 * This is COMPLETE for logs without a chunk index, even if they were requested
+		 * to be loaded WINDOWED.
+		 * \return how the log is loaded
+		 */
+		LogLoading getLoading() const
+		{
+			if (replayClock)
+				return LogLoading::REPLAY;
+			return chunkCache ? LogLoading::WINDOWED : LogLoading::COMPLETE;
+		}
+
+		/*!
+		 * \brief Get the ReplayClock that controls the speed of the replay.
+		 * \exception std::logic_error iff the log is not replayed
+		 * \return the ReplayClock
+		 */
+		ReplayClock& getReplayClock();
+
+		/*!
+		 * \brief Get the LogChunkCache of a log that is loaded WINDOWED.
+		 *
+		 * Together with makeSeries(), it lets the chunks of the log be processed directly
+		 * instead of stepping over them with a view per DataObject.
+		 * \return the LogChunkCache, or nullptr iff the log is not loaded WINDOWED
+		 */
+		LogChunkCache* getChunkCache() { return chunkCache.get(); }
+
+		/*!
+		 * \brief Get the files the log is read from.
+		 * \return the segments of a log that is split into segments, or just the log file
+		 */
+		const std::vector<std::filesystem::path>& getLogFiles() const { return logFiles; }
+
+		/*!
+		 * \brief Get where the values of a PDO are found in the chunks of the log.
+		 * \param pdo the PDO
+		 * \return the LogSeries of the PDO
+		 */
+		std::shared_ptr<const LogSeries> makeSeries(const datatypes::PDO& pdo);
+
+		/*!
+		 * \brief Get where the values of a register are found in the chunks of the log.
+		 * \param reg the register
+		 * \return the LogSeries of the register
+		 */
+		std::shared_ptr<const LogSeries> makeSeries(const datatypes::Register& reg);
+
+		/*!
+		 * \brief Check whether the reader thread has finished reading the log.
+		 *
+		 * Waiting for new data ends once it has.
+		 * \retval true iff all data of the log was read or the log cannot be read
+		 */
+		bool hasFinishedReading() const { return finishedReading; }
+
 		datatypes::PDOInfo getAbsolutePDOInfo(const datatypes::PDO& pdo) override;
 
 		void changeRegisterSettings(
@@ -89,17 +243,124 @@ namespace etherkitten::reader
 		void messageHalt() override;
 
 	private:
-		bool shouldHalt = false;
+		std::atomic<bool> shouldHalt = false;
+		std::atomic<bool> finishedReading = false;
 		std::filesystem::path logFile;
+		// The segments of the log, or just the log file
+		std::vector<std::filesystem::path> logFiles;
 		LogSlaveInformant& logSlaveInformant;
 		uint64_t memoryUsed = 0;
 		std::function<void(int, std::string)> progressFunction;
 		LogCache& logCache;
+		// Only set when the log is loaded WINDOWED
+		std::unique_ptr<LogChunkCache> chunkCache;
+		// Only set when the log is replayed
+		std::unique_ptr<ReplayClock> replayClock;
+		unsigned int workerCount;
 
 		std::unique_ptr<std::thread> readerThread;
 
 		void initReaderThread();
 		void readLog();
+
+		/*!
+		 * \brief Read the data of one file of the log.
+		 * \param path the log file or a segment of the log
+		 * \param parsingContext the ParsingContext to parse with
+		 * \exception std::runtime_error iff the file cannot be read
+		 */
+		void readLogFile(const std::filesystem::path& path, ParsingContext& parsingContext);
+
+		/*!
+		 * \brief Read the header of a log of any version from the start of the file.
+		 * \param log the contents of the log file
+		 * \param parsingContext the ParsingContext to parse with
+		 * \exception std::runtime_error iff the header cannot be read or its version is
+		 * not supported
+		 * \return the header
+		 */
+		LogHeaderBlock readHeader(Serialized& log, ParsingContext& parsingContext);
+
+		/*!
+		 * \brief Read the ChunkIndexBlock of a log of version 2 or later.
+		 * \param log the contents of the log file
+		 * \param indexOffset the file offset of the ChunkIndexBlock
+		 * \param parsingContext the ParsingContext to parse with
+		 * \exception std::runtime_error iff the ChunkIndexBlock cannot be read
+		 * \return the ChunkIndexBlock
+		 */
+		ChunkIndexBlock readChunkIndex(
+		    Serialized& log, uint64_t indexOffset, ParsingContext& parsingContext);
+
+		/*!
+		 * \brief Parse the data blocks between two file offsets in place and insert their data.
+		 *
+		 * Stops at the first block that is incomplete.
+		 * \param log the contents of the log file
+		 * \param parsingContext the ParsingContext to parse with
+		 * \param begin the file offset of the first data block
+		 * \param end the file offset after the last data block
+		 * \param kinds the kinds of blocks to insert as ChunkEntryBlock kinds,
+		 * all other blocks are skipped
+		 */
+		void readDataBlocks(Serialized& log, ParsingContext& parsingContext, uint64_t begin,
+		    uint64_t end, uint8_t kinds);
+
+		/*!
+		 * \brief Get the length of the data block at a file offset.
+		 * \param log the contents of the log file
+		 * \param off the file offset of the data block
+		 * \param parsingContext the ParsingContext to parse with
+		 * \return the length of the data block, or 0 iff it is incomplete
+		 * \exception std::runtime_error iff the data block holds a value of an unknown register
+		 */
+		uint64_t getDataBlockLength(Serialized& log, uint64_t off, ParsingContext& parsingContext);
+
+		/*!
+		 * \brief Parse a data block in place and insert its data.
+		 * \param ser the data block
+		 * \param parsingContext the ParsingContext to parse with
+		 * \param kinds the kinds of blocks to insert as ChunkEntryBlock kinds,
+		 * the data blocks in an EncodedChunkBlock are filtered by them as well
+		 */
+		void insertDataBlock(Serialized& ser, ParsingContext& parsingContext, uint8_t kinds);
+
+		/*!
+		 * \brief Decode an EncodedChunkBlock and insert the data of its data blocks.
+		 *
+		 * An error is posted if the chunk cannot be decoded.
+		 * \param ser the EncodedChunkBlock
+		 * \param parsingContext the ParsingContext to parse with
+		 * \param kinds the kinds of blocks to insert as ChunkEntryBlock kinds
+		 */
+		void insertEncodedChunk(Serialized& ser, ParsingContext& parsingContext, uint8_t kinds);
+
+		/*!
+		 * \brief Decode the chunks of an indexed log in parallel and insert their data
+		 * in the order of the chunk index.
+		 *
+		 * Chunks that cannot be decoded are read with readDataBlocks() instead.
+		 * \param file the log file
+		 * \param parsingContext the ParsingContext to parse with
+		 * \param index the ChunkIndexBlock of the log
+		 * \param ioMapSize the size of the IOMaps in the log
+		 */
+		void readChunks(const MappedFile& file, ParsingContext& parsingContext,
+		    const ChunkIndexBlock& index, size_t ioMapSize);
+
+		/*!
+		 * \brief Insert the register values and IOMaps of a decoded chunk.
+		 * \param chunk the decoded chunk
+		 */
+		void insertChunk(const DecodedChunk& chunk);
+
+		/*!
+		 * \brief Create the LogChunkCache for a log that is loaded WINDOWED.
+		 * \return the LogChunkCache, or nullptr iff the log or one of its segments
+		 * has no chunk index
+		 */
+		std::unique_ptr<LogChunkCache> openChunkCache();
+
 		void insertRegister(const datatypes::Register& reg, uint64_t timestamp, uint64_t data);
 		void insertCoE(const datatypes::CoEObject& obj, uint64_t timestamp, std::any data);
 		/*!
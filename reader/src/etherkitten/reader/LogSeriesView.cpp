@@ -0,0 +1,212 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "LogSeriesView.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace etherkitten::reader
+{
+	namespace
+	{
+		uint64_t toLogTime(datatypes::TimeStamp time)
+		{
+			return time.time_since_epoch().count() <= 0 ? 0 : datatypes::timeStampToInt(time);
+		}
+
+		/*!
+		 * \brief Find the first value of a LogSeries at or after a time.
+		 *
+		 * Chunks that end before the time or cannot contain the LogSeries are not decoded.
+		 * \param series the LogSeries to search
+		 * \param cache the LogChunkCache to get the chunks from
+		 * \param firstChunk the first chunk to search in
+		 * \param time the time to search for
+		 * \return the location of the value, if there is one
+		 */
+		std::optional<LogSeriesLocation> findFrom(const LogSeries& series, LogChunkCache& cache,
+		    size_t firstChunk, datatypes::TimeStamp time)
+		{
+			const ChunkIndexBlock& index = cache.getIndex();
+			const std::vector<ChunkEntryBlock>& chunks = index.getChunks();
+			uint64_t logTime = toLogTime(time);
+			size_t chunk = std::max(
+			    firstChunk, index.findChunks(logTime, std::numeric_limits<uint64_t>::max()).first);
+			for (; chunk < chunks.size(); ++chunk)
+			{
+				if (chunks[chunk].lastTime < logTime || !series.mayBeIn(chunks[chunk]))
+				{
+					continue;
+				}
+				std::shared_ptr<const DecodedChunk> data = cache.getChunk(chunk);
+				const std::vector<datatypes::TimeStamp>& times = series.getTimes(*data);
+				auto found = std::lower_bound(times.begin(), times.end(), time);
+				if (found != times.end())
+				{
+					return LogSeriesLocation{ chunk,
+						static_cast<size_t>(std::distance(times.begin(), found)), std::move(data) };
+				}
+			}
+			return std::nullopt;
+		}
+
+		/*!
+		 * \brief Find the last value of a LogSeries.
+		 * \param series the LogSeries to search
+		 * \param cache the LogChunkCache to get the chunks from
+		 * \return the location of the value, if there is one
+		 */
+		std::optional<LogSeriesLocation> findLast(const LogSeries& series, LogChunkCache& cache)
+		{
+			const std::vector<ChunkEntryBlock>& chunks = cache.getIndex().getChunks();
+			for (size_t chunk = chunks.size(); chunk-- > 0;)
+			{
+				if (!series.mayBeIn(chunks[chunk]))
+				{
+					continue;
+				}
+				std::shared_ptr<const DecodedChunk> data = cache.getChunk(chunk);
+				size_t count = series.getTimes(*data).size();
+				if (count > 0)
+				{
+					return LogSeriesLocation{ chunk, count - 1, std::move(data) };
+				}
+			}
+			return std::nullopt;
+		}
+	} // namespace
+
+	LogSeriesView::LogSeriesView(
+	    std::shared_ptr<const LogSeries> series, LogChunkCache& cache, datatypes::TimeSeries time)
+	    : series(std::move(series))
+	    , cache(cache)
+	    , timeStep(time.microStep)
+	    , current(findFrom(*this->series, cache, 0, time.startTime))
+	{
+		if (!current)
+		{
+			current = findLast(*this->series, cache);
+		}
+	}
+
+	double LogSeriesView::asDouble() const
+	{
+		if (!current)
+		{
+			throw std::out_of_range("This LogSeriesView is empty");
+		}
+		return series->asDouble(*current->data, current->index);
+	}
+
+	LogSeriesView& LogSeriesView::operator++()
+	{
+		if (findNext())
+		{
+			current = next;
+			next.reset();
+			nextSearched = false;
+		}
+		return *this;
+	}
+
+	bool LogSeriesView::hasNext() const { return findNext().has_value(); }
+
+	bool LogSeriesView::isEmpty() const { return !current; }
+
+	datatypes::TimeStamp LogSeriesView::getTime()
+	{
+		if (!current)
+		{
+			throw std::out_of_range("This LogSeriesView is empty");
+		}
+		return series->getTimes(*current->data)[current->index];
+	}
+
+	const std::optional<LogSeriesLocation>& LogSeriesView::findNext() const
+	{
+		if (nextSearched || !current)
+		{
+			return next;
+		}
+		nextSearched = true;
+		const std::vector<datatypes::TimeStamp>& times = series->getTimes(*current->data);
+		if (timeStep == datatypes::TimeStep(0))
+		{
+			if (current->index + 1 < times.size())
+			{
+				next = LogSeriesLocation{ current->chunk, current->index + 1, current->data };
+			}
+			else
+			{
+				next = findFrom(*series, cache, current->chunk + 1, datatypes::TimeStamp());
+			}
+			return next;
+		}
+
+		datatypes::TimeStamp target = times[current->index] + timeStep;
+		auto found = std::lower_bound(times.begin() + current->index + 1, times.end(), target);
+		if (found != times.end())
+		{
+			next = LogSeriesLocation{ current->chunk,
+				static_cast<size_t>(std::distance(times.begin(), found)), current->data };
+		}
+		else
+		{
+			next = findFrom(*series, cache, current->chunk + 1, target);
+		}
+		return next;
+	}
+
+	LogSeriesNewestValueView::LogSeriesNewestValueView(
+	    std::shared_ptr<const LogSeries> series, LogChunkCache& cache)
+	    : series(std::move(series))
+	    , cache(cache)
+	{
+	}
+
+	bool LogSeriesNewestValueView::isEmpty() const
+	{
+		findNewest();
+		return newest == nullptr;
+	}
+
+	const datatypes::AbstractDataPoint& LogSeriesNewestValueView::operator*()
+	{
+		findNewest();
+		if (newest == nullptr)
+		{
+			throw std::out_of_range("This LogSeriesNewestValueView is empty");
+		}
+		return *newest;
+	}
+
+	void LogSeriesNewestValueView::findNewest() const
+	{
+		if (searched)
+		{
+			return;
+		}
+		searched = true;
+		std::optional<LogSeriesLocation> last = findLast(*series, cache);
+		if (last)
+		{
+			newest = series->getDataPoint(*last->data, last->index);
+		}
+	}
+} // namespace etherkitten::reader
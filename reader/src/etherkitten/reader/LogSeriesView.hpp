@@ -0,0 +1,324 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+/*!
+ * \file
+ * \brief Defines the LogSeries, the values of one DataObject in the chunks of a log,
+ * and the views that read a LogSeries through a LogChunkCache.
+ */
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <etherkitten/datatypes/datapoints.hpp>
+#include <etherkitten/datatypes/dataviews.hpp>
+#include <etherkitten/datatypes/ethercatdatatypes.hpp>
+#include <etherkitten/datatypes/time.hpp>
+
+#include "Converter.hpp"
+#include "LogChunkCache.hpp"
+#include "log/chunkindex.hpp"
+
+namespace etherkitten::reader
+{
+	/*!
+	 * \brief The LogSeries describes where the values of one DataObject are found in
+	 * the DecodedChunks of a log and how they are converted.
+	 */
+	class LogSeries
+	{
+	public:
+		virtual ~LogSeries() = default;
+
+		/*!
+		 * \brief Check whether a chunk may contain values of this LogSeries without decoding it.
+		 * \param chunk the entry of the chunk in the ChunkIndexBlock
+		 * \retval true iff the chunk may contain values of this LogSeries
+		 */
+		virtual bool mayBeIn(const ChunkEntryBlock& chunk) const = 0;
+
+		/*!
+		 * \brief Get the TimeStamps of the values of this LogSeries in a chunk.
+		 * \param chunk the decoded chunk
+		 * \return the TimeStamps in ascending order
+		 */
+		virtual const std::vector<datatypes::TimeStamp>& getTimes(
+		    const DecodedChunk& chunk) const = 0;
+
+		/*!
+		 * \brief Get a value of this LogSeries as a double.
+		 * \param chunk the decoded chunk
+		 * \param index the index of the value in getTimes()
+		 * \return the value as a double
+		 */
+		virtual double asDouble(const DecodedChunk& chunk, size_t index) const = 0;
+
+		/*!
+		 * \brief Get a value of this LogSeries as a DataPoint of its type.
+		 * \param chunk the decoded chunk
+		 * \param index the index of the value in getTimes()
+		 * \return the value as a DataPoint
+		 */
+		virtual std::unique_ptr<datatypes::AbstractDataPoint> getDataPoint(
+		    const DecodedChunk& chunk, size_t index) const = 0;
+	};
+
+	/*!
+	 * \brief The values of a register of one slave.
+	 * \tparam Output the type of the register
+	 */
+	template<typename Output>
+	class RegisterLogSeries : public LogSeries
+	{
+	public:
+		/*!
+		 * \brief Create a RegisterLogSeries.
+		 * \param slave the id of the slave
+		 * \param address the address of the register the values are read from
+		 * \param bitOffset the offset of the register's bits in the value
+		 * \param bitLength the length of the register in bits, 0 to use the value as it is
+		 */
+		RegisterLogSeries(uint16_t slave, uint16_t address, size_t bitOffset, size_t bitLength)
+		    : slave(slave)
+		    , key(DecodedChunk::getRegisterKey(slave, address))
+		    , bitOffset(bitOffset)
+		    , bitLength(bitLength)
+		{
+		}
+
+		bool mayBeIn(const ChunkEntryBlock& chunk) const override
+		{
+			return (chunk.blockKinds & ChunkEntryBlock::registerKind) != 0
+			    && chunk.hasSlave(slave);
+		}
+
+		const std::vector<datatypes::TimeStamp>& getTimes(const DecodedChunk& chunk) const override
+		{
+			return chunk.getRegister(key).times;
+		}
+
+		double asDouble(const DecodedChunk& chunk, size_t index) const override
+		{
+			// The values were already converted to the host's byte order when decoding
+			return Converter<uint64_t, double>::shiftAndConvert(
+			    chunk.getRegister(key).values[index], bitOffset, bitLength, false);
+		}
+
+		std::unique_ptr<datatypes::AbstractDataPoint> getDataPoint(
+		    const DecodedChunk& chunk, size_t index) const override
+		{
+			const RegisterSeries& series = chunk.getRegister(key);
+			return std::make_unique<datatypes::DataPoint<Output>>(
+			    Converter<uint64_t, Output>::shiftAndConvert(
+			        series.values[index], bitOffset, bitLength, false),
+			    series.times[index]);
+		}
+
+	private:
+		const uint16_t slave;
+		const uint32_t key;
+		const size_t bitOffset;
+		const size_t bitLength;
+	};
+
+	/*!
+	 * \brief The values of a PDO in the IOMaps.
+	 * \tparam Output the type of the PDO
+	 */
+	template<typename Output>
+	class PDOLogSeries : public LogSeries
+	{
+	public:
+		/*!
+		 * \brief Create a PDOLogSeries.
+		 * \param bitOffset the offset of the PDO in the IOMap in bits
+		 * \param bitLength the length of the PDO in bits
+		 */
+		PDOLogSeries(size_t bitOffset, size_t bitLength)
+		    : bitOffset(bitOffset)
+		    , bitLength(bitLength)
+		{
+		}
+
+		bool mayBeIn(const ChunkEntryBlock& chunk) const override
+		{
+			return (chunk.blockKinds & ChunkEntryBlock::processDataKind) != 0;
+		}
+
+		const std::vector<datatypes::TimeStamp>& getTimes(const DecodedChunk& chunk) const override
+		{
+			return chunk.getIOMapTimes();
+		}
+
+		double asDouble(const DecodedChunk& chunk, size_t index) const override
+		{
+			return convertIOMapToDouble<Output>(chunk.getIOMap(index), bitOffset, bitLength, true);
+		}
+
+		std::unique_ptr<datatypes::AbstractDataPoint> getDataPoint(
+		    const DecodedChunk& chunk, size_t index) const override
+		{
+			return std::make_unique<datatypes::DataPoint<Output>>(
+			    Converter<IOMap*, Output>::shiftAndConvert(
+			        chunk.getIOMap(index), bitOffset, bitLength, true),
+			    chunk.getIOMapTimes()[index]);
+		}
+
+	private:
+		const size_t bitOffset;
+		const size_t bitLength;
+	};
+
+	/*!
+	 * \brief Returns a RegisterLogSeries with output type E.
+	 *
+	 * To be used with the dataTypeMaps.
+	 * \tparam E the output type of the series
+	 */
+	template<datatypes::EtherCATDataTypeEnum E, typename...>
+	class RegisterLogSeriesRetriever
+	{
+	public:
+		using product_t
+		    = std::function<std::shared_ptr<LogSeries>(uint16_t, uint16_t, size_t, size_t)>;
+
+		static product_t eval()
+		{
+			return [](uint16_t slave, uint16_t address, size_t bitOffset,
+			           size_t bitLength) -> std::shared_ptr<LogSeries> {
+				return std::make_shared<RegisterLogSeries<typename datatypes::TypeMap<E>::type>>(
+				    slave, address, bitOffset, bitLength);
+			};
+		}
+	};
+
+	/*!
+	 * \brief Returns a PDOLogSeries with output type E.
+	 *
+	 * To be used with the dataTypeMaps.
+	 * \tparam E the output type of the series
+	 */
+	template<datatypes::EtherCATDataTypeEnum E, typename...>
+	class PDOLogSeriesRetriever
+	{
+	public:
+		using product_t = std::function<std::shared_ptr<LogSeries>(size_t, size_t)>;
+
+		static product_t eval()
+		{
+			return [](size_t bitOffset, size_t bitLength) -> std::shared_ptr<LogSeries> {
+				return std::make_shared<PDOLogSeries<typename datatypes::TypeMap<E>::type>>(
+				    bitOffset, bitLength);
+			};
+		}
+	};
+
+	/*!
+	 * \brief A position of a value of a LogSeries in a log.
+	 */
+	struct LogSeriesLocation
+	{
+		/*!
+		 * \brief The index of the chunk in the ChunkIndexBlock.
+		 */
+		size_t chunk;
+
+		/*!
+		 * \brief The index of the value in the chunk.
+		 */
+		size_t index;
+
+		/*!
+		 * \brief The decoded chunk, which is kept alive while the location is used.
+		 */
+		std::shared_ptr<const DecodedChunk> data;
+	};
+
+	/*!
+	 * \brief The LogSeriesView steps over the values of a LogSeries like a DataView.
+	 *
+	 * Only the chunks the view steps over are decoded, through the LogChunkCache.
+	 * Steps that skip whole chunks only decode the chunks a value is taken from.
+	 */
+	class LogSeriesView : public datatypes::AbstractDataView
+	{
+	public:
+		/*!
+		 * \brief Create a LogSeriesView.
+		 *
+		 * The view starts at the first value at or after the start time of the TimeSeries,
+		 * or at the last value if there is none.
+		 * \param series the LogSeries to step over
+		 * \param cache the LogChunkCache to get the chunks from, which must outlive the view
+		 * \param time the start time and step of the view
+		 */
+		LogSeriesView(
+		    std::shared_ptr<const LogSeries> series, LogChunkCache& cache, datatypes::TimeSeries time);
+
+		double asDouble() const override;
+
+		LogSeriesView& operator++() override;
+
+		bool hasNext() const override;
+
+		bool isEmpty() const override;
+
+		datatypes::TimeStamp getTime() override;
+
+	private:
+		std::shared_ptr<const LogSeries> series;
+		LogChunkCache& cache;
+		datatypes::TimeStep timeStep;
+		std::optional<LogSeriesLocation> current;
+		// The location operator++() moves to, searched for at most once per location
+		mutable std::optional<LogSeriesLocation> next;
+		mutable bool nextSearched = false;
+
+		const std::optional<LogSeriesLocation>& findNext() const;
+	};
+
+	/*!
+	 * \brief The LogSeriesNewestValueView points to the last value of a LogSeries.
+	 *
+	 * Since a log does not change, the value is only looked up once.
+	 */
+	class LogSeriesNewestValueView : public datatypes::AbstractNewestValueView
+	{
+	public:
+		/*!
+		 * \brief Create a LogSeriesNewestValueView.
+		 * \param series the LogSeries to get the last value of
+		 * \param cache the LogChunkCache to get the chunks from, which must outlive the view
+		 */
+		LogSeriesNewestValueView(std::shared_ptr<const LogSeries> series, LogChunkCache& cache);
+
+		bool isEmpty() const override;
+
+		const datatypes::AbstractDataPoint& operator*() override;
+
+	private:
+		std::shared_ptr<const LogSeries> series;
+		LogChunkCache& cache;
+		mutable std::unique_ptr<datatypes::AbstractDataPoint> newest;
+		mutable bool searched = false;
+
+		void findNewest() const;
+	};
+} // namespace etherkitten::reader
@@ -20,7 +20,9 @@
 #include <fstream>
 #include <vector>
 
+#include "LogManifest.hpp"
 #include "log/Serialized.hpp"
+#include "log/header.hpp"
 #include "log/slave.hpp"
 #include "log/slavedetails.hpp"
 #include <etherkitten/datatypes/time.hpp>
@@ -63,36 +65,58 @@ namespace etherkitten::reader
 	{
 		progressFunction(0, "Reading log header");
 		ParsingContext parsingContext(*this, busInfo);
-		std::ifstream fin(logFile, std::ios::in | std::ios::binary);
-		uint64_t version;
+		// Every segment of a log holds the slave information, so the first one is read
+		std::filesystem::path firstFile;
+		try
+		{
+			firstFile = LogManifest::getLogFiles(logFile).front();
+		}
+		catch (const std::runtime_error& e)
+		{
+			throw SlaveInformantError{ "Failed to read log.",
+				{ { "The manifest of the log is not valid. " + std::string(e.what()),
+				    datatypes::ErrorSeverity::FATAL } } };
+		}
+		std::ifstream fin(firstFile, std::ios::in | std::ios::binary);
 		uint64_t pdoDescOffset;
 		uint64_t dataOffset;
 		uint64_t off = 0;
-		static const int headerSize = 40;
 		{
-			Serialized tmp(headerSize);
-			fin.read(tmp.data, headerSize);
-			off += headerSize;
+			// The version tells the size of the rest of the header
+			Serialized tmp(8);
+			fin.read(tmp.data, 8);
 
 			// Maybe we cannot read the logfile
 			if (fin.fail())
 			{
 				throw SlaveInformantError{ "Failed to read log.",
 					{ { "Logfile cannot be read. Maybe it is not accessible?",
-							datatypes::ErrorSeverity::FATAL } } };
+					    datatypes::ErrorSeverity::FATAL } } };
 			}
 
-			version = tmp.read<uint64_t>(0);
-			if (version != 1)
+			uint64_t headerSize = LogHeaderBlock::getSizeOfVersion(tmp.read<uint64_t>(0));
+			if (headerSize == 0)
 			{
 				throw SlaveInformantError{ "Failed to read log.",
 					{ { "Logfile is not valid. First 64 Bits are wrong.",
 					    datatypes::ErrorSeverity::FATAL } } };
 			}
-			pdoDescOffset = tmp.read<uint64_t>(8);
-			dataOffset = tmp.read<uint64_t>(16);
-			busInfo.ioMapUsedSize = tmp.read<uint64_t>(24);
-			busInfo.startTime = datatypes::intToTimeStamp(tmp.read<uint64_t>(32));
+			Serialized ser(headerSize);
+			memcpy(ser.data, tmp.data, 8);
+			fin.read(ser.data + 8, headerSize - 8);
+			if (fin.fail())
+			{
+				throw SlaveInformantError{ "Failed to read log.",
+					{ { "Logfile is not valid. The header is incomplete.",
+					    datatypes::ErrorSeverity::FATAL } } };
+			}
+			off += headerSize;
+
+			LogHeaderBlock header = LogHeaderBlock::serializer.parseSerialized(ser, parsingContext);
+			pdoDescOffset = header.pdoDescOffset;
+			dataOffset = header.dataOffset;
+			busInfo.ioMapUsedSize = header.ioMapSize;
+			busInfo.startTime = datatypes::intToTimeStamp(header.startTime);
 		}
 
 		// Split into Serialized objects of correct size and parse binary
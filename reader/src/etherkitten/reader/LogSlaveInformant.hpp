@@ -42,7 +42,7 @@ namespace etherkitten::reader
 		 *
 		 * When this constructor exits, all information regarding the slaves is read from the log
 		 * file.
-		 * \param logFile the log file that should be used as data source
+		 * \param logFile the log file or log manifest that should be used as data source
 		 * \exception std::runtime_error if the log file cannot be parsed
 		 */
 		LogSlaveInformant(std::filesystem::path logFile);
@@ -55,7 +55,7 @@ namespace etherkitten::reader
 		 * This constructor will additionally report its progress by calling the progressFunction
 		 * regularly with an integer between 0 and 100 representing its percentual progress
 		 * and a string message representing its next task.
-		 * \param logFile the log file that should be used as data source
+		 * \param logFile the log file or log manifest that should be used as data source
 		 * \param progressFunction a function that is called to report initialization progress
 		 * \exception std::runtime_error if the log file cannot be parsed
 		 */
@@ -0,0 +1,211 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "LogWriter.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <unistd.h>
+
+#include "endianness.hpp"
+
+namespace etherkitten::reader
+{
+	namespace
+	{
+		// Page aligned buffers let the kernel copy them without splitting pages
+		constexpr size_t bufferAlignment = 4096;
+	} // namespace
+
+	void LogWriter::FreeDeleter::operator()(char* buffer) const { free(buffer); } // NOLINT
+
+	LogWriter::LogWriter(const std::filesystem::path& path)
+	    : LogWriter(path, defaultBufferSize, defaultBufferCount)
+	{
+	}
+
+	LogWriter::LogWriter(const std::filesystem::path& path, size_t bufferSize, size_t bufferCount)
+	    : fd(open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)) // NOLINT
+	    , bufferSize(bufferSize)
+	{
+		if (bufferSize == 0 || bufferCount < 2)
+		{
+			if (fd >= 0)
+				close(fd);
+			throw std::invalid_argument("a LogWriter needs at least two non-empty buffers");
+		}
+		if (fd < 0)
+		{
+			failed.store(true, std::memory_order_release);
+		}
+		size_t allocationSize = (bufferSize + bufferAlignment - 1) / bufferAlignment
+		    * bufferAlignment;
+		try
+		{
+			for (size_t i = 0; i < bufferCount; ++i)
+			{
+				freeBuffers.emplace_back(
+				    static_cast<char*>(aligned_alloc(bufferAlignment, allocationSize)));
+				if (!freeBuffers.back())
+					throw std::bad_alloc();
+			}
+		}
+		catch (...)
+		{
+			// The destructor does not run for a LogWriter that was not constructed
+			if (fd >= 0)
+				close(fd);
+			throw;
+		}
+		current = std::move(freeBuffers.back());
+		freeBuffers.pop_back();
+		ioThread = std::thread(&LogWriter::writeJobs, this);
+	}
+
+	LogWriter::~LogWriter()
+	{
+		handOver();
+		{
+			std::lock_guard guard(mutex);
+			stopping = true;
+		}
+		jobAdded.notify_one();
+		ioThread.join();
+		if (fd >= 0)
+			close(fd);
+	}
+
+	void LogWriter::write(const char* data, size_t length)
+	{
+		while (length > 0)
+		{
+			if (currentLength == 0)
+				currentSince = std::chrono::steady_clock::now();
+			size_t part = std::min(length, bufferSize - currentLength);
+			memcpy(current.get() + currentLength, data, part);
+			currentLength += part;
+			position += part;
+			data += part;
+			length -= part;
+			if (currentLength == bufferSize)
+				handOver();
+		}
+	}
+
+	void LogWriter::writeAt(uint64_t position, uint64_t value)
+	{
+		// The value must not be overwritten by the buffer it lies in
+		if (position + sizeof(value) > this->position - currentLength)
+			handOver();
+		enqueue({ nullptr, 0, position, flipBytesIfBigEndianHost(value) });
+	}
+
+	void LogWriter::handOverOlderThan(std::chrono::steady_clock::duration maximumLatency)
+	{
+		if (currentLength > 0 && std::chrono::steady_clock::now() - currentSince >= maximumLatency)
+			handOver();
+	}
+
+	void LogWriter::flush()
+	{
+		handOver();
+		std::unique_lock lock(mutex);
+		jobDone.wait(lock, [this] { return jobs.empty() && !busy; });
+	}
+
+	void LogWriter::handOver()
+	{
+		if (currentLength == 0)
+			return;
+		Buffer next;
+		{
+			std::unique_lock lock(mutex);
+			jobDone.wait(lock, [this] { return !freeBuffers.empty(); });
+			next = std::move(freeBuffers.back());
+			freeBuffers.pop_back();
+		}
+		enqueue({ std::move(current), currentLength, 0, 0 });
+		current = std::move(next);
+		currentLength = 0;
+	}
+
+	void LogWriter::enqueue(Job&& job)
+	{
+		{
+			std::lock_guard guard(mutex);
+			jobs.push_back(std::move(job));
+		}
+		jobAdded.notify_one();
+	}
+
+	/*!
+	 * \brief The loop of the I/O thread, which writes the jobs in the order they were added.
+	 */
+	void LogWriter::writeJobs()
+	{
+		std::unique_lock lock(mutex);
+		while (true)
+		{
+			jobAdded.wait(lock, [this] { return stopping || !jobs.empty(); });
+			if (jobs.empty())
+				return;
+			Job job = std::move(jobs.front());
+			jobs.pop_front();
+			busy = true;
+			lock.unlock();
+
+			if (!hasFailed())
+			{
+				if (job.buffer)
+				{
+					writeFully(job.buffer.get(), job.length);
+				}
+				else if (pwrite(fd, &job.value, sizeof(job.value), job.position)
+				    != static_cast<ssize_t>(sizeof(job.value)))
+				{
+					failed.store(true, std::memory_order_release);
+				}
+			}
+
+			lock.lock();
+			if (job.buffer)
+				freeBuffers.push_back(std::move(job.buffer));
+			busy = false;
+			jobDone.notify_all();
+		}
+	}
+
+	void LogWriter::writeFully(const char* data, size_t length)
+	{
+		while (length > 0)
+		{
+			ssize_t written = ::write(fd, data, length);
+			if (written < 0)
+			{
+				if (errno == EINTR)
+					continue;
+				failed.store(true, std::memory_order_release);
+				return;
+			}
+			data += written;
+			length -= written;
+		}
+	}
+} // namespace etherkitten::reader
@@ -0,0 +1,174 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+/*!
+ * \file
+ * \brief Defines the LogWriter, which writes a log file from a dedicated I/O thread.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace etherkitten::reader
+{
+	/*!
+	 * \brief The LogWriter collects the bytes of a log in large buffers and writes the full
+	 * buffers to the file from its own I/O thread.
+	 *
+	 * Writing to a slow SD card or network share therefore never stalls the caller, until
+	 * all buffers are waiting to be written.
+	 * The LogWriter is written to from a single thread.
+	 * It does not throw on I/O errors, since the log is written in the background;
+	 * once an error occurred, hasFailed() returns true and no more data is written.
+	 */
+	class LogWriter
+	{
+	public:
+		/*!
+		 * \brief The size of the buffers unless told otherwise.
+		 */
+		static constexpr size_t defaultBufferSize = 4 * 1024 * 1024;
+
+		/*!
+		 * \brief The number of buffers unless told otherwise.
+		 */
+		static constexpr size_t defaultBufferCount = 4;
+
+		/*!
+		 * \brief Create or truncate a log file and start the I/O thread.
+		 * \param path the path of the log file
+		 */
+		explicit LogWriter(const std::filesystem::path& path);
+
+		/*!
+		 * \brief Create or truncate a log file and start the I/O thread.
+		 * \param path the path of the log file
+		 * \param bufferSize the size of each buffer in bytes
+		 * \param bufferCount the number of buffers, at least 2
+		 * \exception std::invalid_argument iff bufferSize is 0 or bufferCount less than 2
+		 */
+		LogWriter(const std::filesystem::path& path, size_t bufferSize, size_t bufferCount);
+
+		/*!
+		 * \brief Write all remaining data and close the file.
+		 */
+		~LogWriter();
+
+		LogWriter(const LogWriter&) = delete;
+
+		LogWriter(LogWriter&&) = delete;
+
+		LogWriter& operator=(const LogWriter&) = delete;
+
+		LogWriter& operator=(LogWriter&&) = delete;
+
+		/*!
+		 * \brief Append bytes to the log.
+		 *
+		 * Waits for the I/O thread if all buffers are full.
+		 * \param data the bytes to append
+		 * \param length the number of bytes
+		 */
+		void write(const char* data, size_t length);
+
+		/*!
+		 * \brief Overwrite a 64 bit value that was appended earlier.
+		 *
+		 * The value is written after all data in front of it, so it is only on disk once
+		 * the data it refers to is.
+		 * \param position the file offset of the value
+		 * \param value the value to write in little endian byte order
+		 */
+		void writeAt(uint64_t position, uint64_t value);
+
+		/*!
+		 * \brief Get the file offset the next appended byte is written to.
+		 * \return the number of bytes appended so far
+		 */
+		uint64_t getPosition() const { return position; }
+
+		/*!
+		 * \brief Hand the current buffer to the I/O thread if its oldest data has waited
+		 * for at least the given time.
+		 *
+		 * This bounds how much data is lost if the process dies without large writes.
+		 * \param maximumLatency the time data may wait in the current buffer
+		 */
+		void handOverOlderThan(std::chrono::steady_clock::duration maximumLatency);
+
+		/*!
+		 * \brief Wait until all data appended so far is written to the file.
+		 */
+		void flush();
+
+		/*!
+		 * \brief Check whether writing to the file failed.
+		 * \retval true iff the file could not be opened or written
+		 */
+		bool hasFailed() const { return failed.load(std::memory_order_acquire); }
+
+	private:
+		struct FreeDeleter
+		{
+			void operator()(char* buffer) const;
+		};
+		using Buffer = std::unique_ptr<char, FreeDeleter>;
+
+		/*!
+		 * \brief Data or a patch for the I/O thread.
+		 */
+		struct Job
+		{
+			// The buffer to write, or nullptr for a patch
+			Buffer buffer;
+			size_t length;
+			uint64_t position;
+			uint64_t value;
+		};
+
+		int fd;
+		const size_t bufferSize;
+		std::atomic<bool> failed = false;
+		uint64_t position = 0;
+		Buffer current;
+		size_t currentLength = 0;
+		std::chrono::steady_clock::time_point currentSince;
+
+		std::mutex mutex;
+		std::condition_variable jobAdded;
+		std::condition_variable jobDone;
+		std::deque<Job> jobs;
+		std::vector<Buffer> freeBuffers;
+		bool busy = false;
+		bool stopping = false;
+		std::thread ioThread;
+
+		void handOver();
+		void enqueue(Job&& job);
+		void writeJobs();
+		void writeFully(const char* data, size_t length);
+	};
+} // namespace etherkitten::reader
@@ -0,0 +1,461 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "MailboxEngine.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include "endianness.hpp"
+
+namespace etherkitten::reader
+{
+	namespace
+	{
+		// See the EtherCAT standard, part 6, chapters 5.6 and 5.6.2
+		constexpr uint16_t sm0StatusRegister = 0x805;
+		constexpr uint16_t sm1StatusRegister = 0x80D;
+		constexpr uint8_t mailboxFull = 0x08;
+
+		constexpr size_t pduHeaderSize = sizeof(EtherCATPDU) - 1;
+		constexpr size_t mailboxHeaderSize = 6;
+		constexpr size_t coeHeaderSize = 2;
+		constexpr size_t sdoHeaderSize = 8;
+		constexpr size_t sdoOffset = mailboxHeaderSize + coeHeaderSize;
+		constexpr size_t normalDataOffset = sdoOffset + sdoHeaderSize;
+		constexpr size_t segmentDataOffset = sdoOffset + 1;
+		constexpr size_t minimumSegmentLength = 7;
+
+		constexpr uint8_t mailboxTypeError = 0x00;
+		constexpr uint8_t mailboxTypeCoE = 0x03;
+		constexpr uint16_t coeServiceSDORequest = 0x02;
+		constexpr uint16_t coeServiceSDOResponse = 0x03;
+
+		constexpr uint8_t sdoAbort = 0x80;
+		constexpr uint8_t sdoUploadInitiate = 0x40;
+		constexpr uint8_t sdoUploadSegment = 0x60;
+		constexpr uint8_t sdoDownloadInitiate = 0x20;
+		constexpr uint8_t sdoDownloadSegment = 0x00;
+		constexpr uint8_t sdoDownloadInitiateResponse = 0x60;
+		constexpr uint8_t sdoDownloadSegmentResponse = 0x20;
+		constexpr uint8_t sdoUploadInitiateResponse = 0x40;
+		constexpr uint8_t sdoUploadSegmentResponse = 0x00;
+		constexpr uint8_t sdoCommandMask = 0xE0;
+		constexpr uint8_t sdoSizeIndicated = 0x01;
+		constexpr uint8_t sdoExpedited = 0x02;
+		constexpr uint8_t sdoLastSegment = 0x01;
+		constexpr uint8_t sdoToggleShift = 4;
+		constexpr size_t expeditedMaxSize = 4;
+
+		uint16_t readUInt16(const uint8_t* source)
+		{
+			uint16_t value = 0;
+			std::memcpy(&value, source, sizeof(value));
+			return flipBytesIfBigEndianHost(value);
+		}
+
+		uint32_t readUInt32(const uint8_t* source)
+		{
+			uint32_t value = 0;
+			std::memcpy(&value, source, sizeof(value));
+			return flipBytesIfBigEndianHost(value);
+		}
+
+		void writeUInt16(uint8_t* destination, uint16_t value)
+		{
+			value = flipBytesIfBigEndianHost(value);
+			std::memcpy(destination, &value, sizeof(value));
+		}
+
+		void writeUInt32(uint8_t* destination, uint32_t value)
+		{
+			value = flipBytesIfBigEndianHost(value);
+			std::memcpy(destination, &value, sizeof(value));
+		}
+
+		/*!
+		 * \brief Write an EtherCATFrame with a single PDU.
+		 * \return the length of the frame
+		 */
+		size_t writeFrame(EtherCATFrame& frame, uint8_t commandType,
+		    uint16_t slaveConfiguredAddress, uint16_t address, const uint8_t* data,
+		    uint16_t length)
+		{
+			EtherCATPDU* pdu = new (frame.pduArea) EtherCATPDU; // NOLINT
+			pdu->commandType = commandType;
+			pdu->slaveConfiguredAddress = flipBytesIfBigEndianHost(slaveConfiguredAddress);
+			pdu->registerAddress = flipBytesIfBigEndianHost(address);
+			pdu->dataLengthAndNext = flipBytesIfBigEndianHost(length);
+			if (data != nullptr)
+			{
+				std::memcpy(frame.pduArea + pduHeaderSize, data, length); // NOLINT
+			}
+			else
+			{
+				std::memset(frame.pduArea + pduHeaderSize, 0, length); // NOLINT
+			}
+			std::memset(frame.pduArea + pduHeaderSize + length, 0, sizeof(uint16_t)); // NOLINT
+
+			uint16_t frameLength = pduHeaderSize + length + 2 * sizeof(uint16_t);
+			static constexpr uint16_t frameTypePDUs = 0x1000;
+			frame.lengthAndType = flipBytesIfBigEndianHost((frameLength - 2) | frameTypePDUs);
+			return frameLength;
+		}
+	} // namespace
+
+	SDOTransfer::SDOTransfer(MailboxInfo mailbox, uint16_t index, uint8_t subIndex,
+	    std::optional<std::vector<uint8_t>> data, datatypes::TimeStep timeout,
+	    datatypes::TimeStamp now)
+	    : mailbox(mailbox)
+	    , index(index)
+	    , subIndex(subIndex)
+	    , readTransfer(!data.has_value())
+	    , data(std::move(data).value_or(std::vector<uint8_t>()))
+	    , timeout(timeout)
+	    , deadline(now + timeout)
+	{
+		if (mailbox.counter == nullptr || mailbox.writeLength < normalDataOffset
+		    || mailbox.readLength < normalDataOffset
+		    || std::max(mailbox.writeLength, mailbox.readLength) + pduHeaderSize
+		            + sizeof(uint16_t)
+		        > maxTotalPDULength)
+		{
+			fail("The slave has no usable mailbox");
+			return;
+		}
+		prepareInitiateRequest();
+	}
+
+	size_t SDOTransfer::prepareFrame(EtherCATFrame& frame, datatypes::TimeStamp now)
+	{
+		if (step != Step::FINISHED && now > deadline)
+		{
+			fail("The slave did not answer in time");
+		}
+		switch (step)
+		{
+		case Step::CHECK_WRITE_MAILBOX:
+			return writeFrame(frame, fprdCommandType, mailbox.slaveConfiguredAddress,
+			    sm0StatusRegister, nullptr, 1);
+		case Step::WRITE_REQUEST:
+			return writeFrame(frame, fpwrCommandType, mailbox.slaveConfiguredAddress,
+			    mailbox.writeOffset, request.data(), mailbox.writeLength);
+		case Step::CHECK_READ_MAILBOX:
+			return writeFrame(frame, fprdCommandType, mailbox.slaveConfiguredAddress,
+			    sm1StatusRegister, nullptr, 1);
+		case Step::READ_RESPONSE:
+			return writeFrame(frame, fprdCommandType, mailbox.slaveConfiguredAddress,
+			    mailbox.readOffset, nullptr, mailbox.readLength);
+		case Step::FINISHED:
+			break;
+		}
+		return 0;
+	}
+
+	void SDOTransfer::handleReply(
+	    const EtherCATFrame& reply, int workingCounter, datatypes::TimeStamp now)
+	{
+		if (workingCounter != 1)
+		{
+			return;
+		}
+		const uint8_t* replyData = reply.pduArea + pduHeaderSize; // NOLINT
+		switch (step)
+		{
+		case Step::CHECK_WRITE_MAILBOX:
+			if ((replyData[0] & mailboxFull) == 0) // NOLINT
+			{
+				step = Step::WRITE_REQUEST;
+			}
+			break;
+		case Step::WRITE_REQUEST:
+			step = Step::CHECK_READ_MAILBOX;
+			deadline = now + timeout;
+			break;
+		case Step::CHECK_READ_MAILBOX:
+			if ((replyData[0] & mailboxFull) != 0) // NOLINT
+			{
+				step = Step::READ_RESPONSE;
+			}
+			break;
+		case Step::READ_RESPONSE:
+			handleResponse(replyData);
+			break;
+		case Step::FINISHED:
+			break;
+		}
+	}
+
+	bool SDOTransfer::isFinished() const { return step == Step::FINISHED; }
+
+	bool SDOTransfer::hasFailed() const { return !error.empty(); }
+
+	const std::string& SDOTransfer::getError() const { return error; }
+
+	const std::vector<uint8_t>& SDOTransfer::getData() const { return data; }
+
+	void SDOTransfer::fail(std::string reason)
+	{
+		error = std::move(reason);
+		step = Step::FINISHED;
+	}
+
+	void SDOTransfer::writeRequestHeader(uint16_t length)
+	{
+		request.assign(mailbox.writeLength, 0);
+		*mailbox.counter = *mailbox.counter >= 7 ? 1 : *mailbox.counter + 1;
+		writeUInt16(request.data(), length);
+		request[mailboxHeaderSize - 1] = (*mailbox.counter << 4) | mailboxTypeCoE;
+		writeUInt16(request.data() + mailboxHeaderSize, coeServiceSDORequest << 12);
+		step = Step::CHECK_WRITE_MAILBOX;
+	}
+
+	void SDOTransfer::prepareInitiateRequest()
+	{
+		writeRequestHeader(coeHeaderSize + sdoHeaderSize);
+		uint8_t* sdo = request.data() + sdoOffset;
+		writeUInt16(sdo + 1, index);
+		sdo[3] = subIndex; // NOLINT
+		if (readTransfer)
+		{
+			sdo[0] = sdoUploadInitiate;
+		}
+		else if (data.size() <= expeditedMaxSize)
+		{
+			sdo[0] = sdoDownloadInitiate | sdoExpedited | sdoSizeIndicated
+			    | ((expeditedMaxSize - data.size()) << 2);
+			std::copy(data.begin(), data.end(), sdo + 4); // NOLINT
+			transferred = data.size();
+		}
+		else
+		{
+			sdo[0] = sdoDownloadInitiate | sdoSizeIndicated;
+			writeUInt32(sdo + 4, data.size()); // NOLINT
+			transferred = std::min(data.size(), mailbox.writeLength - normalDataOffset);
+			std::copy(data.begin(), data.begin() + transferred,
+			    request.data() + normalDataOffset); // NOLINT
+			writeUInt16(request.data(), coeHeaderSize + sdoHeaderSize + transferred);
+		}
+	}
+
+	void SDOTransfer::prepareSegmentRequest()
+	{
+		writeRequestHeader(coeHeaderSize + sdoHeaderSize);
+		uint8_t* sdo = request.data() + sdoOffset;
+		if (readTransfer)
+		{
+			sdo[0] = sdoUploadSegment | (toggle << sdoToggleShift);
+			return;
+		}
+		size_t segmentLength
+		    = std::min(data.size() - transferred, mailbox.writeLength - segmentDataOffset);
+		bool last = transferred + segmentLength == data.size();
+		sdo[0] = sdoDownloadSegment | (toggle << sdoToggleShift) | (last ? sdoLastSegment : 0);
+		if (segmentLength < minimumSegmentLength)
+		{
+			sdo[0] |= (minimumSegmentLength - segmentLength) << 1;
+		}
+		std::copy(data.begin() + transferred, data.begin() + transferred + segmentLength,
+		    request.data() + segmentDataOffset); // NOLINT
+		transferred += segmentLength;
+		writeUInt16(request.data(),
+		    coeHeaderSize + 1 + std::max(segmentLength, minimumSegmentLength));
+	}
+
+	void SDOTransfer::handleResponse(const uint8_t* response)
+	{
+		// Anything we cannot use is skipped and the read mailbox is polled again
+		step = Step::CHECK_READ_MAILBOX;
+
+		uint16_t length = readUInt16(response);
+		uint8_t type = response[mailboxHeaderSize - 1] & 0x0F; // NOLINT
+		if (type == mailboxTypeError)
+		{
+			fail("The slave reported a mailbox error");
+			return;
+		}
+		if (type != mailboxTypeCoE || length < coeHeaderSize + sdoHeaderSize
+		    || length + mailboxHeaderSize > mailbox.readLength)
+		{
+			return;
+		}
+		uint16_t service = readUInt16(response + mailboxHeaderSize) >> 12; // NOLINT
+		if (service != coeServiceSDORequest && service != coeServiceSDOResponse)
+		{
+			return;
+		}
+
+		const uint8_t* sdo = response + sdoOffset; // NOLINT
+		if (sdo[0] == sdoAbort)
+		{
+			std::stringstream sstream;
+			sstream << "The slave aborted the transfer with abort code 0x" << std::hex
+			        << std::setfill('0') << std::setw(8) << readUInt32(sdo + 4); // NOLINT
+			fail(sstream.str());
+			return;
+		}
+
+		if (initiated)
+		{
+			handleSegmentResponse(response, length);
+		}
+		else if (readUInt16(sdo + 1) == index && sdo[3] == subIndex) // NOLINT
+		{
+			handleInitiateResponse(response, length);
+		}
+	}
+
+	void SDOTransfer::handleInitiateResponse(const uint8_t* response, uint16_t length)
+	{
+		const uint8_t* sdo = response + sdoOffset; // NOLINT
+		uint8_t command = sdo[0] & sdoCommandMask;
+		if (!readTransfer)
+		{
+			if (command == sdoDownloadInitiateResponse)
+			{
+				initiated = true;
+				continueWithSegments();
+			}
+			return;
+		}
+		if (command != sdoUploadInitiateResponse)
+		{
+			return;
+		}
+		initiated = true;
+		if ((sdo[0] & sdoExpedited) != 0)
+		{
+			size_t size = expeditedMaxSize;
+			if ((sdo[0] & sdoSizeIndicated) != 0)
+			{
+				size -= (sdo[0] >> 2) & 0x03; // NOLINT
+			}
+			data.assign(sdo + 4, sdo + 4 + size); // NOLINT
+			completeSize = size;
+		}
+		else
+		{
+			completeSize = readUInt32(sdo + 4); // NOLINT
+			size_t available = std::min<size_t>(
+			    length - coeHeaderSize - sdoHeaderSize, completeSize);
+			data.assign(response + normalDataOffset,
+			    response + normalDataOffset + available); // NOLINT
+		}
+		continueWithSegments();
+	}
+
+	void SDOTransfer::handleSegmentResponse(const uint8_t* response, uint16_t length)
+	{
+		const uint8_t* sdo = response + sdoOffset; // NOLINT
+		uint8_t command = sdo[0] & sdoCommandMask;
+		uint8_t expectedCommand = readTransfer ? sdoUploadSegmentResponse
+		                                       : sdoDownloadSegmentResponse;
+		if (command != expectedCommand)
+		{
+			return;
+		}
+		if (((sdo[0] >> sdoToggleShift) & 1) != static_cast<uint8_t>(toggle))
+		{
+			fail("The slave answered with the wrong toggle bit");
+			return;
+		}
+		toggle = !toggle;
+		if (readTransfer)
+		{
+			size_t segmentLength = length - coeHeaderSize - 1;
+			if (segmentLength == minimumSegmentLength)
+			{
+				segmentLength -= (sdo[0] >> 1) & 0x07; // NOLINT
+			}
+			segmentLength = std::min(segmentLength, completeSize - data.size());
+			data.insert(data.end(), response + segmentDataOffset,
+			    response + segmentDataOffset + segmentLength); // NOLINT
+			if ((sdo[0] & sdoLastSegment) != 0)
+			{
+				completeSize = data.size();
+			}
+		}
+		continueWithSegments();
+	}
+
+	void SDOTransfer::continueWithSegments()
+	{
+		bool done = readTransfer ? data.size() >= completeSize : transferred >= data.size();
+		if (done)
+		{
+			step = Step::FINISHED;
+		}
+		else
+		{
+			prepareSegmentRequest();
+		}
+	}
+
+	void MailboxEngine::submit(std::shared_ptr<CoEUpdateRequest> request, SDOTransfer transfer)
+	{
+		pending.push_back({ std::move(request), std::move(transfer) });
+		moveFinished();
+	}
+
+	bool MailboxEngine::hasWork() const { return !pending.empty(); }
+
+	size_t MailboxEngine::prepareFrame(EtherCATFrame& frame, datatypes::TimeStamp now)
+	{
+		while (!pending.empty())
+		{
+			size_t length = pending.front().transfer.prepareFrame(frame, now);
+			if (length > 0)
+			{
+				return length;
+			}
+			moveFinished();
+		}
+		return 0;
+	}
+
+	void MailboxEngine::handleReply(
+	    const EtherCATFrame& reply, int workingCounter, datatypes::TimeStamp now)
+	{
+		if (!pending.empty())
+		{
+			pending.front().transfer.handleReply(reply, workingCounter, now);
+			moveFinished();
+		}
+	}
+
+	std::optional<MailboxEngine::MailboxJob> MailboxEngine::takeFinished()
+	{
+		if (finished.empty())
+		{
+			return {};
+		}
+		MailboxJob job = std::move(finished.front());
+		finished.pop_front();
+		return job;
+	}
+
+	void MailboxEngine::moveFinished()
+	{
+		while (!pending.empty() && pending.front().transfer.isFinished())
+		{
+			finished.push_back(std::move(pending.front()));
+			pending.pop_front();
+		}
+	}
+} // namespace etherkitten::reader
@@ -0,0 +1,239 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+/*!
+ * \file
+ * \brief Defines the MailboxEngine, which performs CoE SDO transfers one EtherCAT frame
+ * at a time so that they can be interleaved with the process data exchange.
+ */
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <etherkitten/datatypes/time.hpp>
+
+#include "CoEUpdateRequest.hpp"
+#include "EtherCATFrame.hpp"
+
+namespace etherkitten::reader
+{
+	/*!
+	 * \brief The MailboxInfo struct describes the mailboxes of a slave.
+	 */
+	struct MailboxInfo
+	{
+		uint16_t slaveConfiguredAddress = 0;
+
+		/*!
+		 * \brief The physical address of the mailbox the master writes to.
+		 */
+		uint16_t writeOffset = 0;
+
+		/*!
+		 * \brief The length of the mailbox the master writes to.
+		 */
+		uint16_t writeLength = 0;
+
+		/*!
+		 * \brief The physical address of the mailbox the master reads from.
+		 */
+		uint16_t readOffset = 0;
+
+		/*!
+		 * \brief The length of the mailbox the master reads from.
+		 */
+		uint16_t readLength = 0;
+
+		/*!
+		 * \brief The mailbox counter of the slave, which must be shared with everything
+		 * else that writes to the mailbox of the slave.
+		 */
+		uint8_t* counter = nullptr;
+	};
+
+	/*!
+	 * \brief The SDOTransfer class is a state machine that reads or writes a single CoE object
+	 * via SDO services.
+	 *
+	 * Each step of the transfer consists of a single EtherCAT frame with a single PDU:
+	 * checking that the slave's write mailbox is empty, writing a request to it,
+	 * polling the slave's read mailbox until it is full and reading the response from it.
+	 * Expedited, normal and segmented transfers are supported in both directions.
+	 */
+	class SDOTransfer
+	{
+	public:
+		/*!
+		 * \brief Create a new SDOTransfer.
+		 * \param mailbox the mailboxes of the slave that holds the CoE object
+		 * \param index the index of the CoE object
+		 * \param subIndex the subindex of the CoE object
+		 * \param data the data to write, or nothing to read the CoE object
+		 * \param timeout the time the slave may take to answer a single request
+		 * \param now the current time
+		 */
+		SDOTransfer(MailboxInfo mailbox, uint16_t index, uint8_t subIndex,
+		    std::optional<std::vector<uint8_t>> data, datatypes::TimeStep timeout,
+		    datatypes::TimeStamp now);
+
+		/*!
+		 * \brief Write the frame for the next step of this transfer.
+		 *
+		 * Fails the transfer if the slave has not answered in time.
+		 * \param frame the frame to write to
+		 * \param now the current time
+		 * \return the length of the frame, or 0 if this transfer is finished
+		 */
+		size_t prepareFrame(EtherCATFrame& frame, datatypes::TimeStamp now);
+
+		/*!
+		 * \brief Advance this transfer with the reply to the frame from prepareFrame().
+		 *
+		 * If the working counter shows that the slave did not process the frame,
+		 * the same step is repeated.
+		 * \param reply the frame that was received
+		 * \param workingCounter the working counter of the received frame
+		 * \param now the current time
+		 */
+		void handleReply(const EtherCATFrame& reply, int workingCounter, datatypes::TimeStamp now);
+
+		/*!
+		 * \brief Check whether this transfer has finished, successfully or not.
+		 * \retval true iff this transfer needs no more frames
+		 */
+		bool isFinished() const;
+
+		/*!
+		 * \brief Check whether this transfer has failed.
+		 * \retval true iff this transfer has failed
+		 */
+		bool hasFailed() const;
+
+		/*!
+		 * \brief Get the reason this transfer has failed.
+		 * \return a description of the failure, or an empty string if it has not failed
+		 */
+		const std::string& getError() const;
+
+		/*!
+		 * \brief Get the data this transfer has read or written.
+		 * \return the data of the CoE object
+		 */
+		const std::vector<uint8_t>& getData() const;
+
+	private:
+		enum class Step
+		{
+			CHECK_WRITE_MAILBOX,
+			WRITE_REQUEST,
+			CHECK_READ_MAILBOX,
+			READ_RESPONSE,
+			FINISHED
+		};
+
+		MailboxInfo mailbox;
+		uint16_t index;
+		uint8_t subIndex;
+		bool readTransfer;
+		std::vector<uint8_t> data;
+		datatypes::TimeStep timeout;
+		datatypes::TimeStamp deadline;
+
+		Step step = Step::CHECK_WRITE_MAILBOX;
+		bool initiated = false;
+		bool toggle = false;
+		size_t transferred = 0;
+		size_t completeSize = 0;
+		std::vector<uint8_t> request;
+		std::string error;
+
+		void fail(std::string reason);
+		void writeRequestHeader(uint16_t length);
+		void prepareInitiateRequest();
+		void prepareSegmentRequest();
+		void handleResponse(const uint8_t* response);
+		void handleInitiateResponse(const uint8_t* response, uint16_t length);
+		void handleSegmentResponse(const uint8_t* response, uint16_t length);
+		void continueWithSegments();
+	};
+
+	/*!
+	 * \brief The MailboxEngine class runs CoEUpdateRequests as SDOTransfers, one after another
+	 * and one frame at a time.
+	 *
+	 * Its user exchanges at most one frame per cycle of the realtime loop, so no CoE request
+	 * can hold up the process data exchange for longer than a single frame takes.
+	 */
+	class MailboxEngine
+	{
+	public:
+		/*!
+		 * \brief The MailboxJob struct pairs a CoEUpdateRequest with the transfer serving it.
+		 */
+		struct MailboxJob
+		{
+			std::shared_ptr<CoEUpdateRequest> request;
+			SDOTransfer transfer;
+		};
+
+		/*!
+		 * \brief Queue a transfer after all the transfers already queued.
+		 * \param request the request the transfer serves
+		 * \param transfer the transfer to queue
+		 */
+		void submit(std::shared_ptr<CoEUpdateRequest> request, SDOTransfer transfer);
+
+		/*!
+		 * \brief Check whether there are transfers that have not finished yet.
+		 * \retval true iff prepareFrame() may produce a frame
+		 */
+		bool hasWork() const;
+
+		/*!
+		 * \brief Write the frame for the next step of the current transfer.
+		 * \param frame the frame to write to
+		 * \param now the current time
+		 * \return the length of the frame, or 0 if there is nothing to send
+		 */
+		size_t prepareFrame(EtherCATFrame& frame, datatypes::TimeStamp now);
+
+		/*!
+		 * \brief Advance the current transfer with the reply to the frame from prepareFrame().
+		 * \param reply the frame that was received
+		 * \param workingCounter the working counter of the received frame
+		 * \param now the current time
+		 */
+		void handleReply(const EtherCATFrame& reply, int workingCounter, datatypes::TimeStamp now);
+
+		/*!
+		 * \brief Take the oldest finished transfer out of this MailboxEngine.
+		 * \return the finished transfer with its request, or nothing if none has finished
+		 */
+		std::optional<MailboxJob> takeFinished();
+
+	private:
+		std::deque<MailboxJob> pending;
+		std::deque<MailboxJob> finished;
+
+		void moveFinished();
+	};
+} // namespace etherkitten::reader
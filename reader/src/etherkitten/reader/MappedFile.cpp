@@ -0,0 +1,67 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "MappedFile.hpp"
+
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace etherkitten::reader
+{
+	MappedFile::MappedFile(const std::filesystem::path& path)
+	{
+		int fd = open(path.c_str(), O_RDONLY); // NOLINT
+		if (fd < 0)
+		{
+			throw std::runtime_error("cannot open " + path.string());
+		}
+		struct stat status
+		{
+		};
+		if (fstat(fd, &status) != 0)
+		{
+			close(fd);
+			throw std::runtime_error("cannot get the size of " + path.string());
+		}
+		size = status.st_size;
+		if (size > 0)
+		{
+			void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (mapping == MAP_FAILED) // NOLINT
+			{
+				close(fd);
+				throw std::runtime_error("cannot map " + path.string() + " into memory");
+			}
+			// Logs are mostly read front to back
+			madvise(mapping, size, MADV_SEQUENTIAL);
+			data = static_cast<const char*>(mapping);
+		}
+		// The mapping stays valid without the file descriptor
+		close(fd);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (data != nullptr)
+		{
+			munmap(const_cast<char*>(data), size); // NOLINT
+		}
+	}
+} // namespace etherkitten::reader
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+/*!
+ * \file
+ * \brief Defines the MappedFile, a file that is mapped into memory for reading.
+ */
+
+#include <cstdint>
+#include <filesystem>
+
+#include "log/Serialized.hpp"
+
+namespace etherkitten::reader
+{
+	/*!
+	 * \brief The MappedFile maps a file into memory read-only for as long as it exists.
+	 *
+	 * This allows parsing the blocks of a log in place instead of reading each of them
+	 * into a buffer of its own.
+	 */
+	class MappedFile
+	{
+	public:
+		/*!
+		 * \brief Map a file into memory.
+		 * \param path the file to map
+		 * \exception std::runtime_error iff the file cannot be opened or mapped
+		 */
+		explicit MappedFile(const std::filesystem::path& path);
+
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+
+		MappedFile(MappedFile&&) = delete;
+
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		MappedFile& operator=(MappedFile&&) = delete;
+
+		/*!
+		 * \brief Get the contents of the file.
+		 * \return the file's contents, which are only valid while this MappedFile exists
+		 */
+		const char* getData() const { return data; }
+
+		/*!
+		 * \brief Get the size of the file.
+		 * \return the size in bytes
+		 */
+		uint64_t getSize() const { return size; }
+
+		/*!
+		 * \brief Get the contents of the file as a Serialized object that does not own them.
+		 * \return the file's contents, which are only valid while this MappedFile exists
+		 */
+		Serialized getSerialized() const { return Serialized::wrap(data, size); }
+
+	private:
+		const char* data = nullptr;
+		uint64_t size = 0;
+	};
+} // namespace etherkitten::reader
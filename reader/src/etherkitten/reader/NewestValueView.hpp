@@ -63,14 +63,22 @@ namespace etherkitten::reader
 
 		const datatypes::AbstractDataPoint& operator*() override
 		{
-			ListLocation<Type, NodeSize> location = list.getNewest();
+			auto [location, time] = list.getNewestSample();
 			if constexpr (datatypes::is_unique_ptr<Type>())
 			{
 				dataPointCopy = datatypes::DataPoint{
 					Converter<typename Type::pointer, Output>::shiftAndConvert(
 					    location.node->values[location.index].get(), bitOffset, bitLength,
 					    flipBytes),
-					location.node->times[location.index]
+					time
+				};
+			}
+			else if constexpr (std::is_same<Type, IOMapSlab>())
+			{
+				dataPointCopy = datatypes::DataPoint{
+					Converter<IOMap*, Output>::shiftAndConvert(
+					    location.node->at(location.index), bitOffset, bitLength, flipBytes),
+					time
 				};
 			}
 			else
@@ -78,7 +86,7 @@ namespace etherkitten::reader
 				dataPointCopy = datatypes::DataPoint{ Converter<Type, Output>::shiftAndConvert(
 					                                      location.node->values[location.index],
 					                                      bitOffset, bitLength, flipBytes),
-					location.node->times[location.index] };
+					time };
 			}
 			return dataPointCopy;
 		}
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ParallelChunkDecoder.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace etherkitten::reader
+{
+	ParallelChunkDecoder::ParallelChunkDecoder(const MappedFile& file,
+	    const ChunkIndexBlock& index, size_t ioMapSize, unsigned int workerCount)
+	    : file(file)
+	    , index(index)
+	    , ioMapSize(ioMapSize)
+	    , slots(index.getChunks().size())
+	{
+		if (workerCount == 0)
+		{
+			// hardware_concurrency may not know the number of hardware threads
+			workerCount = std::max(std::thread::hardware_concurrency(), 1U);
+		}
+		workerCount = std::min<size_t>(workerCount, std::max<size_t>(slots.size(), 1));
+		chunksAhead = workerCount * chunksAheadPerWorker;
+		workers.reserve(workerCount);
+		for (unsigned int i = 0; i < workerCount; ++i)
+		{
+			workers.emplace_back(&ParallelChunkDecoder::decodeChunks, this);
+		}
+	}
+
+	ParallelChunkDecoder::~ParallelChunkDecoder()
+	{
+		{
+			std::lock_guard guard(mutex);
+			stopped = true;
+		}
+		taken.notify_all();
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	std::unique_ptr<const DecodedChunk> ParallelChunkDecoder::takeNext()
+	{
+		std::unique_lock lock(mutex);
+		if (nextToTake >= slots.size())
+		{
+			throw std::out_of_range("all chunks were taken");
+		}
+		Slot& slot = slots[nextToTake];
+		decoded.wait(lock, [&slot] { return slot.done; });
+		++nextToTake;
+		std::unique_ptr<const DecodedChunk> chunk = std::move(slot.chunk);
+		lock.unlock();
+		// A worker may be waiting for the window to move on
+		taken.notify_one();
+		return chunk;
+	}
+
+	void ParallelChunkDecoder::decodeChunks()
+	{
+		std::unique_lock lock(mutex);
+		while (true)
+		{
+			taken.wait(lock, [this] {
+				return stopped || nextToDecode >= slots.size()
+				    || nextToDecode < nextToTake + chunksAhead;
+			});
+			if (stopped || nextToDecode >= slots.size())
+			{
+				return;
+			}
+			size_t chunk = nextToDecode++;
+			lock.unlock();
+
+			std::unique_ptr<const DecodedChunk> decodedChunk;
+			const ChunkEntryBlock& entry = index.getChunks()[chunk];
+			if (entry.offset <= file.getSize() && entry.length <= file.getSize() - entry.offset)
+			{
+				try
+				{
+					Serialized data = Serialized::wrap(file.getData() + entry.offset, entry.length);
+					decodedChunk = std::make_unique<const DecodedChunk>(data, ioMapSize);
+				}
+				catch (const std::runtime_error& e)
+				{
+					// The chunk is handed out as nullptr
+				}
+			}
+
+			lock.lock();
+			slots[chunk].chunk = std::move(decodedChunk);
+			slots[chunk].done = true;
+			decoded.notify_all();
+		}
+	}
+} // namespace etherkitten::reader
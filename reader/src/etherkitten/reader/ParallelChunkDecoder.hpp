@@ -0,0 +1,120 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+/*!
+ * \file
+ * \brief Defines the ParallelChunkDecoder, which decodes the chunks of a log on several
+ * threads and hands them out in the order of the chunk index.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "LogChunkCache.hpp"
+#include "MappedFile.hpp"
+#include "log/chunkindex.hpp"
+
+namespace etherkitten::reader
+{
+	/*!
+	 * \brief The ParallelChunkDecoder decodes the chunks of an indexed log on worker
+	 * threads and hands them out in the order of the chunk index.
+	 *
+	 * The SearchLists of a SearchListReader must be filled in time order, so the
+	 * decoded chunks are taken from a single thread, one after the other.
+	 * The workers only decode a few chunks ahead of the one that is taken next,
+	 * so the memory used for decoded chunks does not grow with the size of the log.
+	 */
+	class ParallelChunkDecoder
+	{
+	public:
+		/*!
+		 * \brief The number of chunks every worker may decode ahead of the one taken next.
+		 */
+		static constexpr size_t chunksAheadPerWorker = 2;
+
+		/*!
+		 * \brief Start decoding the chunks of a log.
+		 * \param file the log file, which must outlive the ParallelChunkDecoder
+		 * \param index the ChunkIndexBlock of the log, which must outlive the
+		 * ParallelChunkDecoder
+		 * \param ioMapSize the size of the IOMaps in the log
+		 * \param workerCount the number of threads to decode with, 0 for one per hardware thread
+		 */
+		ParallelChunkDecoder(const MappedFile& file, const ChunkIndexBlock& index,
+		    size_t ioMapSize, unsigned int workerCount);
+
+		/*!
+		 * \brief Stop the workers, even if not all chunks were taken.
+		 */
+		~ParallelChunkDecoder();
+
+		ParallelChunkDecoder(const ParallelChunkDecoder&) = delete;
+
+		ParallelChunkDecoder(ParallelChunkDecoder&&) = delete;
+
+		ParallelChunkDecoder& operator=(const ParallelChunkDecoder&) = delete;
+
+		ParallelChunkDecoder& operator=(ParallelChunkDecoder&&) = delete;
+
+		/*!
+		 * \brief Take the next chunk in the order of the chunk index, waiting until it
+		 * is decoded.
+		 *
+		 * Must be called at most once per chunk in the index.
+		 * \return the decoded chunk, or nullptr iff the chunk could not be decoded
+		 */
+		std::unique_ptr<const DecodedChunk> takeNext();
+
+		/*!
+		 * \brief Get the number of threads that decode the chunks.
+		 * \return the number of worker threads
+		 */
+		size_t getWorkerCount() const { return workers.size(); }
+
+	private:
+		/*!
+		 * \brief The state of a chunk that is decoded or waits to be taken.
+		 */
+		struct Slot
+		{
+			bool done = false;
+			std::unique_ptr<const DecodedChunk> chunk;
+		};
+
+		const MappedFile& file;
+		const ChunkIndexBlock& index;
+		const size_t ioMapSize;
+		size_t chunksAhead;
+		std::mutex mutex;
+		std::condition_variable decoded;
+		std::condition_variable taken;
+		std::vector<Slot> slots;
+		size_t nextToDecode = 0;
+		size_t nextToTake = 0;
+		bool stopped = false;
+		std::vector<std::thread> workers;
+
+		void decodeChunks();
+	};
+} // namespace etherkitten::reader
@@ -24,6 +24,7 @@
 
 #include <map>
 #include <memory>
+#include <thread>
 #include <vector>
 
 #include <etherkitten/datatypes/SlaveInfo.hpp>
@@ -31,6 +32,7 @@
 #include <etherkitten/datatypes/dataviews.hpp>
 #include <etherkitten/datatypes/time.hpp>
 
+#include "CycleHistogram.hpp"
 #include "DataView.hpp"
 #include "IOMap.hpp"
 
@@ -76,6 +78,15 @@ namespace etherkitten::reader
 		    const datatypes::Register& reg)
 		    = 0;
 
+		/*!
+		 * \brief Return a view for the newest value of the given CycleStatistic.
+		 * \param statistic the CycleStatistic to return a view for
+		 * \return a view for the newest value of the given CycleStatistic
+		 */
+		virtual std::unique_ptr<datatypes::AbstractNewestValueView> getNewest(
+		    const datatypes::CycleStatistic& statistic)
+		    = 0;
+
 		/*!
 		 * \brief Return a view for all recorded values of the given PDO.
 		 * \param pdo the PDO to return a view for
@@ -96,12 +107,32 @@ namespace etherkitten::reader
 		    const datatypes::Register& reg, datatypes::TimeSeries time)
 		    = 0;
 
+		/*!
+		 * \brief Return a view for the values of the given CycleStatistic, one per cycle.
+		 * \param statistic the CycleStatistic to return a view for
+		 * \param time the time series for the DataView
+		 * \return a view for all values of the given CycleStatistic
+		 */
+		virtual std::shared_ptr<datatypes::AbstractDataView> getView(
+		    const datatypes::CycleStatistic& statistic, datatypes::TimeSeries time)
+		    = 0;
+
+		/*!
+		 * \brief Return the histogram of all values of the given CycleStatisticType.
+		 *
+		 * Unlike the values in the views, the histogram covers every cycle since the start,
+		 * even if the values themselves have been freed to save memory.
+		 * \param type the CycleStatisticType to return the histogram for
+		 * \return the histogram of the values of the given type
+		 */
+		virtual const CycleHistogram& getCycleHistogram(datatypes::CycleStatisticType type) = 0;
+
 		/*!
 		 * \brief Return a view for the unprocessed IOMap data
 		 * \param startTime the timestamp of the first data point
 		 * \return a view for all IOMaps after startTime
 		 */
-		virtual std::shared_ptr<DataView<std::unique_ptr<IOMap>, nodeSize, IOMap*>> getIOMapView(
+		virtual std::shared_ptr<DataView<IOMapSlab, nodeSize, IOMap*>> getIOMapView(
 		    datatypes::TimeStamp startTime)
 		    = 0;
 
@@ -167,6 +198,32 @@ namespace etherkitten::reader
 		 */
 		virtual void setMaximumMemory(size_t size) = 0;
 
+		/*!
+		 * \brief Set whether registers are stored as runs of equal values.
+		 *
+		 * In that mode, only the first and the last sample of every run of equal register
+		 * values are kept, so the memory holds a much longer history of registers that
+		 * rarely change. Readers that do not support it keep every sample.
+		 * \param enabled whether to store runs of register values
+		 */
+		virtual void setRegisterRunLengthStorage(bool enabled) { (void)enabled; }
+
+		/*!
+		 * \brief Wait until new data may be available from the views of this Reader
+		 * or the timeout has passed.
+		 *
+		 * Readers that do not announce new data sleep for the whole timeout.
+		 * Only one thread may wait for new data at a time.
+		 * \param seen the value returned by the previous call, 0 for the first call
+		 * \param timeout the maximum time to wait
+		 * \return the value to pass to the next call
+		 */
+		virtual uint32_t waitForNewData(uint32_t seen, datatypes::TimeStep timeout)
+		{
+			std::this_thread::sleep_for(timeout);
+			return seen;
+		}
+
 		/*!
 		 * \brief Get a TimeStamp that is earlier than all DataPoints offered by this Reader.
 		 *
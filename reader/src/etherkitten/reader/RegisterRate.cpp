@@ -0,0 +1,84 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "RegisterRate.hpp"
+
+namespace etherkitten::reader
+{
+	const std::unordered_map<datatypes::RegisterEnum, RegisterRate>& getDefaultRegisterRates()
+	{
+		using datatypes::RegisterEnum;
+		static constexpr RegisterRate errorCounterRate{ 1000, RegisterPriority::HIGH };
+		static constexpr RegisterRate statusRate{ 100, RegisterPriority::NORMAL };
+		static constexpr RegisterRate staticInfoRate{ 1, RegisterPriority::LOW };
+
+		static const std::unordered_map<RegisterEnum, RegisterRate> rates = {
+			{ RegisterEnum::TYPE, staticInfoRate },
+			{ RegisterEnum::REVISION, staticInfoRate },
+			{ RegisterEnum::BUILD, staticInfoRate },
+			{ RegisterEnum::RAM_SIZE, staticInfoRate },
+			{ RegisterEnum::PORT0_DESCRIPTOR, staticInfoRate },
+			{ RegisterEnum::PORT1_DESCRIPTOR, staticInfoRate },
+			{ RegisterEnum::PORT2_DESCRIPTOR, staticInfoRate },
+			{ RegisterEnum::PORT3_DESCRIPTOR, staticInfoRate },
+			{ RegisterEnum::FMMU_BIT_NOT_SUPPORTED, staticInfoRate },
+			{ RegisterEnum::NO_SUPPORT_RESERVED_REGISTER, staticInfoRate },
+			{ RegisterEnum::DC_SUPPORTED, staticInfoRate },
+			{ RegisterEnum::DC_RANGE, staticInfoRate },
+			{ RegisterEnum::LOW_JITTER_EBUS, staticInfoRate },
+			{ RegisterEnum::ENHANCED_LINK_DETECTION_EBUS, staticInfoRate },
+			{ RegisterEnum::ENHANCED_LINK_DETECTION_MII, staticInfoRate },
+			{ RegisterEnum::SEPARATE_FCS_ERROR_HANDLING, staticInfoRate },
+			{ RegisterEnum::CONFIGURED_STATION_ADDRESS, staticInfoRate },
+			{ RegisterEnum::CONFIGURED_STATION_ALIAS, staticInfoRate },
+			{ RegisterEnum::DLS_USER_OPERATIONAL, statusRate },
+			{ RegisterEnum::LINK_STATUS_PORT_0, statusRate },
+			{ RegisterEnum::LINK_STATUS_PORT_1, statusRate },
+			{ RegisterEnum::LINK_STATUS_PORT_2, statusRate },
+			{ RegisterEnum::LINK_STATUS_PORT_3, statusRate },
+			{ RegisterEnum::LOOP_STATUS_PORT_0, statusRate },
+			{ RegisterEnum::SIGNAL_DETECTION_PORT_0, statusRate },
+			{ RegisterEnum::LOOP_STATUS_PORT_1, statusRate },
+			{ RegisterEnum::SIGNAL_DETECTION_PORT_1, statusRate },
+			{ RegisterEnum::LOOP_STATUS_PORT_2, statusRate },
+			{ RegisterEnum::SIGNAL_DETECTION_PORT_2, statusRate },
+			{ RegisterEnum::LOOP_STATUS_PORT_3, statusRate },
+			{ RegisterEnum::SIGNAL_DETECTION_PORT_3, statusRate },
+			{ RegisterEnum::STATUS_CONTROL, statusRate },
+			{ RegisterEnum::STATUS, statusRate },
+			{ RegisterEnum::FRAME_ERROR_COUNTER_PORT_0, errorCounterRate },
+			{ RegisterEnum::PHYSICAL_ERROR_COUNTER_PORT_0, errorCounterRate },
+			{ RegisterEnum::FRAME_ERROR_COUNTER_PORT_1, errorCounterRate },
+			{ RegisterEnum::PHYSICAL_ERROR_COUNTER_PORT_1, errorCounterRate },
+			{ RegisterEnum::FRAME_ERROR_COUNTER_PORT_2, errorCounterRate },
+			{ RegisterEnum::PHYSICAL_ERROR_COUNTER_PORT_2, errorCounterRate },
+			{ RegisterEnum::FRAME_ERROR_COUNTER_PORT_3, errorCounterRate },
+			{ RegisterEnum::PHYSICAL_ERROR_COUNTER_PORT_3, errorCounterRate },
+			{ RegisterEnum::PREVIOUS_ERROR_COUNTER_PORT_0, errorCounterRate },
+			{ RegisterEnum::PREVIOUS_ERROR_COUNTER_PORT_1, errorCounterRate },
+			{ RegisterEnum::PREVIOUS_ERROR_COUNTER_PORT_2, errorCounterRate },
+			{ RegisterEnum::PREVIOUS_ERROR_COUNTER_PORT_3, errorCounterRate },
+			{ RegisterEnum::MALFORMAT_FRAME_COUNTER, errorCounterRate },
+			{ RegisterEnum::LOCAL_PROBLEM_COUNTER, errorCounterRate },
+			{ RegisterEnum::LOST_LINK_COUNTER_PORT_0, errorCounterRate },
+			{ RegisterEnum::LOST_LINK_COUNTER_PORT_1, errorCounterRate },
+			{ RegisterEnum::LOST_LINK_COUNTER_PORT_2, errorCounterRate },
+			{ RegisterEnum::LOST_LINK_COUNTER_PORT_3, errorCounterRate },
+		};
+		return rates;
+	}
+} // namespace etherkitten::reader
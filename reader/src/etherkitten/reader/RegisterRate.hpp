@@ -0,0 +1,70 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+/*!
+ * \file
+ * \brief Defines RegisterRate, which sets how often the BusReader reads a register.
+ */
+
+#include <unordered_map>
+
+#include <etherkitten/datatypes/register.hpp>
+
+namespace etherkitten::reader
+{
+	/*!
+	 * \brief The RegisterPriority decides which registers are read first when not all
+	 * registers that are due fit into a cycle.
+	 */
+	enum class RegisterPriority
+	{
+		LOW,
+		NORMAL,
+		HIGH,
+	};
+
+	/*!
+	 * \brief The RegisterRate struct defines how often a register is read.
+	 */
+	struct RegisterRate
+	{
+		/*!
+		 * \brief The number of times per second the register is read,
+		 * 0 to read it as often as the cycles leave room for.
+		 */
+		double frequency = 0;
+
+		/*!
+		 * \brief The priority of the register among the registers with a frequency.
+		 *
+		 * Registers without a frequency are only read once all registers with one
+		 * that are due have been read.
+		 */
+		RegisterPriority priority = RegisterPriority::NORMAL;
+	};
+
+	/*!
+	 * \brief Get the rates the BusReader reads registers at unless told otherwise.
+	 *
+	 * The error counters are read at 1 kHz, the DL and AL status at 100 Hz, and the
+	 * static information about the slaves once per second. All other registers are read
+	 * as often as the cycles leave room for.
+	 * \return the default rates of the registers
+	 */
+	const std::unordered_map<datatypes::RegisterEnum, RegisterRate>& getDefaultRegisterRates();
+} // namespace etherkitten::reader
@@ -20,8 +20,10 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstring>
+#include <map>
 #include <stdexcept>
 
 #include <etherkitten/datatypes/dataobjects.hpp>
@@ -32,16 +34,37 @@ namespace etherkitten::reader
 {
 	RegisterScheduler::RegisterScheduler(const std::vector<uint16_t>& slaveConfiguredAddresses,
 	    const std::unordered_map<datatypes::RegisterEnum, bool>& toRead)
+	    : RegisterScheduler(slaveConfiguredAddresses, toRead, {})
+	{
+	}
+
+	RegisterScheduler::RegisterScheduler(const std::vector<uint16_t>& slaveConfiguredAddresses,
+	    const std::unordered_map<datatypes::RegisterEnum, bool>& toRead,
+	    const std::unordered_map<datatypes::RegisterEnum, RegisterRate>& rates)
+	    : RegisterScheduler(slaveConfiguredAddresses, toRead, rates, {})
+	{
+	}
+
+	RegisterScheduler::RegisterScheduler(const std::vector<uint16_t>& slaveConfiguredAddresses,
+	    const std::unordered_map<datatypes::RegisterEnum, bool>& toRead,
+	    const std::unordered_map<datatypes::RegisterEnum, RegisterRate>& rates,
+	    MappedRegisterBlock mappedBlock)
 	    : currentFrameList(new EtherCATFrameList())
 	    , slaveConfiguredAddresses(slaveConfiguredAddresses)
+	    , toRead(toRead)
+	    , mappedBlock(std::move(mappedBlock))
 	{
-		changeRegisterSettings(toRead);
+		changeRegisterRates(rates);
 	}
 
 	RegisterScheduler::RegisterScheduler(const RegisterScheduler& other)
 	    : currentFrameList(other.currentFrameList.load(std::memory_order_acquire))
 	    , frameLists{ new EtherCATFrameList(*currentFrameList) }
 	    , slaveConfiguredAddresses(other.slaveConfiguredAddresses)
+	    , toRead(other.toRead)
+	    , rates(other.rates)
+	    , mappedBlock(other.mappedBlock)
+	    , reservedFrameSpace(other.reservedFrameSpace)
 	{
 	}
 
@@ -49,6 +72,10 @@ namespace etherkitten::reader
 	    : currentFrameList(other.currentFrameList.load(std::memory_order_acquire))
 	    , frameLists(std::move(other.frameLists))
 	    , slaveConfiguredAddresses(std::move(other.slaveConfiguredAddresses))
+	    , toRead(std::move(other.toRead))
+	    , rates(std::move(other.rates))
+	    , mappedBlock(std::move(other.mappedBlock))
+	    , reservedFrameSpace(other.reservedFrameSpace)
 	{
 	}
 
@@ -58,6 +85,10 @@ namespace etherkitten::reader
 		    other.currentFrameList.load(std::memory_order_acquire), std::memory_order_release);
 		this->frameLists.push_back(new EtherCATFrameList(*currentFrameList)); // NOLINT
 		this->slaveConfiguredAddresses = other.slaveConfiguredAddresses;
+		this->toRead = other.toRead;
+		this->rates = other.rates;
+		this->mappedBlock = other.mappedBlock;
+		this->reservedFrameSpace = other.reservedFrameSpace;
 		return *this;
 	}
 
@@ -68,6 +99,10 @@ namespace etherkitten::reader
 		auto tmp = std::move(other.frameLists);
 		this->frameLists.insert(this->frameLists.end(), tmp.begin(), tmp.end());
 		this->slaveConfiguredAddresses = std::move(other.slaveConfiguredAddresses);
+		this->toRead = std::move(other.toRead);
+		this->rates = std::move(other.rates);
+		this->mappedBlock = std::move(other.mappedBlock);
+		this->reservedFrameSpace = other.reservedFrameSpace;
 		return *this;
 	}
 
@@ -85,11 +120,43 @@ namespace etherkitten::reader
 	}
 
 	EtherCATFrameIterator RegisterScheduler::getNextFrames(int frameCount)
+	{
+		return getNextFrames(frameCount, datatypes::now());
+	}
+
+	EtherCATFrameIterator RegisterScheduler::getNextFrames(
+	    int frameCount, datatypes::TimeStamp time)
 	{
 		EtherCATFrameList* list = currentFrameList.load(std::memory_order_acquire);
-		size_t nextIndex = list->nextIndex;
-		list->nextIndex = (list->nextIndex + frameCount) % list->list.size();
-		return EtherCATFrameIterator(list, nextIndex, frameCount);
+		size_t maximumCount = frameCount > 0 ? frameCount : 0;
+		list->selection.clear();
+
+		// The schedules are ordered by priority, so the important frames are taken first
+		for (size_t i = 0; i < list->schedules.size() && list->selection.size() < maximumCount;
+		     ++i)
+		{
+			FrameSchedule& schedule = list->schedules[i];
+			if (schedule.nextRead > time)
+			{
+				continue;
+			}
+			list->selection.push_back(i);
+			schedule.nextRead += schedule.period;
+			if (schedule.nextRead <= time)
+			{
+				// A frame that fell behind is not read in bursts to catch up
+				schedule.nextRead = time + schedule.period;
+			}
+		}
+
+		size_t roundRobinStart = list->schedules.size();
+		size_t roundRobinCount = list->list.size() - roundRobinStart;
+		while (roundRobinCount > 0 && list->selection.size() < maximumCount)
+		{
+			list->selection.push_back(roundRobinStart + list->nextIndex);
+			list->nextIndex = (list->nextIndex + 1) % roundRobinCount;
+		}
+		return EtherCATFrameIterator(list);
 	}
 
 	/*!
@@ -183,58 +250,110 @@ namespace etherkitten::reader
 	void RegisterScheduler::changeRegisterSettings(
 	    const std::unordered_map<datatypes::RegisterEnum, bool>& toRead)
 	{
-		auto intervals = createFrameIntervals(toRead);
-		EtherCATFrameList* newList = createEtherCATFrameList(intervals);
-		frameLists.push_back(newList);
-		currentFrameList.store(newList, std::memory_order_release);
+		this->toRead = toRead;
+		createEtherCATFrameList();
+	}
+
+	void RegisterScheduler::changeRegisterRates(
+	    const std::unordered_map<datatypes::RegisterEnum, RegisterRate>& rates)
+	{
+		for (auto& entry : rates)
+		{
+			if (!std::isfinite(entry.second.frequency) || entry.second.frequency < 0)
+			{
+				throw std::invalid_argument("register frequencies must be finite and not negative");
+			}
+		}
+		this->rates = rates;
+		createEtherCATFrameList();
 	}
 
+	void RegisterScheduler::reserveFrameSpace(size_t length)
+	{
+		if (length > maxReservedFrameSpace)
+		{
+			throw std::invalid_argument("at most half of a frame can be reserved");
+		}
+		reservedFrameSpace = length;
+		createEtherCATFrameList();
+	}
+
+	/*!
+	 * \brief The PDUPlan struct describes a PDU before it is placed in an EtherCAT frame.
+	 */
+	struct PDUPlan
+	{
+		uint8_t commandType; /*!< FPRD or LRD */
+		uint16_t position; /*!< The slave address, or the lower half of the logical address */
+		uint16_t offset; /*!< The register address, or the upper half of the logical address */
+		int start; /*!< The first register address read from every slave */
+		int end; /*!< The register address after the ones read from every slave */
+		std::vector<uint16_t> slaves; /*!< The slaves the PDU reads from, in order */
+
+		/*!
+		 * \brief Get the length of the data section of the PDU.
+		 * \return the length in bytes
+		 */
+		int getDataLength() const { return (end - start) * static_cast<int>(slaves.size()); }
+	};
+
 	/*!
-	 * \brief Create the PDUMetaData for a PDU in an EtherCAT frame.
-	 * \param pduInterval the PDU interval (associated with a slave) to generate metadata for
+	 * \brief Create the PDUMetaData for a PDU in an EtherCAT frame, one for each slave
+	 * the PDU reads from.
+	 * \param plan the plan of the PDU
 	 * \param pduOffset the offset of the PDU relative to the start of the EtherCATFrame
-	 * \return the PDU metadata
+	 * \param pdus the PDU metadata to append to
 	 */
-	PDUMetaData createPDUMetaData(std::tuple<uint16_t, int, int> pduInterval, size_t pduOffset)
+	void createPDUMetaData(const PDUPlan& plan, size_t pduOffset, std::vector<PDUMetaData>& pdus)
 	{
-		PDUMetaData result;
-		result.slaveConfiguredAddress = std::get<0>(pduInterval);
-		size_t dataLength = std::get<2>(pduInterval) - std::get<1>(pduInterval);
-		result.workingCounterOffset = pduOffset + sizeof(EtherCATPDU) - 1 + dataLength;
-
-		// This is kinda ugly and also somewhat inefficient. I just haven't found a nice way
-		// to get the required information from the top-level call all the way down here.
-		for (int address = std::get<1>(pduInterval); address < std::get<2>(pduInterval); ++address)
+		size_t dataOffset = pduOffset + sizeof(EtherCATPDU) - 1;
+		size_t blockLength = plan.end - plan.start;
+		for (size_t slave = 0; slave < plan.slaves.size(); ++slave)
 		{
-			datatypes::RegisterEnum addressAsEnum = static_cast<datatypes::RegisterEnum>(address);
-			if (datatypes::registerMap.find(addressAsEnum) != datatypes::registerMap.end())
+			PDUMetaData result;
+			result.slaveConfiguredAddress = plan.slaves[slave];
+			result.workingCounterOffset = dataOffset + plan.getDataLength();
+			result.expectedWorkingCounter = static_cast<uint16_t>(plan.slaves.size());
+			if (plan.commandType == lrdCommandType)
 			{
-				result.registerOffsets[addressAsEnum]
-				    = address - std::get<1>(pduInterval) + sizeof(EtherCATPDU) - 1 + pduOffset;
+				result.blockPart
+				    = BlockPart{ plan.start, plan.end, dataOffset + slave * blockLength };
 			}
+
+			// This is kinda ugly and also somewhat inefficient. I just haven't found a nice way
+			// to get the required information from the top-level call all the way down here.
+			for (int address = plan.start; address < plan.end; ++address)
+			{
+				datatypes::RegisterEnum addressAsEnum
+				    = static_cast<datatypes::RegisterEnum>(address);
+				if (datatypes::registerMap.find(addressAsEnum) != datatypes::registerMap.end())
+				{
+					result.registerOffsets[addressAsEnum]
+					    = dataOffset + slave * blockLength + address - plan.start;
+				}
+			}
+			pdus.push_back(std::move(result));
 		}
-		return result;
 	}
 
 	/*!
-	 * \brief Create an EtherCATFrame that reads all the given address intervals via FPRD
-	 * if sent on the EtherCAT bus.
-	 * \param slaveAssignedPDUIntervals the PDU intervals to fit in an EtherCATFrame
+	 * \brief Create an EtherCATFrame that reads with all the given PDUs if sent on the
+	 * EtherCAT bus.
+	 * \param plans the plans of the PDUs to fit in an EtherCATFrame
 	 * \return the EtherCATFrame along with its metadata
 	 * \exception std::length_error iff the PDUs are too long to fit in an EtherCAT frame
 	 */
 	std::pair<EtherCATFrame, EtherCATFrameMetaData> createEtherCATFrame(
-	    std::vector<std::tuple<uint16_t, int, int>> slaveAssignedPDUIntervals)
+	    const std::vector<PDUPlan>& plans)
 	{
 		EtherCATFrame frame{};
 		EtherCATFrameMetaData metaData{};
 
 		// Remember where we will write the next PDU
 		uint8_t* currentLocation = static_cast<uint8_t*>(frame.pduArea);
-		for (auto it = slaveAssignedPDUIntervals.begin(); it != slaveAssignedPDUIntervals.end();
-		     ++it)
+		for (auto it = plans.begin(); it != plans.end(); ++it)
 		{
-			uint16_t dataLength = std::get<2>(*it) - std::get<1>(*it);
+			uint16_t dataLength = it->getDataLength();
 			if (currentLocation + dataLength + pduOverhead // NOLINT
 			    >= static_cast<uint8_t*>(frame.pduArea + maxTotalPDULength)) // NOLINT
 			{
@@ -244,10 +363,11 @@ namespace etherkitten::reader
 
 			EtherCATPDU* pdu = new (currentLocation) EtherCATPDU; // NOLINT
 
-			pdu->slaveConfiguredAddress = flipBytesIfBigEndianHost(std::get<0>(*it));
-			pdu->registerAddress = flipBytesIfBigEndianHost(std::get<1>(*it));
+			pdu->commandType = it->commandType;
+			pdu->slaveConfiguredAddress = flipBytesIfBigEndianHost(it->position);
+			pdu->registerAddress = flipBytesIfBigEndianHost(it->offset);
 
-			if (it + 1 != slaveAssignedPDUIntervals.end())
+			if (it + 1 != plans.end())
 			{
 				static constexpr uint16_t hasNextPDU = 1 << 15;
 				pdu->dataLengthAndNext = flipBytesIfBigEndianHost(dataLength | hasNextPDU);
@@ -257,8 +377,8 @@ namespace etherkitten::reader
 				pdu->dataLengthAndNext = flipBytesIfBigEndianHost(dataLength);
 			}
 
-			metaData.pdus.push_back(createPDUMetaData(
-			    *it, currentLocation - reinterpret_cast<uint8_t*>(&frame))); // NOLINT
+			createPDUMetaData(*it, currentLocation - reinterpret_cast<uint8_t*>(&frame), // NOLINT
+			    metaData.pdus);
 
 			currentLocation += sizeof(EtherCATPDU) - 1 + dataLength + sizeof(uint16_t); // NOLINT
 		}
@@ -273,53 +393,174 @@ namespace etherkitten::reader
 	}
 
 	/*!
-	 * \brief Create an EtherCATFrameList from the given address intervals.
+	 * \brief Remove the part of the intervals that lies in the mapped block.
+	 * \param pduIntervals the intervals to split
+	 * \param block the mapped block
+	 * \return the parts of the intervals outside of the block and whether any of the
+	 * intervals overlaps the block
+	 */
+	std::pair<std::vector<std::pair<int, int>>, bool> splitAtBlock(
+	    const std::vector<std::pair<int, int>>& pduIntervals, const MappedRegisterBlock& block)
+	{
+		std::vector<std::pair<int, int>> outside;
+		bool overlapsBlock = false;
+		for (std::pair<int, int> interval : pduIntervals)
+		{
+			if (interval.second <= block.start || interval.first >= block.end)
+			{
+				outside.push_back(interval);
+				continue;
+			}
+			overlapsBlock = true;
+			if (interval.first < block.start)
+			{
+				outside.push_back({ interval.first, block.start });
+			}
+			if (interval.second > block.end)
+			{
+				outside.push_back({ block.end, interval.second });
+			}
+		}
+		return { outside, overlapsBlock };
+	}
+
+	/*!
+	 * \brief Orders RegisterRates by the order in which their frames are scheduled,
+	 * highest priority and frequency first.
+	 */
+	struct RegisterRateOrder
+	{
+		bool operator()(const RegisterRate& lhs, const RegisterRate& rhs) const
+		{
+			if (lhs.priority != rhs.priority)
+			{
+				return lhs.priority > rhs.priority;
+			}
+			return lhs.frequency > rhs.frequency;
+		}
+	};
+
+	/*!
+	 * \brief Create an EtherCATFrameList from the selected registers and their rates
+	 * and make it the current one.
 	 *
-	 * The frames will be generated to contain every interval for every slave.
+	 * Registers with the same rate are fitted into frames together. The frames of
+	 * registers with a frequency come first, ordered by priority, followed by the frames
+	 * of the other registers.
+	 */
+	void RegisterScheduler::createEtherCATFrameList()
+	{
+		std::map<RegisterRate, std::unordered_map<datatypes::RegisterEnum, bool>,
+		    RegisterRateOrder>
+		    groups;
+		std::unordered_map<datatypes::RegisterEnum, bool> roundRobinRegisters;
+		for (std::pair<datatypes::RegisterEnum, bool> selection : toRead)
+		{
+			if (!selection.second)
+			{
+				continue;
+			}
+			auto rate = rates.find(selection.first);
+			if (rate == rates.end() || rate->second.frequency == 0)
+			{
+				roundRobinRegisters.insert(selection);
+			}
+			else
+			{
+				groups[rate->second].insert(selection);
+			}
+		}
+
+		EtherCATFrameList* frameList = new EtherCATFrameList(); // NOLINT
+		for (auto& group : groups)
+		{
+			appendEtherCATFrames(*frameList, createFrameIntervals(group.second));
+			datatypes::TimeStep period = std::chrono::duration_cast<datatypes::TimeStep>(
+			    std::chrono::duration<double>(1 / group.first.frequency));
+			frameList->schedules.resize(frameList->list.size(), { period, {} });
+		}
+		// The list always holds at least one frame
+		if (!roundRobinRegisters.empty() || frameList->list.empty())
+		{
+			appendEtherCATFrames(*frameList, createFrameIntervals(roundRobinRegisters));
+		}
+		// The BusReader reads every frame at most twice per round
+		frameList->selection.reserve(2 * frameList->list.size());
+
+		frameLists.push_back(frameList);
+		currentFrameList.store(frameList, std::memory_order_release);
+	}
+
+	/*!
+	 * \brief Append EtherCATFrames for the given address intervals to an EtherCATFrameList.
+	 *
+	 * The frames will be generated to contain every interval for every slave. The part of
+	 * the intervals that lies in the mapped block is read with LRD PDUs from the slaves
+	 * that have the block mapped, and with FPRD PDUs from the others.
 	 *
 	 * This method will try to fit the PDUs into the frames in order,
 	 * starting a new frame if the next PDU doesn't fit. That is not optimal.
 	 * If it bugs you, write something smarter.
+	 * \param frameList the list to append the frames to
 	 * \param pduIntervals The address intervals to fit into EtherCAT frames
 	 */
-	EtherCATFrameList* RegisterScheduler::createEtherCATFrameList(
-	    const std::vector<std::pair<int, int>>& pduIntervals)
+	void RegisterScheduler::appendEtherCATFrames(
+	    EtherCATFrameList& frameList, const std::vector<std::pair<int, int>>& pduIntervals)
 	{
-		// We need the slave addresses later when generating the frames,
-		// so we add them in here.
-		std::vector<std::tuple<uint16_t, int, int>> slaveAssignedPDUIntervals;
+		auto [outsideIntervals, readsBlock] = splitAtBlock(pduIntervals, mappedBlock);
+		readsBlock = readsBlock && !mappedBlock.slaveConfiguredAddresses.empty();
+
+		std::vector<PDUPlan> plans;
 		for (uint16_t slaveConfiguredAddress : slaveConfiguredAddresses)
 		{
-			for (std::pair<int, int> pduInterval : pduIntervals)
+			bool isMapped = readsBlock
+			    && std::find(mappedBlock.slaveConfiguredAddresses.begin(),
+			           mappedBlock.slaveConfiguredAddresses.end(), slaveConfiguredAddress)
+			        != mappedBlock.slaveConfiguredAddresses.end();
+			for (std::pair<int, int> pduInterval : isMapped ? outsideIntervals : pduIntervals)
+			{
+				plans.push_back({ fprdCommandType, slaveConfiguredAddress,
+				    static_cast<uint16_t>(pduInterval.first), pduInterval.first,
+				    pduInterval.second, { slaveConfiguredAddress } });
+			}
+		}
+		if (readsBlock)
+		{
+			// Each LRD PDU reads the blocks of as many slaves as fit into a frame
+			int blockLength = mappedBlock.end - mappedBlock.start;
+			size_t slavesPerPDU
+			    = (maxTotalPDULength - reservedFrameSpace - pduOverhead - 1) / blockLength;
+			const std::vector<uint16_t>& mapped = mappedBlock.slaveConfiguredAddresses;
+			for (size_t first = 0; first < mapped.size(); first += slavesPerPDU)
 			{
-				slaveAssignedPDUIntervals.push_back(
-				    { slaveConfiguredAddress, pduInterval.first, pduInterval.second });
+				uint32_t logicalAddress = mappedBlock.logicalAddress + first * blockLength;
+				static constexpr int halfShift = 16;
+				plans.push_back({ lrdCommandType, static_cast<uint16_t>(logicalAddress),
+				    static_cast<uint16_t>(logicalAddress >> halfShift), mappedBlock.start,
+				    mappedBlock.end,
+				    std::vector<uint16_t>(mapped.begin() + first,
+				        mapped.begin() + std::min(mapped.size(), first + slavesPerPDU)) });
 			}
 		}
 
-		EtherCATFrameList* frameList = new EtherCATFrameList(); // NOLINT
 		int frameTotalSize = 0;
-		std::vector<std::tuple<uint16_t, int, int>> nextFrameIntervals;
+		std::vector<PDUPlan> nextFramePlans;
 
 		// We add in PDUs until we can't fit the next, then start a new frame.
-		for (auto interval : slaveAssignedPDUIntervals)
+		for (auto& plan : plans)
 		{
-			int nextIntervalLength = std::get<2>(interval) - std::get<1>(interval);
-			if (frameTotalSize + nextIntervalLength + pduOverhead
-			    < static_cast<int>(maxTotalPDULength))
-			{
-				nextFrameIntervals.push_back(interval);
-				frameTotalSize += nextIntervalLength + pduOverhead;
-			}
-			else
+			int nextPlanLength = plan.getDataLength();
+			if (frameTotalSize + nextPlanLength + pduOverhead
+			    >= static_cast<int>(maxTotalPDULength - reservedFrameSpace))
 			{
-				frameList->list.push_back(createEtherCATFrame(nextFrameIntervals));
-				nextFrameIntervals.clear();
+				frameList.list.push_back(createEtherCATFrame(nextFramePlans));
+				nextFramePlans.clear();
 				frameTotalSize = 0;
 			}
+			nextFramePlans.push_back(std::move(plan));
+			frameTotalSize += nextPlanLength + pduOverhead;
 		}
-		frameList->list.push_back(createEtherCATFrame(nextFrameIntervals));
-		return frameList;
+		frameList.list.push_back(createEtherCATFrame(nextFramePlans));
 	}
 
 } // namespace etherkitten::reader
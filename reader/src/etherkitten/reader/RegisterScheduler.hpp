@@ -23,24 +23,37 @@
 
 #include <atomic>
 #include <map>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include <etherkitten/datatypes/dataobjects.hpp>
+#include <etherkitten/datatypes/time.hpp>
 
 #include "EtherCATFrame.hpp"
+#include "RegisterRate.hpp"
 
 namespace etherkitten::reader
 {
 	/*!
-	 * \brief The RegisterScheduler class constructs and RR-schedules EtherCATFrames.
+	 * \brief The RegisterScheduler class constructs and schedules EtherCATFrames.
+	 *
+	 * Registers with the same RegisterRate share their frames. The frames of registers
+	 * with a frequency are handed out whenever they are due, in the order of their
+	 * priority. The room that is left in a round is filled round-robin-style with the
+	 * frames of the registers without a frequency.
+	 *
+	 * Registers are read with one FPRD PDU per slave, except for the registers in a
+	 * MappedRegisterBlock: A single LRD PDU reads them from all slaves that have the
+	 * block mapped. Its working counter only tells whether all of these slaves answered,
+	 * so the PDUMetaData of all of them share the expected working counter.
 	 */
 	class RegisterScheduler
 	{
 	public:
 		/*!
 		 * \brief Construct a new RegisterScheduler that schedules the given registers
-		 * for all of the given slaves.
+		 * for all of the given slaves as often as possible.
 		 * \param slaveConfiguredAddresses the configured addresses of the slaves to
 		 * schedule register readings for
 		 * \param toRead the register selection to schedule readings for
@@ -48,6 +61,37 @@ namespace etherkitten::reader
 		RegisterScheduler(const std::vector<uint16_t>& slaveConfiguredAddresses,
 		    const std::unordered_map<datatypes::RegisterEnum, bool>& toRead);
 
+		/*!
+		 * \brief Construct a new RegisterScheduler that schedules the given registers
+		 * for all of the given slaves at the given rates.
+		 * \param slaveConfiguredAddresses the configured addresses of the slaves to
+		 * schedule register readings for
+		 * \param toRead the register selection to schedule readings for
+		 * \param rates the rates of the registers, registers without one are read
+		 * as often as possible
+		 * \exception std::invalid_argument iff a frequency is negative or not finite
+		 */
+		RegisterScheduler(const std::vector<uint16_t>& slaveConfiguredAddresses,
+		    const std::unordered_map<datatypes::RegisterEnum, bool>& toRead,
+		    const std::unordered_map<datatypes::RegisterEnum, RegisterRate>& rates);
+
+		/*!
+		 * \brief Construct a new RegisterScheduler that schedules the given registers
+		 * for all of the given slaves at the given rates, and reads the registers in the
+		 * mapped block with LRD PDUs from the slaves that have it mapped.
+		 * \param slaveConfiguredAddresses the configured addresses of the slaves to
+		 * schedule register readings for
+		 * \param toRead the register selection to schedule readings for
+		 * \param rates the rates of the registers, registers without one are read
+		 * as often as possible
+		 * \param mappedBlock the register block the FMMUs of the slaves map
+		 * \exception std::invalid_argument iff a frequency is negative or not finite
+		 */
+		RegisterScheduler(const std::vector<uint16_t>& slaveConfiguredAddresses,
+		    const std::unordered_map<datatypes::RegisterEnum, bool>& toRead,
+		    const std::unordered_map<datatypes::RegisterEnum, RegisterRate>& rates,
+		    MappedRegisterBlock mappedBlock);
+
 		/*!
 		 * \brief Construct a new RegisterScheduler that schedules the same registers
 		 * as the other.
@@ -97,34 +141,80 @@ namespace etherkitten::reader
 		size_t getFrameCount();
 
 		/*!
-		 * \brief Get an iterator over the given number of EtherCATFrames with metadata.
+		 * \brief Get an iterator over at most the given number of EtherCATFrames
+		 * with metadata that are due now.
+		 *
+		 * See getNextFrames(int, datatypes::TimeStamp).
+		 * \param frameCount the maximum number of EtherCATFrames to iterate over
+		 * \return an iterator over at most `frameCount` EtherCATFrames
+		 */
+		EtherCATFrameIterator getNextFrames(int frameCount);
+
+		/*!
+		 * \brief Get an iterator over at most the given number of EtherCATFrames
+		 * with metadata that are due at the given time.
 		 *
-		 * When this method is called for the first time, the iterator will start at
-		 * the first available frame. For every call after that, the iterator will start
-		 * at the frame after the end of the last iterator's range. The iterators wrap
-		 * around to the first available frame round-robin-style once all frames have
-		 * been visited.
+		 * The iterator starts with the frames of registers with a frequency that are due,
+		 * by priority. Frames that do not fit stay due for the next call. The remaining
+		 * frames are filled with the frames of registers without a frequency: When this
+		 * method is called for the first time, they start at the first of these frames.
+		 * For every call after that, they start at the frame after the last one handed out.
+		 * They wrap around to the first of these frames round-robin-style once all of them
+		 * have been visited, so the iterator covers exactly `frameCount` frames if there
+		 * are any registers without a frequency.
 		 *
-		 * If changeRegisterSettings is called between calls to this method,
-		 * the iterator will once again start at the first available frame given the
-		 * new register settings.
+		 * If changeRegisterSettings or changeRegisterRates is called between calls to this
+		 * method, the iterator will once again start at the first available frame given the
+		 * new register settings, and all frames are due.
 		 *
-		 * This method may be called simultaneously to changeRegisterSettings, but not
-		 * to itself.
-		 * \param frameCount the number of EtherCATFrames to iterate over
-		 * \return an iterator over `frameCount` EtherCATFrames
+		 * This method may be called simultaneously to changeRegisterSettings and
+		 * changeRegisterRates, but not to itself. The iterator must not be used anymore
+		 * once this method is called again.
+		 * \param frameCount the maximum number of EtherCATFrames to iterate over
+		 * \param time the current time
+		 * \return an iterator over at most `frameCount` EtherCATFrames
 		 */
-		EtherCATFrameIterator getNextFrames(int frameCount);
+		EtherCATFrameIterator getNextFrames(int frameCount, datatypes::TimeStamp time);
 
 		/*!
 		 * \brief Change the selection of registers to schedule readings for.
 		 *
-		 * This method may be called simultaneously to getNextFrames, but not to itself.
+		 * This method may be called simultaneously to getNextFrames, but not to itself
+		 * or changeRegisterRates.
 		 * \param toRead the register selection to schedule readings for
 		 */
 		void changeRegisterSettings(
 		    const std::unordered_map<datatypes::RegisterEnum, bool>& toRead);
 
+		/*!
+		 * \brief Change the rates at which the selected registers are read.
+		 *
+		 * This method may be called simultaneously to getNextFrames, but not to itself
+		 * or changeRegisterSettings.
+		 * \param rates the rates of the registers, registers without one are read
+		 * as often as possible
+		 * \exception std::invalid_argument iff a frequency is negative or not finite
+		 */
+		void changeRegisterRates(
+		    const std::unordered_map<datatypes::RegisterEnum, RegisterRate>& rates);
+
+		/*!
+		 * \brief Leave space at the end of every frame so another PDU can be sent along
+		 * with the registers.
+		 *
+		 * This method may be called simultaneously to getNextFrames, but not to itself,
+		 * changeRegisterSettings or changeRegisterRates.
+		 * \param length the number of bytes to leave free in every frame
+		 * \exception std::invalid_argument iff the length is larger than maxReservedFrameSpace
+		 */
+		void reserveFrameSpace(size_t length);
+
+		/*!
+		 * \brief The most space that can be reserved in a frame, so that the registers still
+		 * have room.
+		 */
+		static constexpr size_t maxReservedFrameSpace = maxTotalPDULength / 2;
+
 	private:
 		/*!
 		 * \brief The EtherCATFrameList that iterators are currently being handed out for.
@@ -141,8 +231,13 @@ namespace etherkitten::reader
 		std::vector<EtherCATFrameList*> frameLists;
 
 		std::vector<uint16_t> slaveConfiguredAddresses;
-
-		EtherCATFrameList* createEtherCATFrameList(
-		    const std::vector<std::pair<int, int>>& pduIntervals);
+		std::unordered_map<datatypes::RegisterEnum, bool> toRead;
+		std::unordered_map<datatypes::RegisterEnum, RegisterRate> rates;
+		MappedRegisterBlock mappedBlock;
+		size_t reservedFrameSpace = 0;
+
+		void createEtherCATFrameList();
+		void appendEtherCATFrames(
+		    EtherCATFrameList& frameList, const std::vector<std::pair<int, int>>& pduIntervals);
 	};
 } // namespace etherkitten::reader
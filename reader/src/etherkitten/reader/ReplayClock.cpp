@@ -0,0 +1,142 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ReplayClock.hpp"
+
+#include <stdexcept>
+
+namespace etherkitten::reader
+{
+	void ReplayClock::setSpeed(double speed)
+	{
+		if (!(speed > 0))
+			throw std::invalid_argument("the replay speed must be greater than 0");
+		std::lock_guard lock(mutex);
+		reanchor();
+		this->speed = speed;
+		changed.notify_all();
+	}
+
+	double ReplayClock::getSpeed()
+	{
+		std::lock_guard lock(mutex);
+		return speed;
+	}
+
+	void ReplayClock::pause()
+	{
+		std::lock_guard lock(mutex);
+		reanchor();
+		paused = true;
+	}
+
+	void ReplayClock::resume()
+	{
+		std::lock_guard lock(mutex);
+		reanchor();
+		paused = false;
+		changed.notify_all();
+	}
+
+	bool ReplayClock::isPaused()
+	{
+		std::lock_guard lock(mutex);
+		return paused;
+	}
+
+	void ReplayClock::seek(datatypes::TimeStamp time)
+	{
+		std::lock_guard lock(mutex);
+		if (started && time < getTimeLocked())
+			throw std::invalid_argument("the replay cannot be moved backward");
+		started = true;
+		anchorTime = time;
+		anchorWallTime = std::chrono::steady_clock::now();
+		changed.notify_all();
+	}
+
+	datatypes::TimeStamp ReplayClock::getTime()
+	{
+		std::lock_guard lock(mutex);
+		return getTimeLocked();
+	}
+
+	bool ReplayClock::waitUntil(datatypes::TimeStamp time)
+	{
+		std::unique_lock lock(mutex);
+		if (!started)
+		{
+			started = true;
+			anchorTime = time;
+			anchorWallTime = std::chrono::steady_clock::now();
+		}
+		while (!stopped)
+		{
+			if (paused)
+			{
+				changed.wait(lock);
+				continue;
+			}
+			if (speed == fastest)
+			{
+				anchorTime = std::max(anchorTime, time);
+				return true;
+			}
+			datatypes::TimeStamp now = getTimeLocked();
+			if (now >= time)
+				return true;
+			// Changes of the speed wake this thread, so the wait is never too long
+			changed.wait_for(lock,
+			    std::chrono::duration<double, std::micro>(
+			        std::chrono::duration<double, std::micro>(time - now).count() / speed));
+		}
+		return false;
+	}
+
+	void ReplayClock::stop()
+	{
+		std::lock_guard lock(mutex);
+		stopped = true;
+		changed.notify_all();
+	}
+
+	/*!
+	 * \brief Get the current time of the clock.
+	 *
+	 * The mutex must be held by the caller.
+	 */
+	datatypes::TimeStamp ReplayClock::getTimeLocked() const
+	{
+		if (!started || paused || speed == fastest)
+			return anchorTime;
+		std::chrono::duration<double, std::micro> elapsed
+		    = std::chrono::steady_clock::now() - anchorWallTime;
+		return anchorTime
+		    + std::chrono::duration_cast<datatypes::TimeStep>(elapsed * speed);
+	}
+
+	/*!
+	 * \brief Start counting from the current time of the clock again.
+	 *
+	 * The mutex must be held by the caller.
+	 */
+	void ReplayClock::reanchor()
+	{
+		anchorTime = getTimeLocked();
+		anchorWallTime = std::chrono::steady_clock::now();
+	}
+} // namespace etherkitten::reader
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+/*!
+ * \file
+ * \brief Defines the ReplayClock, which paces the replay of a log against the
+ * timestamps in the log.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+
+#include <etherkitten/datatypes/time.hpp>
+
+namespace etherkitten::reader
+{
+	/*!
+	 * \brief The ReplayClock tells how far the replay of a log has come and lets the thread
+	 * that inserts the data of the log wait until it is due.
+	 *
+	 * The clock starts at the TimeStamp of the first data it is waited for and then runs
+	 * at its speed relative to the wall clock. It can be paused and moved forward at any time.
+	 * It cannot be moved backward, since data that is inserted into a Reader cannot be taken
+	 * back.
+	 * All methods may be called from any thread.
+	 */
+	class ReplayClock
+	{
+	public:
+		/*!
+		 * \brief The speed at which the data of a log is inserted as fast as possible.
+		 */
+		static constexpr double fastest = std::numeric_limits<double>::infinity();
+
+		/*!
+		 * \brief Set how fast the clock runs compared to the wall clock.
+		 * \param speed the speed, e.g. 1 for the recorded pace, 10 for ten times as fast
+		 * or fastest
+		 * \exception std::invalid_argument iff the speed is not greater than 0
+		 */
+		void setSpeed(double speed);
+
+		/*!
+		 * \brief Get how fast the clock runs compared to the wall clock.
+		 * \return the speed
+		 */
+		double getSpeed();
+
+		/*!
+		 * \brief Stop the clock until resume() is called.
+		 */
+		void pause();
+
+		/*!
+		 * \brief Let the clock run again after pause().
+		 */
+		void resume();
+
+		/*!
+		 * \brief Check whether the clock is paused.
+		 * \retval true iff the clock is paused
+		 */
+		bool isPaused();
+
+		/*!
+		 * \brief Move the clock forward, so all data up to the given TimeStamp is due at once.
+		 * \param time the TimeStamp to move the clock to
+		 * \exception std::invalid_argument iff the time is before the current time of the clock
+		 */
+		void seek(datatypes::TimeStamp time);
+
+		/*!
+		 * \brief Get the current time of the clock.
+		 *
+		 * At the fastest speed, this is the newest TimeStamp that was waited for.
+		 * \return the TimeStamp up to which data is due, or the TimeStamp passed to seek()
+		 * if the clock has not started yet
+		 */
+		datatypes::TimeStamp getTime();
+
+		/*!
+		 * \brief Wait until data with the given TimeStamp is due.
+		 *
+		 * The first call starts the clock at the given TimeStamp.
+		 * Only one thread may wait at a time.
+		 * \param time the TimeStamp of the data
+		 * \retval true iff the data is due
+		 * \retval false iff the clock was stopped
+		 */
+		bool waitUntil(datatypes::TimeStamp time);
+
+		/*!
+		 * \brief Stop the clock for good and wake the waiting thread.
+		 */
+		void stop();
+
+	private:
+		std::mutex mutex;
+		std::condition_variable changed;
+		double speed = 1;
+		bool paused = false;
+		bool started = false;
+		bool stopped = false;
+		// The time of the clock was anchorTime at anchorWallTime
+		datatypes::TimeStamp anchorTime;
+		std::chrono::steady_clock::time_point anchorWallTime;
+
+		datatypes::TimeStamp getTimeLocked() const;
+		void reanchor();
+	};
+} // namespace etherkitten::reader
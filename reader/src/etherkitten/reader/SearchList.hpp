@@ -22,18 +22,25 @@
  * and offers O(1) searching operations on that list.
  */
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <stdexcept>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 
 #include <etherkitten/datatypes/dataviews.hpp>
 #include <etherkitten/datatypes/time.hpp>
 
+#include "AggregateDataView.hpp"
 #include "DataView.hpp"
+#include "IOMap.hpp"
 #include "LLNode.hpp"
 
 namespace etherkitten::reader
@@ -46,12 +53,15 @@ namespace etherkitten::reader
 	 * \brief The SearchList class is an implementation of a singly linked list.
 	 *
 	 * It allows O(1) access to any node in the list via auxiliary searching structures.
+	 * The DataViews it creates use these structures to skip through the list as well.
+	 * SearchLists of arithmetic types also keep a pyramid of Aggregates over
+	 * ever wider time buckets, see getAggregateView().
 	 * A SearchList can be appended to in parallel to being read.
 	 * \tparam Type which type of values the SearchList holds
 	 * \tparam NodeSize the size of the LLNodes in the list
 	 */
 	template<typename Type, size_t NodeSize = 1>
-	class SearchList
+	class SearchList : public ListIndex<Type, NodeSize>
 	{
 	public:
 		/*!
@@ -63,6 +73,14 @@ namespace etherkitten::reader
 		    : head(nullptr)
 		    , tail(nullptr)
 		{
+			if constexpr (std::is_arithmetic<Type>())
+			{
+				pyramid = std::make_unique<Pyramid>();
+				for (auto& level : pyramid->levels)
+				{
+					level = std::make_unique<SearchList<Aggregate, Aggregate::nodeSize>>();
+				}
+			}
 		}
 
 		SearchList(const SearchList&) = delete;
@@ -95,44 +113,79 @@ namespace etherkitten::reader
 		 */
 		void append(Type value, datatypes::TimeStamp time)
 		{
-			TimePointMin timeFloor = std::chrono::floor<std::chrono::minutes>(time);
-			std::lock_guard lg(appendMutex);
-			auto* lastNode = tail.load(std::memory_order_acquire);
-			size_t count
-			    = lastNode != nullptr ? lastNode->count.load(std::memory_order_acquire) : 0;
-			// We still have a node that isn't full yet
-			if (lastNode != nullptr && count < NodeSize)
+			if constexpr (std::is_arithmetic<Type>())
 			{
-				lastNode->values[count] = std::move(value);
-				lastNode->times[count] = time;
-				lastNode->count.fetch_add(1);
+				endRun();
+				aggregate(static_cast<double>(value), time);
 			}
-			// We need to make a new node
-			else
+			appendValue(std::move(value), time);
+		}
+
+		/*!
+		 * \brief Append the given value and time to the SearchList unless they continue the
+		 * run of equal values at its end.
+		 *
+		 * Every run of equal values is stored as its first and its last data point. A value
+		 * that continues the run at the end of the list is not stored right away. Only the
+		 * time it was last seen at is kept, and it is stored as the last data point of the run
+		 * once a different value ends the run. Data points are never changed after they were
+		 * stored, so DataViews see where each run began and where it was last seen. A DataView
+		 * on the first data point of the newest run steps to the time that run was last seen
+		 * at next, as getNewestSample() reports it. The Aggregates receive every value.
+		 * Only available for SearchLists of arithmetic types. The TimeStamps must increase
+		 * monotonically, see append(Type, datatypes::TimeStamp).
+		 * \param value the value to be appended
+		 * \param time the time to be appended
+		 * \return how many data points were stored
+		 */
+		size_t appendChange(Type value, datatypes::TimeStamp time)
+		{
+			static_assert(std::is_arithmetic<Type>(),
+			    "Only SearchLists of arithmetic types can store runs of values");
+			auto* lastNode = tail.load(std::memory_order_acquire);
+			if (lastNode != nullptr
+			    && lastNode->values[lastNode->count.load(std::memory_order_acquire) - 1] == value)
 			{
-				LLNode<Type, NodeSize>* temp // NOLINT
-				    = new LLNode<Type, NodeSize>(std::move(value), time, nullptr);
-				// List is empty
-				if (head.load(std::memory_order_acquire) == nullptr)
-				{
-					head.store(temp, std::memory_order_release);
-					tail.store(temp, std::memory_order_release);
-				}
-				// List has entries
-				else
-				{
-					tail.load(std::memory_order_acquire)
-					    ->next.store(temp, std::memory_order_release);
-					tail.store(temp, std::memory_order_release);
-				}
+				aggregate(static_cast<double>(value), time);
+				runLastSeen.store(time, std::memory_order_release);
+				return 0;
 			}
+			size_t stored = endRun();
+			aggregate(static_cast<double>(value), time);
+			appendValue(value, time);
+			return stored + 1;
+		}
 
-			// New map entry has to be added
-			if (lastTimeInMap.time_since_epoch().count() == 0 || timeFloor >= lastTimeInMap + 1min)
+		/*!
+		 * \brief Copy the given IOMap data to the end of the SearchList.
+		 *
+		 * Only available for SearchLists of IOMapSlab. The data is copied into the slab of
+		 * the last node, so no allocation takes place unless a new node is needed.
+		 * All IOMaps appended to the same SearchList must have the same size.
+		 * The TimeStamps must increase monotonically, see append(Type, datatypes::TimeStamp).
+		 * \param ioMapData the IOMap data to be appended
+		 * \param ioMapSize the size of the IOMap data in bytes
+		 * \param time the time to be appended
+		 * \exception std::invalid_argument iff ioMapSize differs from the size of the IOMaps
+		 * that were appended before
+		 */
+		void append(const uint8_t* ioMapData, size_t ioMapSize, datatypes::TimeStamp time)
+		{
+			static_assert(std::is_same<Type, IOMapSlab>(),
+			    "Only SearchLists of IOMapSlab can have IOMap data appended");
+			auto* lastNode = tail.load(std::memory_order_acquire);
+			if (lastNode != nullptr && lastNode->ioMapSize != ioMapSize)
 			{
-				setNodeLocked(timeFloor, { tail.load(std::memory_order_acquire), count });
-				lastTimeInMap = timeFloor;
+				throw std::invalid_argument("All IOMaps in a SearchList must have the same size");
 			}
+			appendWith(
+			    time, [ioMapData, ioMapSize](LLNode<Type, NodeSize>* node, size_t index) {
+				    node->store(index, ioMapData, ioMapSize);
+			    },
+			    [ioMapData, ioMapSize, time]() {
+				    return new LLNode<Type, NodeSize>( // NOLINT
+				        ioMapData, ioMapSize, time, nullptr);
+			    });
 		}
 
 		/*!
@@ -149,6 +202,49 @@ namespace etherkitten::reader
 			return { lastNode, lastNode->count.load(std::memory_order_acquire) - 1 };
 		}
 
+		/*!
+		 * \brief Get the location of the newest data point in the list and the time of the
+		 * newest value appended to it.
+		 *
+		 * The time is later than that of the data point iff the newest value continues its
+		 * run without being stored yet, see appendChange().
+		 * \return the location of the newest data point and the time of the newest value
+		 */
+		std::pair<ListLocation<Type, NodeSize>, datatypes::TimeStamp> getNewestSample() const
+		{
+			while (true)
+			{
+				ListLocation<Type, NodeSize> location = getNewest();
+				if (location.node == nullptr)
+				{
+					return { location, datatypes::TimeStamp() };
+				}
+				datatypes::TimeStamp lastSeen = runLastSeen.load(std::memory_order_acquire);
+				// The run may have ended in between, and lastSeen may belong to the next one
+				ListLocation<Type, NodeSize> check = getNewest();
+				if (check.node == location.node && check.index == location.index)
+				{
+					return { location,
+						lastSeen != noRun ? lastSeen : location.node->times[location.index] };
+				}
+			}
+		}
+
+		/*!
+		 * \brief Get the time of the oldest data point in the list.
+		 * \return the time of the oldest data point or nothing if the list is empty
+		 */
+		std::optional<datatypes::TimeStamp> getOldestTime()
+		{
+			std::lock_guard<std::mutex> lg(modificationMutex);
+			auto* oldestNode = head.load(std::memory_order_acquire);
+			if (oldestNode == nullptr)
+			{
+				return {};
+			}
+			return oldestNode->times[0];
+		}
+
 		/*!
 		 * \brief Remove the oldest nodes of the SearchList.
 		 * \param count the amount of nodes to remove
@@ -170,9 +266,10 @@ namespace etherkitten::reader
 			datatypes::TimeStamp earliestViewTime = datatypes::TimeStamp::max();
 			for (auto& dataView : usedDataViews)
 			{
-				if (dataView->getTime() < earliestViewTime)
+				datatypes::TimeStamp viewTime = dataView.locationTime();
+				if (viewTime < earliestViewTime)
 				{
-					earliestViewTime = dataView->getTime();
+					earliestViewTime = viewTime;
 				}
 			}
 
@@ -192,6 +289,16 @@ namespace etherkitten::reader
 			}
 			setNodeLocked(headSec, { headAfterRemoval, 0 });
 
+			// Aggregates of removed data points are not needed anymore either
+			if constexpr (std::is_arithmetic<Type>())
+			{
+				for (size_t level = 0; level < Aggregate::levelCount; ++level)
+				{
+					pyramid->levels[level]->removeBefore(
+					    Aggregate::bucketStart(headAfterRemoval->times[0], level));
+				}
+			}
+
 			// Actually remove all nodes until the new head
 			int actuallyRemoved = 0;
 			while (oldHead != headAfterRemoval)
@@ -238,19 +345,93 @@ namespace etherkitten::reader
 			std::shared_ptr<DataView<Type, NodeSize, Output>> view;
 			if (location.has_value())
 			{
-				view = std::make_shared<DataView<Type, NodeSize, Output>>(
-				    location.value(), timeSeries.microStep, bitOffset, bitLength, flipBytes);
+				view = std::make_shared<DataView<Type, NodeSize, Output>>(location.value(),
+				    timeSeries.microStep, bitOffset, bitLength, flipBytes, this);
 			}
 			else
 			{
 				view = std::make_shared<DataView<Type, NodeSize, Output>>(
-				    &head, timeSeries.microStep, bitOffset, bitLength, flipBytes);
+				    &head, timeSeries.microStep, bitOffset, bitLength, flipBytes, this);
 			}
-			usedDataViews.push_back(view);
+			usedDataViews.push_back(
+			    { view, [dataView = view.get()]() { return dataView->getLocationTime(); } });
 
 			return view;
 		}
 
+		/*!
+		 * \brief Remove the oldest nodes of the SearchList whose data points are all older than
+		 * the given time.
+		 *
+		 * The newest node and nodes that DataViews still point into are kept,
+		 * see removeOldest(unsigned int).
+		 * \param time the time to remove the data points before
+		 * \return amount of actually removed nodes
+		 */
+		int removeBefore(datatypes::TimeStamp time)
+		{
+			unsigned int count = 0;
+			LLNode<Type, NodeSize>* current = head.load(std::memory_order_acquire);
+			while (current != nullptr && current->next.load(std::memory_order_acquire) != nullptr
+			    && current->times[current->count.load(std::memory_order_acquire) - 1] < time)
+			{
+				++count;
+				current = current->next.load(std::memory_order_acquire);
+			}
+			return count > 0 ? removeOldest(count) : 0;
+		}
+
+		/*!
+		 * \brief Get a view over the Aggregates of the values in this SearchList.
+		 *
+		 * Only available for SearchLists of arithmetic types. The view steps over the
+		 * buckets of the coarsest level that are not wider than the step of the TimeSeries,
+		 * beginning with the bucket that contains its start time.
+		 * \param timeSeries the TimeSeries to view the values in
+		 * \return the new AggregateDataView
+		 * \exception std::invalid_argument iff the step of the TimeSeries is not coarse enough
+		 * to be served from the Aggregates, see Aggregate::isCoarse()
+		 */
+		std::shared_ptr<AggregateDataView> getAggregateView(datatypes::TimeSeries timeSeries)
+		{
+			static_assert(std::is_arithmetic<Type>(),
+			    "Only SearchLists of arithmetic types keep Aggregates of their values");
+			if (!Aggregate::isCoarse(timeSeries.microStep))
+			{
+				throw std::invalid_argument("The TimeStep is too fine for Aggregates");
+			}
+			size_t level = Aggregate::levelFor(timeSeries.microStep);
+			return std::make_shared<AggregateDataView>(
+			    pyramid->levels[level]->template getView<Aggregate>(
+			        { Aggregate::bucketStart(timeSeries.startTime, level),
+			            datatypes::TimeStep(0) },
+			        false));
+		}
+
+		std::optional<ListLocation<Type, NodeSize>> findMinuteStart(
+		    datatypes::TimeStamp time) override
+		{
+			std::lock_guard guard(nodeMapMutex);
+			auto entry = nodes.find(std::chrono::floor<std::chrono::minutes>(time));
+			if (entry == nodes.end())
+			{
+				return {};
+			}
+			return entry->second;
+		}
+
+		std::optional<datatypes::TimeStamp> findRunEnd(
+		    ListLocation<Type, NodeSize> location) override
+		{
+			auto [newest, lastSeen] = getNewestSample();
+			if (newest.node != location.node || newest.index != location.index
+			    || lastSeen <= location.node->times[location.index])
+			{
+				return {};
+			}
+			return lastSeen;
+		}
+
 	private:
 		std::atomic<LLNode<Type, NodeSize>*> head;
 
@@ -263,7 +444,17 @@ namespace etherkitten::reader
 		    TimePointEqual>
 		    nodes;
 
-		std::vector<std::shared_ptr<datatypes::AbstractDataView>> usedDataViews;
+		/*!
+		 * \brief A DataView handed out by getView() and how to get the time of the data point
+		 * it points into, which may be earlier than its time, see DataView::getLocationTime().
+		 */
+		struct UsedDataView
+		{
+			std::shared_ptr<datatypes::AbstractDataView> view;
+			std::function<datatypes::TimeStamp()> locationTime;
+		};
+
+		std::vector<UsedDataView> usedDataViews;
 
 		std::vector<std::shared_ptr<datatypes::AbstractDataView>> toDeleteDataViews;
 
@@ -275,6 +466,167 @@ namespace etherkitten::reader
 
 		std::mutex nodeMapMutex;
 
+		/*!
+		 * \brief The Aggregates of the values in a SearchList of an arithmetic type.
+		 */
+		struct Pyramid
+		{
+			/*!
+			 * \brief The complete buckets of every level.
+			 */
+			std::array<std::unique_ptr<SearchList<Aggregate, Aggregate::nodeSize>>,
+			    Aggregate::levelCount>
+			    levels;
+
+			/*!
+			 * \brief The buckets of every level that may still receive values.
+			 */
+			std::array<Aggregate, Aggregate::levelCount> open;
+		};
+
+		std::unique_ptr<Pyramid> pyramid;
+
+		static constexpr datatypes::TimeStamp noRun = datatypes::TimeStamp::min();
+
+		/*!
+		 * \brief The time the run of the newest data point was last seen at while that is not
+		 * stored yet, or noRun, see appendChange().
+		 */
+		std::atomic<datatypes::TimeStamp> runLastSeen{ noRun };
+
+		/*!
+		 * \brief Append a new value to the end of the SearchList.
+		 * \param time the time to be appended
+		 * \param store stores the value at a given index of a given node that still has space
+		 * \param create creates a new node containing just the value
+		 */
+		template<typename Store, typename Create>
+		void appendWith(datatypes::TimeStamp time, Store&& store, Create&& create)
+		{
+			TimePointMin timeFloor = std::chrono::floor<std::chrono::minutes>(time);
+			std::lock_guard lg(appendMutex);
+			auto* lastNode = tail.load(std::memory_order_acquire);
+			size_t count
+			    = lastNode != nullptr ? lastNode->count.load(std::memory_order_acquire) : 0;
+			size_t index = 0;
+			// We still have a node that isn't full yet
+			if (lastNode != nullptr && count < NodeSize)
+			{
+				store(lastNode, count);
+				lastNode->times[count] = time;
+				lastNode->count.fetch_add(1);
+				index = count;
+			}
+			// We need to make a new node
+			else
+			{
+				LLNode<Type, NodeSize>* temp = create();
+				// List is empty
+				if (head.load(std::memory_order_acquire) == nullptr)
+				{
+					head.store(temp, std::memory_order_release);
+					tail.store(temp, std::memory_order_release);
+				}
+				// List has entries
+				else
+				{
+					tail.load(std::memory_order_acquire)
+					    ->next.store(temp, std::memory_order_release);
+					tail.store(temp, std::memory_order_release);
+				}
+			}
+
+			// New map entry has to be added
+			if (lastTimeInMap.time_since_epoch().count() == 0 || timeFloor >= lastTimeInMap + 1min)
+			{
+				setNodeLocked(timeFloor, { tail.load(std::memory_order_acquire), index });
+				lastTimeInMap = timeFloor;
+			}
+		}
+
+		/*!
+		 * \brief Append a value without adding it to the Aggregates.
+		 * \param value the value to be appended
+		 * \param time the time to be appended
+		 */
+		void appendValue(Type value, datatypes::TimeStamp time)
+		{
+			appendWith(
+			    time, [&value](LLNode<Type, NodeSize>* node, size_t index) {
+				    node->values[index] = std::move(value);
+			    },
+			    [&value, time]() {
+				    return new LLNode<Type, NodeSize>(std::move(value), time, nullptr); // NOLINT
+			    });
+		}
+
+		/*!
+		 * \brief Store the time the newest run was last seen at as its last data point,
+		 * see appendChange().
+		 * \return how many data points were stored
+		 */
+		size_t endRun()
+		{
+			// Only the appending thread changes runLastSeen
+			datatypes::TimeStamp lastSeen = runLastSeen.load(std::memory_order_relaxed);
+			if (lastSeen == noRun)
+			{
+				return 0;
+			}
+			auto* lastNode = tail.load(std::memory_order_acquire);
+			appendValue(
+			    lastNode->values[lastNode->count.load(std::memory_order_acquire) - 1], lastSeen);
+			runLastSeen.store(noRun, std::memory_order_release);
+			return 1;
+		}
+
+		/*!
+		 * \brief Add a value to the open buckets of the pyramid.
+		 *
+		 * Every open bucket that does not contain time anymore is completed first.
+		 * \param value the value to add
+		 * \param time the time of the value
+		 */
+		void aggregate(double value, datatypes::TimeStamp time)
+		{
+			std::lock_guard lg(appendMutex);
+			for (size_t level = 0; level < Aggregate::levelCount; ++level)
+			{
+				Aggregate& open = pyramid->open[level];
+				if (open.count != 0
+				    && Aggregate::bucketOf(open.minTime, level)
+				        != Aggregate::bucketOf(time, level))
+				{
+					completeBucket(level);
+				}
+			}
+			pyramid->open[0].add(value, time);
+		}
+
+		/*!
+		 * \brief Move the open bucket of a level to the complete ones and merge it into the
+		 * open bucket of the next level.
+		 * \param level the level of the bucket to complete
+		 */
+		void completeBucket(size_t level)
+		{
+			Aggregate complete = pyramid->open[level];
+			pyramid->open[level] = Aggregate();
+			pyramid->levels[level]->append(
+			    complete, Aggregate::bucketStart(complete.minTime, level));
+			if (level + 1 < Aggregate::levelCount)
+			{
+				Aggregate& parent = pyramid->open[level + 1];
+				if (parent.count != 0
+				    && Aggregate::bucketOf(parent.minTime, level + 1)
+				        != Aggregate::bucketOf(complete.minTime, level + 1))
+				{
+					completeBucket(level + 1);
+				}
+				parent.merge(complete);
+			}
+		}
+
 		std::optional<ListLocation<Type, NodeSize>> findAfterTimeStamp(
 		    datatypes::TimeStamp& timeStamp)
 		{
@@ -313,19 +665,18 @@ namespace etherkitten::reader
 				currentIndex = 0;
 				nextNode = nextNode->next.load(std::memory_order_acquire);
 			}
-			while (currentNode->times[currentIndex] < timeStamp)
+			size_t currentCount = currentNode->count.load(std::memory_order_acquire);
+			auto* found = std::lower_bound(currentNode->times.data() + currentIndex,
+			    currentNode->times.data() + currentCount, timeStamp);
+			if (found == currentNode->times.data() + currentCount)
 			{
-				if (currentIndex == NodeSize - 1)
-				{
-					currentNode = currentNode->next.load(std::memory_order_acquire);
-					currentIndex = 0;
-				}
-				else
+				if (nextNode == nullptr)
 				{
-					++currentIndex;
+					return { { currentNode, currentCount - 1 } };
 				}
+				return { { nextNode, 0 } };
 			}
-			return { { currentNode, currentIndex } };
+			return { { currentNode, static_cast<size_t>(found - currentNode->times.data()) } };
 		}
 
 		void setNodeLocked(TimePointMin min, ListLocation<Type, NodeSize> node)
@@ -380,10 +731,10 @@ namespace etherkitten::reader
 			size_t i = 0;
 			while (i < usedDataViews.size())
 			{
-				if (usedDataViews.at(i).unique())
+				if (usedDataViews.at(i).view.unique())
 				{
 					// Move unused DataView to graveyard
-					toDeleteDataViews.push_back(usedDataViews.at(i));
+					toDeleteDataViews.push_back(usedDataViews.at(i).view);
 					// If the unused DataView was the last entry in the list
 					if (i == usedDataViews.size() - 1)
 					{
@@ -393,7 +744,7 @@ namespace etherkitten::reader
 					else
 					{
 						// Save last entry from usedDataViews
-						std::shared_ptr<datatypes::AbstractDataView> temp = usedDataViews.back();
+						UsedDataView temp = usedDataViews.back();
 						// Remove it
 						usedDataViews.pop_back();
 						// And put it where the unused DataView was
@@ -17,10 +17,38 @@
 
 #include "SearchListReader.hpp"
 
+#include <algorithm>
+#include <stdexcept>
+
 #include "endianness.hpp"
 
 namespace etherkitten::reader
 {
+	namespace
+	{
+		/*!
+		 * \brief A NewestValueView of a PDO that keeps the PDO hot as long as it exists.
+		 */
+		class HotNewestValueView : public datatypes::AbstractNewestValueView
+		{
+		public:
+			HotNewestValueView(std::unique_ptr<datatypes::AbstractNewestValueView> view,
+			    std::shared_ptr<const void> holder)
+			    : holder(std::move(holder))
+			    , view(std::move(view))
+			{
+			}
+
+			bool isEmpty() const override { return view->isEmpty(); }
+
+			const datatypes::AbstractDataPoint& operator*() override { return **view; }
+
+		private:
+			std::shared_ptr<const void> holder;
+			std::unique_ptr<datatypes::AbstractNewestValueView> view;
+		};
+	} // namespace
+
 	SearchListReader::SearchListReader(std::vector<uint16_t>&& slaveConfiguredAddresses,
 	    size_t ioMapUsedSize, datatypes::TimeStamp&& startTime)
 	    : slaveConfiguredAddresses(slaveConfiguredAddresses)
@@ -77,9 +105,17 @@ namespace etherkitten::reader
 	    const datatypes::PDO& pdo)
 	{
 		datatypes::PDOInfo info = getAbsolutePDOInfo(pdo);
-		return datatypes::dataTypeMap<bReader::NewestValueViewRetriever, std::unique_ptr<IOMap>,
+		// The view reads the newest IOMap itself, with the type of the PDO,
+		// but the PDO is hot while it is shown
+		auto view = datatypes::dataTypeMap<bReader::NewestValueViewRetriever, IOMapSlab,
 			bReader::SizeT2Type<nodeSize>>.at(
 		    pdo.getType())(ioMapList, info.bitOffset, info.bitLength);
+		auto holder = std::make_shared<bool>();
+		{
+			std::lock_guard guard(hotPDOMutex);
+			makeHot(pdo).subscribers.push_back({ holder, 0 });
+		}
+		return std::make_unique<HotNewestValueView>(std::move(view), std::move(holder));
 	}
 
 	std::unique_ptr<datatypes::AbstractNewestValueView> SearchListReader::getNewest(
@@ -93,10 +129,71 @@ namespace etherkitten::reader
 	std::shared_ptr<datatypes::AbstractDataView> SearchListReader::getView(
 	    const datatypes::PDO& pdo, datatypes::TimeSeries time)
 	{
-		datatypes::PDOInfo info = getAbsolutePDOInfo(pdo);
-		return datatypes::dataTypeMap<bReader::DataViewRetriever, std::unique_ptr<IOMap>,
-			bReader::SizeT2Type<nodeSize>>.at(
-		    pdo.getType())(ioMapList, time, info.bitOffset, info.bitLength);
+		std::lock_guard guard(hotPDOMutex);
+		HotPDO& hot = makeHot(pdo);
+		std::shared_ptr<datatypes::AbstractDataView> view;
+		// SearchLists keep a reference to the DataViews they hand out, but not to
+		// the AggregateDataViews around them
+		long ownReferences = 1;
+		if (Aggregate::isCoarse(time.microStep))
+		{
+			view = hot.values.getAggregateView(time);
+			ownReferences = 0;
+		}
+		else
+		{
+			view = hot.values.getView(time, false);
+		}
+		hot.subscribers.push_back({ view, ownReferences });
+		return view;
+	}
+
+	/*!
+	 * \brief Get the HotPDO of a PDO, making the PDO hot if it is not yet.
+	 *
+	 * A PDO that becomes hot has the IOMaps decoded that are already stored.
+	 * Must be called with the hotPDOMutex locked.
+	 * \param pdo the PDO
+	 * \return the HotPDO of the PDO
+	 */
+	SearchListReader::HotPDO& SearchListReader::makeHot(const datatypes::PDO& pdo)
+	{
+		auto hotPDO = hotPDOs.find(pdo);
+		if (hotPDO != hotPDOs.end())
+		{
+			return hotPDO->second;
+		}
+		HotPDO& hot = hotPDOs
+		                  .emplace(std::piecewise_construct, std::forward_as_tuple(pdo),
+		                      std::forward_as_tuple())
+		                  .first->second;
+		hot.info = getAbsolutePDOInfo(pdo);
+		hot.decode = datatypes::dataTypeMap<bReader::IOMapDecoderRetriever>.at(pdo.getType());
+
+		// IOMaps that are inserted meanwhile are decoded by decodeHotPDOs() once it gets
+		// the hotPDOMutex, unless they were decoded here already
+		auto ioMaps = ioMapList.getView<IOMap*>(
+		    { datatypes::TimeStamp(), datatypes::TimeStep(0) }, false);
+		if (ioMaps->isEmpty() && ioMaps->hasNext())
+		{
+			++(*ioMaps);
+		}
+		size_t decoded = 0;
+		while (!ioMaps->isEmpty())
+		{
+			hot.decodedUntil = ioMaps->getTime();
+			hot.values.append(
+			    hot.decode(**ioMaps, hot.info.bitOffset, hot.info.bitLength), hot.decodedUntil);
+			++decoded;
+			if (!ioMaps->hasNext())
+			{
+				break;
+			}
+			++(*ioMaps);
+		}
+		hot.memoryUsage = decoded * (sizeof(LLNode<double, nodeSize>) / nodeSize);
+		uncountedHotPDOMemory += hot.memoryUsage;
+		return hot;
 	}
 
 	std::shared_ptr<datatypes::AbstractDataView> SearchListReader::getView(
@@ -107,7 +204,69 @@ namespace etherkitten::reader
 		    registerLists, reg, time, slaveConfiguredAddresses[reg.getSlaveID() - 1]);
 	}
 
-	std::shared_ptr<DataView<std::unique_ptr<IOMap>, Reader::nodeSize, IOMap*>>
+	std::unique_ptr<datatypes::AbstractNewestValueView> SearchListReader::getNewest(
+	    const datatypes::CycleStatistic& statistic)
+	{
+		return std::make_unique<NewestValueView<uint32_t, nodeSize>>(
+		    cycleStatisticLists.at(static_cast<size_t>(statistic.getStatisticType())), 0, 0,
+		    false);
+	}
+
+	std::shared_ptr<datatypes::AbstractDataView> SearchListReader::getView(
+	    const datatypes::CycleStatistic& statistic, datatypes::TimeSeries time)
+	{
+		auto& list = cycleStatisticLists.at(static_cast<size_t>(statistic.getStatisticType()));
+		if (Aggregate::isCoarse(time.microStep))
+		{
+			return list.getAggregateView(time);
+		}
+		return list.getView(time, false);
+	}
+
+	const CycleHistogram& SearchListReader::getCycleHistogram(datatypes::CycleStatisticType type)
+	{
+		return cycleHistograms.at(static_cast<size_t>(type));
+	}
+
+	void SearchListReader::insertCycleMeasurement(
+	    const CycleMeasurement& measurement, datatypes::TimeStamp time)
+	{
+		for (size_t type = 0; type < datatypes::cycleStatisticTypeCount; ++type)
+		{
+			insertCycleStatistic(static_cast<datatypes::CycleStatisticType>(type),
+			    measurement[type], time); // NOLINT
+		}
+	}
+
+	void SearchListReader::insertCycleStatistic(
+	    datatypes::CycleStatisticType type, uint32_t value, datatypes::TimeStamp time)
+	{
+		cycleStatisticLists[static_cast<size_t>(type)].append(value, time); // NOLINT
+		cycleHistograms[static_cast<size_t>(type)].record(value); // NOLINT
+		size_t memoryUsage = sizeof(LLNode<uint32_t, nodeSize>) / nodeSize;
+		cycleStatisticMemoryUsage += memoryUsage;
+		currentMemoryUsage += memoryUsage;
+	}
+
+	/*!
+	 * \brief Remove the values before a TimeStamp from the SearchLists of all CycleStatistics.
+	 * \param time the TimeStamp to remove the values before
+	 * \return the amount of memory that was freed in bytes
+	 */
+	size_t SearchListReader::freeCycleStatistics(datatypes::TimeStamp time)
+	{
+		size_t freed = 0;
+		for (auto& list : cycleStatisticLists)
+		{
+			// Only full nodes are removed, and the memory usage is tracked per value
+			freed += list.removeBefore(time) * nodeSize
+			    * (sizeof(LLNode<uint32_t, nodeSize>) / nodeSize);
+		}
+		cycleStatisticMemoryUsage -= freed;
+		return freed;
+	}
+
+	std::shared_ptr<DataView<IOMapSlab, Reader::nodeSize, IOMap*>>
 	SearchListReader::getIOMapView(datatypes::TimeStamp startTime)
 	{
 		datatypes::TimeSeries timeSeries{ startTime, datatypes::TimeStep(0) };
@@ -135,43 +294,133 @@ namespace etherkitten::reader
 		}
 	}
 
-	void SearchListReader::insertIOMap(std::unique_ptr<IOMap> ioMap, datatypes::TimeStamp&& time)
+	void SearchListReader::insertIOMap(
+	    const uint8_t* ioMapData, size_t ioMapSize, datatypes::TimeStamp&& time)
 	{
-		currentMemoryUsage += sizeof(LLNode<std::unique_ptr<IOMap>, nodeSize>) / nodeSize
-		    + sizeof(IOMap) + ioMap->ioMapSize - 1;
-		ioMapList.append(std::move(ioMap), time);
+		if (ioMapSize > ioMapUsedSize)
+		{
+			throw std::invalid_argument("The IOMap is larger than the IOMaps of the bus");
+		}
+		if (ioMapSize < ioMapUsedSize)
+		{
+			paddedIOMap.assign(ioMapData, ioMapData + ioMapSize); // NOLINT
+			paddedIOMap.resize(ioMapUsedSize, 0);
+			ioMapData = paddedIOMap.data();
+		}
+		currentMemoryUsage += sizeof(LLNode<IOMapSlab, nodeSize>) / nodeSize
+		    + IOMapSlab::getSlotSize(ioMapUsedSize);
+		ioMapList.append(ioMapData, ioMapUsedSize, time);
+		ListLocation<IOMapSlab, nodeSize> newest = ioMapList.getNewest();
+		decodeHotPDOs(newest.node->at(newest.index), time);
 		pdoTimeStamps.add(time);
 	}
 
+	/*!
+	 * \brief Decode the values of all hot PDOs from the given IOMap and append them to their
+	 * respective SearchLists.
+	 *
+	 * PDOs that none of their views are in use for anymore are no longer hot and
+	 * are removed along with their SearchLists.
+	 * \param ioMap the IOMap that was just inserted
+	 * \param time the TimeStamp of the IOMap
+	 */
+	void SearchListReader::decodeHotPDOs(IOMap* ioMap, datatypes::TimeStamp time)
+	{
+		std::lock_guard guard(hotPDOMutex);
+		currentMemoryUsage += uncountedHotPDOMemory;
+		uncountedHotPDOMemory = 0;
+		auto hotPDO = hotPDOs.begin();
+		while (hotPDO != hotPDOs.end())
+		{
+			auto& subscribers = hotPDO->second.subscribers;
+			// A view is unused once the SearchList it belongs to holds the only references to it
+			subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(),
+			                      [](const Subscriber& subscriber) {
+				                      return subscriber.holder.use_count()
+				                          <= subscriber.ownReferences;
+			                      }),
+			    subscribers.end());
+			if (subscribers.empty())
+			{
+				currentMemoryUsage -= hotPDO->second.memoryUsage;
+				hotPDO = hotPDOs.erase(hotPDO);
+				continue;
+			}
+			HotPDO& hot = hotPDO->second;
+			if (time <= hot.decodedUntil)
+			{
+				// The IOMap was decoded when the PDO became hot
+				++hotPDO;
+				continue;
+			}
+			hot.values.append(hot.decode(ioMap, hot.info.bitOffset, hot.info.bitLength), time);
+			hot.decodedUntil = time;
+			hot.memoryUsage += sizeof(LLNode<double, nodeSize>) / nodeSize;
+			currentMemoryUsage += sizeof(LLNode<double, nodeSize>) / nodeSize;
+			++hotPDO;
+		}
+	}
+
+	/*!
+	 * \brief Remove the values of all hot PDOs that are older than the given time.
+	 *
+	 * Only whole nodes are removed, so each SearchList may keep some older values.
+	 * \param time the time to remove the values before
+	 * \return the amount of memory that was freed in bytes
+	 */
+	size_t SearchListReader::freeHotPDOs(datatypes::TimeStamp time)
+	{
+		std::lock_guard guard(hotPDOMutex);
+		// What is freed must have been counted before
+		currentMemoryUsage += uncountedHotPDOMemory;
+		uncountedHotPDOMemory = 0;
+		size_t freed = 0;
+		for (auto& [pdo, hot] : hotPDOs)
+		{
+			// Only full nodes are removed, and the memory usage is tracked per value
+			size_t freedFromPDO = hot.values.removeBefore(time) * nodeSize
+			    * (sizeof(LLNode<double, nodeSize>) / nodeSize);
+			hot.memoryUsage -= freedFromPDO;
+			freed += freedFromPDO;
+		}
+		return freed;
+	}
+
 	void SearchListReader::insertRegister(datatypes::RegisterEnum registerType, uint8_t* dataPtr,
 	    uint16_t slaveConfiguredAddress, datatypes::TimeStamp& time)
 	{
 		auto& list = registerLists.at(slaveConfiguredAddress).at(registerType);
+		bool runLength = registerRunLengthStorage.load(std::memory_order_acquire);
 		uint64_t result = 0;
+		size_t stored = 0;
 		switch (getRegisterByteLength(registerType))
 		{
 		case 1:
-			std::get<0>(list).append(flipBytesIfBigEndianHost(*dataPtr), time);
-			currentMemoryUsage
-			    += sizeof(LLNode<datatypes::EtherCATDataType::UNSIGNED8, nodeSize>) / nodeSize;
+			stored = appendRegister(
+			    std::get<0>(list), flipBytesIfBigEndianHost(*dataPtr), time, runLength);
+			currentMemoryUsage += stored
+			    * (sizeof(LLNode<datatypes::EtherCATDataType::UNSIGNED8, nodeSize>) / nodeSize);
 			break;
 		case 2:
 			std::memcpy(&result, dataPtr, sizeof(datatypes::EtherCATDataType::UNSIGNED16));
-			std::get<1>(list).append(flipBytesIfBigEndianHost(result), time);
-			currentMemoryUsage
-			    += sizeof(LLNode<datatypes::EtherCATDataType::UNSIGNED16, nodeSize>) / nodeSize;
+			stored = appendRegister(
+			    std::get<1>(list), flipBytesIfBigEndianHost(result), time, runLength);
+			currentMemoryUsage += stored
+			    * (sizeof(LLNode<datatypes::EtherCATDataType::UNSIGNED16, nodeSize>) / nodeSize);
 			break;
 		case 4:
 			std::memcpy(&result, dataPtr, sizeof(datatypes::EtherCATDataType::UNSIGNED32));
-			std::get<2>(list).append(flipBytesIfBigEndianHost(result), time);
-			currentMemoryUsage
-			    += sizeof(LLNode<datatypes::EtherCATDataType::UNSIGNED32, nodeSize>) / nodeSize;
+			stored = appendRegister(
+			    std::get<2>(list), flipBytesIfBigEndianHost(result), time, runLength);
+			currentMemoryUsage += stored
+			    * (sizeof(LLNode<datatypes::EtherCATDataType::UNSIGNED32, nodeSize>) / nodeSize);
 			break;
 		case 8: // NOLINT
 			std::memcpy(&result, dataPtr, sizeof(datatypes::EtherCATDataType::UNSIGNED64));
-			std::get<3>(list).append(flipBytesIfBigEndianHost(result), time);
-			currentMemoryUsage
-			    += sizeof(LLNode<datatypes::EtherCATDataType::UNSIGNED64, nodeSize>) / nodeSize;
+			stored = appendRegister(
+			    std::get<3>(list), flipBytesIfBigEndianHost(result), time, runLength);
+			currentMemoryUsage += stored
+			    * (sizeof(LLNode<datatypes::EtherCATDataType::UNSIGNED64, nodeSize>) / nodeSize);
 			break;
 		}
 	}
@@ -202,6 +451,11 @@ namespace etherkitten::reader
 		maximumMemory.store(size, std::memory_order_release);
 	}
 
+	void SearchListReader::setRegisterRunLengthStorage(bool enabled)
+	{
+		registerRunLengthStorage.store(enabled, std::memory_order_release);
+	}
+
 	void SearchListReader::freeMemoryIfNecessary()
 	{
 		size_t maxMemory = maximumMemory.load(std::memory_order_acquire);
@@ -223,15 +477,24 @@ namespace etherkitten::reader
 		size_t freeFromIOMap = pdoQuota * toFree;
 		size_t freeFromRegisters = (1 - pdoQuota) * toFree;
 
-		// Space for the node + pointer + space for IOMap + space for IOMap metadata (-1 for first
-		// array element)
-		size_t singleIOMapNodeSpace = sizeof(LLNode<std::unique_ptr<IOMap>, nodeSize>)
-		    + nodeSize * (ioMapUsedSize + sizeof(IOMap) - 1);
+		// Space for the node + its slab of IOMaps including their metadata
+		size_t singleIOMapNodeSpace = sizeof(LLNode<IOMapSlab, nodeSize>)
+		    + nodeSize * IOMapSlab::getSlotSize(ioMapUsedSize) + IOMapSlab::padding;
 		size_t ioMapsToFree = freeFromIOMap / singleIOMapNodeSpace;
 
 		int freedIOMaps = ioMapList.removeOldest(ioMapsToFree);
 		// Try to reclaim remaining space from registers
 		freeFromRegisters += (ioMapsToFree - freedIOMaps) * singleIOMapNodeSpace;
+		// Hot PDOs only need to hold values for the time the IOMaps still cover,
+		// and the CycleStatistics are recorded once per cycle like the IOMaps
+		size_t freedFromHotPDOs = 0;
+		size_t freedFromCycleStatistics = 0;
+		std::optional<datatypes::TimeStamp> oldestIOMap = ioMapList.getOldestTime();
+		if (oldestIOMap.has_value())
+		{
+			freedFromHotPDOs = freeHotPDOs(oldestIOMap.value());
+			freedFromCycleStatistics = freeCycleStatistics(oldestIOMap.value());
+		}
 
 		// This approach does not always perform optimally and does not free registers equally
 		// across slaves or among one slave. It should do well enough as long as there are
@@ -283,7 +546,7 @@ namespace etherkitten::reader
 				freeFromRegistersPerSlave = remainingToFreeFromRegisters / remainingSlaves;
 			}
 		}
-		return toFree - remainingToFreeFromRegisters;
+		return toFree - remainingToFreeFromRegisters + freedFromHotPDOs + freedFromCycleStatistics;
 	}
 
 	void SearchListReader::insertNewRegisterTimeStamp(datatypes::TimeStamp& time)
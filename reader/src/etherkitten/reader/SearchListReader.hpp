@@ -21,8 +21,17 @@
  * \brief Defines the SearchListReader, a Reader that holds its data in SearchLists.
  */
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 #include <etherkitten/datatypes/SlaveInfo.hpp>
 #include <etherkitten/datatypes/dataobjects.hpp>
@@ -31,6 +40,7 @@
 #include <etherkitten/datatypes/time.hpp>
 
 #include "BusSlaveInformant.hpp"
+#include "EventSignal.hpp"
 #include "IOMap.hpp"
 #include "Reader.hpp"
 #include "RingBuffer.hpp"
@@ -48,6 +58,15 @@ namespace etherkitten::reader
 	 * Users of the library may access the values with AbstractNewestValueViews and
 	 * AbstractDataViews. If an implementing class is destroyed, all AbstractNewestValueViews
 	 * and AbstractDataViews that were created by it are invalidated.
+	 *
+	 * PDOs that any view is requested for become "hot": as long as any of those views is in
+	 * use, the value of the PDO is decoded once from every inserted IOMap into a dedicated
+	 * SearchList. When a PDO becomes hot, the IOMaps that are already stored are decoded as
+	 * well, so its AbstractDataViews read the decoded values from the first one on instead of
+	 * extracting the PDO from the IOMaps themselves.
+	 *
+	 * Views with a step that is coarse enough for Aggregates (see Aggregate::isCoarse()) are
+	 * AggregateDataViews for decoded PDOs and for registers that are shown as they are stored.
 	 */
 	class SearchListReader : public Reader // NOLINT(cppcoreguidelines-special-member-functions)
 	{
@@ -69,7 +88,15 @@ namespace etherkitten::reader
 		std::shared_ptr<datatypes::AbstractDataView> getView(
 		    const datatypes::Register& reg, datatypes::TimeSeries time) override;
 
-		std::shared_ptr<DataView<std::unique_ptr<IOMap>, nodeSize, IOMap*>> getIOMapView(
+		std::unique_ptr<datatypes::AbstractNewestValueView> getNewest(
+		    const datatypes::CycleStatistic& statistic) override;
+
+		std::shared_ptr<datatypes::AbstractDataView> getView(
+		    const datatypes::CycleStatistic& statistic, datatypes::TimeSeries time) override;
+
+		const CycleHistogram& getCycleHistogram(datatypes::CycleStatisticType type) override;
+
+		std::shared_ptr<DataView<IOMapSlab, nodeSize, IOMap*>> getIOMapView(
 		    datatypes::TimeStamp startTime) override;
 
 		std::shared_ptr<datatypes::AbstractDataView> getRegisterRawDataView(
@@ -90,21 +117,72 @@ namespace etherkitten::reader
 
 		void setMaximumMemory(size_t size) override;
 
+		void setRegisterRunLengthStorage(bool enabled) override;
+
 		datatypes::TimeStamp getStartTime() const override;
 
+		uint32_t waitForNewData(uint32_t seen, datatypes::TimeStep timeout) override
+		{
+			return newDataSignal.waitFor(seen, timeout);
+		}
+
 	protected:
 		/*!
-		 * \brief Insert an IOMap into the respective SearchList.
-		 * \param ioMap the IOMap to insert
+		 * \brief The values of all CycleStatisticTypes for one cycle,
+		 * indexed by the CycleStatisticType.
+		 */
+		using CycleMeasurement = std::array<uint32_t, datatypes::cycleStatisticTypeCount>;
+
+		/*!
+		 * \brief Convert a duration to the nanoseconds stored for a CycleStatistic.
+		 * \param duration the duration to convert
+		 * \return the duration in nanoseconds, clamped to the range of the stored values
+		 */
+		static uint32_t toCycleValue(std::chrono::nanoseconds duration)
+		{
+			auto nanoseconds = duration.count();
+			return static_cast<uint32_t>(std::clamp<decltype(nanoseconds)>(
+			    nanoseconds, 0, std::numeric_limits<uint32_t>::max()));
+		}
+
+		/*!
+		 * \brief Insert the values of the CycleStatistics for one cycle into their SearchLists
+		 * and histograms.
+		 * \param measurement the values of the cycle
+		 * \param time the TimeStamp of the start of the cycle
+		 */
+		void insertCycleMeasurement(
+		    const CycleMeasurement& measurement, datatypes::TimeStamp time);
+
+		/*!
+		 * \brief Insert the value of one CycleStatistic for one cycle into its SearchList
+		 * and histogram.
+		 * \param type the CycleStatisticType of the value, which must be valid
+		 * \param value the value of the cycle
+		 * \param time the TimeStamp of the start of the cycle
+		 */
+		void insertCycleStatistic(
+		    datatypes::CycleStatisticType type, uint32_t value, datatypes::TimeStamp time);
+
+		/*!
+		 * \brief Copy an IOMap into the respective SearchList.
+		 *
+		 * IOMaps shorter than the ioMapUsedSize this SearchListReader was constructed with
+		 * are padded with zeros.
+		 * \param ioMapData the data of the IOMap to insert
+		 * \param ioMapSize the size of the IOMap data in bytes
 		 * \param time the TimeStamp to associate with the IOMap
+		 * \exception std::invalid_argument iff the IOMap is longer than ioMapUsedSize
 		 */
-		void insertIOMap(std::unique_ptr<IOMap> ioMap, datatypes::TimeStamp&& time);
+		void insertIOMap(
+		    const uint8_t* ioMapData, size_t ioMapSize, datatypes::TimeStamp&& time);
 
 		/*!
 		 * \brief Insert a register value into its respective SearchList.
 		 *
 		 * The registerType must be the byte-aligned register if there are multiple
-		 * registers in the same byte.
+		 * registers in the same byte. With run-length storage, a value that continues a run
+		 * of equal values is only stored once the run ends, see SearchList::appendChange().
 		 * \param registerType the type of the register to insert
 		 * \param dataPtr a pointer to the data to insert
 		 * \param slaveConfiguredAddress the address of the slave the register belongs to
@@ -126,21 +204,71 @@ namespace etherkitten::reader
 		 */
 		void freeMemoryIfNecessary();
 
+		/*!
+		 * \brief Wake the thread that waits for new data, if there is one.
+		 *
+		 * Call this after inserting a batch of data.
+		 */
+		void signalNewData() { newDataSignal.signal(); }
+
 		std::vector<uint16_t> slaveConfiguredAddresses; // NOLINT
 
 	private:
-		SearchList<std::unique_ptr<IOMap>, nodeSize> ioMapList;
+		EventSignal newDataSignal;
+
+		/*!
+		 * \brief A view that keeps a PDO hot.
+		 */
+		struct Subscriber
+		{
+			// The view, or what a NewestValueView holds on to while it exists
+			std::weak_ptr<const void> holder;
+			// How many references the SearchList the view reads from holds itself
+			long ownReferences;
+		};
+
+		/*!
+		 * \brief A PDO whose values are decoded from every IOMap as it is inserted.
+		 */
+		struct HotPDO
+		{
+			datatypes::PDOInfo info;
+			std::function<double(IOMap*, size_t, size_t)> decode;
+			SearchList<double, nodeSize> values;
+			// The views that keep this PDO hot
+			std::vector<Subscriber> subscribers;
+			// The TimeStamp of the newest IOMap that was decoded
+			datatypes::TimeStamp decodedUntil = datatypes::TimeStamp::min();
+			size_t memoryUsage = 0;
+		};
+
+		SearchList<IOMapSlab, nodeSize> ioMapList;
+		std::unordered_map<datatypes::PDO, HotPDO, datatypes::PDOHash, datatypes::PDOEqual>
+		    hotPDOs;
+		std::mutex hotPDOMutex;
+		// The memory of the values decoded when PDOs became hot, which is added to the
+		// currentMemoryUsage by the thread that inserts the data
+		size_t uncountedHotPDOMemory = 0;
 		std::unordered_map<uint16_t,
 		    std::unordered_map<datatypes::RegisterEnum, bReader::RegTypesVariant<nodeSize>>>
 		    registerLists;
 
+		std::array<SearchList<uint32_t, nodeSize>, datatypes::cycleStatisticTypeCount>
+		    cycleStatisticLists;
+		std::array<CycleHistogram, datatypes::cycleStatisticTypeCount> cycleHistograms;
+		size_t cycleStatisticMemoryUsage = 0;
+
 		const datatypes::TimeStamp startTime;
 
+		std::atomic_bool registerRunLengthStorage = false;
+
 		std::atomic_size_t maximumMemory;
 		static constexpr float quotaUsageBeforeDeletion = 0.9;
 		size_t currentMemoryUsage;
 
 		size_t ioMapUsedSize;
+		// Holds IOMaps that are too short while they are padded
+		std::vector<uint8_t> paddedIOMap;
 
 		static constexpr size_t frequencyAveragerCount = 100;
 		// Note that the atomics in the RingBuffer are non-blocking on x86-64 with g++
@@ -149,6 +277,34 @@ namespace etherkitten::reader
 
 		size_t freeMemory(size_t toFree);
 
+		/*!
+		 * \brief Append a register value to its SearchList.
+		 * \param list the SearchList of the register
+		 * \param value the value to append
+		 * \param time the TimeStamp of the value
+		 * \param runLength whether to only store changes, see SearchList::appendChange()
+		 * \return how many data points were stored
+		 */
+		template<typename T>
+		static size_t appendRegister(SearchList<T, nodeSize>& list, uint64_t value,
+		    datatypes::TimeStamp time, bool runLength)
+		{
+			if (runLength)
+			{
+				return list.appendChange(static_cast<T>(value), time);
+			}
+			list.append(static_cast<T>(value), time);
+			return 1;
+		}
+
+		HotPDO& makeHot(const datatypes::PDO& pdo);
+
+		void decodeHotPDOs(IOMap* ioMap, datatypes::TimeStamp time);
+
+		size_t freeHotPDOs(datatypes::TimeStamp time);
+
+		size_t freeCycleStatistics(datatypes::TimeStamp time);
+
 		static double getFrequency(
 		    RingBuffer<datatypes::TimeStamp, frequencyAveragerCount>& buffer);
 	};
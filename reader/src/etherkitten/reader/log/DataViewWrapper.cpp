@@ -19,6 +19,7 @@
 
 #include "../DataView.hpp"
 #include "Serialized.hpp"
+#include "cyclestatistic.hpp"
 #include "registerdata.hpp"
 #include <any>
 #include <etherkitten/datatypes/datapoints.hpp>
@@ -46,10 +47,15 @@ namespace etherkitten::reader
 
 	Serialized RegisterDataViewWrapper::get()
 	{
-		using namespace datatypes::EtherCATDataType;
 		datatypes::TimeStamp timeStamp(dataView->getTime());
 		auto ms = datatypes::timeStampToInt(timeStamp);
+		RegisterDataBlock block{ regAddr, slaveId, static_cast<uint64_t>(ms), getValue() };
+		return block.getSerializer().serialize(block);
+	}
 
+	uint64_t RegisterDataViewWrapper::getValue()
+	{
+		using namespace datatypes::EtherCATDataType;
 		uint64_t data;
 		switch (datatypes::getRegisterByteLength(static_cast<datatypes::RegisterEnum>(regAddr)))
 		{
@@ -72,9 +78,7 @@ namespace etherkitten::reader
 		default:
 			throw std::runtime_error("unexpected register length");
 		}
-
-		RegisterDataBlock block{ regAddr, slaveId, static_cast<uint64_t>(ms), data };
-		return block.getSerializer().serialize(block);
+		return data;
 	}
 
 	bool RegisterDataViewWrapper::isEmpty() { return dataView->isEmpty(); }
@@ -82,7 +86,7 @@ namespace etherkitten::reader
 	datatypes::TimeStamp RegisterDataViewWrapper::getTime() { return dataView->getTime(); }
 
 	IOMapDataViewWrapper::IOMapDataViewWrapper(
-	    std::shared_ptr<DataView<std::unique_ptr<IOMap>, Reader::nodeSize, IOMap*>> dataView)
+	    std::shared_ptr<DataView<IOMapSlab, Reader::nodeSize, IOMap*>> dataView)
 	    : dataView(dataView)
 	{
 		firstIsValid = !dataView->isEmpty();
@@ -101,4 +105,31 @@ namespace etherkitten::reader
 	datatypes::TimeStamp IOMapDataViewWrapper::getTime() { return dataView->getTime(); }
 
 	IOMap* IOMapDataViewWrapper::get() { return **dataView.get(); }
+
+	CycleStatisticDataViewWrapper::CycleStatisticDataViewWrapper(
+	    datatypes::CycleStatisticType type, std::shared_ptr<datatypes::AbstractDataView> dataView)
+	    : type(type)
+	    , dataView(std::dynamic_pointer_cast<DataView<uint32_t, Reader::nodeSize>>(dataView))
+	{
+		firstIsValid = !dataView->isEmpty();
+	}
+
+	bool CycleStatisticDataViewWrapper::hasNext() { return dataView->hasNext() || firstIsValid; }
+
+	void CycleStatisticDataViewWrapper::next()
+	{
+		if (firstIsValid)
+			firstIsValid = false;
+		else
+			++(*dataView);
+	}
+
+	Serialized CycleStatisticDataViewWrapper::get()
+	{
+		CycleStatisticBlock block{ static_cast<uint16_t>(type),
+			datatypes::timeStampToInt(dataView->getTime()), **dataView };
+		return block.getSerializer().serialize(block);
+	}
+
+	datatypes::TimeStamp CycleStatisticDataViewWrapper::getTime() { return dataView->getTime(); }
 } // namespace etherkitten::reader
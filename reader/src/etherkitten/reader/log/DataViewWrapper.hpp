@@ -66,6 +66,25 @@ namespace etherkitten::reader
 		 */
 		Serialized get();
 
+		/*!
+		 * \brief Get the value of the current data point.
+		 * Must only be called after next() has been called at least once.
+		 * \return the raw value of the register
+		 */
+		uint64_t getValue();
+
+		/*!
+		 * \brief Get the address of the register this wrapper reads.
+		 * \return the register address
+		 */
+		uint16_t getRegisterAddress() const { return regAddr; }
+
+		/*!
+		 * \brief Get the slave whose register this wrapper reads.
+		 * \return the slave id
+		 */
+		uint16_t getSlaveId() const { return slaveId; }
+
 		/*!
 		 * \brief Get whether get() and getTime() can be called.
 		 * This is true, if there has been data from the underlaying DataView.
@@ -98,7 +117,7 @@ namespace etherkitten::reader
 		 * \param dataView The dataView for the register
 		 */
 		IOMapDataViewWrapper(
-		    std::shared_ptr<DataView<std::unique_ptr<IOMap>, Reader::nodeSize, IOMap*>> dataView);
+		    std::shared_ptr<DataView<IOMapSlab, Reader::nodeSize, IOMap*>> dataView);
 
 		/*!
 		 * \brief Get whether there is new data for the register
@@ -126,7 +145,51 @@ namespace etherkitten::reader
 
 	private:
 		bool firstIsValid = false;
-		std::shared_ptr<DataView<std::unique_ptr<IOMap>, Reader::nodeSize, IOMap*>> dataView;
+		std::shared_ptr<DataView<IOMapSlab, Reader::nodeSize, IOMap*>> dataView;
+	};
+
+	/*!
+	 * \brief Wraps the DataView of a CycleStatistic and handles its serialization.
+	 */
+	class CycleStatisticDataViewWrapper
+	{
+	public:
+		/*!
+		 * \brief Create CycleStatisticDataViewWrapper with given type and dataView
+		 * \param type The CycleStatisticType of the dataView
+		 * \param dataView The dataView for the CycleStatistic
+		 */
+		CycleStatisticDataViewWrapper(datatypes::CycleStatisticType type,
+		    std::shared_ptr<datatypes::AbstractDataView> dataView);
+
+		/*!
+		 * \brief Get whether there is new data for the CycleStatistic
+		 * \return whether there is new data
+		 */
+		bool hasNext();
+
+		/*!
+		 * \brief Go to the next data
+		 */
+		void next();
+
+		/*!
+		 * \brief Serialize the current data point.
+		 * Must only be called after next() has been called at least once.
+		 * \return the buffer containing the data for the log file
+		 */
+		Serialized get();
+
+		/*!
+		 * \brief Get the timestamp of the current data
+		 * \return the timestamp of the data this Wrapper currently points to
+		 */
+		datatypes::TimeStamp getTime();
+
+	private:
+		const datatypes::CycleStatisticType type;
+		bool firstIsValid = false;
+		std::shared_ptr<DataView<uint32_t, Reader::nodeSize>> dataView;
 	};
 
 } // namespace etherkitten::reader
@@ -31,6 +31,16 @@ namespace etherkitten::reader
 		memcpy(data, ser.data, length);
 	}
 
+	Serialized::Serialized(Serialized&& ser) noexcept
+	    : data(ser.data)
+	    , length(ser.length)
+	    , shouldFree(ser.shouldFree)
+	{
+		ser.data = nullptr;
+		ser.length = 0;
+		ser.shouldFree = false;
+	}
+
 	Serialized::Serialized(uint64_t length)
 	{
 		data = new char[length];
@@ -60,4 +70,10 @@ namespace etherkitten::reader
 		throw std::runtime_error(s.str());
 	}
 
+	Serialized Serialized::wrap(const char* data, uint64_t length)
+	{
+		// Only parsing reads from the buffer, so it is never written to
+		return Serialized(const_cast<char*>(data), length); // NOLINT
+	}
+
 } // namespace etherkitten::reader
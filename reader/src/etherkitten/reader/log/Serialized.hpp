@@ -40,7 +40,13 @@ namespace etherkitten::reader
 		 */
 		Serialized(uint64_t length);
 
-		Serialized(Serialized&& ser) = default;
+		/*!
+		 * \brief Move a Serialized object.
+		 *
+		 * The moved from object is left empty and does not own a buffer anymore.
+		 * \param ser the object to move
+		 */
+		Serialized(Serialized&& ser) noexcept;
 
 		/*!
 		 * \brief Create a copy of a Serialized object.
@@ -63,6 +69,18 @@ namespace etherkitten::reader
 		 */
 		Serialized getAt(uint64_t offset, uint64_t length);
 
+		/*!
+		 * \brief Create a Serialized object representing a buffer it does not own,
+		 * e.g. a file that is mapped into memory.
+		 *
+		 * The buffer must outlive the created object and must not be written to
+		 * through it.
+		 * \param data the buffer
+		 * \param length the length of the buffer
+		 * \return the Serialized object for the buffer
+		 */
+		static Serialized wrap(const char* data, uint64_t length);
+
 		/*!
 		 * \brief data the buffer of length length
 		 */
@@ -0,0 +1,231 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "chunkindex.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace etherkitten::reader
+{
+	ChunkEntryBlockSerializer ChunkEntryBlock::serializer;
+	ChunkIndexBlockSerializer ChunkIndexBlock::serializer;
+
+	/*
+	 * block structure:
+	 * *--------*--------*------------*-----------*-------------*-------------*---------------*
+	 * | offset | length | first time | last time | block kinds | slave count |    slaves     |
+	 * *--------*--------*------------*-----------*-------------*-------------*---------------*
+	 * |   64   |   64   |     64     |    64     |      8      |     16      | 16 per slave  |
+	 * *--------*--------*------------*-----------*-------------*-------------*---------------*
+	 * second line contains the length in bits
+	 */
+
+	void ChunkEntryBlockSerializer::serialize(const ChunkEntryBlock& obj, Serialized& ser)
+	{
+		ser.write(obj.offset, 0);
+		ser.write(obj.length, 8);
+		ser.write(obj.firstTime, 16);
+		ser.write(obj.lastTime, 24);
+		ser.write(obj.blockKinds, 32);
+		ser.write(static_cast<uint16_t>(obj.slaves.size()), 33);
+		uint64_t offset = 35;
+		for (uint16_t slave : obj.slaves)
+		{
+			ser.write(slave, offset);
+			offset += 2;
+		}
+	}
+
+	Serialized ChunkEntryBlockSerializer::serialize(const ChunkEntryBlock& obj)
+	{
+		Serialized ser(obj.getSerializedSize());
+		serialize(obj, ser);
+		return ser;
+	}
+
+	ChunkEntryBlock ChunkEntryBlockSerializer::parseSerialized(
+	    Serialized& ser, ParsingContext& context)
+	{
+		(void)context;
+		uint16_t slaveCount = ser.read<uint16_t>(33);
+		std::vector<uint16_t> slaves;
+		slaves.reserve(slaveCount);
+		for (uint64_t i = 0; i < slaveCount; ++i)
+		{
+			slaves.push_back(ser.read<uint16_t>(35 + 2 * i));
+		}
+		return ChunkEntryBlock{ ser.read<uint64_t>(0), ser.read<uint64_t>(8),
+			ser.read<uint64_t>(16), ser.read<uint64_t>(24), ser.read<uint8_t>(32),
+			std::move(slaves) };
+	}
+
+	uint8_t ChunkEntryBlock::getKindOf(uint32_t ident)
+	{
+		switch ((ident & 0xFF000000) >> 24)
+		{
+		case 0x80:
+			return processDataKind;
+		case 0x90:
+			return coeKind;
+		case 0xA0:
+			return errorKind;
+		case 0xC0:
+			return encodedChunkKind;
+		case 0xE0:
+			return cycleStatisticKind;
+		default:
+			return registerKind;
+		}
+	}
+
+	void ChunkEntryBlock::addDataBlock(const Serialized& block)
+	{
+		uint32_t ident = block.read<uint32_t>(0);
+		uint64_t time = block.read<uint64_t>(4);
+		uint8_t kind = getKindOf(ident);
+		if (kind == registerKind || kind == coeKind)
+		{
+			addSlave(ident & 0xFFFF);
+		}
+		else if (kind == errorKind)
+		{
+			// The slaves of an ErrorBlock follow its timestamp and length
+			addSlave(block.read<uint16_t>(20));
+			addSlave(block.read<uint16_t>(22));
+		}
+
+		if (isEmpty())
+		{
+			firstTime = time;
+			lastTime = time;
+		}
+		else
+		{
+			firstTime = std::min(firstTime, time);
+			lastTime = std::max(lastTime, time);
+		}
+		blockKinds |= kind;
+		length += block.length;
+	}
+
+	bool ChunkEntryBlock::hasSlave(uint16_t slave) const
+	{
+		return std::binary_search(slaves.begin(), slaves.end(), slave);
+	}
+
+	void ChunkEntryBlock::addSlave(uint16_t slave)
+	{
+		// ErrorBlocks use the largest id for errors without a slave
+		if (slave == std::numeric_limits<uint16_t>::max())
+			return;
+		auto it = std::lower_bound(slaves.begin(), slaves.end(), slave);
+		if (it == slaves.end() || *it != slave)
+			slaves.insert(it, slave);
+	}
+
+	uint64_t ChunkEntryBlock::getSerializedSize() const { return 35 + 2 * slaves.size(); }
+
+	/*
+	 * block structure:
+	 * *----*-------------*-----------*---------------------*
+	 * | id | chunk count | blocksize | chunk entry blocks  |
+	 * *----*-------------*-----------*---------------------*
+	 * | 32 |     64      |    64     |                     |
+	 * *----*-------------*-----------*---------------------*
+	 * second line contains the length in bits
+	 */
+
+	void ChunkIndexBlockSerializer::serialize(const ChunkIndexBlock& obj, Serialized& ser)
+	{
+		ser.write(obj.ident, 0);
+		ser.write(static_cast<uint64_t>(obj.chunks.size()), 4);
+		ser.write(obj.getSerializedSize(), 12);
+		uint64_t offset = ChunkIndexBlock::headerSize;
+		for (auto& chunk : obj.chunks)
+		{
+			Serialized sub = ser.getAt(offset, chunk.getSerializedSize());
+			chunk.getSerializer().serialize(chunk, sub);
+			offset += sub.length;
+		}
+	}
+
+	Serialized ChunkIndexBlockSerializer::serialize(const ChunkIndexBlock& obj)
+	{
+		Serialized ser(obj.getSerializedSize());
+		serialize(obj, ser);
+		return ser;
+	}
+
+	ChunkIndexBlock ChunkIndexBlockSerializer::parseSerialized(
+	    Serialized& ser, ParsingContext& context)
+	{
+		if (((ser.read<uint32_t>(0) & 0xFF000000) >> 24) != 0xB0)
+			throw std::runtime_error("block is not a ChunkIndexBlock");
+		uint64_t chunkCount = ser.read<uint64_t>(4);
+		std::vector<ChunkEntryBlock> chunks;
+		uint64_t offset = ChunkIndexBlock::headerSize;
+		for (uint64_t i = 0; i < chunkCount; ++i)
+		{
+			Serialized sub = ser.getAt(offset, ser.length - offset);
+			chunks.push_back(ChunkEntryBlock::serializer.parseSerialized(sub, context));
+			offset += chunks.back().getSerializedSize();
+		}
+		return ChunkIndexBlock{ std::move(chunks) };
+	}
+
+	ChunkIndexBlock::ChunkIndexBlock(std::vector<ChunkEntryBlock> chunks)
+	    : chunks(std::move(chunks))
+	    , latestUpTo(this->chunks.size())
+	    , earliestFrom(this->chunks.size())
+	{
+		uint64_t latest = 0;
+		for (size_t i = 0; i < this->chunks.size(); ++i)
+		{
+			latest = std::max(latest, this->chunks[i].lastTime);
+			latestUpTo[i] = latest;
+		}
+		uint64_t earliest = std::numeric_limits<uint64_t>::max();
+		for (size_t i = this->chunks.size(); i > 0; --i)
+		{
+			earliest = std::min(earliest, this->chunks[i - 1].firstTime);
+			earliestFrom[i - 1] = earliest;
+		}
+	}
+
+	std::pair<size_t, size_t> ChunkIndexBlock::findChunks(uint64_t from, uint64_t to) const
+	{
+		// Every chunk in front of first only holds data from before the window
+		size_t first
+		    = std::lower_bound(latestUpTo.begin(), latestUpTo.end(), from) - latestUpTo.begin();
+		// Every chunk from end on only holds data from after the window
+		size_t end = std::upper_bound(earliestFrom.begin(), earliestFrom.end(), to)
+		    - earliestFrom.begin();
+		return { first, std::max(first, end) };
+	}
+
+	uint64_t ChunkIndexBlock::getSerializedSize() const
+	{
+		uint64_t size = headerSize;
+		for (auto& chunk : chunks)
+		{
+			size += chunk.getSerializedSize();
+		}
+		return size;
+	}
+} // namespace etherkitten::reader
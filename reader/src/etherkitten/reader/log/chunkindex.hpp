@@ -0,0 +1,249 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+/*!
+ * \file
+ * \brief Defines ChunkEntryBlock and ChunkIndexBlock, which make the data blocks of a log
+ * seekable, and the corresponding Serializers.
+ */
+
+#include "Block.hpp"
+#include "Serialized.hpp"
+#include "Serializer.hpp"
+#include <inttypes.h>
+#include <utility>
+#include <vector>
+
+namespace etherkitten::reader
+{
+	class ChunkEntryBlock;
+	class ChunkIndexBlock;
+
+	/*!
+	 * \brief Serializes ChunkEntryBlock and parses serialized ChunkEntryBlock
+	 */
+	class ChunkEntryBlockSerializer : public Serializer<ChunkEntryBlock>
+	{
+	public:
+		Serialized serialize(const ChunkEntryBlock& obj) override;
+		void serialize(const ChunkEntryBlock& obj, Serialized& ser) override;
+		ChunkEntryBlock parseSerialized(Serialized& data, ParsingContext& context) override;
+	};
+
+	/*!
+	 * \brief Describes one chunk of a log, a consecutive run of data blocks.
+	 *
+	 * The Logger starts a new chunk once the current one has grown to the chunk size,
+	 * so all chunks but the last are at least that long. Data blocks are never split
+	 * between chunks.
+	 */
+	class ChunkEntryBlock : public Block<ChunkEntryBlock>
+	{
+	public:
+		/*!
+		 * \brief Create an empty ChunkEntryBlock for a chunk that starts at the given offset.
+		 * \param offset the file offset of the first data block of the chunk
+		 */
+		explicit ChunkEntryBlock(uint64_t offset)
+		    : ChunkEntryBlock(offset, 0, 0, 0, 0, {})
+		{
+		}
+
+		ChunkEntryBlock(uint64_t offset, uint64_t length, uint64_t firstTime, uint64_t lastTime,
+		    uint8_t blockKinds, std::vector<uint16_t> slaves)
+		    : offset(offset)
+		    , length(length)
+		    , firstTime(firstTime)
+		    , lastTime(lastTime)
+		    , blockKinds(blockKinds)
+		    , slaves(std::move(slaves))
+		{
+		}
+		friend ChunkEntryBlockSerializer;
+
+		/*!
+		 * \brief Bit in blockKinds that marks ProcessDataBlocks.
+		 */
+		static constexpr uint8_t processDataKind = 0x01;
+
+		/*!
+		 * \brief Bit in blockKinds that marks RegisterDataBlocks.
+		 */
+		static constexpr uint8_t registerKind = 0x02;
+
+		/*!
+		 * \brief Bit in blockKinds that marks CoEDataBlocks.
+		 */
+		static constexpr uint8_t coeKind = 0x04;
+
+		/*!
+		 * \brief Bit in blockKinds that marks ErrorBlocks.
+		 */
+		static constexpr uint8_t errorKind = 0x08;
+
+		/*!
+		 * \brief The kind of an EncodedChunkBlock.
+		 *
+		 * It is never set in blockKinds, which tells the kinds of the blocks it contains.
+		 */
+		static constexpr uint8_t encodedChunkKind = 0x10;
+
+		/*!
+		 * \brief Bit in blockKinds that marks CycleStatisticBlocks.
+		 */
+		static constexpr uint8_t cycleStatisticKind = 0x20;
+
+		/*!
+		 * \brief Get the kind of a data block from its identifier.
+		 * \param ident the first 32 bits of the data block
+		 * \return the bit in blockKinds that marks the kind of the block
+		 */
+		static uint8_t getKindOf(uint32_t ident);
+
+		/*!
+		 * \brief Append a serialized data block to this chunk.
+		 *
+		 * The kind, the timestamp and the slaves of the block are read from the block itself.
+		 * \param block the serialized data block
+		 * \exception std::runtime_error iff block is too short to be a data block
+		 */
+		void addDataBlock(const Serialized& block);
+
+		/*!
+		 * \brief Check whether this chunk contains data blocks.
+		 * \retval true iff no data block was added to this chunk
+		 */
+		bool isEmpty() const { return length == 0; }
+
+		/*!
+		 * \brief Check whether this chunk may contain data of a slave.
+		 * \param slave the id of the slave
+		 * \retval true iff a register, CoE or error block of the slave is in this chunk
+		 */
+		bool hasSlave(uint16_t slave) const;
+
+		/*!
+		 * \brief file offset of the first data block of the chunk
+		 */
+		uint64_t offset;
+
+		/*!
+		 * \brief length of the chunk in bytes
+		 *
+		 * For an encoded chunk this is the length of its EncodedChunkBlock.
+		 */
+		uint64_t length;
+
+		/*!
+		 * \brief earliest timestamp of the data blocks in the chunk
+		 */
+		uint64_t firstTime;
+
+		/*!
+		 * \brief latest timestamp of the data blocks in the chunk
+		 */
+		uint64_t lastTime;
+
+		/*!
+		 * \brief bitmask of the kinds of data blocks in the chunk
+		 */
+		uint8_t blockKinds;
+
+		/*!
+		 * \brief sorted ids of the slaves with register, CoE or error blocks in the chunk
+		 *
+		 * Process data belongs to all slaves and is only marked in blockKinds.
+		 */
+		std::vector<uint16_t> slaves;
+
+		/*!
+		 * \brief Serializer that can be used for ChunkEntryBlock
+		 */
+		static ChunkEntryBlockSerializer serializer;
+		Serializer<ChunkEntryBlock>& getSerializer() const override { return serializer; }
+		uint64_t getSerializedSize() const override;
+
+	private:
+		void addSlave(uint16_t slave);
+	};
+
+	/*!
+	 * \brief Serializes ChunkIndexBlock and parses serialized ChunkIndexBlock
+	 */
+	class ChunkIndexBlockSerializer : public Serializer<ChunkIndexBlock>
+	{
+	public:
+		Serialized serialize(const ChunkIndexBlock& obj) override;
+		void serialize(const ChunkIndexBlock& obj, Serialized& ser) override;
+		ChunkIndexBlock parseSerialized(Serialized& data, ParsingContext& context) override;
+	};
+
+	/*!
+	 * \brief The index of all chunks of a log, written after the last chunk.
+	 *
+	 * The streams of data blocks the Logger interleaves are each ordered by time,
+	 * but lag behind each other, so the time ranges of neighboring chunks may overlap.
+	 * The index still finds the chunks that may hold data of a time window with two binary
+	 * searches over the running maximum of the last timestamps and the running minimum
+	 * of the first timestamps, both of which are sorted.
+	 */
+	class ChunkIndexBlock : public Block<ChunkIndexBlock>
+	{
+	public:
+		explicit ChunkIndexBlock(std::vector<ChunkEntryBlock> chunks);
+		friend ChunkIndexBlockSerializer;
+
+		/*!
+		 * \brief Length of the part of the block in front of the chunk entries, which
+		 * contains the length of the whole block.
+		 */
+		static constexpr uint64_t headerSize = 20;
+
+		/*!
+		 * \brief Get the entries of all chunks in file order.
+		 * \return the chunk entries
+		 */
+		const std::vector<ChunkEntryBlock>& getChunks() const { return chunks; }
+
+		/*!
+		 * \brief Find the chunks that may contain data between two timestamps.
+		 *
+		 * Runs in O(log n) of the number of chunks.
+		 * \param from the earliest timestamp of the window
+		 * \param to the latest timestamp of the window
+		 * \return the index of the first chunk and the index after the last chunk that may
+		 * contain data from the window, both are equal if no chunk does
+		 */
+		std::pair<size_t, size_t> findChunks(uint64_t from, uint64_t to) const;
+
+		/*!
+		 * \brief Serializer that can be used for ChunkIndexBlock
+		 */
+		static ChunkIndexBlockSerializer serializer;
+		Serializer<ChunkIndexBlock>& getSerializer() const override { return serializer; }
+		uint64_t getSerializedSize() const override;
+
+	private:
+		uint32_t ident = 0xB0000000;
+		std::vector<ChunkEntryBlock> chunks;
+		// latestUpTo[i] is the latest timestamp in the chunks 0 to i
+		std::vector<uint64_t> latestUpTo;
+		// earliestFrom[i] is the earliest timestamp in the chunks i to the last one
+		std::vector<uint64_t> earliestFrom;
+	};
+} // namespace etherkitten::reader
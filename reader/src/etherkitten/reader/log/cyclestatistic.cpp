@@ -0,0 +1,54 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "cyclestatistic.hpp"
+
+namespace etherkitten::reader
+{
+	CycleStatisticBlockSerializer CycleStatisticBlock::serializer;
+
+	/*
+	 * block structure:
+	 * *----------------------*-----------*-------*
+	 * | id (containing type) | timestamp | value |
+	 * *----------------------*-----------*-------*
+	 * |          32          |     64    |  32   |
+	 * *----------------------*-----------*-------*
+	 * second line contains the length in bits
+	 */
+
+	void CycleStatisticBlockSerializer::serialize(const CycleStatisticBlock& obj, Serialized& ser)
+	{
+		ser.write(CycleStatisticBlock::ident | obj.type, 0);
+		ser.write(obj.timestamp, 4);
+		ser.write(obj.value, 12);
+	}
+
+	Serialized CycleStatisticBlockSerializer::serialize(const CycleStatisticBlock& obj)
+	{
+		Serialized ser(obj.getSerializedSize());
+		serialize(obj, ser);
+		return ser;
+	}
+
+	CycleStatisticBlock CycleStatisticBlockSerializer::parseSerialized(
+	    Serialized& ser, ParsingContext& context)
+	{
+		(void)context;
+		uint16_t type = ser.read<uint32_t>(0) & 0xFFFF;
+		return CycleStatisticBlock{ type, ser.read<uint64_t>(4), ser.read<uint32_t>(12) };
+	}
+} // namespace etherkitten::reader
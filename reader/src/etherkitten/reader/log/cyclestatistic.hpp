@@ -0,0 +1,94 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+/*!
+ * \file
+ * \brief Defines CycleStatisticBlock and the corresponding Serializer.
+ */
+
+#include "Block.hpp"
+#include "Serialized.hpp"
+#include "Serializer.hpp"
+#include <inttypes.h>
+
+namespace etherkitten::reader
+{
+	class CycleStatisticBlock;
+
+	/*!
+	 * \brief Serializes CycleStatisticBlock and parses serialized CycleStatisticBlocks
+	 */
+	class CycleStatisticBlockSerializer : public Serializer<CycleStatisticBlock>
+	{
+	public:
+		Serialized serialize(const CycleStatisticBlock& obj) override;
+		void serialize(const CycleStatisticBlock& obj, Serialized& ser) override;
+		CycleStatisticBlock parseSerialized(Serialized& data, ParsingContext& context) override;
+	};
+
+	/*!
+	 * \brief Block containing the value of a CycleStatistic for one cycle
+	 *
+	 * It is laid out like a RegisterDataBlock with a 32 bit value, so the ChunkEncoder
+	 * stores the values of every CycleStatisticType as a stream, like those of a register.
+	 */
+	class CycleStatisticBlock : public Block<CycleStatisticBlock>
+	{
+	public:
+		CycleStatisticBlock(uint16_t type, uint64_t timestamp, uint32_t value)
+		    : type(type)
+		    , timestamp(timestamp)
+		    , value(value)
+		{
+		}
+		friend CycleStatisticBlockSerializer;
+
+		/*!
+		 * \brief The identifier of a CycleStatisticBlock without its type.
+		 */
+		static constexpr uint32_t ident = 0xE0000000;
+
+		/*!
+		 * \brief The size of every CycleStatisticBlock.
+		 */
+		static constexpr uint64_t size = 16;
+
+		/*!
+		 * \brief The CycleStatisticType of the value in this block.
+		 *
+		 * Logs written by other versions may contain types that are not known.
+		 */
+		uint16_t type;
+
+		/*!
+		 * \brief timestamp of the start of the cycle
+		 */
+		uint64_t timestamp;
+
+		/*!
+		 * \brief value of the CycleStatistic in this cycle
+		 */
+		uint32_t value;
+
+		/*!
+		 * \brief Serializer that can be used for CycleStatisticBlock
+		 */
+		static CycleStatisticBlockSerializer serializer;
+		Serializer<CycleStatisticBlock>& getSerializer() const override { return serializer; }
+		uint64_t getSerializedSize() const override { return size; }
+	};
+} // namespace etherkitten::reader
@@ -0,0 +1,389 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "encodedchunk.hpp"
+
+#include "chunkindex.hpp"
+#include "processdata.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace etherkitten::reader
+{
+	/*
+	 * block structure:
+	 * *----*-----------*--------*----------------*-----------------------*
+	 * | id | base time | length | decoded length |        records        |
+	 * *----*-----------*--------*----------------*-----------------------*
+	 * | 32 |    64     |   64   |       64       |  up to length in bytes |
+	 * *----*-----------*--------*----------------*-----------------------*
+	 * second line contains the length in bits
+	 *
+	 * Every record starts with a varint head that tells its kind:
+	 * *-----------*----------------------------------------------------------------------*
+	 * |   head    |                              record                                  |
+	 * *-----------*----------------------------------------------------------------------*
+	 * |     0     | ProcessDataBlock: time, then pairs of a varint number of unchanged   |
+	 * |           | bytes and a varint number of changed bytes followed by these bytes   |
+	 * |           | XOR the previous IOMap, until the whole IOMap is covered             |
+	 * |     1     | any other block: varint length, the block                            |
+	 * |     2     | first block of a register or cycle statistic: 32 bit block id,       |
+	 * |           | 8 bit value length, time, value                                      |
+	 * | 3 + 2s    | block of the register stream s: time, value                          |
+	 * | 3 + 2s +1 | block of the register stream s that repeats interval and value       |
+	 * *-----------*----------------------------------------------------------------------*
+	 * Varints hold 7 bits per byte, least significant first, with the top bit set on all
+	 * bytes but the last. A time is the zigzag varint of the change of the interval to the
+	 * previous time of the same register or the previous IOMap, a value is the zigzag varint
+	 * of the difference to the previous value of the same register. The first time and
+	 * value of every stream are relative to the base time and to 0.
+	 */
+
+	namespace
+	{
+		constexpr uint64_t processDataHead = 0;
+		constexpr uint64_t verbatimHead = 1;
+		constexpr uint64_t newRegisterHead = 2;
+		constexpr uint64_t firstStreamHead = 3;
+		constexpr uint64_t registerHeaderSize = 12;
+		// Changed bytes of an IOMap are only split by runs of unchanged bytes this long
+		constexpr uint64_t minimumUnchangedRun = 4;
+
+		uint64_t zigzag(uint64_t value)
+		{
+			return (value << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(value) >> 63);
+		}
+
+		uint64_t unzigzag(uint64_t value) { return (value >> 1) ^ (~(value & 1) + 1); }
+
+		/*!
+		 * \brief Reads the records of an EncodedChunkBlock with bounds checks.
+		 */
+		class RecordReader
+		{
+		public:
+			RecordReader(Serialized& block, uint64_t offset)
+			    : block(block)
+			    , offset(offset)
+			{
+			}
+
+			bool atEnd() const { return offset == block.length; }
+
+			uint8_t readByte()
+			{
+				uint8_t byte = block.read<uint8_t>(offset);
+				++offset;
+				return byte;
+			}
+
+			uint64_t readVarint()
+			{
+				uint64_t value = 0;
+				for (unsigned int shift = 0; shift < 64; shift += 7)
+				{
+					uint8_t byte = readByte();
+					value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+					if ((byte & 0x80) == 0)
+						return value;
+				}
+				throw std::runtime_error("varint in encoded chunk is too long");
+			}
+
+			Serialized readBytes(uint64_t length)
+			{
+				Serialized bytes = block.getAt(offset, length);
+				offset += length;
+				return bytes;
+			}
+
+		private:
+			Serialized& block;
+			uint64_t offset;
+		};
+
+		uint64_t readTime(RecordReader& reader, uint64_t& time, uint64_t& interval)
+		{
+			interval += unzigzag(reader.readVarint());
+			time += interval;
+			return time;
+		}
+	} // namespace
+
+	Serialized EncodedChunkBlock::decode(Serialized& block, uint64_t ioMapSize)
+	{
+		if (block.length < headerSize || block.read<uint32_t>(0) != ident
+		    || block.read<uint64_t>(12) != block.length)
+			throw std::runtime_error("not a valid encoded chunk");
+		uint64_t baseTime = block.read<uint64_t>(4);
+		uint64_t decodedLength = block.read<uint64_t>(20);
+		// No record decodes to more than a register or a ProcessDataBlock
+		uint64_t maximumExpansion = std::max<uint64_t>(
+		    registerHeaderSize + sizeof(uint64_t), ProcessDataBlock::headerSize + ioMapSize);
+		if (decodedLength / maximumExpansion > block.length - headerSize)
+			throw std::runtime_error("decoded length of encoded chunk is not valid");
+
+		struct RegisterStream
+		{
+			uint32_t ident;
+			uint8_t valueLength;
+			uint64_t time;
+			uint64_t interval;
+			uint64_t value;
+		};
+		std::vector<RegisterStream> streams;
+		uint64_t ioMapTime = baseTime;
+		uint64_t ioMapInterval = 0;
+		std::vector<char> ioMap(ioMapSize);
+
+		Serialized decoded(decodedLength);
+		uint64_t offset = 0;
+		RecordReader reader(block, headerSize);
+		while (!reader.atEnd())
+		{
+			uint64_t head = reader.readVarint();
+			if (head == processDataHead)
+			{
+				uint64_t time = readTime(reader, ioMapTime, ioMapInterval);
+				uint64_t position = 0;
+				while (position < ioMapSize)
+				{
+					uint64_t unchanged = reader.readVarint();
+					if (unchanged > ioMapSize - position)
+						throw std::runtime_error("IOMap in encoded chunk is too long");
+					position += unchanged;
+					if (position == ioMapSize)
+						break;
+					uint64_t changed = reader.readVarint();
+					if (changed > ioMapSize - position)
+						throw std::runtime_error("IOMap in encoded chunk is too long");
+					Serialized bytes = reader.readBytes(changed);
+					for (uint64_t i = 0; i < changed; ++i)
+					{
+						ioMap[position + i] ^= bytes.data[i];
+					}
+					position += changed;
+				}
+				Serialized target = decoded.getAt(offset, ProcessDataBlock::headerSize + ioMapSize);
+				target.write(ProcessDataBlock::ident, 0);
+				target.write(time, 4);
+				memcpy(target.data + ProcessDataBlock::headerSize, ioMap.data(), ioMapSize);
+				offset += target.length;
+				continue;
+			}
+			if (head == verbatimHead)
+			{
+				uint64_t length = reader.readVarint();
+				Serialized bytes = reader.readBytes(length);
+				Serialized target = decoded.getAt(offset, length);
+				memcpy(target.data, bytes.data, length);
+				offset += length;
+				continue;
+			}
+
+			RegisterStream* stream;
+			bool repeated = false;
+			if (head == newRegisterHead)
+			{
+				uint32_t registerIdent = reader.readByte();
+				for (unsigned int i = 1; i < sizeof(registerIdent); ++i)
+				{
+					registerIdent |= static_cast<uint32_t>(reader.readByte()) << (8 * i);
+				}
+				uint8_t valueLength = reader.readByte();
+				if (valueLength > sizeof(uint64_t))
+					throw std::runtime_error("register value in encoded chunk is too long");
+				streams.push_back({ registerIdent, valueLength, baseTime, 0, 0 });
+				stream = &streams.back();
+			}
+			else
+			{
+				uint64_t index = (head - firstStreamHead) >> 1;
+				if (index >= streams.size())
+					throw std::runtime_error("unknown register in encoded chunk");
+				stream = &streams[index];
+				repeated = ((head - firstStreamHead) & 1) != 0;
+			}
+			if (repeated)
+			{
+				stream->time += stream->interval;
+			}
+			else
+			{
+				readTime(reader, stream->time, stream->interval);
+				stream->value += unzigzag(reader.readVarint());
+			}
+			Serialized target = decoded.getAt(offset, registerHeaderSize + stream->valueLength);
+			target.write(stream->ident, 0);
+			target.write(stream->time, 4);
+			for (unsigned int i = 0; i < stream->valueLength; ++i)
+			{
+				target.write(
+				    static_cast<uint8_t>(stream->value >> (8 * i)), registerHeaderSize + i);
+			}
+			offset += target.length;
+		}
+		if (offset != decodedLength)
+			throw std::runtime_error("decoded length of encoded chunk does not match");
+		return decoded;
+	}
+
+	ChunkEncoder::ChunkEncoder(uint64_t ioMapSize)
+	    : ioMapSize(ioMapSize)
+	    , lastIOMap(ioMapSize)
+	{
+	}
+
+	void ChunkEncoder::addDataBlock(const Serialized& block)
+	{
+		if (block.length < registerHeaderSize)
+			throw std::runtime_error("data block is too short");
+		uint32_t ident = block.read<uint32_t>(0);
+		uint64_t time = block.read<uint64_t>(4);
+		if (isEmpty())
+		{
+			baseTime = time;
+			ioMapStream = { baseTime, 0, 0 };
+		}
+		decodedLength += block.length;
+
+		uint8_t kind = ChunkEntryBlock::getKindOf(ident);
+		if (kind == ChunkEntryBlock::processDataKind
+		    && block.length == ProcessDataBlock::headerSize + ioMapSize)
+		{
+			writeVarint(processDataHead);
+			writeTime(ioMapStream, time);
+			const char* ioMap = block.data + ProcessDataBlock::headerSize;
+			uint64_t position = 0;
+			while (position < ioMapSize)
+			{
+				uint64_t unchanged = position;
+				while (unchanged < ioMapSize && ioMap[unchanged] == lastIOMap[unchanged])
+					++unchanged;
+				writeVarint(unchanged - position);
+				position = unchanged;
+				if (position == ioMapSize)
+					break;
+
+				// Short runs of unchanged bytes cost less as part of the changed bytes
+				uint64_t changedEnd = position;
+				uint64_t run = 0;
+				while (changedEnd + run < ioMapSize && run < minimumUnchangedRun)
+				{
+					if (ioMap[changedEnd + run] == lastIOMap[changedEnd + run])
+					{
+						++run;
+					}
+					else
+					{
+						changedEnd += run + 1;
+						run = 0;
+					}
+				}
+				writeVarint(changedEnd - position);
+				for (; position < changedEnd; ++position)
+				{
+					records.push_back(ioMap[position] ^ lastIOMap[position]);
+					lastIOMap[position] = ioMap[position];
+				}
+			}
+		}
+		else if ((kind == ChunkEntryBlock::registerKind
+		             || kind == ChunkEntryBlock::cycleStatisticKind)
+		    && block.length <= registerHeaderSize + sizeof(uint64_t))
+		{
+			uint64_t value = 0;
+			uint64_t valueLength = block.length - registerHeaderSize;
+			for (unsigned int i = 0; i < valueLength; ++i)
+			{
+				value |= static_cast<uint64_t>(block.read<uint8_t>(registerHeaderSize + i))
+				    << (8 * i);
+			}
+
+			auto [found, isNew] = streamIndices.try_emplace(ident, streams.size());
+			if (isNew)
+			{
+				streams.push_back({ baseTime, 0, 0 });
+				writeVarint(newRegisterHead);
+				for (unsigned int i = 0; i < sizeof(ident); ++i)
+				{
+					records.push_back(static_cast<char>(ident >> (8 * i)));
+				}
+				records.push_back(static_cast<char>(valueLength));
+			}
+			Stream& stream = streams[found->second];
+			uint64_t head = firstStreamHead + (found->second << 1);
+			if (!isNew && time - stream.time == stream.interval && value == stream.value)
+			{
+				writeVarint(head + 1);
+				stream.time = time;
+				return;
+			}
+			if (!isNew)
+				writeVarint(head);
+			writeTime(stream, time);
+			writeVarint(zigzag(value - stream.value));
+			stream.value = value;
+		}
+		else
+		{
+			writeVarint(verbatimHead);
+			writeVarint(block.length);
+			records.insert(records.end(), block.data, block.data + block.length);
+		}
+	}
+
+	Serialized ChunkEncoder::finish()
+	{
+		Serialized block(EncodedChunkBlock::headerSize + records.size());
+		block.write(EncodedChunkBlock::ident, 0);
+		block.write(baseTime, 4);
+		block.write(block.length, 12);
+		block.write(decodedLength, 20);
+		memcpy(block.data + EncodedChunkBlock::headerSize, records.data(), records.size());
+		reset();
+		return block;
+	}
+
+	void ChunkEncoder::reset()
+	{
+		decodedLength = 0;
+		records.clear();
+		streamIndices.clear();
+		streams.clear();
+		std::fill(lastIOMap.begin(), lastIOMap.end(), 0);
+	}
+
+	void ChunkEncoder::writeVarint(uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			records.push_back(static_cast<char>((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+		records.push_back(static_cast<char>(value));
+	}
+
+	void ChunkEncoder::writeTime(Stream& stream, uint64_t time)
+	{
+		uint64_t interval = time - stream.time;
+		writeVarint(zigzag(interval - stream.interval));
+		stream.time = time;
+		stream.interval = interval;
+	}
+} // namespace etherkitten::reader
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+/*!
+ * \file
+ * \brief Defines EncodedChunkBlock, which stores the data blocks of a chunk in a compact
+ * encoding, and the ChunkEncoder that creates it.
+ */
+
+#include "Serialized.hpp"
+#include <inttypes.h>
+#include <unordered_map>
+#include <vector>
+
+namespace etherkitten::reader
+{
+	/*!
+	 * \brief An EncodedChunkBlock holds all data blocks of one chunk of a version 3 log.
+	 *
+	 * Most of a log is register and process data that hardly changes between two samples,
+	 * while every plain data block repeats its identifier and full timestamp.
+	 * The data blocks of the chunk are therefore encoded as records:
+	 * - the timestamps of every register and of the IOMaps are stored as the change of
+	 *   their interval, so samples at a steady rate take no space for their timestamp,
+	 * - register values are stored as the difference to the previous value of the same
+	 *   register, and a sample that repeats both interval and value is a single byte,
+	 * - the samples of every CycleStatisticType are stored like those of a register,
+	 * - every IOMap is XORed with the previous one and only the runs of changed bytes are
+	 *   stored,
+	 * - all other blocks are stored verbatim.
+	 *
+	 * Every chunk is encoded on its own, so it can be decoded without the ones in front of it.
+	 * The chunk entry in the ChunkIndexBlock describes the decoded data blocks, except for
+	 * its length, which is the length of the EncodedChunkBlock.
+	 */
+	class EncodedChunkBlock
+	{
+	public:
+		/*!
+		 * \brief The identifier of an EncodedChunkBlock.
+		 */
+		static constexpr uint32_t ident = 0xC0000000;
+
+		/*!
+		 * \brief The size of an EncodedChunkBlock without its records.
+		 */
+		static constexpr uint64_t headerSize = 28;
+
+		/*!
+		 * \brief Decode an EncodedChunkBlock into the data blocks it holds.
+		 * \param block the EncodedChunkBlock, including its header
+		 * \param ioMapSize the size of the IOMaps in the log
+		 * \return the data blocks, as they would be in a version 2 log
+		 * \exception std::runtime_error iff block is not a valid EncodedChunkBlock
+		 */
+		static Serialized decode(Serialized& block, uint64_t ioMapSize);
+	};
+
+	/*!
+	 * \brief Encodes the data blocks of a chunk into an EncodedChunkBlock.
+	 *
+	 * The data blocks are encoded as they are added, so the plain blocks are not kept.
+	 */
+	class ChunkEncoder
+	{
+	public:
+		/*!
+		 * \brief Create a ChunkEncoder for a log.
+		 * \param ioMapSize the size of the IOMaps in the log
+		 */
+		explicit ChunkEncoder(uint64_t ioMapSize);
+
+		/*!
+		 * \brief Add a serialized data block to the current chunk.
+		 * \param block the data block
+		 * \exception std::runtime_error iff block is too short to be a data block
+		 */
+		void addDataBlock(const Serialized& block);
+
+		/*!
+		 * \brief Check whether a data block was added since the last EncodedChunkBlock.
+		 * \retval true iff no data block was added
+		 */
+		bool isEmpty() const { return decodedLength == 0; }
+
+		/*!
+		 * \brief Create the EncodedChunkBlock of the data blocks added so far and start
+		 * a new chunk.
+		 * \return the serialized EncodedChunkBlock
+		 */
+		Serialized finish();
+
+	private:
+		/*!
+		 * \brief The last sample of a register or of the IOMaps.
+		 */
+		struct Stream
+		{
+			uint64_t time;
+			uint64_t interval;
+			uint64_t value;
+		};
+
+		const uint64_t ioMapSize;
+		uint64_t baseTime = 0;
+		uint64_t decodedLength = 0;
+		std::vector<char> records;
+		// The index of the register stream of every register block identifier
+		std::unordered_map<uint32_t, size_t> streamIndices;
+		std::vector<Stream> streams;
+		Stream ioMapStream{};
+		std::vector<char> lastIOMap;
+
+		void reset();
+		void writeVarint(uint64_t value);
+		void writeTime(Stream& stream, uint64_t time);
+	};
+} // namespace etherkitten::reader
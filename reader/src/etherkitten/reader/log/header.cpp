@@ -0,0 +1,85 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "header.hpp"
+
+#include <stdexcept>
+
+namespace etherkitten::reader
+{
+	LogHeaderBlockSerializer LogHeaderBlock::serializer;
+
+	/*
+	 * block structure:
+	 * *---------*-------------------*-------------*-------------*------------*--------------*
+	 * | version | pdo desc. offset  | data offset | iomap size  | start time | index offset |
+	 * *---------*-------------------*-------------*-------------*------------*--------------*
+	 * |   64    |        64         |      64     |      64     |     64     |      64      |
+	 * *---------*-------------------*-------------*-------------*------------*--------------*
+	 * second line contains the length in bits, the index offset only exists from version 2 on
+	 */
+
+	void LogHeaderBlockSerializer::serialize(const LogHeaderBlock& obj, Serialized& ser)
+	{
+		if (obj.getSerializedSize() == 0)
+			throw std::runtime_error("unsupported log version");
+		ser.write(obj.version, 0);
+		ser.write(obj.pdoDescOffset, 8);
+		ser.write(obj.dataOffset, 16);
+		ser.write(obj.ioMapSize, 24);
+		ser.write(obj.startTime, 32);
+		if (obj.version >= 2)
+			ser.write(obj.indexOffset, LogHeaderBlock::indexOffsetPosition);
+	}
+
+	Serialized LogHeaderBlockSerializer::serialize(const LogHeaderBlock& obj)
+	{
+		Serialized ser(obj.getSerializedSize());
+		serialize(obj, ser);
+		return ser;
+	}
+
+	LogHeaderBlock LogHeaderBlockSerializer::parseSerialized(
+	    Serialized& ser, ParsingContext& context)
+	{
+		(void)context;
+		uint64_t version = ser.read<uint64_t>(0);
+		if (LogHeaderBlock::getSizeOfVersion(version) == 0)
+			throw std::runtime_error("unsupported log version");
+		uint64_t indexOffset = 0;
+		if (version >= 2)
+			indexOffset = ser.read<uint64_t>(LogHeaderBlock::indexOffsetPosition);
+		return LogHeaderBlock{ version, ser.read<uint64_t>(8), ser.read<uint64_t>(16),
+			ser.read<uint64_t>(24), ser.read<uint64_t>(32), indexOffset };
+	}
+
+	uint64_t LogHeaderBlock::getSizeOfVersion(uint64_t version)
+	{
+		switch (version)
+		{
+		case 1:
+			return 40;
+		case 2:
+		case 3:
+			return 48;
+		default:
+			return 0;
+		}
+	}
+
+	uint64_t LogHeaderBlock::getSerializedSize() const { return getSizeOfVersion(version); }
+} // namespace etherkitten::reader
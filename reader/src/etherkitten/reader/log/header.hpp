@@ -0,0 +1,138 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+/*!
+ * \file
+ * \brief Defines LogHeaderBlock and the corresponding Serializer.
+ */
+
+#include "Block.hpp"
+#include "Serialized.hpp"
+#include "Serializer.hpp"
+#include <inttypes.h>
+
+namespace etherkitten::reader
+{
+	class LogHeaderBlock;
+	/*!
+	 * \brief Serializes LogHeaderBlock and parses serialized LogHeaderBlock
+	 */
+	class LogHeaderBlockSerializer : public Serializer<LogHeaderBlock>
+	{
+	public:
+		Serialized serialize(const LogHeaderBlock& obj) override;
+		void serialize(const LogHeaderBlock& obj, Serialized& ser) override;
+
+		/*!
+		 * \brief Parse a header of any supported version.
+		 * \param data the buffer to parse, must be at least as long as the header
+		 * of its version
+		 * \param context the ParsingContext, which is not used
+		 * \return the parsed header
+		 * \exception std::runtime_error iff the version is not supported or data is too short
+		 */
+		LogHeaderBlock parseSerialized(Serialized& data, ParsingContext& context) override;
+	};
+
+	/*!
+	 * \brief The header at the start of every log file.
+	 *
+	 * Version 1 logs contain the data blocks as one flat stream.
+	 * Version 2 logs group the data blocks into chunks and end with a ChunkIndexBlock,
+	 * which the header points to.
+	 * Version 3 logs have the same header as version 2 logs, but store every chunk as an
+	 * EncodedChunkBlock.
+	 */
+	class LogHeaderBlock : public Block<LogHeaderBlock>
+	{
+	public:
+		LogHeaderBlock(uint64_t version, uint64_t pdoDescOffset, uint64_t dataOffset,
+		    uint64_t ioMapSize, uint64_t startTime, uint64_t indexOffset)
+		    : version(version)
+		    , pdoDescOffset(pdoDescOffset)
+		    , dataOffset(dataOffset)
+		    , ioMapSize(ioMapSize)
+		    , startTime(startTime)
+		    , indexOffset(indexOffset)
+		{
+		}
+		friend LogHeaderBlockSerializer;
+
+		/*!
+		 * \brief The version the Logger writes.
+		 */
+		static constexpr uint64_t currentVersion = 2;
+
+		/*!
+		 * \brief The version the Logger writes when it encodes the chunks.
+		 */
+		static constexpr uint64_t encodedVersion = 3;
+
+		/*!
+		 * \brief The offset of the index offset in the header, which is written last.
+		 */
+		static constexpr uint64_t indexOffsetPosition = 40;
+
+		/*!
+		 * \brief Get the size of the header of a log version.
+		 * \param version the version of the log
+		 * \return the size of the header in bytes or 0 iff the version is not supported
+		 */
+		static uint64_t getSizeOfVersion(uint64_t version);
+
+		/*!
+		 * \brief version of the log file
+		 */
+		uint64_t version;
+
+		/*!
+		 * \brief file offset of the first SlaveDetailsBlock
+		 */
+		uint64_t pdoDescOffset;
+
+		/*!
+		 * \brief file offset of the first data block
+		 */
+		uint64_t dataOffset;
+
+		/*!
+		 * \brief size of the IOMap in the ProcessDataBlocks
+		 */
+		uint64_t ioMapSize;
+
+		/*!
+		 * \brief timestamp that is earlier than all data in the log
+		 */
+		uint64_t startTime;
+
+		/*!
+		 * \brief file offset of the ChunkIndexBlock, 0 if the log has no index
+		 *
+		 * This is always 0 in version 1 logs and in later logs whose Logger did not stop
+		 * properly.
+		 */
+		uint64_t indexOffset;
+
+		/*!
+		 * \brief Serializer that can be used for LogHeaderBlock
+		 */
+		static LogHeaderBlockSerializer serializer;
+		Serializer<LogHeaderBlock>& getSerializer() const override { return serializer; }
+		uint64_t getSerializedSize() const override;
+	};
+} // namespace etherkitten::reader
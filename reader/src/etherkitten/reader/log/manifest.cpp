@@ -0,0 +1,130 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "manifest.hpp"
+
+#include <stdexcept>
+
+namespace etherkitten::reader
+{
+	SegmentEntryBlockSerializer SegmentEntryBlock::serializer;
+	ManifestBlockSerializer ManifestBlock::serializer;
+
+	/*
+	 * block structure:
+	 * *------------*-----------*--------------------------*
+	 * | first time | last time |        file name         |
+	 * *------------*-----------*--------------------------*
+	 * |     64     |    64     | depends on string length |
+	 * *------------*-----------*--------------------------*
+	 * second line contains the length in bits
+	 */
+
+	void SegmentEntryBlockSerializer::serialize(const SegmentEntryBlock& obj, Serialized& ser)
+	{
+		ser.write(obj.firstTime, 0);
+		ser.write(obj.lastTime, 8);
+		ser.write(obj.fileName, 16);
+	}
+
+	Serialized SegmentEntryBlockSerializer::serialize(const SegmentEntryBlock& obj)
+	{
+		Serialized ser(obj.getSerializedSize());
+		serialize(obj, ser);
+		return ser;
+	}
+
+	SegmentEntryBlock SegmentEntryBlockSerializer::parseSerialized(
+	    Serialized& ser, ParsingContext& context)
+	{
+		(void)context;
+		return SegmentEntryBlock::parse(ser);
+	}
+
+	SegmentEntryBlock SegmentEntryBlock::parse(Serialized& ser)
+	{
+		return SegmentEntryBlock{ ser.read<uint64_t>(0), ser.read<uint64_t>(8),
+			ser.read<std::string>(16) };
+	}
+
+	uint64_t SegmentEntryBlock::getSerializedSize() const { return 16 + fileName.size() + 1; }
+
+	/*
+	 * block structure:
+	 * *----*---------------*-----------*-----------------------*
+	 * | id | segment count | blocksize | segment entry blocks  |
+	 * *----*---------------*-----------*-----------------------*
+	 * | 32 |      64       |    64     |                       |
+	 * *----*---------------*-----------*-----------------------*
+	 * second line contains the length in bits
+	 */
+
+	void ManifestBlockSerializer::serialize(const ManifestBlock& obj, Serialized& ser)
+	{
+		ser.write(ManifestBlock::ident, 0);
+		ser.write(static_cast<uint64_t>(obj.segments.size()), 4);
+		ser.write(obj.getSerializedSize(), 12);
+		uint64_t offset = ManifestBlock::headerSize;
+		for (auto& segment : obj.segments)
+		{
+			Serialized sub = ser.getAt(offset, segment.getSerializedSize());
+			segment.getSerializer().serialize(segment, sub);
+			offset += sub.length;
+		}
+	}
+
+	Serialized ManifestBlockSerializer::serialize(const ManifestBlock& obj)
+	{
+		Serialized ser(obj.getSerializedSize());
+		serialize(obj, ser);
+		return ser;
+	}
+
+	ManifestBlock ManifestBlockSerializer::parseSerialized(Serialized& ser, ParsingContext& context)
+	{
+		(void)context;
+		return ManifestBlock::parse(ser);
+	}
+
+	ManifestBlock ManifestBlock::parse(Serialized& ser)
+	{
+		if (ser.length < ManifestBlock::headerSize || ser.read<uint32_t>(0) != ManifestBlock::ident)
+			throw std::runtime_error("block is not a ManifestBlock");
+		uint64_t segmentCount = ser.read<uint64_t>(4);
+		std::vector<SegmentEntryBlock> segments;
+		uint64_t offset = ManifestBlock::headerSize;
+		for (uint64_t i = 0; i < segmentCount; ++i)
+		{
+			if (offset >= ser.length)
+				throw std::runtime_error("the ManifestBlock is incomplete");
+			Serialized sub = ser.getAt(offset, ser.length - offset);
+			segments.push_back(SegmentEntryBlock::parse(sub));
+			offset += segments.back().getSerializedSize();
+		}
+		return ManifestBlock{ std::move(segments) };
+	}
+
+	uint64_t ManifestBlock::getSerializedSize() const
+	{
+		uint64_t size = headerSize;
+		for (auto& segment : segments)
+		{
+			size += segment.getSerializedSize();
+		}
+		return size;
+	}
+} // namespace etherkitten::reader
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/*!
+ * \file
+ * \brief Defines SegmentEntryBlock and ManifestBlock, which list the segments of a log
+ * that is split into several files, and the corresponding Serializers.
+ */
+
+#include "Block.hpp"
+#include "Serialized.hpp"
+#include "Serializer.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace etherkitten::reader
+{
+	class SegmentEntryBlock;
+	class ManifestBlock;
+
+	/*!
+	 * \brief Serializes SegmentEntryBlock and parses serialized SegmentEntryBlock
+	 */
+	class SegmentEntryBlockSerializer : public Serializer<SegmentEntryBlock>
+	{
+	public:
+		Serialized serialize(const SegmentEntryBlock& obj) override;
+		void serialize(const SegmentEntryBlock& obj, Serialized& ser) override;
+		SegmentEntryBlock parseSerialized(Serialized& data, ParsingContext& context) override;
+	};
+
+	/*!
+	 * \brief The entry of one segment in a ManifestBlock.
+	 *
+	 * Every segment is a complete log with its own header, slave information
+	 * and chunk index.
+	 */
+	class SegmentEntryBlock : public Block<SegmentEntryBlock>
+	{
+	public:
+		SegmentEntryBlock(uint64_t firstTime, uint64_t lastTime, std::string fileName)
+		    : firstTime(firstTime)
+		    , lastTime(lastTime)
+		    , fileName(std::move(fileName))
+		{
+		}
+		friend SegmentEntryBlockSerializer;
+
+		/*!
+		 * \brief Parse a serialized SegmentEntryBlock, which needs no ParsingContext.
+		 * \param data the buffer to parse
+		 * \return the parsed SegmentEntryBlock
+		 * \exception std::runtime_error iff the buffer is too short
+		 */
+		static SegmentEntryBlock parse(Serialized& data);
+
+		/*!
+		 * \brief earliest timestamp of the data blocks in the segment
+		 *
+		 * This and lastTime are 0 while the segment is written.
+		 */
+		uint64_t firstTime;
+
+		/*!
+		 * \brief latest timestamp of the data blocks in the segment
+		 */
+		uint64_t lastTime;
+
+		/*!
+		 * \brief name of the segment's file, which is in the directory of the manifest
+		 */
+		std::string fileName;
+
+		/*!
+		 * \brief Serializer that can be used for SegmentEntryBlock
+		 */
+		static SegmentEntryBlockSerializer serializer;
+		Serializer<SegmentEntryBlock>& getSerializer() const override { return serializer; }
+		uint64_t getSerializedSize() const override;
+	};
+
+	/*!
+	 * \brief Serializes ManifestBlock and parses serialized ManifestBlock
+	 */
+	class ManifestBlockSerializer : public Serializer<ManifestBlock>
+	{
+	public:
+		Serialized serialize(const ManifestBlock& obj) override;
+		void serialize(const ManifestBlock& obj, Serialized& ser) override;
+		ManifestBlock parseSerialized(Serialized& data, ParsingContext& context) override;
+	};
+
+	/*!
+	 * \brief The only block of a manifest, which lists the segments of a log in the order
+	 * they were written in.
+	 */
+	class ManifestBlock : public Block<ManifestBlock>
+	{
+	public:
+		explicit ManifestBlock(std::vector<SegmentEntryBlock> segments)
+		    : segments(std::move(segments))
+		{
+		}
+		friend ManifestBlockSerializer;
+
+		/*!
+		 * \brief Parse a serialized ManifestBlock, which needs no ParsingContext.
+		 * \param data the buffer to parse
+		 * \return the parsed ManifestBlock
+		 * \exception std::runtime_error iff the buffer does not hold a complete ManifestBlock
+		 */
+		static ManifestBlock parse(Serialized& data);
+
+		/*!
+		 * \brief The ident a manifest starts with, which no log header starts with.
+		 */
+		static constexpr uint32_t ident = 0xD0000000;
+
+		/*!
+		 * \brief Length of the part of the block in front of the segment entries, which
+		 * contains the length of the whole block.
+		 */
+		static constexpr uint64_t headerSize = 20;
+
+		/*!
+		 * \brief Get the entries of all segments.
+		 * \return the segment entries
+		 */
+		const std::vector<SegmentEntryBlock>& getSegments() const { return segments; }
+
+		/*!
+		 * \brief Serializer that can be used for ManifestBlock
+		 */
+		static ManifestBlockSerializer serializer;
+		Serializer<ManifestBlock>& getSerializer() const override { return serializer; }
+		uint64_t getSerializedSize() const override;
+
+	private:
+		std::vector<SegmentEntryBlock> segments;
+	};
+} // namespace etherkitten::reader
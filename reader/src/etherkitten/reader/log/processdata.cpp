@@ -42,6 +42,16 @@ namespace etherkitten::reader
 		memcpy(ser.data + 12, obj.data.data, obj.data.length);
 	}
 
+	void ProcessDataBlockSerializer::serialize(
+	    uint64_t timestamp, const IOMap* ioMap, Serialized& ser)
+	{
+		if (ser.length != ProcessDataBlock::headerSize + ioMap->ioMapSize)
+			throw std::runtime_error("buffer length does not match the size of the IOMap");
+		ser.write(ProcessDataBlock::ident, 0);
+		ser.write(timestamp, 4);
+		memcpy(ser.data + ProcessDataBlock::headerSize, ioMap->ioMap, ioMap->ioMapSize);
+	}
+
 	Serialized ProcessDataBlockSerializer::serialize(const ProcessDataBlock& obj)
 	{
 		Serialized ser(obj.getSerializedSize());
@@ -53,9 +63,8 @@ namespace etherkitten::reader
 	    Serialized& ser, ParsingContext& context)
 	{
 		uint64_t timestamp = ser.read<uint64_t>(4);
-		Serialized data(context.getIOMapSize());
-		memcpy(data.data, ser.data + 12, context.getIOMapSize());
-		return ProcessDataBlock{ timestamp, std::move(data) };
+		// The IOMap is not copied, so the block must not outlive ser
+		return ProcessDataBlock{ timestamp, ser.getAt(12, context.getIOMapSize()) };
 	}
 
 	uint64_t ProcessDataBlock::getSerializedSize() const { return 12 + data.length; }
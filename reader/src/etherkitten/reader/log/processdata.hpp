@@ -21,10 +21,12 @@
  * \brief Defines ProcessDataBlock and the corresponding Serializer.
  */
 
+#include "../IOMap.hpp"
 #include "Block.hpp"
 #include "Serialized.hpp"
 #include "Serializer.hpp"
 #include <inttypes.h>
+#include <utility>
 #include <vector>
 
 namespace etherkitten::reader
@@ -39,6 +41,17 @@ namespace etherkitten::reader
 		Serialized serialize(const ProcessDataBlock& obj) override;
 		void serialize(const ProcessDataBlock& obj, Serialized& ser) override;
 		ProcessDataBlock parseSerialized(Serialized& data, ParsingContext& context) override;
+
+		/*!
+		 * \brief Serialize a ProcessDataBlock straight from an IOMap into the given buffer.
+		 *
+		 * This avoids copying the IOMap into a ProcessDataBlock first.
+		 * \param timestamp the timestamp of the block
+		 * \param ioMap the IOMap containing the data of the block
+		 * \param ser the buffer to serialize to, must be exactly as long as the block
+		 * \exception std::runtime_error iff ser does not have the length of the block
+		 */
+		void serialize(uint64_t timestamp, const IOMap* ioMap, Serialized& ser);
 	};
 
 	/*!
@@ -49,7 +62,7 @@ namespace etherkitten::reader
 	public:
 		ProcessDataBlock(uint64_t timestamp, Serialized&& data)
 		    : timestamp(timestamp)
-		    , data(data)
+		    , data(std::move(data))
 		{
 		}
 		friend ProcessDataBlockSerializer;
@@ -71,7 +84,14 @@ namespace etherkitten::reader
 		Serializer<ProcessDataBlock>& getSerializer() const override { return serializer; }
 		uint64_t getSerializedSize() const override;
 
-	private:
-		uint32_t ident = 0x80000000;
+		/*!
+		 * \brief The size of a serialized ProcessDataBlock without its data
+		 */
+		static constexpr uint64_t headerSize = 12;
+
+		/*!
+		 * \brief The identifier of a ProcessDataBlock
+		 */
+		static constexpr uint32_t ident = 0x80000000;
 	};
 } // namespace etherkitten::reader
@@ -17,18 +17,23 @@
 
 #include "logger.hpp"
 
-#include <fstream>
+#include <algorithm>
 #include <mutex>
+#include <sstream>
 #include <thread>
 #include <unordered_set>
 
+#include "LogManifest.hpp"
+
 #include "log/CoEUpdate.hpp"
 #include "log/Serialized.hpp"
 #include "log/Serializer.hpp"
+#include "log/chunkindex.hpp"
 #include "log/coe.hpp"
 #include "log/coedata.hpp"
 #include "log/error.hpp"
 #include "log/esi.hpp"
+#include "log/header.hpp"
 #include "log/neighbors.hpp"
 #include "log/pdo.hpp"
 #include "log/pdodetails.hpp"
@@ -47,10 +52,12 @@ namespace etherkitten::reader
 	Logger::Logger(SlaveInformant& slaveInformant, Reader& reader,
 	    std::shared_ptr<datatypes::ErrorIterator> errorIterator, std::filesystem::path&& logFile,
 	    std::function<void(int, std::string)> progressFunction)
-	    : ostrm(logFile, std::ios::binary)
+	    : logFile(std::move(logFile))
 	    , slaveInformant(slaveInformant)
 	    , reader(reader)
+	    , processDataBuffer(ProcessDataBlock::headerSize + slaveInformant.getIOMapSize())
 	    , errorWrapper(errorIterator)
+	    , chunkEncoder(slaveInformant.getIOMapSize())
 	    , progressFunction(progressFunction)
 	{
 	}
@@ -70,6 +77,14 @@ namespace etherkitten::reader
 		{
 			fetchDataViews(slaveInformant.getSlaveInfo(i));
 		}
+
+		cycleStatisticWrappers.clear();
+		for (size_t i = 0; i < datatypes::cycleStatisticTypeCount; ++i)
+		{
+			datatypes::CycleStatistic statistic(static_cast<datatypes::CycleStatisticType>(i));
+			cycleStatisticWrappers.emplace_back(
+			    statistic.getStatisticType(), reader.getView(statistic, { startTime, 0s }));
+		}
 	}
 
 	void Logger::fetchDataViews(const datatypes::SlaveInfo& slaveInfo)
@@ -91,11 +106,30 @@ namespace etherkitten::reader
 		}
 	}
 
-	void Logger::startLog(datatypes::TimeStamp time)
+	void Logger::startLog(datatypes::TimeStamp time) { start(time, std::nullopt); }
+
+	void Logger::startCapture(datatypes::TimeStamp time, CaptureSettings settings)
+	{
+		if (settings.preTrigger.count() < 0 || settings.postTrigger.count() < 0)
+			throw std::invalid_argument("the capture times must not be negative");
+		start(time, std::move(settings));
+	}
+
+	void Logger::start(datatypes::TimeStamp time, std::optional<CaptureSettings>&& capture)
 	{
 		if (state == LoggerState::NO_LOG)
 		{
+			// The thread of a log that failed has ended by itself
+			if (thread.joinable())
+				thread.join();
+			writeFailed = false;
 			startTime = time;
+			this->capture = std::move(capture);
+			captureTriggered = false;
+			manualTrigger = false;
+			lastProcessDataTime.reset();
+			newestTime = 0;
+			segments.clear();
 			fetchDataViews();
 			ioMapWrapper = std::make_unique<IOMapDataViewWrapper>(reader.getIOMapView(startTime));
 			thread = std::thread(&Logger::writeLog, this);
@@ -108,10 +142,15 @@ namespace etherkitten::reader
 
 	void Logger::stopLog()
 	{
-		if (state != LoggerState::NO_LOG && state != LoggerState::STOPPING)
+		{
+			// The logger thread may end by itself at the same time if writing the log failed
+			std::lock_guard<std::mutex> lock(mutex);
+			if (state != LoggerState::NO_LOG)
+				state = LoggerState::STOPPING;
+		}
+		if (thread.joinable())
 		{
 			// Wait for logger thread to finish
-			setState(LoggerState::STOPPING);
 			thread.join();
 
 			// Delete all register wrappers from previous log
@@ -119,14 +158,112 @@ namespace etherkitten::reader
 		}
 	}
 
-	void Logger::write64(uint64_t data)
+	void Logger::setChunkSize(uint64_t chunkSize)
 	{
-		data = flipBytesIfBigEndianHost(data);
-		ostrm.write(reinterpret_cast<char*>(&data), sizeof data);
+		if (chunkSize == 0)
+			throw std::invalid_argument("the chunk size must not be 0");
+		if (thread.joinable())
+			throw std::runtime_error("cannot change the chunk size while the logger is running");
+		this->chunkSize = chunkSize;
 	}
 
-	void Logger::writeSerialized(Serialized& ser) { ostrm.write(ser.data, ser.length); }
-	void Logger::writeSerialized(Serialized&& ser) { ostrm.write(ser.data, ser.length); }
+	void Logger::setEncodeChunks(bool encodeChunks)
+	{
+		if (thread.joinable())
+			throw std::runtime_error(
+			    "cannot change the chunk encoding while the logger is running");
+		this->encodeChunks = encodeChunks;
+	}
+
+	void Logger::setRotation(
+	    uint64_t maximumSegmentSize, datatypes::TimeStep maximumSegmentDuration)
+	{
+		if (maximumSegmentDuration.count() < 0)
+			throw std::invalid_argument("the segment duration must not be negative");
+		if (thread.joinable())
+			throw std::runtime_error("cannot change the rotation while the logger is running");
+		this->maximumSegmentSize = maximumSegmentSize;
+		this->maximumSegmentDuration = maximumSegmentDuration;
+	}
+
+	void Logger::trigger() { manualTrigger = true; }
+
+	std::filesystem::path Logger::getCapturePath(unsigned int number) const
+	{
+		return getNumberedPath(number);
+	}
+
+	std::filesystem::path Logger::getNumberedPath(unsigned int number) const
+	{
+		std::filesystem::path path = logFile;
+		path.replace_filename(logFile.stem().string() + "-" + std::to_string(number)
+		    + logFile.extension().string());
+		return path;
+	}
+
+	void Logger::writeSerialized(Serialized& ser) { writer->write(ser.data, ser.length); }
+	void Logger::writeSerialized(Serialized&& ser) { writer->write(ser.data, ser.length); }
+
+	void Logger::writeDataBlock(const Serialized& ser)
+	{
+		// A chunk never spans an incident, so chunks in memory get their offset once written
+		if (currentChunk.isEmpty() && writer)
+			currentChunk.offset = writer->getPosition();
+		if (encodeChunks)
+			chunkEncoder.addDataBlock(ser);
+		else if (isWaitingForTrigger())
+			captureBuffer.insert(captureBuffer.end(), ser.data, ser.data + ser.length);
+		else
+			writer->write(ser.data, ser.length);
+		currentChunk.addDataBlock(ser);
+		newestTime = std::max(newestTime, currentChunk.lastTime);
+		if (currentChunk.length >= chunkSize)
+			finishChunk();
+	}
+
+	void Logger::finishChunk()
+	{
+		if (currentChunk.isEmpty())
+			return;
+		if (encodeChunks)
+		{
+			Serialized encoded = chunkEncoder.finish();
+			if (isWaitingForTrigger())
+				captureBuffer.assign(encoded.data, encoded.data + encoded.length);
+			else
+				writer->write(encoded.data, encoded.length);
+			currentChunk.length = encoded.length;
+		}
+		if (isWaitingForTrigger())
+		{
+			captureRing.push_back({ std::move(currentChunk), std::move(captureBuffer) });
+			captureBuffer.clear();
+			uint64_t preTrigger = capture->preTrigger.count();
+			uint64_t caughtUpTime = getCaughtUpTime();
+			while (!captureRing.empty()
+			    && captureRing.front().entry.lastTime + preTrigger < caughtUpTime)
+				captureRing.pop_front();
+		}
+		else
+		{
+			chunks.push_back(std::move(currentChunk));
+		}
+		currentChunk = ChunkEntryBlock(0);
+	}
+
+	void Logger::writeChunkIndex()
+	{
+		finishChunk();
+		ChunkIndexBlock index(std::move(chunks));
+		chunks.clear();
+		uint64_t pos = writer->getPosition();
+		writeSerialized(index.getSerializer().serialize(index));
+
+		// The LogWriter writes the index offset after the index, so an interrupted log is
+		// never pointed to a partial index
+		writer->writeAt(LogHeaderBlock::indexOffsetPosition, pos);
+		writer->flush();
+	}
 
 	void Logger::writeSlaveInfo(datatypes::SlaveInfo& slaveInfo)
 	{
@@ -160,10 +297,7 @@ namespace etherkitten::reader
 		writeSerialized(ser);
 
 		// Write PDO details offset
-		uint64_t pos = ostrm.tellp();
-		ostrm.seekp(8);
-		write64(pos);
-		ostrm.seekp(pos);
+		writer->writeAt(8, writer->getPosition());
 	}
 
 	void Logger::writePDODetails(datatypes::SlaveInfo& slaveInfo)
@@ -181,30 +315,21 @@ namespace etherkitten::reader
 		writeSerialized(ser);
 
 		// Write data offset
-		uint64_t pos = ostrm.tellp();
-		ostrm.seekp(16);
-		write64(pos);
-		ostrm.seekp(pos);
+		writer->writeAt(16, writer->getPosition());
 	}
 
-	void Logger::writeLog()
+	void Logger::openLogFile(const std::filesystem::path& path)
 	{
+		writer = std::make_unique<LogWriter>(path);
+
 		progressFunction(0, "Writing slave info");
 		setState(LoggerState::WRITE_SLAVE_INFO);
-		// Write version
-		uint64_t version = 1;
-		write64(version);
-
-		// Write offset placeholder
-		uint64_t zero = 0;
-		write64(zero);
-		write64(zero);
-
-		// Write ioMap size
-		write64(slaveInformant.getIOMapSize());
-
-		// Write start timestamp
-		write64(datatypes::timeStampToInt(reader.getStartTime()));
+		// Write header with offset placeholders
+		uint64_t version
+		    = encodeChunks ? LogHeaderBlock::encodedVersion : LogHeaderBlock::currentVersion;
+		LogHeaderBlock header{ version, 0, 0, slaveInformant.getIOMapSize(),
+			datatypes::timeStampToInt(reader.getStartTime()), 0 };
+		writeSerialized(header.getSerializer().serialize(header));
 
 		// Write SlaveInfo (note that the master is not written to the log since we get no
 		// information)
@@ -226,7 +351,99 @@ namespace etherkitten::reader
 
 		reportProgress();
 		setState(LoggerState::WRITE_DATA);
+	}
+
+	void Logger::closeLogFile()
+	{
+		if (isRotating())
+		{
+			// The time range of the segment is known once its last chunk is finished
+			finishChunk();
+			SegmentEntryBlock& segment = segments.back();
+			if (!chunks.empty())
+			{
+				segment.firstTime = chunks.front().firstTime;
+				segment.lastTime = chunks.front().lastTime;
+			}
+			for (auto& chunk : chunks)
+			{
+				segment.firstTime = std::min(segment.firstTime, chunk.firstTime);
+				segment.lastTime = std::max(segment.lastTime, chunk.lastTime);
+			}
+		}
+		writeChunkIndex();
+		bool failed = writer->hasFailed();
+		writer.reset();
+		if (failed)
+		{
+			reportWriteFailure();
+			return;
+		}
+		if (isRotating())
+			LogManifest::write(logFile, ManifestBlock(segments));
+	}
+
+	void Logger::reportWriteFailure()
+	{
+		writeFailed = true;
+		progressFunction(0, "Writing the log failed, logging stopped");
+	}
+
+	void Logger::dropLog()
+	{
+		writer.reset();
+		if (encodeChunks && !currentChunk.isEmpty())
+			chunkEncoder.finish();
+		currentChunk = ChunkEntryBlock(0);
+		chunks.clear();
+		captureRing.clear();
+		captureBuffer.clear();
+	}
+
+	bool Logger::isRotating() const
+	{
+		return !capture && (maximumSegmentSize != 0 || maximumSegmentDuration.count() != 0);
+	}
+
+	void Logger::openSegment()
+	{
+		std::filesystem::path path = getSegmentPath(segments.size() + 1);
+		segments.emplace_back(0, 0, path.filename().string());
+		// The manifest lists the segment before it is written, so it is never left behind
+		LogManifest::write(logFile, ManifestBlock(segments));
+		openLogFile(path);
+	}
+
+	bool Logger::segmentIsFull() const
+	{
+		// A segment holds at least one chunk, so every segment has an index
+		if (chunks.empty())
+			return false;
+		if (maximumSegmentSize != 0 && writer->getPosition() >= maximumSegmentSize)
+			return true;
+		return maximumSegmentDuration.count() != 0
+		    && newestTime - chunks.front().firstTime
+		    >= static_cast<uint64_t>(maximumSegmentDuration.count());
+	}
 
+	void Logger::writeLog()
+	{
+		if (capture)
+		{
+			progressFunction(0, "Waiting for an incident");
+			setState(LoggerState::WRITE_DATA);
+		}
+		else if (isRotating())
+		{
+			openSegment();
+		}
+		else
+		{
+			openLogFile(logFile);
+		}
+
+		uint32_t seenData = 0;
+		unsigned int idleSteps = 0;
 		while (state != LoggerState::STOPPING)
 		{
 			if (progressCounter >= progressCounterMax)
@@ -236,15 +453,159 @@ namespace etherkitten::reader
 				reachedEndOfPD = false;
 			}
 
-			if (!writeNextBlock())
+			if (manualTrigger.exchange(false))
+				fireTrigger(newestTime);
+
+			if (writeNextBlock())
+			{
+				idleSteps = 0;
+			}
+			else if (++idleSteps >= balancingSteps)
+			{
+				// Nothing was written for a whole round, so all data has been written
+				idleSteps = 0;
+				if (writer)
+					writer->handOverOlderThan(maximumWriteLatency);
+				seenData = reader.waitForNewData(seenData, idleWakeupInterval);
+			}
+
+			if (isRotating() && segmentIsFull())
+			{
+				closeLogFile();
+				if (!writeFailed)
+					openSegment();
+			}
+
+			// Checking newestTime first is cheaper, since it is never before the caught up time
+			if (captureTriggered && newestTime >= captureEnd && getCaughtUpTime() >= captureEnd)
 			{
-				std::this_thread::sleep_for(1ms);
+				closeLogFile();
+				captureTriggered = false;
 			}
+
+			if (writer && writer->hasFailed())
+				reportWriteFailure();
+			if (writeFailed)
+				break;
 		}
 
+		if (writeFailed)
+		{
+			// Nothing more can be written to the file
+			dropLog();
+		}
+		else if (writer)
+		{
+			closeLogFile();
+		}
+		else
+		{
+			// Stopped while waiting for an incident
+			finishChunk();
+			captureRing.clear();
+		}
+		captureTriggered = false;
 		setState(LoggerState::NO_LOG);
 	}
 
+	void Logger::fireTrigger(uint64_t time)
+	{
+		if (!capture)
+			return;
+		uint64_t end = time + capture->postTrigger.count();
+		if (captureTriggered)
+		{
+			captureEnd = std::max(captureEnd, end);
+			return;
+		}
+
+		// Move the current chunk into memory as well, so the log starts with whole chunks
+		finishChunk();
+		captureTriggered = true;
+		captureEnd = end;
+		openLogFile(getCapturePath(++captureCount));
+
+		uint64_t preTrigger = capture->preTrigger.count();
+		for (auto& chunk : captureRing)
+		{
+			if (chunk.entry.lastTime + preTrigger < time)
+				continue;
+			chunk.entry.offset = writer->getPosition();
+			writer->write(chunk.data.data(), chunk.data.size());
+			chunks.push_back(std::move(chunk.entry));
+		}
+		captureRing.clear();
+	}
+
+	uint64_t Logger::getCaughtUpTime()
+	{
+		// Process data and registers are written at different rates, so one may lag behind
+		uint64_t time = newestTime;
+		if (ioMapWrapper->hasNext())
+			time = std::min(time, datatypes::timeStampToInt(ioMapWrapper->getTime()));
+		for (auto& wrapper : registerWrappers)
+		{
+			if (wrapper.hasNext())
+				time = std::min(time, datatypes::timeStampToInt(wrapper.getTime()));
+		}
+		for (auto& wrapper : cycleStatisticWrappers)
+		{
+			if (wrapper.hasNext())
+				time = std::min(time, datatypes::timeStampToInt(wrapper.getTime()));
+		}
+		return time;
+	}
+
+	void Logger::checkTriggers(RegisterDataViewWrapper& wrapper)
+	{
+		if (!capture)
+			return;
+		uint64_t value = wrapper.getValue();
+		for (auto& trigger : capture->triggers)
+		{
+			if (trigger.firesOnRegister(wrapper.getSlaveId(), wrapper.getRegisterAddress(), value))
+			{
+				fireTrigger(datatypes::timeStampToInt(wrapper.getTime()));
+				return;
+			}
+		}
+	}
+
+	void Logger::checkTriggers(const datatypes::ErrorMessage& message, datatypes::TimeStamp time)
+	{
+		if (!capture)
+			return;
+		for (auto& trigger : capture->triggers)
+		{
+			if (trigger.firesOnError(message.getSeverity()))
+			{
+				fireTrigger(datatypes::timeStampToInt(time));
+				return;
+			}
+		}
+	}
+
+	void Logger::checkTriggers(datatypes::TimeStamp processDataTime)
+	{
+		if (!capture)
+			return;
+		if (lastProcessDataTime)
+		{
+			auto gap = std::chrono::duration_cast<datatypes::TimeStep>(
+			    processDataTime - *lastProcessDataTime);
+			for (auto& trigger : capture->triggers)
+			{
+				if (trigger.firesOnProcessDataGap(gap))
+				{
+					// The gap is only noticed at the process data that ends it
+					fireTrigger(datatypes::timeStampToInt(processDataTime));
+					break;
+				}
+			}
+		}
+		lastProcessDataTime = processDataTime;
+	}
+
 	void Logger::setState(LoggerState state)
 	{
 		std::lock_guard<std::mutex> lock(mutex);
@@ -267,16 +628,16 @@ namespace etherkitten::reader
 				CoEUpdate& update = coeQueue.front();
 				Serialized ser(update.get());
 				coeQueue.pop();
-				writeSerialized(ser);
+				writeDataBlock(ser);
 				return true;
 			}
 		}
 
 		// balance registers and process data
 		readerCounter++;
-		if (readerCounter >= 6)
+		if (readerCounter >= balancingSteps)
 			readerCounter = 0;
-		if (readerCounter < 3)
+		if (readerCounter < balancingSteps / 2)
 		{
 			// write register
 			for (auto& wrp : registerWrappers)
@@ -284,7 +645,8 @@ namespace etherkitten::reader
 				if (wrp.hasNext())
 				{
 					wrp.next();
-					writeSerialized(wrp.get());
+					checkTriggers(wrp);
+					writeDataBlock(wrp.get());
 					blockWritten = true;
 				}
 			}
@@ -298,10 +660,22 @@ namespace etherkitten::reader
 			ErrorBlock errorBlock(static_cast<uint8_t>(message.getSeverity()), message.getMessage(),
 			    datatypes::timeStampToInt(time), message.getAssociatedSlaves().first,
 			    message.getAssociatedSlaves().second);
-			writeSerialized(errorBlock.getSerializer().serialize(errorBlock));
+			checkTriggers(message, time);
+			writeDataBlock(errorBlock.getSerializer().serialize(errorBlock));
 			blockWritten = true;
 		}
 
+		// write cycle statistics at the rate of the process data
+		for (auto& wrp : cycleStatisticWrappers)
+		{
+			if (wrp.hasNext())
+			{
+				wrp.next();
+				writeDataBlock(wrp.get());
+				blockWritten = true;
+			}
+		}
+
 		// write process data
 		return writeProcessDataBlock() || blockWritten;
 	}
@@ -315,12 +689,10 @@ namespace etherkitten::reader
 		}
 
 		ioMapWrapper->next();
-		auto ioMap = ioMapWrapper->get();
-		Serialized ser(ioMap->ioMapSize);
-		memcpy(ser.data, ioMap->ioMap, ioMap->ioMapSize);
-		ProcessDataBlock block{ datatypes::timeStampToInt(ioMapWrapper->getTime()),
-			std::move(ser) };
-		writeSerialized(block.getSerializer().serialize(block));
+		checkTriggers(ioMapWrapper->getTime());
+		ProcessDataBlock::serializer.serialize(datatypes::timeStampToInt(ioMapWrapper->getTime()),
+		    ioMapWrapper->get(), processDataBuffer);
+		writeDataBlock(processDataBuffer);
 		return true;
 	}
 
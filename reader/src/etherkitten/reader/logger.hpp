@@ -21,22 +21,30 @@
  * \brief Defines the Logger, which writes logfiles to the disk.
  */
 
+#include "CaptureTrigger.hpp"
 #include "DataView.hpp"
 #include "ErrorStatistician.hpp"
+#include "LogWriter.hpp"
 #include "SearchListReader.hpp"
 #include "SlaveInformant.hpp"
 #include "log/CoEUpdate.hpp"
 #include "log/DataViewWrapper.hpp"
 #include "log/Serialized.hpp"
+#include "log/chunkindex.hpp"
+#include "log/encodedchunk.hpp"
+#include "log/manifest.hpp"
 #include <etherkitten/datatypes/SlaveInfo.hpp>
 #include <etherkitten/datatypes/dataviews.hpp>
 #include <etherkitten/datatypes/ethercatdatatypes.hpp>
 #include <etherkitten/datatypes/time.hpp>
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <filesystem>
-#include <fstream>
 #include <memory>
 
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <thread>
 
@@ -65,6 +73,20 @@ namespace etherkitten::reader
 	 * The remaining file is filled with data blocks containing the data obtained from
 	 * the bus at runtime. This includes the data which can later be plotted in the GUI.
 	 *
+	 * Since version 2, the data blocks are grouped into chunks of about the same size and
+	 * the file ends with a ChunkIndexBlock that holds the time range, the kinds of blocks,
+	 * the slaves and the file offset of every chunk. The header points to this index once
+	 * the Logger has stopped, so readers can seek to a time window without parsing the data
+	 * in front of it. Version 1 logs have no chunks and no index.
+	 *
+	 * Version 3 logs store every chunk as one EncodedChunkBlock, which takes up a fraction
+	 * of the space of the plain data blocks. A chunk is only written once it is complete,
+	 * so the data of the last chunk is lost if the Logger does not stop properly.
+	 *
+	 * A Logger that rotates its log writes a series of such log files, its segments, which
+	 * are each complete logs. The file the Logger was given then holds a ManifestBlock that
+	 * lists the segments and their time ranges.
+	 *
 	 * For detailed information about how the blocks are structured see the files in which
 	 * they are defined.
 	 *
@@ -89,8 +111,8 @@ namespace etherkitten::reader
 		 * to start logging you need to call startLog().
 		 *
 		 * The logger writes information about the slave into the logfile.
-		 * Then it writes all register data and process data with a timestamp greater
-		 * than the one specified in startLog to the log.
+		 * Then it writes all register data, process data and cycle statistics with a timestamp
+		 * greater than the one specified in startLog to the log.
 		 * All error messages and coe updates are also included in the logfile.
 		 *
 		 * \param slaveInformant the SlaveInformant
@@ -129,6 +151,47 @@ namespace etherkitten::reader
 		 */
 		void startLog(datatypes::TimeStamp time);
 
+		/*!
+		 * \brief Start capturing incidents. The logger thread is started.
+		 *
+		 * Instead of writing one log, the Logger keeps the encoded data of the last
+		 * preTrigger in memory and writes nothing until a trigger fires or trigger()
+		 * is called. The log of the n-th incident is then written to getCapturePath(n)
+		 * and holds the data from preTrigger before to postTrigger after the incident.
+		 * Afterwards the Logger waits for the next incident.
+		 *
+		 * The data in memory is dropped chunk by chunk, so a little more than preTrigger
+		 * may be written in front of an incident.
+		 * \param time the first TimeStamp of data to capture
+		 * \param settings how much data to write around which incidents
+		 * \exception std::runtime_error iff the logger is already logging
+		 * \exception std::invalid_argument iff preTrigger or postTrigger is negative
+		 */
+		void startCapture(datatypes::TimeStamp time, CaptureSettings settings);
+
+		/*!
+		 * \brief Capture an incident at the newest data the Logger has seen.
+		 *
+		 * Does nothing unless the Logger is capturing.
+		 */
+		void trigger();
+
+		/*!
+		 * \brief Get the number of incidents the Logger has started writing logs of.
+		 * \return the number of captured incidents
+		 */
+		unsigned int getCaptureCount() const { return captureCount.load(); }
+
+		/*!
+		 * \brief Get the path of the log of a captured incident.
+		 *
+		 * It is the path of the logfile of the Logger with the number of the incident appended
+		 * to its stem.
+		 * \param number the number of the incident, starting at 1
+		 * \return the path of its log
+		 */
+		std::filesystem::path getCapturePath(unsigned int number) const;
+
 		/*!
 		 * \brief Stop logging.
 		 *
@@ -139,6 +202,15 @@ namespace etherkitten::reader
 		 */
 		void stopLog();
 
+		/*!
+		 * \brief Check whether writing the log failed.
+		 *
+		 * Once a log file cannot be written, the Logger reports the failure through the
+		 * progressFunction and stops logging by itself. It is reset by the next start.
+		 * \retval true iff writing the last log failed
+		 */
+		bool hasFailed() const { return writeFailed.load(); }
+
 		/*!
 		 * \brief Write an update to a CoEObject to the log
 		 * \param object the object which has been updated
@@ -147,19 +219,117 @@ namespace etherkitten::reader
 		void updateCoE(const datatypes::CoEObject& object,
 		    std::shared_ptr<datatypes::AbstractDataPoint>&& dataPoint);
 
+		/*!
+		 * \brief Set the size after which the Logger starts a new chunk of data blocks.
+		 *
+		 * Smaller chunks let readers seek more precisely but make the index larger.
+		 * \param chunkSize the chunk size in bytes
+		 * \exception std::invalid_argument iff chunkSize is 0
+		 * \exception std::runtime_error iff the logger is already logging
+		 */
+		void setChunkSize(uint64_t chunkSize);
+
+		/*!
+		 * \brief Set whether the Logger encodes the chunks compactly and writes
+		 * a version 3 log.
+		 *
+		 * Logs with plain chunks are written as version 2 and can be read by older readers.
+		 * \param encodeChunks whether to encode the chunks
+		 * \exception std::runtime_error iff the logger is already logging
+		 */
+		void setEncodeChunks(bool encodeChunks);
+
+		/*!
+		 * \brief Set when the Logger starts a new segment of the log.
+		 *
+		 * Without limits the log is written to a single file. With a limit, startLog()
+		 * writes the log to segments at getSegmentPath() and a manifest listing them to
+		 * the logfile of the Logger. A segment is finished once it reaches either limit,
+		 * though it always holds at least one chunk. Capturing is not affected.
+		 * \param maximumSegmentSize the size of a segment in bytes, 0 for no limit
+		 * \param maximumSegmentDuration the time span of the data in a segment, 0 for no limit
+		 * \exception std::invalid_argument iff maximumSegmentDuration is negative
+		 * \exception std::runtime_error iff the logger is already logging
+		 */
+		void setRotation(uint64_t maximumSegmentSize, datatypes::TimeStep maximumSegmentDuration);
+
+		/*!
+		 * \brief Get the path of a segment of a rotated log.
+		 *
+		 * It is the path of the logfile of the Logger with the number of the segment appended
+		 * to its stem.
+		 * \param number the number of the segment, starting at 1
+		 * \return the path of the segment
+		 */
+		std::filesystem::path getSegmentPath(unsigned int number) const
+		{
+			return getNumberedPath(number);
+		}
+
+		/*!
+		 * \brief The chunk size the Logger uses unless told otherwise.
+		 */
+		static constexpr uint64_t defaultChunkSize = 1 << 20;
+
 	private:
-		std::ofstream ostrm;
+		const std::filesystem::path logFile;
+		std::unique_ptr<LogWriter> writer;
 		SlaveInformant& slaveInformant;
 		datatypes::TimeStamp startTime;
 		LoggerState state = NO_LOG;
+		std::atomic<bool> writeFailed = false;
 		std::mutex mutex;
 		std::mutex coeMutex;
 		std::queue<CoEUpdate> coeQueue;
 		Reader& reader;
 		std::vector<RegisterDataViewWrapper> registerWrappers;
+		std::vector<CycleStatisticDataViewWrapper> cycleStatisticWrappers;
+		/*
+		 * readerCounter counts the calls to writeNextBlock in a round of balancingSteps.
+		 * Registers are written in the first half of the round, process data in the second.
+		 */
+		static constexpr unsigned int balancingSteps = 6;
 		uint64_t readerCounter = 0;
 		std::unique_ptr<IOMapDataViewWrapper> ioMapWrapper;
+		// Reused for every ProcessDataBlock so writing process data does not allocate
+		Serialized processDataBuffer;
 		datatypes::FirstEmptyErrorIterator errorWrapper;
+		uint64_t chunkSize = defaultChunkSize;
+		ChunkEntryBlock currentChunk{ 0 };
+		bool encodeChunks = false;
+		ChunkEncoder chunkEncoder;
+		std::vector<ChunkEntryBlock> chunks;
+		// The newest timestamp of all data blocks written so far
+		uint64_t newestTime = 0;
+
+		/*!
+		 * \brief A finished chunk that waits in memory for an incident.
+		 */
+		struct CapturedChunk
+		{
+			ChunkEntryBlock entry;
+			std::vector<char> data;
+		};
+
+		/*
+		 * These are only used while capturing. Since the streams of data are written at
+		 * different rates, the data in memory is dropped and the post trigger time ends
+		 * by the time up to which all streams have been written, see getCaughtUpTime().
+		 */
+		std::optional<CaptureSettings> capture;
+		bool captureTriggered = false;
+		uint64_t captureEnd = 0;
+		std::deque<CapturedChunk> captureRing;
+		// Holds the plain data blocks of the current chunk while waiting for an incident
+		std::vector<char> captureBuffer;
+		std::atomic<unsigned int> captureCount = 0;
+		std::atomic<bool> manualTrigger = false;
+		std::optional<datatypes::TimeStamp> lastProcessDataTime;
+
+		// These are only used while rotating, see setRotation()
+		uint64_t maximumSegmentSize = 0;
+		datatypes::TimeStep maximumSegmentDuration{ 0 };
+		std::vector<SegmentEntryBlock> segments;
 
 		// These are for progress calculation
 		std::vector<std::unique_ptr<datatypes::AbstractNewestValueView>> registerNewestValues;
@@ -172,12 +342,37 @@ namespace etherkitten::reader
 		const unsigned long progressCounterMax = 100;
 		bool reachedEndOfPD = false;
 
-		void write64(uint64_t data);
+		/*
+		 * Without new data, the data in the current buffer of the LogWriter is written at
+		 * the latest after maximumWriteLatency. The Logger also looks for new data every
+		 * idleWakeupInterval in case the Reader does not announce it.
+		 */
+		static constexpr std::chrono::seconds maximumWriteLatency{ 1 };
+		static constexpr std::chrono::milliseconds idleWakeupInterval{ 10 };
+
 		void writeSerialized(Serialized& ser);
 		void writeSerialized(Serialized&& ser);
+		void writeDataBlock(const Serialized& ser);
+		void finishChunk();
+		void writeChunkIndex();
 		void writeSlaveInfo(datatypes::SlaveInfo& slaveInfo);
 		void writePDODetails(datatypes::SlaveInfo& slaveInfo);
 		void writeLog();
+		void start(datatypes::TimeStamp time, std::optional<CaptureSettings>&& capture);
+		void openLogFile(const std::filesystem::path& path);
+		void closeLogFile();
+		void reportWriteFailure();
+		void dropLog();
+		bool isRotating() const;
+		void openSegment();
+		bool segmentIsFull() const;
+		std::filesystem::path getNumberedPath(unsigned int number) const;
+		bool isWaitingForTrigger() const { return capture && !captureTriggered; }
+		void fireTrigger(uint64_t time);
+		uint64_t getCaughtUpTime();
+		void checkTriggers(RegisterDataViewWrapper& wrapper);
+		void checkTriggers(const datatypes::ErrorMessage& message, datatypes::TimeStamp time);
+		void checkTriggers(datatypes::TimeStamp processDataTime);
 		void setState(LoggerState state);
 		bool writeNextBlock();
 		bool writeProcessDataBlock();
@@ -32,6 +32,9 @@
 #include <etherkitten/datatypes/ethercatdatatypes.hpp>
 #include <etherkitten/datatypes/time.hpp>
 
+#include "AggregateDataView.hpp"
+#include "Converter.hpp"
+#include "IOMap.hpp"
 #include "NewestValueView.hpp"
 
 namespace etherkitten::reader::bReader
@@ -95,6 +98,8 @@ namespace etherkitten::reader::bReader
 	/*!
 	 * \brief Returns a DataView with underlying type T and output type E.
 	 *
+	 * If the values are used as they are stored and the step of the TimeSeries is coarse,
+	 * an AggregateDataView over the list is returned instead.
 	 * To be used with the dataTypeMaps.
 	 * \tparam E the output type of the view
 	 * \tparam T the underlying type of the view
@@ -112,8 +117,38 @@ namespace etherkitten::reader::bReader
 			return [](SearchList<T, NodeSize::value>& list, datatypes::TimeSeries time,
 			           size_t bitOffset,
 			           size_t bitLength) -> std::shared_ptr<datatypes::AbstractDataView> {
-				return list.template getView<typename datatypes::TypeMap<E>::type>(
-				    time, bitOffset, bitLength, true);
+				using Output = typename datatypes::TypeMap<E>::type;
+				if constexpr (std::is_arithmetic<T>() && std::is_same<T, Output>())
+				{
+					static constexpr size_t byteSize = 8;
+					if (bitOffset == 0 && bitLength == sizeof(T) * byteSize
+					    && Aggregate::isCoarse(time.microStep))
+					{
+						return list.getAggregateView(time);
+					}
+				}
+				return list.template getView<Output>(time, bitOffset, bitLength, true);
+			};
+		}
+	};
+
+	/*!
+	 * \brief Returns a function that extracts a value of type E from an IOMap as a double.
+	 *
+	 * To be used with the dataTypeMaps.
+	 * \tparam E the type of the value in the IOMap
+	 */
+	template<datatypes::EtherCATDataTypeEnum E, typename...>
+	class IOMapDecoderRetriever
+	{
+	public:
+		using product_t = std::function<double(IOMap*, size_t, size_t)>;
+
+		static product_t eval()
+		{
+			return [](IOMap* ioMap, size_t bitOffset, size_t bitLength) -> double {
+				return convertIOMapToDouble<typename datatypes::TypeMap<E>::type>(
+				    ioMap, bitOffset, bitLength, true);
 			};
 		}
 	};
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <etherkitten/datatypes/dataobjects.hpp>
+#include <etherkitten/datatypes/errors.hpp>
+#include <etherkitten/reader/CaptureTrigger.hpp>
+#include <etherkitten/reader/LogCache.hpp>
+#include <etherkitten/reader/logger.hpp>
+
+#include "DataReaderMock.hpp"
+#include "LogTestHelpers.hpp"
+#include "SlaveInformantMock.hpp"
+
+using namespace etherkitten::reader;
+using namespace etherkitten::datatypes;
+using namespace std::chrono_literals;
+
+SCENARIO("CaptureTriggers fire on the events they are made for", "[Logger]")
+{
+	GIVEN("A trigger for each kind of event")
+	{
+		CaptureTrigger error = CaptureTrigger::onError(ErrorSeverity::MEDIUM);
+		CaptureTrigger gap = CaptureTrigger::onProcessDataGap(5ms);
+		CaptureTrigger reg
+		    = CaptureTrigger::onRegisterAbove(Register(2, RegisterEnum::BUILD), 100);
+		uint16_t build = static_cast<uint16_t>(RegisterEnum::BUILD);
+
+		THEN("They only fire on their own kind of event")
+		{
+			REQUIRE(error.getType() == CaptureTriggerType::ERROR);
+			REQUIRE_FALSE(error.firesOnError(ErrorSeverity::LOW));
+			REQUIRE(error.firesOnError(ErrorSeverity::MEDIUM));
+			REQUIRE(error.firesOnError(ErrorSeverity::FATAL));
+			REQUIRE_FALSE(error.firesOnProcessDataGap(1s));
+			REQUIRE_FALSE(error.firesOnRegister(2, build, 1000));
+
+			REQUIRE(gap.getType() == CaptureTriggerType::PROCESS_DATA_GAP);
+			REQUIRE_FALSE(gap.firesOnProcessDataGap(5ms));
+			REQUIRE(gap.firesOnProcessDataGap(6ms));
+			REQUIRE_FALSE(gap.firesOnError(ErrorSeverity::FATAL));
+
+			REQUIRE(reg.getType() == CaptureTriggerType::REGISTER_ABOVE);
+			REQUIRE_FALSE(reg.firesOnRegister(2, build, 100));
+			REQUIRE(reg.firesOnRegister(2, build, 101));
+			REQUIRE_FALSE(reg.firesOnRegister(1, build, 101));
+			REQUIRE_FALSE(
+			    reg.firesOnRegister(2, static_cast<uint16_t>(RegisterEnum::TYPE), 101));
+		}
+	}
+
+	GIVEN("A trigger for a register that is a bit field")
+	{
+		// LINK_STATUS_PORT_0 is bit 4 of the register at 0x110
+		CaptureTrigger link
+		    = CaptureTrigger::onRegisterAbove(Register(1, RegisterEnum::LINK_STATUS_PORT_0), 0);
+		uint16_t address = 0x110;
+
+		THEN("It only fires on the bits of that register")
+		{
+			REQUIRE_FALSE(link.firesOnRegister(1, address, 0x01));
+			REQUIRE_FALSE(link.firesOnRegister(1, address, 0xEF));
+			REQUIRE(link.firesOnRegister(1, address, 0x10));
+			REQUIRE(link.firesOnRegister(1, address, 0xFF));
+		}
+	}
+}
+
+SCENARIO("A capturing Logger only writes the data around incidents", "[Logger]")
+{
+	GIVEN("A Reader with a register spike and a gap in the process data")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 1, 2 } };
+		PDO pdo = PDO(1, "PDO", EtherCATDataTypeEnum::INTEGER16, 0, PDODirection::INPUT);
+		reader.slaveInformant.feedSlaveInfo(1,
+		    SlaveInfo(1, "Slave1", std::vector<PDO>{ pdo }, {}, ESIData{}, {},
+		        std::array<unsigned int, 4>{ 0, 0, 0, 0 }));
+		reader.appendPDOToIOMap(pdo);
+		Register reg = Register(1, RegisterEnum::BUILD);
+		// The Logger writes process data twice as often as registers, so it is fed twice as
+		// often to keep both close to each other in time, like on a bus
+		for (uint64_t i = 0; i < 400; ++i)
+		{
+			if (i < 240 || i >= 260)
+				reader.feedPDOData({ { pdo, i } }, at(500 * (i + 1)));
+			if (i % 2 == 0)
+				reader.feedRegister(reg, at(500 * i + 1500), i == 100 ? 1000 : i % 200);
+		}
+		LogCache errorCache;
+		Logger logger{ reader.slaveInformant, reader, errorCache.getErrors(),
+			"Capturelog.ekl" };
+		logger.setChunkSize(128);
+		logger.setEncodeChunks(true);
+
+		WHEN("The Logger captures incidents of both kinds")
+		{
+			logger.startCapture(at(0),
+			    { 10ms, 5ms,
+			        { CaptureTrigger::onRegisterAbove(reg, 500),
+			            CaptureTrigger::onProcessDataGap(5ms) } });
+			std::this_thread::sleep_for(500ms);
+			logger.stopLog();
+
+			THEN("It writes one log per incident with the data around it")
+			{
+				REQUIRE(logger.getCaptureCount() == 2);
+				REQUIRE(logger.getCapturePath(1) == "Capturelog-1.ekl");
+
+				auto spike = readRegister(logger.getCapturePath(1), reg);
+				REQUIRE_FALSE(spike.empty());
+				REQUIRE(spike.front().second >= at(30000));
+				REQUIRE(spike.front().second <= at(41500));
+				REQUIRE(spike.back().second >= at(56500));
+				REQUIRE(spike.back().second <= at(65000));
+				REQUIRE(std::find(spike.begin(), spike.end(),
+				            std::pair<uint64_t, TimeStamp>{ 1000, at(51500) })
+				    != spike.end());
+
+				auto gap = readRegister(logger.getCapturePath(2), reg);
+				REQUIRE_FALSE(gap.empty());
+				REQUIRE(gap.front().second >= at(110000));
+				REQUIRE(gap.front().second <= at(120500));
+				REQUIRE(gap.back().second >= at(135500));
+				REQUIRE(gap.back().second <= at(145000));
+			}
+		}
+
+		WHEN("The Logger captures an incident manually and is stopped while it waits for "
+		     "the next one")
+		{
+			logger.startCapture(at(0), { 5ms, 0ms, {} });
+			std::this_thread::sleep_for(200ms);
+			logger.trigger();
+			std::this_thread::sleep_for(200ms);
+			logger.stopLog();
+
+			THEN("It writes the data in front of the trigger")
+			{
+				REQUIRE(logger.getCaptureCount() == 1);
+				auto values = readRegister(logger.getCapturePath(1), reg);
+				REQUIRE_FALSE(values.empty());
+				REQUIRE(values.front().second >= at(180000));
+				REQUIRE(values.front().second <= at(195500));
+				REQUIRE(values.back().second == at(200500));
+			}
+		}
+
+		WHEN("The capture times are negative")
+		{
+			THEN("The Logger does not start capturing")
+			{
+				REQUIRE_THROWS_AS(logger.startCapture(at(0), { -1ms, 0ms, {} }),
+				    std::invalid_argument);
+			}
+		}
+	}
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <etherkitten/reader/CycleHistogram.hpp>
+
+#include <cstdint>
+#include <thread>
+
+#include "ThreadContainer.hpp"
+
+using namespace etherkitten::reader;
+
+SCENARIO("The CycleHistogram places values in buckets with a bounded relative error",
+    "[CycleHistogram]")
+{
+	GIVEN("The bucket layout of the CycleHistogram")
+	{
+		THEN("Small values have their own buckets")
+		{
+			for (uint64_t value = 0; value < (1 << CycleHistogram::subBucketBits); ++value)
+			{
+				REQUIRE(CycleHistogram::bucketOf(value) == value);
+				REQUIRE(CycleHistogram::lowestValueIn(value) == value);
+				REQUIRE(CycleHistogram::highestValueIn(value) == value);
+			}
+		}
+
+		THEN("Every value lies within its bucket and the buckets are contiguous")
+		{
+			for (uint64_t value : { 64ULL, 65ULL, 127ULL, 128ULL, 1000ULL, 999999ULL, 1000000ULL,
+			         (1ULL << 31) - 1, 1ULL << 31, (1ULL << 32) - 1 })
+			{
+				size_t bucket = CycleHistogram::bucketOf(value);
+				REQUIRE(bucket < CycleHistogram::bucketCount);
+				REQUIRE(CycleHistogram::lowestValueIn(bucket) <= value);
+				REQUIRE(CycleHistogram::highestValueIn(bucket) >= value);
+				REQUIRE(CycleHistogram::lowestValueIn(bucket + 1)
+				    == CycleHistogram::highestValueIn(bucket) + 1);
+				double width = CycleHistogram::highestValueIn(bucket)
+				    - CycleHistogram::lowestValueIn(bucket) + 1;
+				REQUIRE(width / value <= 1.0 / (1 << (CycleHistogram::subBucketBits - 1)));
+			}
+			REQUIRE(CycleHistogram::bucketOf((1ULL << 32) - 1) == CycleHistogram::bucketCount - 1);
+		}
+	}
+
+	GIVEN("An empty CycleHistogram")
+	{
+		CycleHistogram histogram;
+
+		THEN("All of its statistics are 0")
+		{
+			REQUIRE(histogram.getCount() == 0);
+			REQUIRE(histogram.getMin() == 0);
+			REQUIRE(histogram.getMax() == 0);
+			REQUIRE(histogram.getMean() == 0);
+			REQUIRE(histogram.getValueAtPercentile(99) == 0);
+		}
+
+		WHEN("I record the values from 1 to 1000")
+		{
+			for (uint64_t value = 1; value <= 1000; ++value)
+			{
+				histogram.record(value);
+			}
+
+			THEN("It knows their count, extremes and mean")
+			{
+				REQUIRE(histogram.getCount() == 1000);
+				REQUIRE(histogram.getMin() == 1);
+				REQUIRE(histogram.getMax() == 1000);
+				REQUIRE(histogram.getMean() == Approx(500.5));
+			}
+
+			THEN("Its percentiles are close to the exact ones")
+			{
+				REQUIRE(histogram.getValueAtPercentile(0) == 1);
+				REQUIRE(histogram.getValueAtPercentile(50) == Approx(500).epsilon(0.04));
+				REQUIRE(histogram.getValueAtPercentile(99) == Approx(990).epsilon(0.04));
+				REQUIRE(histogram.getValueAtPercentile(100) == 1000);
+			}
+		}
+
+		WHEN("I record a value that does not fit into 32 bits")
+		{
+			histogram.record(1ULL << 40);
+
+			THEN("It is counted as the largest value that fits")
+			{
+				REQUIRE(histogram.getMax() == (1ULL << 32) - 1);
+				REQUIRE(histogram.getBucketCount(CycleHistogram::bucketCount - 1) == 1);
+			}
+		}
+	}
+}
+
+SCENARIO("The CycleHistogram can be read while it is being written", "[CycleHistogram]")
+{
+	GIVEN("A CycleHistogram that a thread writes to")
+	{
+		CycleHistogram histogram;
+		static constexpr uint64_t valueCount = 100000;
+		ThreadContainer<CycleHistogram*> writer(
+		    [](CycleHistogram* histogram) {
+			    for (uint64_t value = 0; value < valueCount; ++value)
+			    {
+				    histogram->record(value % 1000);
+			    }
+		    },
+		    &histogram);
+
+		WHEN("I read it at the same time")
+		{
+			uint64_t lastCount = 0;
+			while (lastCount < valueCount)
+			{
+				uint64_t count = histogram.getCount();
+				REQUIRE(count >= lastCount);
+				REQUIRE(histogram.getValueAtPercentile(100) <= 999);
+				lastCount = count;
+			}
+
+			THEN("It ends up with all values")
+			{
+				REQUIRE(histogram.getMin() == 0);
+				REQUIRE(histogram.getMax() == 999);
+			}
+		}
+	}
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <etherkitten/reader/CycleTimer.hpp>
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace etherkitten::reader;
+using namespace std::chrono_literals;
+
+SCENARIO("The CycleTimer starts cycles at absolute deadlines", "[CycleTimer]")
+{
+	GIVEN("A CycleTimer with a cycle time of 2ms")
+	{
+		CycleSchedule schedule{ 2ms, 0ms };
+		auto start = std::chrono::steady_clock::now();
+		CycleTimer timer(schedule);
+
+		WHEN("The cycles take varying amounts of time")
+		{
+			for (int cycle = 0; cycle < 50; ++cycle) // NOLINT
+			{
+				std::this_thread::sleep_for(std::chrono::microseconds(100 * (cycle % 10)));
+				REQUIRE(timer.waitForNextCycle() == 0);
+			}
+			auto elapsed = std::chrono::steady_clock::now() - start;
+
+			THEN("The time spent in the cycles does not accumulate as drift")
+			{
+				REQUIRE(elapsed >= 100ms);
+				REQUIRE(elapsed < 110ms);
+			}
+		}
+
+		WHEN("A cycle overruns by more than two cycles")
+		{
+			std::this_thread::sleep_for(5ms);
+			size_t skipped = timer.waitForNextCycle();
+			auto afterOverrun = std::chrono::steady_clock::now();
+			timer.waitForNextCycle();
+			auto nextCycle = std::chrono::steady_clock::now();
+
+			THEN("The missed cycles are skipped instead of caught up on")
+			{
+				REQUIRE(skipped >= 1);
+				REQUIRE(afterOverrun - start < 6ms);
+				REQUIRE(nextCycle - start >= 6ms);
+				REQUIRE(nextCycle - start < 8ms);
+			}
+		}
+	}
+
+	GIVEN("A CycleTimer that busy waits for the whole cycle")
+	{
+		CycleSchedule schedule{ 1ms, 1ms };
+		auto start = std::chrono::steady_clock::now();
+		CycleTimer timer(schedule);
+
+		WHEN("It waits for some cycles")
+		{
+			for (int cycle = 0; cycle < 10; ++cycle) // NOLINT
+			{
+				timer.waitForNextCycle();
+			}
+
+			THEN("It keeps the same schedule")
+			{
+				REQUIRE(std::chrono::steady_clock::now() - start >= 10ms);
+				REQUIRE(std::chrono::steady_clock::now() - start < 12ms);
+			}
+		}
+	}
+
+	GIVEN("Invalid CycleSchedules")
+	{
+		THEN("They are rejected")
+		{
+			REQUIRE_THROWS_AS(CycleSchedule({ 0ms, 0ms }).validate(), std::invalid_argument);
+			REQUIRE_THROWS_AS(CycleSchedule({ 1ms, 2ms }).validate(), std::invalid_argument);
+			REQUIRE_THROWS_AS(CycleTimer(CycleSchedule{ -1ms, 0ms }), std::invalid_argument);
+			REQUIRE_NOTHROW(CycleSchedule({ 1ms, 1ms }).validate());
+		}
+	}
+}
@@ -69,6 +69,14 @@ namespace etherkitten::reader
 		insertRegister(
 		    static_cast<datatypes::RegisterEnum>(static_cast<uint16_t>(reg.getRegister())),
 		    reinterpret_cast<uint8_t*>(&value), reg.getSlaveID() - 1, time);
+		signalNewData();
+	}
+
+	void DataReaderMock::feedCycleMeasurement(
+	    const CycleMeasurement& measurement, datatypes::TimeStamp time)
+	{
+		insertCycleMeasurement(measurement, time);
+		signalNewData();
 	}
 
 	template<datatypes::EtherCATDataTypeEnum E, typename...>
@@ -108,18 +116,15 @@ namespace etherkitten::reader
 	void DataReaderMock::feedPDOData(
 	    std::vector<std::pair<datatypes::PDO, uint64_t>> values, datatypes::TimeStamp time)
 	{
-		uint8_t ioMap[ioMapSize];
-		for (uint16_t i = 0; i < ioMapSize; i++)
-			ioMap[i] = 0;
+		std::vector<uint8_t> ioMap(ioMapSize, 0);
 
 		for (std::pair<datatypes::PDO, uint64_t>& pair : values)
 		{
 			std::pair<uint16_t, uint16_t> bounds = getBounds(pair.first);
-			memcpy(ioMap + bounds.first, &pair.second, bounds.second);
+			memcpy(ioMap.data() + bounds.first, &pair.second, bounds.second);
 		}
-		std::unique_ptr<IOMap> ptr(new (ioMapSize) IOMap{ ioMapSize, {} });
-		std::memcpy(ptr->ioMap, ioMap, ioMapSize);
-		insertIOMap(std::move(ptr), std::move(time));
+		insertIOMap(ioMap.data(), ioMap.size(), std::move(time));
+		signalNewData();
 	}
 
 } // namespace etherkitten::reader
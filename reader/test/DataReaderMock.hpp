@@ -42,6 +42,9 @@ namespace etherkitten::reader
 		// Feed data in for tests
 		void feedRegister(datatypes::Register reg, datatypes::TimeStamp time, uint64_t value);
 
+		// Feed the values of all CycleStatistics for one cycle
+		void feedCycleMeasurement(const CycleMeasurement& measurement, datatypes::TimeStamp time);
+
 		/*!
 		 * \brief Registers a pdo object for the IOMap.
 		 * That is needed before feedPDOData() is called.
@@ -61,6 +64,9 @@ namespace etherkitten::reader
 
 		void setSlaveInfo(size_t i, datatypes::SlaveInfo slaveInfo);
 
+		// Free memory like the BusReader does after inserting data
+		using SearchListReader::freeMemoryIfNecessary;
+
 		SlaveInformantMock slaveInformant;
 
 	private:
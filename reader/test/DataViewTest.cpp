@@ -17,9 +17,16 @@
 
 #include <catch2/catch.hpp>
 
+#include <array>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include "etherkitten/reader/DataView.hpp"
 #include <etherkitten/datatypes/time.hpp>
 #include <etherkitten/reader/LLNode.hpp>
+#include <etherkitten/reader/SearchList.hpp>
 
 // clazy:excludeall=non-pod-global-static
 
@@ -122,3 +129,120 @@ SCENARIO("A DataView<int> behaves like an iterator over a linked list")
 		}
 	}
 }
+
+SCENARIO("A DataView reads batches of values like it steps over them one at a time")
+{
+	GIVEN("A SearchList<int> with values spread over several nodes")
+	{
+		SearchList<int, 7> searchList; // NOLINT
+		auto emptyView = searchList.getView({ ekdatatypes::TimeStamp(), 0s }, false);
+		ekdatatypes::TimeStamp startTime = ekdatatypes::now();
+		for (int i = 0; i < 100; ++i) // NOLINT
+		{
+			searchList.append(i, startTime + ekdatatypes::TimeStep(i * 10 + (i % 4))); // NOLINT
+		}
+
+		auto readOneByOne = [](ekdatatypes::AbstractDataView& view) {
+			std::vector<std::pair<double, ekdatatypes::TimeStamp>> read;
+			while (view.hasNext())
+			{
+				++view;
+				read.emplace_back(view.asDouble(), view.getTime());
+			}
+			return read;
+		};
+		auto readInBatches = [](ekdatatypes::AbstractDataView& view) {
+			std::vector<std::pair<double, ekdatatypes::TimeStamp>> read;
+			std::array<double, 9> values; // NOLINT
+			std::array<ekdatatypes::TimeStamp, 9> times; // NOLINT
+			size_t count = 0;
+			while ((count = view.readBatch(values.data(), times.data(), values.size())) > 0)
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					read.emplace_back(values[i], times[i]);
+				}
+			}
+			return read;
+		};
+
+		WHEN("I read a DataView without a step in batches")
+		{
+			auto oneByOne = searchList.getView({ startTime, 0s }, false);
+			auto batched = searchList.getView({ startTime, 0s }, false);
+
+			THEN("I get every value and end up on the newest one")
+			{
+				auto expected = readOneByOne(*oneByOne);
+				REQUIRE(expected.size() == 99); // NOLINT
+				REQUIRE(readInBatches(*batched) == expected);
+				REQUIRE(batched->getTime() == oneByOne->getTime());
+			}
+		}
+
+		WHEN("I read a DataView with a step in batches")
+		{
+			auto oneByOne = searchList.getView({ startTime, ekdatatypes::TimeStep(25) }, false);
+			auto batched = searchList.getView({ startTime, ekdatatypes::TimeStep(25) }, false);
+
+			THEN("I get the same values as when stepping")
+			{
+				auto expected = readOneByOne(*oneByOne);
+				REQUIRE(readInBatches(*batched) == expected);
+				REQUIRE(batched->getTime() == oneByOne->getTime());
+			}
+		}
+
+		WHEN("I read a DataView that was created before the list had values in batches")
+		{
+			THEN("The batch starts with the oldest value")
+			{
+				auto read = readInBatches(*emptyView);
+				REQUIRE(read.size() == 100); // NOLINT
+				REQUIRE(read.front().first == 0);
+				REQUIRE(read.front().second == startTime);
+			}
+		}
+	}
+}
+
+SCENARIO("A DataView's TimeStamp can be read from another thread while it is advanced")
+{
+	GIVEN("A DataView over a SearchList with many values")
+	{
+		SearchList<int, 100> searchList; // NOLINT
+		ekdatatypes::TimeStamp startTime = ekdatatypes::now();
+		for (int i = 0; i < 100000; ++i) // NOLINT
+		{
+			searchList.append(i, startTime + ekdatatypes::TimeStep(i));
+		}
+		auto view = searchList.getView({ startTime, 0s }, false);
+
+		WHEN("I advance it while another thread reads its TimeStamp")
+		{
+			std::atomic_bool done = false;
+			bool monotonic = true;
+			std::thread reader([&view, &done, &monotonic, startTime]() {
+				ekdatatypes::TimeStamp last = startTime;
+				while (!done)
+				{
+					ekdatatypes::TimeStamp time = view->getTime();
+					monotonic &= time >= last;
+					last = time;
+				}
+			});
+			while (view->hasNext())
+			{
+				++(*view);
+			}
+			done = true;
+			reader.join();
+
+			THEN("The other thread only ever sees the DataView move forward")
+			{
+				REQUIRE(monotonic);
+				REQUIRE(view->getTime() == startTime + ekdatatypes::TimeStep(99999)); // NOLINT
+			}
+		}
+	}
+}
@@ -155,7 +155,25 @@ public:
 		    .getView({ {}, {} }, false);
 	}
 
-	std::shared_ptr<DataView<std::unique_ptr<IOMap>, nodeSize, IOMap*>> getIOMapView(
+	std::unique_ptr<ekdatatypes::AbstractNewestValueView> getNewest(
+	    const ekdatatypes::CycleStatistic& /*statistic*/) override
+	{
+		return nullptr;
+	}
+
+	std::shared_ptr<ekdatatypes::AbstractDataView> getView(
+	    const ekdatatypes::CycleStatistic& /*statistic*/,
+	    ekdatatypes::TimeSeries /*time*/) override
+	{
+		return nullptr;
+	}
+
+	const CycleHistogram& getCycleHistogram(ekdatatypes::CycleStatisticType /*type*/) override
+	{
+		return cycleHistogram;
+	}
+
+	std::shared_ptr<DataView<IOMapSlab, nodeSize, IOMap*>> getIOMapView(
 	    ekdatatypes::TimeStamp /*startTime*/) override
 	{
 		return nullptr;
@@ -196,6 +214,7 @@ public:
 private:
 	std::unordered_map<ekdatatypes::RegisterEnum, std::vector<SearchList<uint8_t, nodeSize>>>
 	    registerMaps;
+	CycleHistogram cycleHistogram;
 };
 
 SCENARIO("ErrorStatistician can report error statistics", "[ErrorStatistician]")
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <etherkitten/reader/EventSignal.hpp>
+
+#include <chrono>
+#include <thread>
+
+#include "ThreadContainer.hpp"
+
+using namespace etherkitten::reader;
+using namespace std::chrono_literals;
+
+SCENARIO("The EventSignal wakes a waiting thread", "[EventSignal]")
+{
+	GIVEN("An EventSignal")
+	{
+		EventSignal signal;
+		uint32_t seen = signal.getSequence();
+
+		WHEN("I wait on it without anyone signaling it")
+		{
+			auto start = std::chrono::steady_clock::now();
+			uint32_t sequence = signal.waitFor(seen, 20ms);
+
+			THEN("The wait ends after the timeout without a new sequence number")
+			{
+				REQUIRE(std::chrono::steady_clock::now() - start >= 15ms);
+				REQUIRE(sequence == seen);
+			}
+		}
+
+		WHEN("It has been signaled since I last looked at it")
+		{
+			signal.signal();
+
+			THEN("The wait returns right away with a new sequence number")
+			{
+				auto start = std::chrono::steady_clock::now();
+				REQUIRE(signal.waitFor(seen, 10s) != seen);
+				REQUIRE(std::chrono::steady_clock::now() - start < 1s);
+			}
+		}
+
+		WHEN("Another thread signals it while I wait")
+		{
+			ThreadContainer<EventSignal*> t(
+			    [](EventSignal* toSignal) {
+				    std::this_thread::sleep_for(5ms);
+				    toSignal->signal();
+			    },
+			    &signal);
+
+			THEN("The wait ends long before the timeout")
+			{
+				auto start = std::chrono::steady_clock::now();
+				uint32_t sequence = seen;
+				while (sequence == seen && std::chrono::steady_clock::now() - start < 10s)
+				{
+					sequence = signal.waitFor(seen, 10s);
+				}
+				REQUIRE(sequence != seen);
+				REQUIRE(std::chrono::steady_clock::now() - start < 1s);
+			}
+		}
+	}
+}
@@ -0,0 +1,356 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include <etherkitten/datatypes/dataobjects.hpp>
+#include <etherkitten/datatypes/errors.hpp>
+#include <etherkitten/datatypes/register.hpp>
+#include <etherkitten/reader/LogCache.hpp>
+#include <etherkitten/reader/LogChunkCache.hpp>
+#include <etherkitten/reader/LogReader.hpp>
+#include <etherkitten/reader/LogSlaveInformant.hpp>
+#include <etherkitten/reader/MappedFile.hpp>
+#include <etherkitten/reader/ParallelChunkDecoder.hpp>
+#include <etherkitten/reader/logger.hpp>
+
+#include "DataReaderMock.hpp"
+#include "LogTestHelpers.hpp"
+#include "SlaveInformantMock.hpp"
+
+using namespace etherkitten::reader;
+using namespace etherkitten::datatypes;
+
+namespace
+{
+	ChunkIndexBlock readIndex(const std::filesystem::path& path)
+	{
+		SlaveInformantMock si{ 0, 0 };
+		LogBusInfo bi;
+		ParsingContext pc(si, bi);
+		std::ifstream fin(path, std::ios::in | std::ios::binary);
+		Serialized headerSer(48);
+		fin.read(headerSer.data, 48);
+		LogHeaderBlock header = LogHeaderBlock::serializer.parseSerialized(headerSer, pc);
+		uint64_t length = std::filesystem::file_size(path) - header.indexOffset;
+		Serialized indexSer(length);
+		fin.seekg(header.indexOffset);
+		fin.read(indexSer.data, length);
+		return ChunkIndexBlock::serializer.parseSerialized(indexSer, pc);
+	}
+} // namespace
+
+SCENARIO("A log can be read from a window of decoded chunks", "[LogReader]")
+{
+	GIVEN("A log in small chunks with process data, register data and an error")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 1, 3 } };
+		PDO pdo1 = PDO(1, "PDO1", EtherCATDataTypeEnum::INTEGER16, 0, PDODirection::INPUT);
+		PDO pdo2 = PDO(1, "PDO2", EtherCATDataTypeEnum::UNSIGNED8, 1, PDODirection::INPUT);
+		reader.slaveInformant.feedSlaveInfo(1,
+		    SlaveInfo(1, "Slave1", std::vector<PDO>{ pdo1, pdo2 }, {}, ESIData{}, {},
+		        std::array<unsigned int, 4>{ 0, 0, 0, 0 }));
+		Register reg = Register(1, RegisterEnum::BUILD);
+		Register bitReg = Register(1, RegisterEnum::LINK_STATUS_PORT_0);
+		reader.appendPDOToIOMap(pdo1);
+		reader.appendPDOToIOMap(pdo2);
+		for (uint64_t i = 0; i < 200; ++i)
+		{
+			reader.feedPDOData({ { pdo1, 1000 - 7 * i }, { pdo2, i % 256 } },
+			    at(1000 * (i + 1)));
+			reader.feedRegister(reg, at(1000 * (i + 1) + 500), 3 * i);
+			reader.feedRegister(
+			    Register(1, RegisterEnum::DLS_USER_OPERATIONAL), at(1000 * (i + 1) + 500), i);
+		}
+		LogCache errorCache;
+		errorCache.postError(ErrorMessage("Something broke", ErrorSeverity::MEDIUM),
+		    at(100500));
+		{
+			Logger logger{ reader.slaveInformant, reader, errorCache.getErrors(),
+				"Windowlog.ekl" };
+			logger.setChunkSize(256);
+			logger.startLog(intToTimeStamp(0));
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+			logger.stopLog();
+		}
+
+		LogCache completeCache;
+		LogSlaveInformant completeInformant{ "Windowlog.ekl" };
+		LogReader complete{ "Windowlog.ekl", completeInformant, completeCache };
+		LogCache windowedCache;
+		LogSlaveInformant windowedInformant{ "Windowlog.ekl" };
+		LogReader windowed{ "Windowlog.ekl", windowedInformant, windowedCache,
+			[](int, std::string) {}, LogLoading::WINDOWED };
+		std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+		THEN("Only the LogReader that was asked to loads the log windowed")
+		{
+			REQUIRE(complete.getLoading() == LogLoading::COMPLETE);
+			REQUIRE(windowed.getLoading() == LogLoading::WINDOWED);
+		}
+
+		THEN("Both LogReaders return the same values")
+		{
+			for (TimeStep step : { TimeStep(0), TimeStep(std::chrono::microseconds(7)),
+			         TimeStep(std::chrono::microseconds(40)) })
+			{
+				for (TimeStamp start : { at(0), at(57300) })
+				{
+					auto pdoValues = readAllValues(*windowed.getView(pdo1, { start, step }));
+					REQUIRE(pdoValues == readAllValues(*complete.getView(pdo1, { start, step })));
+					REQUIRE(readAllValues(*windowed.getView(pdo2, { start, step }))
+					    == readAllValues(*complete.getView(pdo2, { start, step })));
+					REQUIRE(readAllValues(*windowed.getView(reg, { start, step }))
+					    == readAllValues(*complete.getView(reg, { start, step })));
+					REQUIRE(readAllValues(*windowed.getView(bitReg, { start, step }))
+					    == readAllValues(*complete.getView(bitReg, { start, step })));
+				}
+			}
+			auto pdoValues = readAllValues(*windowed.getView(pdo1, { at(0), 0s }));
+			REQUIRE(pdoValues.size() == 200);
+			REQUIRE(pdoValues.back().first == 1000 - 7 * 199);
+		}
+
+		THEN("A view starts at the first value after its start time")
+		{
+			auto view = windowed.getView(reg, { at(57300), 0s });
+			REQUIRE(view->getTime() == at(57500));
+			REQUIRE(view->asDouble() == 3 * 56);
+			auto late = windowed.getView(reg, { at(1000000), 0s });
+			REQUIRE(late->getTime() == at(200500));
+			REQUIRE_FALSE(late->hasNext());
+		}
+
+		THEN("The NewestValueViews point to the last values")
+		{
+			auto newest = windowed.getNewest(reg);
+			REQUIRE_FALSE(newest->isEmpty());
+			REQUIRE((**newest).asString(NumberFormat::DECIMAL) == "597");
+			REQUIRE((**newest).getTime() == at(200500));
+			auto newestPDO = windowed.getNewest(pdo1);
+			REQUIRE((**newestPDO).getTime() == at(200000));
+		}
+
+		THEN("The raw register values can be read")
+		{
+			auto raw = readAllValues(*windowed.getRegisterRawDataView(
+			    1, static_cast<uint16_t>(RegisterEnum::BUILD), { at(0), 0s }));
+			REQUIRE(raw.size() == 200);
+			REQUIRE(raw[10].first == 30);
+		}
+
+		THEN("The errors are read completely")
+		{
+			auto errors = windowedCache.getErrors();
+			REQUIRE_FALSE(errors->isEmpty());
+			REQUIRE((**errors).getValue().getMessage() == "Something broke");
+			REQUIRE((**errors).getTime() == at(100500));
+		}
+	}
+}
+
+SCENARIO("The LogChunkCache keeps the recently used chunks within its memory limit",
+    "[LogChunkCache]")
+{
+	GIVEN("A log in small chunks and a LogChunkCache for it")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 1, 0 } };
+		reader.slaveInformant.feedSlaveInfo(1,
+		    SlaveInfo(1, "Slave1", {}, {}, ESIData{}, {},
+		        std::array<unsigned int, 4>{ 0, 0, 0, 0 }));
+		Register reg = Register(1, RegisterEnum::BUILD);
+		for (uint64_t i = 0; i < 100; ++i)
+		{
+			reader.feedRegister(reg, intToTimeStamp(1000 * (i + 1)), i);
+		}
+		LogCache errorCache;
+		{
+			Logger logger{ reader.slaveInformant, reader, errorCache.getErrors(),
+				"Cachelog.ekl" };
+			logger.setChunkSize(64);
+			logger.startLog(intToTimeStamp(0));
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+			logger.stopLog();
+		}
+		LogChunkCache cache{ "Cachelog.ekl", readIndex("Cachelog.ekl"), 0 };
+		size_t chunkCount = cache.getIndex().getChunks().size();
+		REQUIRE(chunkCount > 3);
+		uint32_t key = DecodedChunk::getRegisterKey(1, static_cast<uint16_t>(RegisterEnum::BUILD));
+
+		WHEN("All chunks are decoded")
+		{
+			uint64_t values = 0;
+			for (size_t i = 0; i < chunkCount; ++i)
+			{
+				values += cache.getChunk(i)->getRegister(key).values.size();
+			}
+
+			THEN("They contain all values and are all cached")
+			{
+				REQUIRE(values == 100);
+				REQUIRE(cache.getCachedChunkCount() == chunkCount);
+				REQUIRE(cache.getMemoryUsage() > 0);
+			}
+
+			THEN("A cached chunk is handed out again")
+			{
+				REQUIRE(cache.getChunk(1) == cache.getChunk(1));
+			}
+
+			THEN("Lowering the memory limit drops the least recently used chunks")
+			{
+				std::shared_ptr<const DecodedChunk> first = cache.getChunk(0);
+				size_t chunkSize = first->getMemoryUsage();
+				cache.setMaximumMemory(2 * chunkSize);
+				REQUIRE(cache.getCachedChunkCount() <= 2);
+				REQUIRE(cache.getMemoryUsage() <= 2 * chunkSize);
+				REQUIRE(cache.getChunk(0) == first);
+				// A dropped chunk stays valid for whoever still uses it
+				REQUIRE(first->getRegister(key).values.front() == 0);
+			}
+
+			THEN("The most recently used chunk is kept even if it exceeds the limit")
+			{
+				cache.setMaximumMemory(0);
+				REQUIRE(cache.getCachedChunkCount() == 1);
+			}
+		}
+	}
+}
+
+SCENARIO("The chunks of a log are decoded in parallel and handed out in order",
+    "[ParallelChunkDecoder]")
+{
+	GIVEN("A log in small chunks")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 1, 0 } };
+		reader.slaveInformant.feedSlaveInfo(1,
+		    SlaveInfo(1, "Slave1", {}, {}, ESIData{}, {},
+		        std::array<unsigned int, 4>{ 0, 0, 0, 0 }));
+		Register reg = Register(1, RegisterEnum::BUILD);
+		for (uint64_t i = 0; i < 100; ++i)
+		{
+			reader.feedRegister(reg, at(1000 * (i + 1)), i);
+		}
+		LogCache errorCache;
+		{
+			Logger logger{ reader.slaveInformant, reader, errorCache.getErrors(),
+				"Parallellog.ekl" };
+			logger.setChunkSize(64);
+			logger.startLog(intToTimeStamp(0));
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+			logger.stopLog();
+		}
+		ChunkIndexBlock index = readIndex("Parallellog.ekl");
+		MappedFile file{ "Parallellog.ekl" };
+		LogChunkCache cache{ "Parallellog.ekl", readIndex("Parallellog.ekl"), 0 };
+		size_t chunkCount = index.getChunks().size();
+		REQUIRE(chunkCount > 3);
+		uint32_t key = DecodedChunk::getRegisterKey(1, static_cast<uint16_t>(RegisterEnum::BUILD));
+
+		WHEN("The chunks are decoded by one or several workers")
+		{
+			THEN("They are handed out in the order of the index")
+			{
+				for (unsigned int workers : { 1U, 4U })
+				{
+					ParallelChunkDecoder decoder{ file, index, 0, workers };
+					REQUIRE(decoder.getWorkerCount() == workers);
+					for (size_t i = 0; i < chunkCount; ++i)
+					{
+						std::unique_ptr<const DecodedChunk> chunk = decoder.takeNext();
+						REQUIRE(chunk != nullptr);
+						REQUIRE(chunk->getRegister(key).values
+						    == cache.getChunk(i)->getRegister(key).values);
+						REQUIRE(chunk->getRegister(key).times
+						    == cache.getChunk(i)->getRegister(key).times);
+					}
+					REQUIRE_THROWS(decoder.takeNext());
+				}
+			}
+		}
+
+		WHEN("The decoder is destroyed before all chunks were taken")
+		{
+			{
+				ParallelChunkDecoder decoder{ file, index, 0, 4 };
+				decoder.takeNext();
+			}
+
+			THEN("The workers stop") { SUCCEED(); }
+		}
+
+		WHEN("The log is loaded by LogReaders with different numbers of workers")
+		{
+			LogCache singleCache;
+			LogSlaveInformant singleInformant{ "Parallellog.ekl" };
+			LogReader single{ "Parallellog.ekl", singleInformant, singleCache,
+				[](int, std::string) {}, LogLoading::COMPLETE, 1 };
+			LogCache parallelCache;
+			LogSlaveInformant parallelInformant{ "Parallellog.ekl" };
+			std::vector<int> progress;
+			LogReader parallel{ "Parallellog.ekl", parallelInformant, parallelCache,
+				[&progress](int percent, std::string) { progress.push_back(percent); },
+				LogLoading::COMPLETE, 4 };
+			std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+			THEN("They read the same values")
+			{
+				auto values = readAllValues(*parallel.getView(reg, { at(0), 0s }));
+				REQUIRE(values.size() == 100);
+				REQUIRE(values == readAllValues(*single.getView(reg, { at(0), 0s })));
+				REQUIRE(values.back() == std::make_pair(99.0, at(100000)));
+			}
+
+			THEN("The progress is reported in order")
+			{
+				REQUIRE(progress.size() > chunkCount);
+				REQUIRE(std::is_sorted(progress.begin(), progress.end()));
+				REQUIRE(progress.back() == 100);
+			}
+		}
+	}
+}
+
+SCENARIO("A chunk with a register value of an unknown register cannot be decoded",
+    "[LogChunkCache]")
+{
+	GIVEN("A chunk with a register block whose register does not exist")
+	{
+		uint16_t address = 0x7FFF;
+		REQUIRE(registerMap.find(static_cast<RegisterEnum>(address)) == registerMap.end());
+		Serialized data(13);
+		data.write(static_cast<uint32_t>(address << 16 | 1), 0);
+		data.write(static_cast<uint64_t>(600000000), 4);
+		data.write(static_cast<uint8_t>(42), 12);
+
+		WHEN("The chunk is decoded")
+		{
+			THEN("It is rejected as malformed")
+			{
+				REQUIRE_THROWS_AS(DecodedChunk(data, 0), std::runtime_error);
+			}
+		}
+	}
+}
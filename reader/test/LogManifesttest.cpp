@@ -0,0 +1,190 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#include <etherkitten/datatypes/dataobjects.hpp>
+#include <etherkitten/reader/LogCache.hpp>
+#include <etherkitten/reader/LogManifest.hpp>
+#include <etherkitten/reader/LogReader.hpp>
+#include <etherkitten/reader/LogSlaveInformant.hpp>
+#include <etherkitten/reader/log/manifest.hpp>
+#include <etherkitten/reader/logger.hpp>
+
+#include "DataReaderMock.hpp"
+#include "LogTestHelpers.hpp"
+#include "SlaveInformantMock.hpp"
+
+using namespace etherkitten::reader;
+using namespace etherkitten::datatypes;
+using namespace std::chrono_literals;
+
+SCENARIO("ManifestBlocks can be serialized and parsed", "[LogManifest]")
+{
+	GIVEN("A ManifestBlock with two segments")
+	{
+		ManifestBlock manifest{ { { 10, 20, "log-1.ekl" }, { 21, 35, "log-2.ekl" } } };
+
+		WHEN("It is serialized and parsed")
+		{
+			Serialized ser = manifest.getSerializer().serialize(manifest);
+			ManifestBlock parsed = ManifestBlock::parse(ser);
+
+			THEN("It lists the same segments")
+			{
+				REQUIRE(ser.length == manifest.getSerializedSize());
+				REQUIRE(parsed.getSegments().size() == 2);
+				REQUIRE(parsed.getSegments()[0].firstTime == 10);
+				REQUIRE(parsed.getSegments()[0].lastTime == 20);
+				REQUIRE(parsed.getSegments()[0].fileName == "log-1.ekl");
+				REQUIRE(parsed.getSegments()[1].firstTime == 21);
+				REQUIRE(parsed.getSegments()[1].lastTime == 35);
+				REQUIRE(parsed.getSegments()[1].fileName == "log-2.ekl");
+			}
+		}
+
+		WHEN("It is cut short")
+		{
+			Serialized ser = manifest.getSerializer().serialize(manifest);
+			Serialized part = ser.getAt(0, ser.length - 3);
+
+			THEN("It cannot be parsed")
+			{
+				REQUIRE_THROWS_AS(ManifestBlock::parse(part), std::runtime_error);
+			}
+		}
+
+		WHEN("It is written to a file")
+		{
+			REQUIRE(LogManifest::write("Manifest.ekl", manifest));
+
+			THEN("The file is a manifest that lists the segments next to it")
+			{
+				REQUIRE(LogManifest::isManifest("Manifest.ekl"));
+				REQUIRE(LogManifest::read("Manifest.ekl").getSegments().size() == 2);
+				auto files = LogManifest::getLogFiles("Manifest.ekl");
+				REQUIRE(files.size() == 2);
+				REQUIRE(files[1] == std::filesystem::path("log-2.ekl"));
+				REQUIRE_FALSE(std::filesystem::exists("Manifest.ekl.tmp"));
+			}
+		}
+	}
+}
+
+SCENARIO("A rotating Logger splits its log into segments that are read as one log",
+    "[LogManifest]")
+{
+	GIVEN("A Reader with 200ms of process data and registers")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 1, 2 } };
+		PDO pdo = PDO(1, "PDO", EtherCATDataTypeEnum::INTEGER16, 0, PDODirection::INPUT);
+		reader.slaveInformant.feedSlaveInfo(1,
+		    SlaveInfo(1, "Slave1", std::vector<PDO>{ pdo }, {}, ESIData{}, {},
+		        std::array<unsigned int, 4>{ 0, 0, 0, 0 }));
+		reader.appendPDOToIOMap(pdo);
+		Register reg = Register(1, RegisterEnum::BUILD);
+		for (uint64_t i = 0; i < 400; ++i)
+		{
+			reader.feedPDOData({ { pdo, i } }, at(500 * (i + 1)));
+			if (i % 2 == 0)
+				reader.feedRegister(reg, at(500 * i + 1500), i / 2);
+		}
+		LogCache errorCache;
+		Logger logger{ reader.slaveInformant, reader, errorCache.getErrors(),
+			"Rotatedlog.ekl" };
+		logger.setChunkSize(128);
+		logger.setEncodeChunks(true);
+
+		WHEN("The Logger rotates by duration")
+		{
+			logger.setRotation(0, 20ms);
+			logger.startLog(at(0));
+			std::this_thread::sleep_for(500ms);
+			logger.stopLog();
+
+			THEN("The manifest lists segments of about that duration in order")
+			{
+				REQUIRE(LogManifest::isManifest("Rotatedlog.ekl"));
+				auto segments = LogManifest::read("Rotatedlog.ekl").getSegments();
+				REQUIRE(segments.size() >= 5);
+				REQUIRE(segments[0].fileName == logger.getSegmentPath(1).filename().string());
+				for (size_t i = 0; i < segments.size(); ++i)
+				{
+					REQUIRE(std::filesystem::exists(logger.getSegmentPath(i + 1)));
+					REQUIRE(segments[i].firstTime <= segments[i].lastTime);
+					// A segment is finished by the chunk that reaches the duration
+					REQUIRE(segments[i].lastTime - segments[i].firstTime < 40000);
+				}
+				REQUIRE(segments.front().firstTime == timeStampToInt(at(500)));
+				REQUIRE(segments.back().lastTime == timeStampToInt(at(200500)));
+			}
+
+			THEN("The slaves of the log are read from its first segment")
+			{
+				LogSlaveInformant informant{ "Rotatedlog.ekl" };
+				REQUIRE(informant.getSlaveCount() == 1);
+				REQUIRE(informant.getSlaveInfo(1).getName() == "Slave1");
+			}
+
+			THEN("All data of the segments is read from the manifest")
+			{
+				for (LogLoading loading : { LogLoading::COMPLETE, LogLoading::WINDOWED })
+				{
+					auto values = readRegister("Rotatedlog.ekl", reg, loading);
+					REQUIRE(values.size() == 200);
+					for (uint64_t i = 0; i < values.size(); ++i)
+					{
+						REQUIRE(values[i].first == i);
+						REQUIRE(values[i].second == at(1000 * i + 1500));
+					}
+				}
+			}
+		}
+
+		WHEN("The Logger rotates by size")
+		{
+			logger.setRotation(1000, 0s);
+			logger.startLog(at(0));
+			std::this_thread::sleep_for(500ms);
+			logger.stopLog();
+
+			THEN("The segments are a little larger than the size and hold all data")
+			{
+				auto segments = LogManifest::read("Rotatedlog.ekl").getSegments();
+				REQUIRE(segments.size() >= 2);
+				for (size_t i = 0; i + 1 < segments.size(); ++i)
+				{
+					REQUIRE(std::filesystem::file_size(logger.getSegmentPath(i + 1)) >= 1000);
+				}
+				REQUIRE(readRegister("Rotatedlog.ekl", reg, LogLoading::WINDOWED).size() == 200);
+			}
+		}
+
+		WHEN("The segment duration is negative")
+		{
+			THEN("The rotation is not changed")
+			{
+				REQUIRE_THROWS_AS(logger.setRotation(0, -1ms), std::invalid_argument);
+			}
+		}
+	}
+}
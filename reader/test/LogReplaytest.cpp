@@ -0,0 +1,259 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <thread>
+
+#include <etherkitten/datatypes/dataobjects.hpp>
+#include <etherkitten/reader/LogCache.hpp>
+#include <etherkitten/reader/LogReader.hpp>
+#include <etherkitten/reader/LogSlaveInformant.hpp>
+#include <etherkitten/reader/ReplayClock.hpp>
+#include <etherkitten/reader/logger.hpp>
+
+#include "DataReaderMock.hpp"
+#include "LogTestHelpers.hpp"
+#include "SlaveInformantMock.hpp"
+
+using namespace etherkitten::reader;
+using namespace etherkitten::datatypes;
+using namespace std::chrono_literals;
+
+namespace
+{
+	size_t countValues(LogReader& reader, const Register& reg)
+	{
+		auto view = reader.getView(reg, { at(0), 0s });
+		if (view->isEmpty())
+			return 0;
+		size_t count = 1;
+		while (view->hasNext())
+		{
+			++(*view);
+			++count;
+		}
+		return count;
+	}
+
+	/*!
+	 * \brief Wait until a register has a number of values or a generous timeout passed.
+	 * \param reader the LogReader to count the values in
+	 * \param reg the register
+	 * \param count the number of values to wait for
+	 * \return the number of values of the register
+	 */
+	size_t waitForValues(LogReader& reader, const Register& reg, size_t count)
+	{
+		auto deadline = std::chrono::steady_clock::now() + 10s;
+		size_t values = countValues(reader, reg);
+		while (values < count && std::chrono::steady_clock::now() < deadline)
+		{
+			std::this_thread::sleep_for(5ms);
+			values = countValues(reader, reg);
+		}
+		return values;
+	}
+
+	template<typename F>
+	std::chrono::steady_clock::duration timeOf(F&& f)
+	{
+		auto start = std::chrono::steady_clock::now();
+		f();
+		return std::chrono::steady_clock::now() - start;
+	}
+} // namespace
+
+SCENARIO("A ReplayClock paces data against its TimeStamps", "[LogReader]")
+{
+	GIVEN("A ReplayClock that has started")
+	{
+		ReplayClock clock;
+		REQUIRE(clock.waitUntil(at(0)));
+
+		WHEN("It runs at the recorded pace")
+		{
+			THEN("Data is due after the time between the TimeStamps")
+			{
+				auto waited = timeOf([&]() { REQUIRE(clock.waitUntil(at(50000))); });
+				REQUIRE(waited >= 49ms);
+				REQUIRE(clock.getTime() >= at(50000));
+			}
+		}
+
+		WHEN("It runs ten times as fast")
+		{
+			clock.setSpeed(10);
+
+			THEN("Data is due after a tenth of the time")
+			{
+				auto waited = timeOf([&]() { REQUIRE(clock.waitUntil(at(100000))); });
+				REQUIRE(waited >= 9ms);
+				// However long the wait took, the clock ran ten times as far
+				REQUIRE(clock.getTime()
+				    >= at(0) + std::chrono::duration_cast<TimeStep>(9 * waited));
+			}
+		}
+
+		WHEN("It runs as fast as possible")
+		{
+			clock.setSpeed(ReplayClock::fastest);
+
+			THEN("All data is due at once")
+			{
+				auto waited = timeOf([&]() { REQUIRE(clock.waitUntil(at(100000000))); });
+				// At the recorded pace, this would take 100s
+				REQUIRE(waited < 1s);
+				REQUIRE(clock.getTime() == at(100000000));
+			}
+		}
+
+		WHEN("It is paused")
+		{
+			clock.pause();
+			TimeStamp paused = clock.getTime();
+			std::this_thread::sleep_for(20ms);
+
+			THEN("It stands still until it is resumed")
+			{
+				REQUIRE(clock.isPaused());
+				REQUIRE(clock.getTime() == paused);
+				std::thread resumer([&]() {
+					std::this_thread::sleep_for(30ms);
+					clock.resume();
+				});
+				auto waited = timeOf([&]() { REQUIRE(clock.waitUntil(paused)); });
+				resumer.join();
+				REQUIRE(waited >= 25ms);
+				REQUIRE_FALSE(clock.isPaused());
+			}
+
+			THEN("Stopping it wakes the waiting thread")
+			{
+				std::thread stopper([&]() {
+					std::this_thread::sleep_for(10ms);
+					clock.stop();
+				});
+				REQUIRE_FALSE(clock.waitUntil(paused));
+				stopper.join();
+			}
+		}
+
+		WHEN("It is moved")
+		{
+			THEN("It can only be moved forward")
+			{
+				clock.seek(at(100000000));
+				REQUIRE(clock.getTime() >= at(100000000));
+				// Without moving the clock, this would take 99s
+				auto waited = timeOf([&]() { REQUIRE(clock.waitUntil(at(99000000))); });
+				REQUIRE(waited < 1s);
+				REQUIRE_THROWS_AS(clock.seek(at(50000000)), std::invalid_argument);
+			}
+		}
+
+		WHEN("Its speed is not positive")
+		{
+			THEN("The speed is not changed")
+			{
+				REQUIRE_THROWS_AS(clock.setSpeed(0), std::invalid_argument);
+				REQUIRE_THROWS_AS(clock.setSpeed(-1), std::invalid_argument);
+				REQUIRE(clock.getSpeed() == 1);
+			}
+		}
+	}
+}
+
+SCENARIO("A LogReader replays a log at the pace it was recorded at", "[LogReader]")
+{
+	GIVEN("A log with 400ms of registers")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 1, 2 } };
+		PDO pdo = PDO(1, "PDO", EtherCATDataTypeEnum::INTEGER16, 0, PDODirection::INPUT);
+		reader.slaveInformant.feedSlaveInfo(1,
+		    SlaveInfo(1, "Slave1", std::vector<PDO>{ pdo }, {}, ESIData{}, {},
+		        std::array<unsigned int, 4>{ 0, 0, 0, 0 }));
+		reader.appendPDOToIOMap(pdo);
+		Register reg = Register(1, RegisterEnum::BUILD);
+		for (uint64_t i = 0; i < 200; ++i)
+		{
+			reader.feedPDOData({ { pdo, i } }, at(2000 * i + 1000));
+			reader.feedRegister(reg, at(2000 * i + 1000), i);
+		}
+		{
+			LogCache errorCache;
+			Logger logger{ reader.slaveInformant, reader, errorCache.getErrors(),
+				"Replaylog.ekl" };
+			logger.setChunkSize(256);
+			logger.setEncodeChunks(true);
+			logger.startLog(at(0));
+			std::this_thread::sleep_for(300ms);
+			logger.stopLog();
+		}
+
+		LogCache cache;
+		LogSlaveInformant informant{ "Replaylog.ekl" };
+		auto replayStart = std::chrono::steady_clock::now();
+		LogReader replay{ "Replaylog.ekl", informant, cache, [](int, std::string) {},
+			LogLoading::REPLAY };
+		REQUIRE(replay.getLoading() == LogLoading::REPLAY);
+
+		WHEN("It is replayed at the recorded pace")
+		{
+			size_t values = waitForValues(replay, reg, 200);
+			auto replayed = std::chrono::steady_clock::now() - replayStart;
+
+			THEN("The data is inserted over the time it was recorded in")
+			{
+				REQUIRE(values == 200);
+				// The first and the last value were recorded 398ms apart
+				REQUIRE(replayed >= 390ms);
+			}
+		}
+
+		WHEN("It is paused and moved to its end")
+		{
+			// At this speed, the log takes 40s to replay
+			replay.getReplayClock().setSpeed(0.01);
+			std::this_thread::sleep_for(50ms);
+			replay.getReplayClock().pause();
+			size_t paused = countValues(replay, reg);
+			std::this_thread::sleep_for(100ms);
+			REQUIRE(countValues(replay, reg) == paused);
+			replay.getReplayClock().seek(at(400000));
+			replay.getReplayClock().resume();
+
+			THEN("All data up to there is inserted at once")
+			{
+				REQUIRE(paused < 200);
+				REQUIRE(waitForValues(replay, reg, 200) == 200);
+			}
+		}
+
+		WHEN("It is loaded without replaying")
+		{
+			LogCache completeCache;
+			LogReader complete{ "Replaylog.ekl", informant, completeCache };
+
+			THEN("There is no ReplayClock")
+			{
+				REQUIRE_THROWS_AS(complete.getReplayClock(), std::logic_error);
+			}
+		}
+	}
+}
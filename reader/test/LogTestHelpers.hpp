@@ -0,0 +1,99 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <etherkitten/datatypes/dataobjects.hpp>
+#include <etherkitten/datatypes/dataviews.hpp>
+#include <etherkitten/datatypes/time.hpp>
+#include <etherkitten/reader/LogCache.hpp>
+#include <etherkitten/reader/LogReader.hpp>
+#include <etherkitten/reader/LogSlaveInformant.hpp>
+
+namespace etherkitten::reader
+{
+	/*!
+	 * \brief Get a TimeStamp ten minutes after the epoch.
+	 *
+	 * The minute index of a SearchList does not handle values from the first minute,
+	 * so logs written at these TimeStamps can be read back like any other.
+	 */
+	inline datatypes::TimeStamp at(uint64_t micros)
+	{
+		return datatypes::intToTimeStamp(600000000 + micros);
+	}
+
+	/*!
+	 * \brief Step over all values of a view.
+	 * \param view the view, which is left at its last value
+	 * \return the values and their TimeStamps
+	 */
+	inline std::vector<std::pair<double, datatypes::TimeStamp>> readAllValues(
+	    datatypes::AbstractDataView& view)
+	{
+		std::vector<std::pair<double, datatypes::TimeStamp>> values;
+		if (view.isEmpty())
+			return values;
+		values.emplace_back(view.asDouble(), view.getTime());
+		while (view.hasNext())
+		{
+			++view;
+			values.emplace_back(view.asDouble(), view.getTime());
+		}
+		return values;
+	}
+
+	/*!
+	 * \brief Read all values of a register from a log.
+	 *
+	 * Gives the LogReader some time to load the log first.
+	 * \param path the log file
+	 * \param reg the register to read
+	 * \param loading how the LogReader loads the log
+	 * \return the raw values of the register and their TimeStamps
+	 */
+	inline std::vector<std::pair<uint64_t, datatypes::TimeStamp>> readRegister(
+	    const std::filesystem::path& path, const datatypes::Register& reg,
+	    LogLoading loading = LogLoading::COMPLETE)
+	{
+		LogCache cache;
+		LogSlaveInformant informant{ path };
+		LogReader reader{ path, informant, cache, [](int, std::string) {}, loading };
+		std::this_thread::sleep_for(std::chrono::milliseconds(200));
+		REQUIRE(reader.getLoading() == loading);
+		std::vector<std::pair<uint64_t, datatypes::TimeStamp>> values;
+		auto view = reader.getView(reg, { at(0), std::chrono::seconds(0) });
+		if (view->isEmpty())
+			return values;
+		values.emplace_back(static_cast<uint64_t>(view->asDouble()), view->getTime());
+		while (view->hasNext())
+		{
+			++(*view);
+			values.emplace_back(static_cast<uint64_t>(view->asDouble()), view->getTime());
+		}
+		return values;
+	}
+} // namespace etherkitten::reader
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <etherkitten/reader/LogWriter.hpp>
+
+#include "DataReaderMock.hpp"
+#include "SlaveInformantMock.hpp"
+
+using namespace etherkitten::reader;
+using namespace etherkitten::datatypes;
+using namespace std::chrono_literals;
+
+namespace
+{
+	std::string readFile(const std::filesystem::path& path)
+	{
+		std::ifstream fin(path, std::ios::in | std::ios::binary);
+		return std::string(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+	}
+} // namespace
+
+SCENARIO("The LogWriter writes data from its own thread", "[LogWriter]")
+{
+	GIVEN("A LogWriter with small buffers")
+	{
+		std::filesystem::path path = "LogWriterlog.ekl";
+		LogWriter writer{ path, 16, 2 };
+		std::string data = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+		WHEN("I write more data than fits into all buffers")
+		{
+			writer.write(data.data(), data.size());
+			writer.flush();
+
+			THEN("The file contains all the data")
+			{
+				REQUIRE(writer.getPosition() == data.size());
+				REQUIRE(readFile(path) == data);
+				REQUIRE_FALSE(writer.hasFailed());
+			}
+		}
+
+		WHEN("I patch values that are already written and values that are still buffered")
+		{
+			writer.write(data.data(), data.size());
+			writer.writeAt(8, 0x3837363534333231);
+			writer.writeAt(data.size() - 8, 0x3837363534333231);
+			writer.flush();
+
+			THEN("The file contains the patched values")
+			{
+				std::string expected = data;
+				std::memcpy(expected.data() + 8, "12345678", 8);
+				std::memcpy(expected.data() + data.size() - 8, "12345678", 8);
+				REQUIRE(readFile(path) == expected);
+				REQUIRE(writer.getPosition() == data.size());
+			}
+		}
+
+		WHEN("I write less data than fits into a buffer and let it wait")
+		{
+			writer.write(data.data(), 4);
+			writer.handOverOlderThan(1h);
+			std::this_thread::sleep_for(10ms);
+
+			THEN("The data is only written once it has waited for long enough")
+			{
+				REQUIRE(readFile(path).empty());
+				writer.handOverOlderThan(0s);
+				std::this_thread::sleep_for(50ms);
+				REQUIRE(readFile(path) == data.substr(0, 4));
+			}
+		}
+	}
+
+	GIVEN("A LogWriter that is destroyed without being flushed")
+	{
+		std::filesystem::path path = "LogWriterlog.ekl";
+		std::string data = "0123456789";
+		{
+			LogWriter writer{ path, 16, 2 };
+			writer.write(data.data(), data.size());
+		}
+
+		THEN("The file contains all the data")
+		{
+			REQUIRE(readFile(path) == data);
+		}
+	}
+
+	GIVEN("A path in a directory that does not exist")
+	{
+		std::filesystem::path path = "does/not/exist.ekl";
+
+		THEN("The LogWriter reports a failure instead of throwing")
+		{
+			LogWriter writer{ path };
+			writer.write("data", 4);
+			writer.flush();
+			REQUIRE(writer.hasFailed());
+		}
+	}
+
+	GIVEN("Fewer than two buffers")
+	{
+		THEN("The LogWriter cannot be created")
+		{
+			REQUIRE_THROWS_AS(LogWriter("LogWriterlog.ekl", 16, 1), std::invalid_argument);
+			REQUIRE_THROWS_AS(LogWriter("LogWriterlog.ekl", 0, 2), std::invalid_argument);
+		}
+	}
+}
+
+SCENARIO("A SearchListReader wakes a thread that waits for new data", "[LogWriter]")
+{
+	GIVEN("A reader with a thread waiting for new data")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 1, 0 } };
+		uint32_t seen = reader.waitForNewData(0, 0ms);
+
+		WHEN("Data is inserted")
+		{
+			std::thread feeder([&reader]() {
+				std::this_thread::sleep_for(20ms);
+				reader.feedRegister(Register{ 1, RegisterEnum::CONFIGURED_STATION_ADDRESS },
+				    intToTimeStamp(600000000), 1);
+			});
+			auto start = std::chrono::steady_clock::now();
+			uint32_t next = reader.waitForNewData(seen, 10s);
+			feeder.join();
+
+			THEN("The waiting thread wakes up long before the timeout")
+			{
+				REQUIRE(next != seen);
+				REQUIRE(std::chrono::steady_clock::now() - start < 5s);
+			}
+		}
+	}
+}
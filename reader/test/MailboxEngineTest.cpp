@@ -0,0 +1,400 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <etherkitten/reader/MailboxEngine.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <etherkitten/datatypes/time.hpp>
+
+// clazy:excludeall=non-pod-global-static
+
+using namespace etherkitten::reader;
+using namespace std::chrono_literals;
+namespace ekdatatypes = etherkitten::datatypes;
+
+namespace
+{
+	constexpr uint16_t slaveAddress = 0x1001;
+	constexpr uint16_t writeOffset = 0x1000;
+	constexpr uint16_t readOffset = 0x1100;
+	constexpr uint16_t mailboxLength = 64;
+	constexpr size_t pduHeaderSize = sizeof(EtherCATPDU) - 1;
+
+	/*!
+	 * \brief A slave with a CoE SDO server that answers requests after a fixed delay.
+	 */
+	class SimulatedSlave
+	{
+	public:
+		std::map<std::pair<uint16_t, uint8_t>, std::vector<uint8_t>> objects;
+		ekdatatypes::TimeStep responseDelay = 2ms;
+		bool sendEmergencyFirst = false;
+
+		explicit SimulatedSlave(ekdatatypes::TimeStamp& clock)
+		    : clock(clock)
+		{
+		}
+
+		MailboxInfo getMailboxInfo()
+		{
+			return { slaveAddress, writeOffset, mailboxLength, readOffset, mailboxLength,
+				&counter };
+		}
+
+		/*!
+		 * \brief Process a frame with a single PDU like the slave would.
+		 * \return the working counter
+		 */
+		int process(EtherCATFrame& frame)
+		{
+			auto* pdu = reinterpret_cast<EtherCATPDU*>(frame.pduArea); // NOLINT
+			uint8_t* data = frame.pduArea + pduHeaderSize; // NOLINT
+			size_t length = pdu->dataLengthAndNext & 0x7FF;
+			if (pdu->slaveConfiguredAddress != slaveAddress)
+			{
+				return 0;
+			}
+			answerIfReady();
+			if (pdu->commandType == fpwrCommandType && pdu->registerAddress == writeOffset)
+			{
+				if (requestPending)
+				{
+					return 0;
+				}
+				std::memcpy(writeMailbox.data(), data, length);
+				requestPending = true;
+				requestTime = clock;
+				return 1;
+			}
+			if (pdu->commandType != fprdCommandType)
+			{
+				return 0;
+			}
+			switch (pdu->registerAddress)
+			{
+			case 0x805:
+				data[0] = requestPending ? 0x08 : 0x00;
+				return 1;
+			case 0x80D:
+				data[0] = responses.empty() ? 0x00 : 0x08;
+				return 1;
+			case readOffset:
+				if (responses.empty())
+				{
+					return 0;
+				}
+				std::memcpy(data, responses.front().data(), length);
+				responses.erase(responses.begin());
+				return 1;
+			default:
+				return 0;
+			}
+		}
+
+	private:
+		ekdatatypes::TimeStamp& clock;
+		uint8_t counter = 0;
+		std::array<uint8_t, mailboxLength> writeMailbox{};
+		bool requestPending = false;
+		ekdatatypes::TimeStamp requestTime;
+		std::vector<std::vector<uint8_t>> responses;
+		std::vector<uint8_t> segmentedData;
+		size_t segmentedOffset = 0;
+		std::pair<uint16_t, uint8_t> downloadTarget;
+
+		std::vector<uint8_t> makeResponse(uint16_t length, uint16_t service = 3)
+		{
+			std::vector<uint8_t> response(mailboxLength, 0);
+			response[0] = length & 0xFF;
+			response[1] = length >> 8;
+			response[5] = 0x03;
+			response[7] = service << 4;
+			return response;
+		}
+
+		void answerIfReady()
+		{
+			if (!requestPending || clock - requestTime < responseDelay)
+			{
+				return;
+			}
+			requestPending = false;
+			if (sendEmergencyFirst)
+			{
+				responses.push_back(makeResponse(10, 1));
+			}
+			responses.push_back(answer());
+		}
+
+		std::vector<uint8_t> answer()
+		{
+			uint8_t* sdo = writeMailbox.data() + 8;
+			uint8_t command = sdo[0] & 0xE0;
+			std::pair<uint16_t, uint8_t> key{ sdo[1] | (sdo[2] << 8), sdo[3] };
+			std::vector<uint8_t> response = makeResponse(10);
+			uint8_t* responseSDO = response.data() + 8;
+			std::copy(sdo + 1, sdo + 4, responseSDO + 1);
+			if ((command == 0x40 || command == 0x20) && objects.count(key) == 0)
+			{
+				responseSDO[0] = 0x80;
+				responseSDO[6] = 0x02;
+				responseSDO[7] = 0x06;
+				return response;
+			}
+			if (command == 0x40)
+			{
+				const std::vector<uint8_t>& value = objects.at(key);
+				if (value.size() <= 4)
+				{
+					responseSDO[0] = 0x43 | ((4 - value.size()) << 2);
+					std::copy(value.begin(), value.end(), responseSDO + 4);
+					return response;
+				}
+				responseSDO[0] = 0x41;
+				responseSDO[4] = value.size();
+				size_t inFirst = std::min<size_t>(value.size(), mailboxLength - 16);
+				std::copy(value.begin(), value.begin() + inFirst, response.data() + 16);
+				response[0] = 10 + inFirst;
+				segmentedData = value;
+				segmentedOffset = inFirst;
+				return response;
+			}
+			if (command == 0x60)
+			{
+				size_t segmentLength
+				    = std::min<size_t>(segmentedData.size() - segmentedOffset, mailboxLength - 9);
+				bool last = segmentedOffset + segmentLength == segmentedData.size();
+				responseSDO[0] = (sdo[0] & 0x10) | (last ? 0x01 : 0x00);
+				if (segmentLength < 7)
+				{
+					responseSDO[0] |= (7 - segmentLength) << 1;
+				}
+				std::copy(segmentedData.begin() + segmentedOffset,
+				    segmentedData.begin() + segmentedOffset + segmentLength, responseSDO + 1);
+				segmentedOffset += segmentLength;
+				response[0] = 3 + std::max<size_t>(segmentLength, 7);
+				return response;
+			}
+			if (command == 0x20)
+			{
+				downloadTarget = key;
+				if ((sdo[0] & 0x02) != 0)
+				{
+					size_t size = 4 - ((sdo[0] >> 2) & 0x03);
+					objects[key].assign(sdo + 4, sdo + 4 + size);
+				}
+				else
+				{
+					size_t inFirst = (writeMailbox[0] | (writeMailbox[1] << 8)) - 10;
+					objects[key].assign(writeMailbox.data() + 16, writeMailbox.data() + 16 + inFirst);
+				}
+				responseSDO[0] = 0x60;
+				return response;
+			}
+			// Download segment
+			size_t segmentLength = (writeMailbox[0] | (writeMailbox[1] << 8)) - 3;
+			if (segmentLength == 7)
+			{
+				segmentLength -= (sdo[0] >> 1) & 0x07;
+			}
+			objects[downloadTarget].insert(
+			    objects[downloadTarget].end(), sdo + 1, sdo + 1 + segmentLength);
+			responseSDO[0] = 0x20 | (sdo[0] & 0x10);
+			return response;
+		}
+	};
+
+	/*!
+	 * \brief Run a single transfer through a MailboxEngine with one frame per cycle.
+	 * \return the finished job
+	 */
+	MailboxEngine::MailboxJob runTransfer(SimulatedSlave& slave, ekdatatypes::TimeStamp& clock,
+	    uint16_t index, uint8_t subIndex, std::optional<std::vector<uint8_t>> data)
+	{
+		MailboxEngine engine;
+		engine.submit(nullptr,
+		    SDOTransfer(slave.getMailboxInfo(), index, subIndex, std::move(data), 100ms, clock));
+		EtherCATFrame frame;
+		while (engine.hasWork())
+		{
+			clock += 1ms;
+			if (engine.prepareFrame(frame, clock) > 0)
+			{
+				int workingCounter = slave.process(frame);
+				engine.handleReply(frame, workingCounter, clock);
+			}
+		}
+		auto job = engine.takeFinished();
+		REQUIRE(job.has_value());
+		return std::move(*job);
+	}
+} // namespace
+
+SCENARIO("The MailboxEngine reads and writes CoE objects", "[MailboxEngine]")
+{
+	GIVEN("A slave with some CoE objects")
+	{
+		ekdatatypes::TimeStamp clock;
+		SimulatedSlave slave(clock);
+		std::vector<uint8_t> shortValue{ 0x12, 0x34 };
+		std::vector<uint8_t> normalValue{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+		std::vector<uint8_t> longValue(200);
+		for (size_t i = 0; i < longValue.size(); ++i)
+		{
+			longValue[i] = static_cast<uint8_t>(i * 7);
+		}
+		slave.objects[{ 0x1000, 0 }] = shortValue;
+		slave.objects[{ 0x1008, 0 }] = normalValue;
+		slave.objects[{ 0x1009, 0 }] = longValue;
+
+		WHEN("I read objects of different lengths")
+		{
+			auto expedited = runTransfer(slave, clock, 0x1000, 0, {});
+			auto normal = runTransfer(slave, clock, 0x1008, 0, {});
+			auto segmented = runTransfer(slave, clock, 0x1009, 0, {});
+
+			THEN("I get their values")
+			{
+				REQUIRE_FALSE(expedited.transfer.hasFailed());
+				REQUIRE(expedited.transfer.getData() == shortValue);
+				REQUIRE_FALSE(normal.transfer.hasFailed());
+				REQUIRE(normal.transfer.getData() == normalValue);
+				REQUIRE_FALSE(segmented.transfer.hasFailed());
+				REQUIRE(segmented.transfer.getData() == longValue);
+			}
+		}
+
+		WHEN("I write objects of different lengths")
+		{
+			std::vector<uint8_t> newShort{ 0x56 };
+			std::vector<uint8_t> newLong(150, 0xAB);
+			auto expedited = runTransfer(slave, clock, 0x1000, 0, newShort);
+			auto segmented = runTransfer(slave, clock, 0x1009, 0, newLong);
+
+			THEN("The slave has the new values")
+			{
+				REQUIRE_FALSE(expedited.transfer.hasFailed());
+				REQUIRE(slave.objects.at({ 0x1000, 0 }) == newShort);
+				REQUIRE_FALSE(segmented.transfer.hasFailed());
+				REQUIRE(slave.objects.at({ 0x1009, 0 }) == newLong);
+			}
+		}
+
+		WHEN("The slave sends an emergency message before its answer")
+		{
+			slave.sendEmergencyFirst = true;
+			auto job = runTransfer(slave, clock, 0x1000, 0, {});
+
+			THEN("The emergency message is skipped")
+			{
+				REQUIRE_FALSE(job.transfer.hasFailed());
+				REQUIRE(job.transfer.getData() == shortValue);
+			}
+		}
+
+		WHEN("I read an object the slave does not have")
+		{
+			auto job = runTransfer(slave, clock, 0x2000, 1, {});
+
+			THEN("The transfer fails with the abort code")
+			{
+				REQUIRE(job.transfer.hasFailed());
+				REQUIRE(job.transfer.getError().find("06020000") != std::string::npos);
+			}
+		}
+
+		WHEN("The slave does not answer in time")
+		{
+			slave.responseDelay = 1s;
+			auto job = runTransfer(slave, clock, 0x1000, 0, {});
+
+			THEN("The transfer fails")
+			{
+				REQUIRE(job.transfer.hasFailed());
+			}
+		}
+	}
+}
+
+SCENARIO("CoE reads via the MailboxEngine do not delay the process data exchange",
+    "[MailboxEngine]")
+{
+	GIVEN("A slave that takes 2ms to answer and a bus on which each frame takes 20us")
+	{
+		ekdatatypes::TimeStamp clock;
+		SimulatedSlave slave(clock);
+		slave.objects[{ 0x1000, 0 }] = { 0x12, 0x34 };
+		const ekdatatypes::TimeStep frameTime = 20us;
+		const ekdatatypes::TimeStep cycleTime = 1ms;
+		EtherCATFrame frame;
+
+		// Returns the time each of 20 cycles spent on the bus
+		auto runCycles = [&](bool readCoE, bool blocking) {
+			MailboxEngine engine;
+			std::vector<ekdatatypes::TimeStep> cycleDurations;
+			for (int cycle = 0; cycle < 20; ++cycle)
+			{
+				ekdatatypes::TimeStamp cycleStart = clock;
+				clock += frameTime; // The process data frame
+				if (readCoE && cycle % 5 == 0)
+				{
+					engine.submit(nullptr,
+					    SDOTransfer(slave.getMailboxInfo(), 0x1000, 0, {}, 100ms, clock));
+				}
+				// A blocking read exchanges frames until it is done, like ec_SDOread does
+				do
+				{
+					if (engine.prepareFrame(frame, clock) > 0)
+					{
+						clock += frameTime;
+						engine.handleReply(frame, slave.process(frame), clock);
+					}
+				} while (blocking && engine.hasWork());
+				while (auto job = engine.takeFinished())
+				{
+					REQUIRE_FALSE(job->transfer.hasFailed());
+				}
+				cycleDurations.push_back(
+				    std::chrono::duration_cast<ekdatatypes::TimeStep>(clock - cycleStart));
+				clock = std::max(clock, cycleStart + cycleTime);
+			}
+			return *std::max_element(cycleDurations.begin(), cycleDurations.end());
+		};
+
+		WHEN("I run the realtime loop with and without CoE reads")
+		{
+			ekdatatypes::TimeStep withoutCoE = runCycles(false, false);
+			ekdatatypes::TimeStep interleaved = runCycles(true, false);
+			ekdatatypes::TimeStep blocking = runCycles(true, true);
+
+			THEN("Interleaved reads add at most one frame to a cycle, blocking reads overrun it")
+			{
+				REQUIRE(withoutCoE == frameTime);
+				REQUIRE(interleaved <= withoutCoE + frameTime);
+				REQUIRE(blocking > cycleTime);
+			}
+		}
+	}
+}
@@ -670,3 +670,303 @@ SCENARIO(
 		}
 	}
 }
+
+bool frameReadsRegister(EtherCATFrameMetaData* metaData, ekdatatypes::RegisterEnum reg)
+{
+	for (const PDUMetaData& pdu : metaData->pdus)
+	{
+		if (pdu.registerOffsets.count(reg) != 0)
+			return true;
+	}
+	return false;
+}
+
+SCENARIO("The RegisterScheduler reads registers at their rates", "[RegisterScheduler]")
+{
+	GIVEN("registers with different rates and one without a rate")
+	{
+		using ekdatatypes::RegisterEnum;
+		std::vector<uint16_t> slaveAddress = { 0x3468 };
+		std::unordered_map<RegisterEnum, bool> rMap{
+			{ RegisterEnum::RAM_SIZE, true },
+			{ RegisterEnum::STATUS, true },
+			{ RegisterEnum::FRAME_ERROR_COUNTER_PORT_0, true },
+			{ RegisterEnum::SYSTEM_TIME, true },
+		};
+		std::unordered_map<RegisterEnum, RegisterRate> rates{
+			{ RegisterEnum::RAM_SIZE, { 1, RegisterPriority::LOW } },
+			{ RegisterEnum::STATUS, { 100, RegisterPriority::NORMAL } },
+			{ RegisterEnum::FRAME_ERROR_COUNTER_PORT_0, { 1000, RegisterPriority::HIGH } },
+		};
+		RegisterScheduler sched(slaveAddress, rMap, rates);
+		ekdatatypes::TimeStamp start = ekdatatypes::now();
+		auto framesAt = [&](int frameCount, std::chrono::microseconds time) {
+			std::vector<EtherCATFrameMetaData*> frames;
+			for (auto it = sched.getNextFrames(frameCount, start + time); !it.atEnd(); ++it)
+			{
+				frames.push_back((*it).second);
+			}
+			return frames;
+		};
+
+		THEN("Every rate gets its own frames")
+		{
+			REQUIRE(sched.getFrameCount() == 4);
+		}
+
+		WHEN("All registers are due")
+		{
+			auto frames = framesAt(6, std::chrono::microseconds(0));
+
+			THEN("The registers with a rate come first by priority and the rest is filled")
+			{
+				REQUIRE(frames.size() == 6);
+				REQUIRE(frameReadsRegister(frames[0], RegisterEnum::FRAME_ERROR_COUNTER_PORT_0));
+				REQUIRE(frameReadsRegister(frames[1], RegisterEnum::STATUS));
+				REQUIRE(frameReadsRegister(frames[2], RegisterEnum::RAM_SIZE));
+				for (size_t i = 3; i < frames.size(); ++i)
+				{
+					REQUIRE(frameReadsRegister(frames[i], RegisterEnum::SYSTEM_TIME));
+				}
+			}
+
+			THEN("The registers with a rate are only read again once they are due")
+			{
+				auto later = framesAt(3, std::chrono::microseconds(500));
+				for (auto* frame : later)
+				{
+					REQUIRE(frameReadsRegister(frame, RegisterEnum::SYSTEM_TIME));
+				}
+				later = framesAt(3, std::chrono::microseconds(1000));
+				REQUIRE(frameReadsRegister(later[0], RegisterEnum::FRAME_ERROR_COUNTER_PORT_0));
+				REQUIRE(frameReadsRegister(later[1], RegisterEnum::SYSTEM_TIME));
+				later = framesAt(3, std::chrono::microseconds(10000));
+				REQUIRE(frameReadsRegister(later[0], RegisterEnum::FRAME_ERROR_COUNTER_PORT_0));
+				REQUIRE(frameReadsRegister(later[1], RegisterEnum::STATUS));
+				REQUIRE(frameReadsRegister(later[2], RegisterEnum::SYSTEM_TIME));
+			}
+		}
+
+		WHEN("Fewer frames fit into a round than are due")
+		{
+			auto first = framesAt(1, std::chrono::microseconds(0));
+			auto second = framesAt(1, std::chrono::microseconds(100));
+			auto third = framesAt(1, std::chrono::microseconds(200));
+
+			THEN("The frames that did not fit stay due")
+			{
+				REQUIRE(frameReadsRegister(first[0], RegisterEnum::FRAME_ERROR_COUNTER_PORT_0));
+				REQUIRE(frameReadsRegister(second[0], RegisterEnum::STATUS));
+				REQUIRE(frameReadsRegister(third[0], RegisterEnum::RAM_SIZE));
+			}
+		}
+
+		WHEN("The rates are removed")
+		{
+			sched.changeRegisterRates({});
+			auto frames = framesAt(3, std::chrono::microseconds(0));
+
+			THEN("All registers are read round-robin-style in one frame")
+			{
+				REQUIRE(sched.getFrameCount() == 1);
+				REQUIRE(frames.size() == 3);
+				REQUIRE(frames[0] == frames[2]);
+				REQUIRE(frameReadsRegister(frames[0], RegisterEnum::RAM_SIZE));
+				REQUIRE(frameReadsRegister(frames[0], RegisterEnum::SYSTEM_TIME));
+			}
+		}
+
+		WHEN("A frequency is invalid")
+		{
+			THEN("The rates are not changed")
+			{
+				REQUIRE_THROWS_AS(
+				    sched.changeRegisterRates({ { RegisterEnum::STATUS, { -1 } } }),
+				    std::invalid_argument);
+				REQUIRE(sched.getFrameCount() == 4);
+			}
+		}
+	}
+
+	GIVEN("only registers with a rate")
+	{
+		using ekdatatypes::RegisterEnum;
+		std::vector<uint16_t> slaveAddress = { 0x3468 };
+		std::unordered_map<RegisterEnum, bool> rMap{ { RegisterEnum::BUILD, true } };
+		RegisterScheduler sched(
+		    slaveAddress, rMap, { { RegisterEnum::BUILD, { 10, RegisterPriority::LOW } } });
+		ekdatatypes::TimeStamp start = ekdatatypes::now();
+
+		THEN("Rounds without due registers read nothing")
+		{
+			auto it = sched.getNextFrames(2, start);
+			REQUIRE(it.hasCompletedLoop());
+			++it;
+			REQUIRE(it.atEnd());
+			REQUIRE(sched.getNextFrames(2, start + std::chrono::milliseconds(50)).atEnd());
+			REQUIRE_FALSE(sched.getNextFrames(2, start + std::chrono::milliseconds(100)).atEnd());
+		}
+	}
+
+	GIVEN("more registers than fit into one frame")
+	{
+		std::vector<uint16_t> slaveAddresses;
+		for (uint16_t i = 0; i < 200; ++i)
+		{
+			slaveAddresses.push_back(0x2000 + i);
+		}
+		std::unordered_map<ekdatatypes::RegisterEnum, bool> rMap{
+			{ ekdatatypes::RegisterEnum::BUILD, true },
+		};
+		RegisterScheduler sched(slaveAddresses, rMap);
+
+		THEN("Every slave is read by one of the frames")
+		{
+			size_t pduCount = 0;
+			auto it = sched.getNextFrames(static_cast<int>(sched.getFrameCount()));
+			for (; !it.atEnd(); ++it)
+			{
+				pduCount += (*it).second->pdus.size();
+			}
+			REQUIRE(pduCount == slaveAddresses.size());
+		}
+	}
+}
+
+SCENARIO("The RegisterScheduler reads a mapped register block with LRD PDUs", "[RegisterScheduler]")
+{
+	using ekdatatypes::RegisterEnum;
+	const int blockStart = static_cast<int>(RegisterEnum::FRAME_ERROR_COUNTER_PORT_0);
+	const int blockEnd = static_cast<int>(RegisterEnum::LOST_LINK_COUNTER_PORT_3) + 1;
+	const uint32_t logicalAddress = 0x10000000;
+
+	GIVEN("three slaves of which two have the error counters mapped")
+	{
+		std::vector<uint16_t> slaveAddresses = { 0x1001, 0x1002, 0x1003 };
+		std::unordered_map<RegisterEnum, bool> rMap{
+			{ RegisterEnum::RAM_SIZE, true },
+			{ RegisterEnum::FRAME_ERROR_COUNTER_PORT_0, true },
+		};
+		MappedRegisterBlock block{ blockStart, blockEnd, logicalAddress, { 0x1001, 0x1003 } };
+		RegisterScheduler sched(slaveAddresses, rMap, {}, block);
+		auto it = sched.getNextFrames(1);
+		uint8_t* frame = reinterpret_cast<uint8_t*>((*it).first);
+		EtherCATFrameMetaData* metaData = (*it).second;
+
+		THEN("The mapped slaves share an LRD PDU and the other one is read with FPRD")
+		{
+			REQUIRE(sched.getFrameCount() == 1);
+			// RAM_SIZE of all three slaves, the counters of slave 2, the LRD PDU for two slaves
+			REQUIRE(metaData->pdus.size() == 6);
+			std::vector<const PDUMetaData*> counterPDUs;
+			for (const PDUMetaData& pdu : metaData->pdus)
+			{
+				if (pdu.registerOffsets.count(RegisterEnum::FRAME_ERROR_COUNTER_PORT_0) != 0)
+					counterPDUs.push_back(&pdu);
+			}
+			REQUIRE(counterPDUs.size() == 3);
+			REQUIRE(counterPDUs[0]->slaveConfiguredAddress == 0x1002);
+			REQUIRE(counterPDUs[0]->expectedWorkingCounter == 1);
+			REQUIRE_FALSE(counterPDUs[0]->blockPart.has_value());
+
+			const PDUMetaData& first = *counterPDUs[1];
+			const PDUMetaData& second = *counterPDUs[2];
+			REQUIRE(first.slaveConfiguredAddress == 0x1001);
+			REQUIRE(second.slaveConfiguredAddress == 0x1003);
+			REQUIRE(first.expectedWorkingCounter == 2);
+			REQUIRE(first.workingCounterOffset == second.workingCounterOffset);
+			size_t firstOffset = first.registerOffsets.at(RegisterEnum::FRAME_ERROR_COUNTER_PORT_0);
+			size_t secondOffset
+			    = second.registerOffsets.at(RegisterEnum::FRAME_ERROR_COUNTER_PORT_0);
+			REQUIRE(secondOffset - firstOffset == static_cast<size_t>(blockEnd - blockStart));
+			REQUIRE(second.registerOffsets.at(RegisterEnum::LOST_LINK_COUNTER_PORT_3)
+			    == secondOffset + blockEnd - 1 - blockStart);
+
+			// The PDU header lies in front of the data of the first slave
+			uint8_t* header = frame + firstOffset - (sizeof(EtherCATPDU) - 1);
+			checkIfFrameEqualsVector(header,
+			    { lrdCommandType, 0xff, 0x00, 0x00, 0x00, 0x10, 2 * (blockEnd - blockStart),
+			        0x00 });
+			REQUIRE(first.workingCounterOffset == secondOffset + blockEnd - blockStart);
+
+			// Each slave can be read on its own if the LRD PDU comes back short
+			REQUIRE(second.blockPart.has_value());
+			REQUIRE(second.blockPart->start == blockStart);
+			REQUIRE(second.blockPart->end == blockEnd);
+			REQUIRE(second.blockPart->dataOffset == secondOffset);
+			REQUIRE(first.blockPart->dataOffset == firstOffset);
+		}
+	}
+
+	GIVEN("many slaves that all have the error counters mapped")
+	{
+		std::vector<uint16_t> slaveAddresses;
+		for (uint16_t i = 0; i < 200; ++i)
+		{
+			slaveAddresses.push_back(0x1000 + i);
+		}
+		std::unordered_map<RegisterEnum, bool> rMap{
+			{ RegisterEnum::FRAME_ERROR_COUNTER_PORT_0, true },
+		};
+		RegisterScheduler unmapped(slaveAddresses, rMap);
+		RegisterScheduler mapped(slaveAddresses, rMap, {},
+		    { blockStart, blockStart + 4, logicalAddress, slaveAddresses });
+
+		THEN("Fewer frames read the registers of all slaves")
+		{
+			REQUIRE(mapped.getFrameCount() < unmapped.getFrameCount());
+			size_t slaveCount = 0;
+			auto it = mapped.getNextFrames(static_cast<int>(mapped.getFrameCount()));
+			for (; !it.atEnd(); ++it)
+			{
+				slaveCount += (*it).second->pdus.size();
+			}
+			REQUIRE(slaveCount == slaveAddresses.size());
+		}
+	}
+}
+
+SCENARIO("The RegisterScheduler leaves space in its frames", "[RegisterScheduler]")
+{
+	using ekdatatypes::RegisterEnum;
+	GIVEN("a RegisterScheduler for many slaves")
+	{
+		std::vector<uint16_t> slaveAddresses;
+		for (uint16_t i = 0; i < 200; ++i)
+		{
+			slaveAddresses.push_back(0x1000 + i);
+		}
+		std::unordered_map<RegisterEnum, bool> rMap{ { RegisterEnum::RAM_SIZE, true },
+			{ RegisterEnum::FRAME_ERROR_COUNTER_PORT_0, true } };
+		RegisterScheduler sched(slaveAddresses, rMap);
+		size_t frameCount = sched.getFrameCount();
+
+		WHEN("space is reserved in every frame")
+		{
+			const size_t reserved = 200;
+			sched.reserveFrameSpace(reserved);
+
+			THEN("No frame uses the reserved space")
+			{
+				REQUIRE(sched.getFrameCount() > frameCount);
+				auto it = sched.getNextFrames(static_cast<int>(sched.getFrameCount()));
+				for (; !it.atEnd(); ++it)
+				{
+					REQUIRE((*it).second->lengthOfFrame - sizeof(uint16_t) + reserved
+					    <= maxTotalPDULength);
+				}
+			}
+		}
+
+		WHEN("more than half of a frame is reserved")
+		{
+			THEN("The RegisterScheduler refuses")
+			{
+				REQUIRE_THROWS_AS(
+				    sched.reserveFrameSpace(RegisterScheduler::maxReservedFrameSpace + 1),
+				    std::invalid_argument);
+				REQUIRE(sched.getFrameCount() == frameCount);
+			}
+		}
+	}
+}
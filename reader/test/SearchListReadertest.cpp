@@ -0,0 +1,519 @@
+/*
+ * Copyright 2021 Niklas Arlt, Matthias Becht, Florian Bossert, Marwin Madsen, and Philip Scherer
+ *
+ * This file is part of EtherKITten.
+ *
+ * EtherKITten is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * EtherKITten is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EtherKITten.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "DataReaderMock.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <chrono>
+#include <memory>
+
+#include <etherkitten/reader/AggregateDataView.hpp>
+#include <etherkitten/reader/DataView.hpp>
+#include <etherkitten/reader/IOMap.hpp>
+#include <etherkitten/reader/LLNode.hpp>
+
+using namespace etherkitten::reader;
+using namespace etherkitten::datatypes;
+
+SCENARIO("The SearchListReader decodes PDOs that are being viewed on insertion",
+    "[SearchListReader]")
+{
+	GIVEN("A SearchListReader with some PDO data")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 2, 3 } };
+		PDO pdo1 = PDO(1, "PDO1", EtherCATDataTypeEnum::INTEGER16, 0, PDODirection::INPUT);
+		PDO pdo2 = PDO(1, "PDO2", EtherCATDataTypeEnum::UNSIGNED8, 1, PDODirection::INPUT);
+		reader.appendPDOToIOMap(pdo1);
+		reader.appendPDOToIOMap(pdo2);
+		TimeStamp start = now();
+		TimeStep step{ 100 };
+		reader.feedPDOData({ { pdo1, 0x1234 }, { pdo2, 0x12 } }, start);
+
+		WHEN("I request a DataView for a PDO")
+		{
+			auto firstView = reader.getView(pdo1, { start - step, 0s });
+
+			THEN("Even the first view reads the values decoded from the stored IOMaps")
+			{
+				REQUIRE(std::dynamic_pointer_cast<DataView<double, Reader::nodeSize>>(firstView)
+				    != nullptr);
+				REQUIRE(firstView->asDouble() == 0x1234);
+				REQUIRE(firstView->getTime() == start);
+			}
+
+			AND_WHEN("More IOMaps are inserted")
+			{
+				reader.feedPDOData({ { pdo1, 0x2345 }, { pdo2, 0x23 } }, start + 2 * step);
+				reader.feedPDOData({ { pdo1, 0x3456 }, { pdo2, 0x34 } }, start + 3 * step);
+
+				THEN("The view steps over the values that were decoded on insertion")
+				{
+					REQUIRE(firstView->hasNext());
+					++(*firstView);
+					REQUIRE(firstView->asDouble() == 0x2345);
+					REQUIRE(firstView->getTime() == start + 2 * step);
+					++(*firstView);
+					REQUIRE(firstView->asDouble() == 0x3456);
+					REQUIRE(firstView->hasNext() == false);
+				}
+
+				THEN("A view on the new IOMaps uses the decoded values")
+				{
+					auto hotView = reader.getView(pdo1, { start + 2 * step, 0s });
+					REQUIRE(std::dynamic_pointer_cast<DataView<double, Reader::nodeSize>>(hotView)
+					    != nullptr);
+					REQUIRE(hotView->asDouble() == 0x2345);
+					REQUIRE(hotView->getTime() == start + 2 * step);
+				}
+
+				AND_WHEN("All views on the PDO are released and it is viewed again later")
+				{
+					firstView.reset();
+					reader.feedPDOData({ { pdo1, 0x4567 }, { pdo2, 0x45 } }, start + 4 * step);
+					auto view = reader.getView(pdo1, { start + 3 * step, 0s });
+
+					THEN("The values are decoded again from the IOMaps, including the newest")
+					{
+						REQUIRE(std::dynamic_pointer_cast<DataView<double, Reader::nodeSize>>(view)
+						    != nullptr);
+						REQUIRE(view->asDouble() == 0x3456);
+						++(*view);
+						REQUIRE(view->asDouble() == 0x4567);
+						REQUIRE(view->hasNext() == false);
+					}
+				}
+			}
+		}
+
+		WHEN("I request a NewestValueView for a PDO")
+		{
+			auto newest = reader.getNewest(pdo2);
+			reader.feedPDOData({ { pdo1, 0x2345 }, { pdo2, 0x23 } }, start + 2 * step);
+
+			THEN("It shows the newest value with the type of the PDO")
+			{
+				REQUIRE((**newest).asString(NumberFormat::HEXADECIMAL) == "0x23");
+				REQUIRE((**newest).getTime() == start + 2 * step);
+			}
+
+			THEN("Views on the PDO read the values that were decoded while it was shown")
+			{
+				auto view = reader.getView(pdo2, { start, 0s });
+				REQUIRE(std::dynamic_pointer_cast<DataView<double, Reader::nodeSize>>(view)
+				    != nullptr);
+				REQUIRE(view->asDouble() == 0x12);
+				++(*view);
+				REQUIRE(view->asDouble() == 0x23);
+				REQUIRE(view->hasNext() == false);
+			}
+		}
+	}
+
+	GIVEN("A SearchListReader without any IOMaps")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 1, 1 } };
+		PDO pdo = PDO(1, "PDO", EtherCATDataTypeEnum::UNSIGNED8, 0, PDODirection::INPUT);
+		reader.appendPDOToIOMap(pdo);
+		TimeStamp start = now();
+
+		WHEN("A PDO is viewed before its first IOMap is inserted")
+		{
+			auto newest = reader.getNewest(pdo);
+			auto view = reader.getView(pdo, { start, 0s });
+			reader.feedPDOData({ { pdo, 1 } }, start);
+			reader.feedPDOData({ { pdo, 2 } }, start + 1ms);
+
+			THEN("The views show the values as they are inserted")
+			{
+				REQUIRE((**newest).asString(NumberFormat::DECIMAL) == "2");
+				REQUIRE(view->isEmpty());
+				++(*view);
+				REQUIRE(view->asDouble() == 1);
+				++(*view);
+				REQUIRE(view->asDouble() == 2);
+				REQUIRE(view->hasNext() == false);
+			}
+		}
+	}
+}
+
+SCENARIO("The SearchListReader keeps the decoded values of PDOs that the IOMaps still cover",
+    "[SearchListReader]")
+{
+	GIVEN("A SearchListReader that started decoding a PDO long after its first IOMap")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 1, 4 } };
+		PDO pdo = PDO(1, "PDO", EtherCATDataTypeEnum::UNSIGNED32, 0, PDODirection::INPUT);
+		reader.appendPDOToIOMap(pdo);
+		TimeStamp start = now();
+		TimeStep step = std::chrono::milliseconds(1);
+		// Enough IOMaps for freeMemoryIfNecessary to remove a few nodes of them
+		constexpr int ioMapCount = 300000;
+		for (int i = 0; i < ioMapCount / 2; ++i)
+		{
+			reader.feedPDOData({ { pdo, static_cast<uint64_t>(i) } }, start + i * step);
+		}
+		auto subscriber = reader.getView(pdo, { start + (ioMapCount / 2 - 1) * step, 0s });
+		for (int i = ioMapCount / 2; i < ioMapCount; ++i)
+		{
+			reader.feedPDOData({ { pdo, static_cast<uint64_t>(i) } }, start + i * step);
+		}
+
+		WHEN("Memory is freed")
+		{
+			size_t ioMapMemory = ioMapCount
+			    * (sizeof(LLNode<IOMapSlab, Reader::nodeSize>) / Reader::nodeSize
+			        + IOMapSlab::getSlotSize(4));
+			reader.setMaximumMemory(ioMapMemory);
+			reader.freeMemoryIfNecessary();
+
+			THEN("The oldest IOMaps are gone")
+			{
+				auto view = reader.getIOMapView(start);
+				REQUIRE(view->getTime() > start);
+			}
+
+			THEN("A view on the decoded values still begins with the first decoded value")
+			{
+				auto hotView = reader.getView(pdo, { start + ioMapCount / 2 * step, 0s });
+				REQUIRE(std::dynamic_pointer_cast<DataView<double, Reader::nodeSize>>(hotView)
+				    != nullptr);
+				REQUIRE(hotView->getTime() == start + ioMapCount / 2 * step);
+				REQUIRE(hotView->asDouble() == ioMapCount / 2);
+			}
+		}
+	}
+}
+
+SCENARIO("AggregateDataViews keep the decoded values of a PDO alive", "[SearchListReader]")
+{
+	GIVEN("A SearchListReader that decodes a PDO for a coarse view only")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 1, 2 } };
+		PDO pdo = PDO(1, "PDO", EtherCATDataTypeEnum::INTEGER16, 0, PDODirection::INPUT);
+		reader.appendPDOToIOMap(pdo);
+		TimeStamp start = now();
+		TimeStep step = std::chrono::milliseconds(10);
+		reader.feedPDOData({ { pdo, 0 } }, start);
+		auto fineView = reader.getView(pdo, { start, 0s });
+		for (int i = 1; i <= 50; ++i) // NOLINT
+		{
+			reader.feedPDOData({ { pdo, static_cast<uint64_t>(i) } }, start + i * step);
+		}
+		auto coarseView = reader.getView(pdo, { start + step, 100ms });
+		REQUIRE(std::dynamic_pointer_cast<AggregateDataView>(coarseView) != nullptr);
+		fineView.reset();
+
+		WHEN("More IOMaps are inserted")
+		{
+			for (int i = 51; i <= 100; ++i) // NOLINT
+			{
+				reader.feedPDOData({ { pdo, static_cast<uint64_t>(i) } }, start + i * step);
+			}
+
+			THEN("The PDO is still decoded and the coarse view can be stepped")
+			{
+				auto hotView = reader.getView(pdo, { start + 60 * step, 0s }); // NOLINT
+				REQUIRE(std::dynamic_pointer_cast<DataView<double, Reader::nodeSize>>(hotView)
+				    != nullptr);
+				size_t steps = 0;
+				while (coarseView->hasNext())
+				{
+					++(*coarseView);
+					REQUIRE(coarseView->asDouble() >= 1);
+					REQUIRE(coarseView->asDouble() <= 100); // NOLINT
+					++steps;
+				}
+				REQUIRE(steps > 0);
+			}
+		}
+	}
+}
+
+SCENARIO("The SearchListReader only copies as much of an IOMap as it is given",
+    "[SearchListReader]")
+{
+	GIVEN("A SearchListReader for a bus with a larger IOMap than its PDOs fill")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 1, 4 } };
+		PDO pdo = PDO(1, "PDO", EtherCATDataTypeEnum::UNSIGNED8, 0, PDODirection::INPUT);
+		reader.appendPDOToIOMap(pdo);
+		TimeStamp start = now();
+
+		WHEN("I insert an IOMap that only holds the PDO")
+		{
+			reader.feedPDOData({ { pdo, 0x42 } }, start);
+
+			THEN("The rest of the IOMap is padded")
+			{
+				auto ioMaps = reader.getIOMapView(start);
+				REQUIRE((**ioMaps)->ioMapSize == 4);
+				REQUIRE((**ioMaps)->ioMap[0] == 0x42);
+				REQUIRE((**ioMaps)->ioMap[3] == 0); // NOLINT
+			}
+		}
+	}
+
+	GIVEN("A SearchListReader for a bus with a smaller IOMap than its PDOs fill")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 1, 1 } };
+		PDO pdo = PDO(1, "PDO", EtherCATDataTypeEnum::INTEGER32, 0, PDODirection::INPUT);
+		reader.appendPDOToIOMap(pdo);
+
+		THEN("IOMaps that are too large are rejected")
+		{
+			REQUIRE_THROWS_AS(reader.feedPDOData({ { pdo, 1 } }, now()), std::invalid_argument);
+		}
+	}
+}
+
+SCENARIO("The SearchListReader returns AggregateDataViews for coarse steps", "[SearchListReader]")
+{
+	GIVEN("A SearchListReader with register data that contains a short spike")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 1, 0 } };
+		Register reg = Register(1, RegisterEnum::BUILD);
+		TimeStamp start = now();
+		for (int i = 0; i < 2000; ++i) // NOLINT
+		{
+			reader.feedRegister(reg, start + std::chrono::milliseconds(i), i == 1234 ? 999 : 1);
+		}
+
+		WHEN("I request a DataView with a fine step")
+		{
+			auto view = reader.getView(reg, { start, std::chrono::milliseconds(1) });
+
+			THEN("I get a DataView over the values")
+			{
+				REQUIRE(std::dynamic_pointer_cast<AggregateDataView>(view) == nullptr);
+			}
+		}
+
+		WHEN("I request a DataView with a coarse step")
+		{
+			auto view = reader.getView(reg, { start, std::chrono::milliseconds(500) });
+
+			THEN("I get an AggregateDataView that does not skip the spike")
+			{
+				REQUIRE(std::dynamic_pointer_cast<AggregateDataView>(view) != nullptr);
+				bool sawSpike = view->asDouble() == 999; // NOLINT
+				while (view->hasNext())
+				{
+					++(*view);
+					sawSpike |= view->asDouble() == 999; // NOLINT
+				}
+				REQUIRE(sawSpike);
+			}
+		}
+	}
+}
+
+SCENARIO("The SearchListReader keeps the CycleStatistics of every cycle", "[SearchListReader]")
+{
+	GIVEN("A SearchListReader with the measurements of some cycles")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 1, 0 } };
+		TimeStamp start = now();
+		for (uint32_t i = 0; i < 100; ++i) // NOLINT
+		{
+			std::array<uint32_t, cycleStatisticTypeCount> measurement{};
+			measurement[static_cast<size_t>(CycleStatisticType::LOOP_DURATION)] = 1000 + i;
+			measurement[static_cast<size_t>(CycleStatisticType::DEADLINE_MISS)] = i == 42 ? 1 : 0;
+			reader.feedCycleMeasurement(measurement, start + std::chrono::milliseconds(i));
+		}
+		CycleStatistic loopDuration(CycleStatisticType::LOOP_DURATION);
+
+		WHEN("I request a DataView for a CycleStatistic")
+		{
+			auto view = reader.getView(loopDuration, { start, 0s });
+
+			THEN("It steps over the values of all cycles")
+			{
+				REQUIRE(view->asDouble() == 1000);
+				REQUIRE(view->getTime() == start);
+				size_t count = 1;
+				while (view->hasNext())
+				{
+					++(*view);
+					++count;
+				}
+				REQUIRE(count == 100);
+				REQUIRE(view->asDouble() == 1099);
+			}
+		}
+
+		WHEN("I request a NewestValueView for a CycleStatistic")
+		{
+			auto view = reader.getNewest(loopDuration);
+
+			THEN("It shows the value of the last cycle")
+			{
+				auto& dataPoint = dynamic_cast<const DataPoint<uint32_t>&>(**view);
+				REQUIRE(dataPoint.getValue() == 1099);
+			}
+		}
+
+		WHEN("I request the histogram of a CycleStatisticType")
+		{
+			const CycleHistogram& misses
+			    = reader.getCycleHistogram(CycleStatisticType::DEADLINE_MISS);
+			const CycleHistogram& durations
+			    = reader.getCycleHistogram(CycleStatisticType::LOOP_DURATION);
+
+			THEN("It has counted the values of all cycles")
+			{
+				REQUIRE(misses.getCount() == 100);
+				REQUIRE(misses.getBucketCount(1) == 1);
+				REQUIRE(durations.getMin() == 1000);
+				REQUIRE(durations.getMax() == 1099);
+			}
+		}
+	}
+}
+
+SCENARIO("The SearchListReader keeps the CycleStatistics that the IOMaps still cover",
+    "[SearchListReader]")
+{
+	GIVEN("A SearchListReader with the IOMaps and measurements of many cycles")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 1, 4 } };
+		PDO pdo = PDO(1, "PDO", EtherCATDataTypeEnum::UNSIGNED32, 0, PDODirection::INPUT);
+		reader.appendPDOToIOMap(pdo);
+		TimeStamp start = now();
+		TimeStep step = std::chrono::milliseconds(1);
+		// Enough IOMaps for freeMemoryIfNecessary to remove a few nodes of them
+		constexpr int cycleCount = 300000;
+		for (int i = 0; i < cycleCount; ++i)
+		{
+			reader.feedPDOData({ { pdo, static_cast<uint64_t>(i) } }, start + i * step);
+			reader.feedCycleMeasurement({}, start + i * step);
+		}
+		CycleStatistic loopDuration(CycleStatisticType::LOOP_DURATION);
+		size_t ioMapMemory = cycleCount
+		    * (sizeof(LLNode<IOMapSlab, Reader::nodeSize>) / Reader::nodeSize
+		        + IOMapSlab::getSlotSize(4));
+
+		WHEN("Memory is freed")
+		{
+			reader.setMaximumMemory(ioMapMemory);
+			reader.freeMemoryIfNecessary();
+
+			THEN("The CycleStatistics begin where the IOMaps begin")
+			{
+				auto ioMapView = reader.getIOMapView(start);
+				REQUIRE(ioMapView->getTime() > start);
+				REQUIRE(reader.getView(loopDuration, { start, 0s })->getTime()
+				    == ioMapView->getTime());
+			}
+
+			THEN("The histograms still count every cycle")
+			{
+				REQUIRE(reader.getCycleHistogram(CycleStatisticType::LOOP_DURATION).getCount()
+				    == cycleCount);
+			}
+		}
+
+		WHEN("Memory is freed while a view holds on to the oldest IOMaps")
+		{
+			auto ioMapView = reader.getIOMapView(start);
+			reader.setMaximumMemory(ioMapMemory);
+			reader.freeMemoryIfNecessary();
+
+			THEN("No CycleStatistics are freed either")
+			{
+				REQUIRE(ioMapView->getTime() == start);
+				REQUIRE(reader.getView(loopDuration, { start, 0s })->getTime() == start);
+			}
+		}
+	}
+}
+
+SCENARIO("The SearchListReader can store registers as runs of equal values", "[SearchListReader]")
+{
+	GIVEN("A SearchListReader that stores registers as runs")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 1, 0 } };
+		reader.setRegisterRunLengthStorage(true);
+		Register reg = Register(1, RegisterEnum::BUILD);
+		TimeStamp start = now();
+
+		WHEN("I insert a register value that only changes once")
+		{
+			for (int i = 0; i < 2000; ++i) // NOLINT
+			{
+				reader.feedRegister(reg, start + std::chrono::milliseconds(i), i == 1234 ? 999 : 1);
+			}
+
+			THEN("A DataView shows the runs up to the last value inserted")
+			{
+				auto view = reader.getView(reg, { start, TimeStep(0) });
+				std::vector<std::pair<double, int>> expected{ { 1, 0 }, { 1, 1233 },
+					{ 999, 1234 }, { 1, 1235 }, { 1, 1999 } };
+				for (size_t i = 0; i < expected.size(); ++i)
+				{
+					REQUIRE(view->asDouble() == expected[i].first);
+					REQUIRE(view->getTime()
+					    == start + std::chrono::milliseconds(expected[i].second));
+					REQUIRE(view->hasNext() == (i + 1 < expected.size()));
+					++(*view);
+				}
+				auto newest = reader.getNewest(reg);
+				REQUIRE((**newest).getTime() == start + std::chrono::milliseconds(1999));
+			}
+		}
+
+		WHEN("I plot a register whose value stays constant")
+		{
+			for (int i = 0; i < 1000; ++i) // NOLINT
+			{
+				reader.feedRegister(reg, start + std::chrono::milliseconds(i), 1);
+			}
+			auto view = reader.getView(reg, { start, std::chrono::milliseconds(10) });
+			std::array<double, 16> values{}; // NOLINT
+			std::array<TimeStamp, 16> times{}; // NOLINT
+			auto readAll = [&]() {
+				TimeStamp last = view->getTime();
+				size_t read = 0;
+				while ((read = view->readBatch(values.data(), times.data(), values.size())) > 0)
+				{
+					last = times[read - 1];
+				}
+				return last;
+			};
+
+			THEN("The series reaches the latest read time")
+			{
+				REQUIRE(readAll() == start + std::chrono::milliseconds(999));
+				REQUIRE(view->asDouble() == 1);
+
+				AND_THEN("It follows the register as it is read further")
+				{
+					for (int i = 1000; i < 2000; ++i) // NOLINT
+					{
+						reader.feedRegister(reg, start + std::chrono::milliseconds(i), 1);
+					}
+					REQUIRE(readAll() == start + std::chrono::milliseconds(1999));
+					reader.feedRegister(reg, start + std::chrono::milliseconds(2010), 2); // NOLINT
+					REQUIRE(readAll() == start + std::chrono::milliseconds(2010));
+					REQUIRE(view->asDouble() == 2);
+				}
+			}
+		}
+	}
+}
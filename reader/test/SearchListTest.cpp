@@ -17,6 +17,9 @@
 
 #include <catch2/catch.hpp>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -176,3 +179,440 @@ SCENARIO(
 		}
 	}
 }
+
+SCENARIO("A SearchList<IOMapSlab> stores IOMaps in contiguous slabs", "[SearchList]")
+{
+	GIVEN("A SearchList<IOMapSlab> with more IOMaps than fit into one node")
+	{
+		static constexpr size_t nodeSize = 4;
+		static constexpr size_t ioMapSize = 3;
+		SearchList<IOMapSlab, nodeSize> searchList;
+		ekdatatypes::TimeStamp startTime{ ekdatatypes::now() };
+		ekdatatypes::TimeStep timeStep{ 1000 };
+		std::vector<ekdatatypes::TimeStamp> times;
+		for (uint8_t i = 0; i < 10; ++i)
+		{
+			std::array<uint8_t, ioMapSize> ioMap{ i, static_cast<uint8_t>(i + 1),
+				static_cast<uint8_t>(i + 2) };
+			times.push_back(startTime + i * timeStep);
+			searchList.append(ioMap.data(), ioMapSize, times[i]);
+		}
+
+		WHEN("I get a DataView over the IOMaps")
+		{
+			ekdatatypes::TimeSeries timeSeries{ times[0], ekdatatypes::TimeStep(0) };
+			auto dataView = searchList.getView<IOMap*>(timeSeries, false);
+
+			THEN("Every IOMap is returned with its size and data, across node boundaries")
+			{
+				for (uint8_t i = 0; i < 10; ++i)
+				{
+					IOMap* ioMap = **dataView;
+					REQUIRE(dataView->getTime() == times[i]);
+					REQUIRE(ioMap->ioMapSize == ioMapSize);
+					REQUIRE(ioMap->ioMap[0] == i);
+					REQUIRE(ioMap->ioMap[2] == i + 2); // NOLINT
+					REQUIRE(dataView->hasNext() == (i < 9));
+					++(*dataView);
+				}
+			}
+		}
+
+		WHEN("I get a DataView that extracts bits from the IOMaps")
+		{
+			ekdatatypes::TimeSeries timeSeries{ times[0], ekdatatypes::TimeStep(0) };
+			auto dataView = searchList.getView<uint16_t>(timeSeries, 8, 16, false);
+
+			THEN("The DataView converts the values from the slab")
+			{
+				REQUIRE(dataView->asDouble() == 0x0201);
+				++(*dataView);
+				REQUIRE(dataView->asDouble() == 0x0302);
+			}
+		}
+
+		WHEN("I append an IOMap of a different size")
+		{
+			std::array<uint8_t, ioMapSize + 1> ioMap{};
+
+			THEN("The SearchList rejects it")
+			{
+				REQUIRE_THROWS_AS(
+				    searchList.append(ioMap.data(), ioMap.size(), ekdatatypes::now()),
+				    std::invalid_argument);
+			}
+		}
+	}
+}
+
+SCENARIO("A DataView steps through a SearchList spanning several minutes", "[SearchList]")
+{
+	GIVEN("A SearchList<int> with data points over several minutes and nodes")
+	{
+		static constexpr size_t nodeSize = 10;
+		SearchList<int, nodeSize> searchList;
+		ekdatatypes::TimeStamp startTime{ std::chrono::ceil<std::chrono::minutes>(
+			ekdatatypes::now()) };
+		std::vector<ekdatatypes::TimeStamp> times;
+		for (int i = 0; i < 500; ++i) // NOLINT
+		{
+			// Irregular gaps so that steps do not line up with data points
+			times.push_back(startTime + std::chrono::milliseconds(i * 7000 + (i % 3) * 500));
+			searchList.append(i, times.back());
+		}
+
+		auto expectedSteps = [&times](ekdatatypes::TimeStep timeStep) {
+			std::vector<int> expected{ 0 };
+			while (true)
+			{
+				ekdatatypes::TimeStamp target = times[expected.back()] + timeStep;
+				auto next = std::lower_bound(times.begin(), times.end(), target);
+				if (next == times.end())
+				{
+					return expected;
+				}
+				expected.push_back(next - times.begin());
+			}
+		};
+
+		auto visitSteps = [&searchList, &times](ekdatatypes::TimeStep timeStep) {
+			auto dataView = searchList.getView({ times[0], timeStep }, false);
+			std::vector<int> visited{ **dataView };
+			while (dataView->hasNext())
+			{
+				++(*dataView);
+				visited.push_back(**dataView);
+			}
+			return visited;
+		};
+
+		WHEN("I step through it in steps smaller than a node")
+		{
+			ekdatatypes::TimeStep timeStep = std::chrono::seconds(3);
+
+			THEN("The DataView visits the first data point after every step")
+			{
+				REQUIRE(visitSteps(timeStep) == expectedSteps(timeStep));
+			}
+		}
+
+		WHEN("I step through it in steps longer than a minute")
+		{
+			ekdatatypes::TimeStep timeStep = std::chrono::seconds(95); // NOLINT
+
+			THEN("The DataView visits the first data point after every step")
+			{
+				REQUIRE(visitSteps(timeStep) == expectedSteps(timeStep));
+			}
+		}
+
+		WHEN("I step through it in steps of several minutes")
+		{
+			ekdatatypes::TimeStep timeStep = std::chrono::minutes(7); // NOLINT
+
+			THEN("The DataView visits the first data point after every step")
+			{
+				REQUIRE(visitSteps(timeStep) == expectedSteps(timeStep));
+			}
+		}
+	}
+}
+
+SCENARIO("A SearchList<int> keeps Aggregates of its values", "[SearchList]")
+{
+	GIVEN("A SearchList<int> with a data point every millisecond and two outliers")
+	{
+		SearchList<int, 100> searchList; // NOLINT
+		ekdatatypes::TimeStamp startTime{ Aggregate::bucketStart(
+			ekdatatypes::now(), Aggregate::levelCount - 1) };
+		std::vector<ekdatatypes::TimeStamp> times;
+		std::vector<int> values;
+		for (int i = 0; i < 10000; ++i) // NOLINT
+		{
+			times.push_back(startTime + std::chrono::milliseconds(i));
+			values.push_back(i == 5000 ? 1000 : (i == 7777 ? -1000 : i % 100)); // NOLINT
+			searchList.append(values.back(), times.back());
+		}
+
+		WHEN("I get an AggregateDataView with a step of a second")
+		{
+			ekdatatypes::TimeStep timeStep = std::chrono::seconds(1);
+			size_t level = Aggregate::levelFor(timeStep);
+			auto view = searchList.getAggregateView({ startTime, timeStep });
+
+			THEN("The buckets are as wide as possible without exceeding the step")
+			{
+				REQUIRE(Aggregate::bucketWidth(level) <= timeStep);
+				REQUIRE(Aggregate::bucketWidth(level + 1) > timeStep);
+			}
+
+			THEN("Every complete bucket summarizes the values in it")
+			{
+				uint64_t lastBucket = Aggregate::bucketOf(times.back(), level);
+				uint64_t bucket = Aggregate::bucketOf(startTime, level);
+				bool first = true;
+				while (first || view->hasNext())
+				{
+					if (!first)
+					{
+						++(*view);
+					}
+					first = false;
+					Aggregate aggregate = **view;
+					if (Aggregate::bucketOf(aggregate.minTime, level) != bucket)
+					{
+						continue;
+					}
+					Aggregate expected;
+					for (size_t i = 0; i < times.size(); ++i)
+					{
+						if (Aggregate::bucketOf(times[i], level) == bucket)
+						{
+							expected.add(values[i], times[i]);
+						}
+					}
+					REQUIRE(aggregate.count == expected.count);
+					REQUIRE(aggregate.min == expected.min);
+					REQUIRE(aggregate.max == expected.max);
+					REQUIRE(aggregate.mean() == Approx(expected.mean()));
+					++bucket;
+				}
+				REQUIRE(bucket == lastBucket);
+			}
+
+			THEN("The view shows both outliers at the time they occurred")
+			{
+				bool sawMax = false;
+				bool sawMin = false;
+				ekdatatypes::TimeStamp lastTime = view->getTime();
+				while (view->hasNext())
+				{
+					++(*view);
+					REQUIRE(view->getTime() >= lastTime);
+					lastTime = view->getTime();
+					sawMax |= view->asDouble() == 1000 && lastTime == times[5000]; // NOLINT
+					sawMin |= view->asDouble() == -1000 && lastTime == times[7777]; // NOLINT
+				}
+				REQUIRE(sawMax);
+				REQUIRE(sawMin);
+			}
+		}
+
+		WHEN("I get an AggregateDataView with a step that is too fine")
+		{
+			THEN("The SearchList rejects it")
+			{
+				REQUIRE_THROWS_AS(
+				    searchList.getAggregateView({ startTime, std::chrono::milliseconds(1) }),
+				    std::invalid_argument);
+			}
+		}
+
+		WHEN("I remove the oldest nodes")
+		{
+			searchList.removeOldest(50); // NOLINT
+			auto view = searchList.getAggregateView({ startTime, Aggregate::bucketWidth(0) });
+
+			THEN("The Aggregates of the removed values are removed as well")
+			{
+				REQUIRE(view->getTime() > times[4000]); // NOLINT
+				REQUIRE(view->getTime() <= times[5000]); // NOLINT
+			}
+		}
+	}
+}
+
+SCENARIO("A SearchList<int> stores runs of equal values", "[SearchList]")
+{
+	GIVEN("A SearchList<int> that two runs of values with a single value in between are "
+	      "appended to as changes")
+	{
+		SearchList<int, 100> searchList; // NOLINT
+		ekdatatypes::TimeStamp startTime{ Aggregate::bucketStart(
+			ekdatatypes::now(), Aggregate::levelCount - 1) };
+		size_t stored = 0;
+		for (int i = 0; i < 3000; ++i) // NOLINT
+		{
+			int value = i < 1000 ? 5 : (i < 2000 ? 7 : 5); // NOLINT
+			stored += searchList.appendChange(value, startTime + std::chrono::milliseconds(i));
+		}
+		// Ends the last run, which stores its last data point as well
+		stored += searchList.appendChange(9, startTime + std::chrono::milliseconds(3000)); // NOLINT
+
+		WHEN("I get a DataView over the SearchList")
+		{
+			auto view = searchList.getView({ startTime, ekdatatypes::TimeStep(0) }, false);
+
+			THEN("It shows where each run began and where it was last seen")
+			{
+				REQUIRE(stored == 7);
+				std::vector<std::pair<int, int>> expected{ { 5, 0 }, { 5, 999 }, { 7, 1000 },
+					{ 7, 1999 }, { 5, 2000 }, { 5, 2999 }, { 9, 3000 } };
+				for (size_t i = 0; i < expected.size(); ++i)
+				{
+					REQUIRE(**view == expected[i].first);
+					REQUIRE(view->getTime()
+					    == startTime + std::chrono::milliseconds(expected[i].second));
+					REQUIRE(view->hasNext() == (i + 1 < expected.size()));
+					++(*view);
+				}
+			}
+		}
+
+		WHEN("I get an AggregateDataView over the SearchList")
+		{
+			auto view = searchList.getAggregateView({ startTime, std::chrono::milliseconds(500) });
+
+			THEN("Its Aggregates contain every appended value")
+			{
+				const Aggregate& first = **view;
+				REQUIRE(first.count > 2);
+				REQUIRE(first.min == 5);
+				REQUIRE(first.max == 5);
+			}
+		}
+	}
+
+	GIVEN("A SearchList<int> with a run of values that spans several minutes")
+	{
+		SearchList<int, 100> searchList; // NOLINT
+		ekdatatypes::TimeStamp startTime = ekdatatypes::now();
+		for (int i = 0; i <= 300; ++i) // NOLINT
+		{
+			searchList.appendChange(1, startTime + std::chrono::seconds(i));
+		}
+		searchList.appendChange(2, startTime + std::chrono::seconds(301)); // NOLINT
+
+		WHEN("I get a DataView that starts in the middle of the run")
+		{
+			auto view = searchList.getView(
+			    { startTime + std::chrono::seconds(150), ekdatatypes::TimeStep(0) }, false);
+
+			THEN("It starts at the end of the run")
+			{
+				REQUIRE(**view == 1);
+				REQUIRE(view->getTime() == startTime + std::chrono::seconds(300));
+				REQUIRE(view->hasNext());
+				++(*view);
+				REQUIRE(**view == 2);
+			}
+		}
+
+		WHEN("I step through it in steps of a minute")
+		{
+			auto view = searchList.getView({ startTime, std::chrono::minutes(1) }, false);
+
+			THEN("It steps from the start of the run to its end")
+			{
+				REQUIRE(view->getTime() == startTime);
+				++(*view);
+				REQUIRE(view->getTime() == startTime + std::chrono::seconds(300));
+			}
+		}
+	}
+}
+
+SCENARIO("A DataView on the newest run of a SearchList<int> sees the run end", "[SearchList]")
+{
+	GIVEN("A SearchList<int> with a run of values that is still going on")
+	{
+		SearchList<int, 100> searchList; // NOLINT
+		ekdatatypes::TimeStamp startTime = ekdatatypes::now();
+		searchList.appendChange(1, startTime);
+		auto view = searchList.getView({ startTime, ekdatatypes::TimeStep(0) }, false);
+		for (int i = 1; i < 10; ++i) // NOLINT
+		{
+			REQUIRE(searchList.appendChange(1, startTime + std::chrono::seconds(i)) == 0);
+		}
+
+		THEN("The view steps to the time the run was last seen at")
+		{
+			REQUIRE(**view == 1);
+			REQUIRE(view->getTime() == startTime);
+			REQUIRE(view->hasNext());
+			++(*view);
+			REQUIRE(**view == 1);
+			REQUIRE(view->getTime() == startTime + std::chrono::seconds(9));
+			REQUIRE_FALSE(view->hasNext());
+			++(*view);
+			REQUIRE(view->getTime() == startTime + std::chrono::seconds(9));
+
+			AND_THEN("It follows the run as it goes on")
+			{
+				searchList.appendChange(1, startTime + std::chrono::seconds(10)); // NOLINT
+				REQUIRE(view->hasNext());
+				++(*view);
+				REQUIRE(**view == 1);
+				REQUIRE(view->getTime() == startTime + std::chrono::seconds(10));
+			}
+		}
+
+		THEN("The view reads the run up to the time it was last seen at in a batch")
+		{
+			std::array<double, 4> values{};
+			std::array<ekdatatypes::TimeStamp, 4> times{};
+			REQUIRE(view->readBatch(values.data(), times.data(), values.size()) == 1);
+			REQUIRE(values[0] == 1);
+			REQUIRE(times[0] == startTime + std::chrono::seconds(9));
+			REQUIRE(view->readBatch(values.data(), times.data(), values.size()) == 0);
+		}
+
+		THEN("The newest sample is the one the run was last seen at")
+		{
+			auto [location, time] = searchList.getNewestSample();
+			REQUIRE(location.node->values[location.index] == 1);
+			REQUIRE(time == startTime + std::chrono::seconds(9));
+		}
+
+		WHEN("A different value ends the run")
+		{
+			REQUIRE(searchList.appendChange(2, startTime + std::chrono::seconds(10)) == 2);
+
+			THEN("The view steps to the end of the run and then to the new value")
+			{
+				REQUIRE(view->hasNext());
+				++(*view);
+				REQUIRE(**view == 1);
+				REQUIRE(view->getTime() == startTime + std::chrono::seconds(9));
+				++(*view);
+				REQUIRE(**view == 2);
+				REQUIRE(view->getTime() == startTime + std::chrono::seconds(10));
+				REQUIRE_FALSE(view->hasNext());
+			}
+
+			THEN("The newest sample is the new value")
+			{
+				REQUIRE(searchList.getNewestSample().second
+				    == startTime + std::chrono::seconds(10));
+			}
+		}
+
+		WHEN("A different value ends the run while the view is on its end")
+		{
+			++(*view);
+			REQUIRE(searchList.appendChange(2, startTime + std::chrono::seconds(10)) == 2);
+
+			THEN("The view steps to the new value without repeating the end of the run")
+			{
+				REQUIRE(view->hasNext());
+				++(*view);
+				REQUIRE(**view == 2);
+				REQUIRE(view->getTime() == startTime + std::chrono::seconds(10));
+				REQUIRE_FALSE(view->hasNext());
+			}
+		}
+
+		WHEN("A value is appended without run-length storage")
+		{
+			searchList.append(1, startTime + std::chrono::seconds(10));
+
+			THEN("The end of the run is stored before it")
+			{
+				++(*view);
+				REQUIRE(view->getTime() == startTime + std::chrono::seconds(9));
+				++(*view);
+				REQUIRE(view->getTime() == startTime + std::chrono::seconds(10));
+			}
+		}
+	}
+}
@@ -19,8 +19,13 @@
 
 #include <catch2/catch.hpp>
 
+#include <chrono>
 #include <filesystem>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include <etherkitten/reader/LogReader.hpp>
 #include <etherkitten/reader/logger.hpp>
@@ -330,6 +335,55 @@ SCENARIO("Logger starts log, LogReder reads the logfile", "[Logger]")
 			}
 		}
 
+		WHEN("The reader has some cycle measurements")
+		{
+			for (uint32_t i = 1; i <= 3; ++i)
+			{
+				std::array<uint32_t, cycleStatisticTypeCount> measurement{};
+				measurement[static_cast<size_t>(CycleStatisticType::SEND_TIME)] = 1000 * i;
+				measurement[static_cast<size_t>(CycleStatisticType::DEADLINE_MISS)] = i == 2;
+				reader.feedCycleMeasurement(measurement, intToTimeStamp(100000 * i));
+			}
+
+			{
+				Logger logger{ reader.slaveInformant, reader,
+					std::make_shared<MyErrorIterator>(MyErrorIterator{ {} }), "Testlog.ekl" };
+				logger.startLog(etherkitten::datatypes::intToTimeStamp(0));
+
+				std::this_thread::sleep_for(std::chrono::milliseconds(100));
+				logger.stopLog();
+			}
+
+			LogCache cache;
+			LogSlaveInformant slaveInformant{ "Testlog.ekl" };
+			LogReader reader{ "Testlog.ekl", slaveInformant, cache };
+			std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+			THEN("The LogReader creates DataViews with the correct cycle statistics")
+			{
+				CycleStatistic sendTime{ CycleStatisticType::SEND_TIME };
+				auto view = reader.getView(sendTime, TimeSeries{ intToTimeStamp(0), 0s });
+				REQUIRE(view->isEmpty() == false);
+				REQUIRE(view->asDouble() == 1000);
+				REQUIRE(view->getTime() == intToTimeStamp(100000));
+				++(*view);
+				REQUIRE(view->asDouble() == 2000);
+				REQUIRE(view->getTime() == intToTimeStamp(200000));
+				++(*view);
+				REQUIRE(view->hasNext() == false);
+				REQUIRE(view->asDouble() == 3000);
+				REQUIRE(view->getTime() == intToTimeStamp(300000));
+			}
+
+			THEN("The LogReader rebuilds the histograms of the cycle statistics")
+			{
+				const CycleHistogram& misses
+				    = reader.getCycleHistogram(CycleStatisticType::DEADLINE_MISS);
+				REQUIRE(misses.getCount() == 3);
+				REQUIRE(misses.getMax() == 1);
+			}
+		}
+
 		WHEN("The logger has some CoE data")
 		{
 			{
@@ -472,6 +526,40 @@ SCENARIO("Logger starts log, LogReder reads the logfile", "[Logger]")
 				REQUIRE((**errors).getValue().getAssociatedSlaves().second == 35);
 			}
 		}
+
+		WHEN("The log file cannot be written")
+		{
+			std::mutex messageMutex;
+			std::vector<std::string> messages;
+			Logger logger{ reader.slaveInformant, reader,
+				std::make_shared<MyErrorIterator>(MyErrorIterator{ {} }),
+				"does/not/exist.ekl", [&](int, std::string message) {
+				    std::lock_guard lock(messageMutex);
+				    messages.push_back(message);
+				} };
+			logger.startLog(etherkitten::datatypes::intToTimeStamp(0));
+
+			auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+			while (!logger.hasFailed() && std::chrono::steady_clock::now() < deadline)
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+			THEN("The Logger stops by itself and reports the failure")
+			{
+				REQUIRE(logger.hasFailed());
+				{
+					std::lock_guard lock(messageMutex);
+					REQUIRE(messages.back() == "Writing the log failed, logging stopped");
+				}
+				logger.stopLog();
+				REQUIRE(logger.hasFailed());
+			}
+
+			THEN("The Logger can start a new log")
+			{
+				logger.startLog(etherkitten::datatypes::intToTimeStamp(0));
+				logger.stopLog();
+			}
+		}
 	}
 
 	std::filesystem::remove("Testlog.ekl");
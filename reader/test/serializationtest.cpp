@@ -17,21 +17,38 @@
 
 #include <catch2/catch.hpp>
 
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <thread>
 
 #include <etherkitten/datatypes/dataobjects.hpp>
 #include <etherkitten/datatypes/ethercatdatatypes.hpp>
 #include <etherkitten/reader/DataView.hpp>
 #include <etherkitten/reader/DatatypesSerializer.hpp>
 #include <etherkitten/reader/IOMap.hpp>
+#include <etherkitten/reader/LogCache.hpp>
+#include <etherkitten/reader/LogReader.hpp>
+#include <etherkitten/reader/LogSlaveInformant.hpp>
+#include <etherkitten/reader/log/chunkindex.hpp>
 #include <etherkitten/reader/log/DataViewWrapper.hpp>
 #include <etherkitten/reader/log/coe.hpp>
 #include <etherkitten/reader/log/coeentry.hpp>
+#include <etherkitten/reader/log/cyclestatistic.hpp>
+#include <etherkitten/reader/log/encodedchunk.hpp>
+#include <etherkitten/reader/log/error.hpp>
 #include <etherkitten/reader/log/esi.hpp>
+#include <etherkitten/reader/log/header.hpp>
 #include <etherkitten/reader/log/neighbors.hpp>
 #include <etherkitten/reader/log/pdo.hpp>
 #include <etherkitten/reader/log/pdodetails.hpp>
+#include <etherkitten/reader/log/processdata.hpp>
+#include <etherkitten/reader/log/registerdata.hpp>
+#include <etherkitten/reader/logger.hpp>
 
+#include "DataReaderMock.hpp"
 #include "SlaveInformantMock.hpp"
 
 // clazy:excludeall=non-pod-global-static
@@ -39,6 +56,32 @@
 using namespace etherkitten::reader;
 using namespace etherkitten::datatypes;
 
+namespace
+{
+	Serialized readFromFile(const std::filesystem::path& path, uint64_t offset, uint64_t length)
+	{
+		std::ifstream fin(path, std::ios::in | std::ios::binary);
+		fin.seekg(offset);
+		Serialized ser(length);
+		fin.read(ser.data, length);
+		return ser;
+	}
+
+	std::vector<std::pair<double, TimeStamp>> readAll(AbstractDataView& view)
+	{
+		std::vector<std::pair<double, TimeStamp>> values;
+		if (view.isEmpty())
+			return values;
+		values.emplace_back(view.asDouble(), view.getTime());
+		while (view.hasNext())
+		{
+			++view;
+			values.emplace_back(view.asDouble(), view.getTime());
+		}
+		return values;
+	}
+} // namespace
+
 SCENARIO("Serialized works correctly", "[Logger]")
 {
 	GIVEN("A serialized object and some data")
@@ -117,6 +160,38 @@ SCENARIO("Serialized works correctly", "[Logger]")
 				REQUIRE_THROWS(ser.getAt(5, 6));
 			}
 		}
+
+		WHEN("I move it")
+		{
+			ser.write<uint64_t>(42, 0);
+			Serialized moved(std::move(ser));
+
+			THEN("The new object owns the buffer and the old one is empty")
+			{
+				REQUIRE(moved.length == 10);
+				REQUIRE(moved.read<uint64_t>(0) == 42);
+				REQUIRE(ser.data == nullptr); // NOLINT
+				REQUIRE(ser.length == 0);     // NOLINT
+			}
+		}
+	}
+
+	GIVEN("Some data that is not owned by a Serialized")
+	{
+		std::array<char, 8> buffer{};
+
+		WHEN("I wrap it")
+		{
+			Serialized ser = Serialized::wrap(buffer.data(), buffer.size());
+
+			THEN("I read the data in place")
+			{
+				buffer[0] = 7;
+				REQUIRE(ser.data == buffer.data());
+				REQUIRE(ser.read<uint8_t>(0) == 7);
+				REQUIRE_THROWS(ser.getAt(4, 5));
+			}
+		}
 	}
 }
 
@@ -297,6 +372,29 @@ SCENARIO("Block classes are working properly", "[Logger]")
 		}
 	}
 
+	GIVEN("A CycleStatisticBlock")
+	{
+		CycleStatisticBlock block{ static_cast<uint16_t>(CycleStatisticType::RECEIVE_LATENCY),
+			98765, 0xDEADBEEF };
+		WHEN("I serialize that block")
+		{
+			Serialized ser = block.getSerializer().serialize(block);
+			THEN("The result is as expected")
+			{
+				SlaveInformantMock si{ 0, 8 };
+				LogBusInfo bi;
+				ParsingContext pc(si, bi);
+				REQUIRE(ser.length == CycleStatisticBlock::size);
+				REQUIRE(ChunkEntryBlock::getKindOf(ser.read<uint32_t>(0))
+				    == ChunkEntryBlock::cycleStatisticKind);
+				auto obj = CycleStatisticBlock::serializer.parseSerialized(ser, pc);
+				REQUIRE(obj.type == static_cast<uint16_t>(CycleStatisticType::RECEIVE_LATENCY));
+				REQUIRE(obj.timestamp == 98765);
+				REQUIRE(obj.value == 0xDEADBEEF);
+			}
+		}
+	}
+
 	GIVEN("A PDODetailsBlock")
 	{
 		PDODetailsBlock block{ 7283, 5763, 93, 3765 };
@@ -419,3 +517,505 @@ SCENARIO("DatatypesSerializes works")
 		}
 	}
 }
+
+SCENARIO("The log header and the chunk index can be serialized", "[Logger]")
+{
+	SlaveInformantMock si{ 0, 8 };
+	LogBusInfo bi;
+	ParsingContext pc(si, bi);
+
+	GIVEN("A LogHeaderBlock of the current version")
+	{
+		LogHeaderBlock block{ LogHeaderBlock::currentVersion, 48, 123, 8, 4567, 8910 };
+		WHEN("I serialize that block")
+		{
+			Serialized ser = block.getSerializer().serialize(block);
+			THEN("The result is as expected")
+			{
+				REQUIRE(ser.length == 48);
+				auto obj = LogHeaderBlock::serializer.parseSerialized(ser, pc);
+				REQUIRE(obj.version == 2);
+				REQUIRE(obj.pdoDescOffset == 48);
+				REQUIRE(obj.dataOffset == 123);
+				REQUIRE(obj.ioMapSize == 8);
+				REQUIRE(obj.startTime == 4567);
+				REQUIRE(obj.indexOffset == 8910);
+			}
+		}
+
+		WHEN("I try to read a header of an unknown version")
+		{
+			Serialized ser = block.getSerializer().serialize(block);
+			ser.write<uint64_t>(4, 0);
+			THEN("An exception is thrown")
+			{
+				REQUIRE(LogHeaderBlock::getSizeOfVersion(4) == 0);
+				REQUIRE_THROWS(LogHeaderBlock::serializer.parseSerialized(ser, pc));
+			}
+		}
+	}
+
+	GIVEN("A LogHeaderBlock of version 1")
+	{
+		LogHeaderBlock block{ 1, 40, 123, 8, 4567, 0 };
+		WHEN("I serialize that block")
+		{
+			Serialized ser = block.getSerializer().serialize(block);
+			THEN("It has the layout of version 1 and no index")
+			{
+				REQUIRE(ser.length == 40);
+				auto obj = LogHeaderBlock::serializer.parseSerialized(ser, pc);
+				REQUIRE(obj.version == 1);
+				REQUIRE(obj.pdoDescOffset == 40);
+				REQUIRE(obj.dataOffset == 123);
+				REQUIRE(obj.ioMapSize == 8);
+				REQUIRE(obj.startTime == 4567);
+				REQUIRE(obj.indexOffset == 0);
+			}
+		}
+	}
+
+	GIVEN("A ChunkEntryBlock that data blocks are added to")
+	{
+		ChunkEntryBlock chunk{ 1000 };
+		REQUIRE(chunk.isEmpty());
+		RegisterDataBlock reg{ 0x0910, 3, 500, 42 };
+		ErrorBlock error{ 1, "error", 200, 7, std::numeric_limits<unsigned int>::max() };
+		RegisterDataBlock reg2{ 0x0910, 1, 300, 43 };
+		Serialized regSer = reg.getSerializer().serialize(reg);
+		Serialized errorSer = error.getSerializer().serialize(error);
+		Serialized reg2Ser = reg2.getSerializer().serialize(reg2);
+		chunk.addDataBlock(regSer);
+		chunk.addDataBlock(errorSer);
+		chunk.addDataBlock(reg2Ser);
+
+		THEN("It knows the time range, the kinds and the slaves of the blocks")
+		{
+			REQUIRE_FALSE(chunk.isEmpty());
+			REQUIRE(chunk.offset == 1000);
+			REQUIRE(chunk.length == regSer.length + errorSer.length + reg2Ser.length);
+			REQUIRE(chunk.firstTime == 200);
+			REQUIRE(chunk.lastTime == 500);
+			REQUIRE(chunk.blockKinds
+			    == (ChunkEntryBlock::registerKind | ChunkEntryBlock::errorKind));
+			REQUIRE(chunk.slaves == std::vector<uint16_t>{ 1, 3, 7 });
+			REQUIRE(chunk.hasSlave(3));
+			REQUIRE_FALSE(chunk.hasSlave(2));
+		}
+
+		WHEN("I serialize that block")
+		{
+			Serialized ser = chunk.getSerializer().serialize(chunk);
+			THEN("The result is as expected")
+			{
+				auto obj = ChunkEntryBlock::serializer.parseSerialized(ser, pc);
+				REQUIRE(obj.offset == chunk.offset);
+				REQUIRE(obj.length == chunk.length);
+				REQUIRE(obj.firstTime == 200);
+				REQUIRE(obj.lastTime == 500);
+				REQUIRE(obj.blockKinds == chunk.blockKinds);
+				REQUIRE(obj.slaves == chunk.slaves);
+			}
+		}
+	}
+
+	GIVEN("A ChunkIndexBlock with overlapping chunks")
+	{
+		ChunkIndexBlock block{ std::vector<ChunkEntryBlock>{
+		    ChunkEntryBlock{ 100, 50, 0, 100, ChunkEntryBlock::registerKind, { 1 } },
+		    ChunkEntryBlock{ 150, 50, 50, 200, ChunkEntryBlock::processDataKind, {} },
+		    ChunkEntryBlock{ 200, 50, 150, 300, ChunkEntryBlock::registerKind, { 1, 2 } },
+		    ChunkEntryBlock{ 250, 50, 310, 400, ChunkEntryBlock::coeKind, { 2 } },
+		    ChunkEntryBlock{ 300, 50, 410, 500, ChunkEntryBlock::errorKind, {} } } };
+
+		WHEN("I serialize that block")
+		{
+			Serialized ser = block.getSerializer().serialize(block);
+			THEN("The result is as expected")
+			{
+				auto obj = ChunkIndexBlock::serializer.parseSerialized(ser, pc);
+				REQUIRE(ser.read<uint64_t>(12) == ser.length);
+				REQUIRE(obj.getChunks().size() == 5);
+				for (size_t i = 0; i < 5; ++i)
+				{
+					REQUIRE(obj.getChunks()[i].offset == block.getChunks()[i].offset);
+					REQUIRE(obj.getChunks()[i].length == block.getChunks()[i].length);
+					REQUIRE(obj.getChunks()[i].firstTime == block.getChunks()[i].firstTime);
+					REQUIRE(obj.getChunks()[i].lastTime == block.getChunks()[i].lastTime);
+					REQUIRE(obj.getChunks()[i].blockKinds == block.getChunks()[i].blockKinds);
+					REQUIRE(obj.getChunks()[i].slaves == block.getChunks()[i].slaves);
+				}
+				REQUIRE(obj.findChunks(180, 320) == block.findChunks(180, 320));
+			}
+		}
+
+		WHEN("I try to read a ChunkIndexBlock with wrong identifier")
+		{
+			Serialized ser = block.getSerializer().serialize(block);
+			ser.data[3] = 0x45;
+			THEN("An exception is thrown")
+			{
+				REQUIRE_THROWS(ChunkIndexBlock::serializer.parseSerialized(ser, pc));
+			}
+		}
+
+		THEN("It finds the chunks that may contain data of a time window")
+		{
+			REQUIRE(block.findChunks(0, 1000) == std::pair<size_t, size_t>{ 0, 5 });
+			REQUIRE(block.findChunks(180, 190) == std::pair<size_t, size_t>{ 1, 3 });
+			REQUIRE(block.findChunks(120, 120) == std::pair<size_t, size_t>{ 1, 2 });
+			REQUIRE(block.findChunks(305, 308) == std::pair<size_t, size_t>{ 3, 3 });
+			REQUIRE(block.findChunks(450, 2000) == std::pair<size_t, size_t>{ 4, 5 });
+			REQUIRE(block.findChunks(600, 700) == std::pair<size_t, size_t>{ 5, 5 });
+		}
+	}
+
+	GIVEN("An empty ChunkIndexBlock")
+	{
+		ChunkIndexBlock block{ {} };
+		THEN("It finds no chunks")
+		{
+			REQUIRE(block.findChunks(0, 1000) == std::pair<size_t, size_t>{ 0, 0 });
+		}
+	}
+}
+
+SCENARIO("Logs are written in chunks that can be found through their index", "[Logger]")
+{
+	GIVEN("A Logger with small chunks and a Reader with register data of two slaves")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 2, 3 } };
+		for (unsigned int id = 1; id <= 2; ++id)
+		{
+			reader.slaveInformant.feedSlaveInfo(id,
+			    SlaveInfo(id, "Slave" + std::to_string(id), {}, {}, ESIData{}, {},
+			        std::array<unsigned int, 4>{ 0, 0, 0, 0 }));
+		}
+		Register reg1 = Register(1, RegisterEnum::BUILD);
+		Register reg2 = Register(2, RegisterEnum::BUILD);
+		for (uint64_t i = 0; i < 50; ++i)
+		{
+			reader.feedRegister(reg1, intToTimeStamp(1000 * (i + 1)), i);
+			reader.feedRegister(reg2, intToTimeStamp(1000 * (i + 1) + 500), 2 * i);
+		}
+		LogCache errorCache;
+		{
+			Logger logger{ reader.slaveInformant, reader, errorCache.getErrors(),
+				"Chunklog.ekl" };
+			logger.setChunkSize(64);
+			logger.startLog(intToTimeStamp(0));
+			REQUIRE_THROWS(logger.setChunkSize(128));
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			logger.stopLog();
+		}
+
+		SlaveInformantMock si{ 0, 8 };
+		LogBusInfo bi;
+		ParsingContext pc(si, bi);
+		Serialized headerSer = readFromFile("Chunklog.ekl", 0, 48);
+		LogHeaderBlock header = LogHeaderBlock::serializer.parseSerialized(headerSer, pc);
+		uint64_t fileSize = std::filesystem::file_size("Chunklog.ekl");
+		Serialized indexSer
+		    = readFromFile("Chunklog.ekl", header.indexOffset, fileSize - header.indexOffset);
+		ChunkIndexBlock index = ChunkIndexBlock::serializer.parseSerialized(indexSer, pc);
+		auto& chunks = index.getChunks();
+
+		THEN("The log has version 2 and ends with its index")
+		{
+			REQUIRE(header.version == 2);
+			REQUIRE(header.indexOffset != 0);
+			REQUIRE(indexSer.read<uint64_t>(12) == fileSize - header.indexOffset);
+		}
+
+		THEN("The chunks cover all data blocks without gaps")
+		{
+			REQUIRE(chunks.size() > 1);
+			REQUIRE(chunks.front().offset == header.dataOffset);
+			for (size_t i = 0; i + 1 < chunks.size(); ++i)
+			{
+				REQUIRE(chunks[i].length >= 64);
+				REQUIRE(chunks[i].offset + chunks[i].length == chunks[i + 1].offset);
+			}
+			REQUIRE(chunks.back().offset + chunks.back().length == header.indexOffset);
+			for (auto& chunk : chunks)
+			{
+				REQUIRE(chunk.blockKinds == ChunkEntryBlock::registerKind);
+				REQUIRE(chunk.firstTime <= chunk.lastTime);
+			}
+		}
+
+		THEN("The data of a time window is in the chunks the index finds")
+		{
+			auto [first, end] = index.findChunks(20000, 30000);
+			REQUIRE(first < end);
+			for (size_t i = 0; i < first; ++i)
+			{
+				REQUIRE(chunks[i].lastTime < 20000);
+			}
+			for (size_t i = end; i < chunks.size(); ++i)
+			{
+				REQUIRE(chunks[i].firstTime > 30000);
+			}
+			REQUIRE(chunks[first].hasSlave(1));
+		}
+
+		WHEN("A LogReader reads the log")
+		{
+			LogCache cache;
+			LogSlaveInformant slaveInformant{ "Chunklog.ekl" };
+			LogReader logReader{ "Chunklog.ekl", slaveInformant, cache };
+			std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+			THEN("It reads all data from all chunks")
+			{
+				auto values1 = readAll(*logReader.getView(reg1, { intToTimeStamp(0), 0s }));
+				auto values2 = readAll(*logReader.getView(reg2, { intToTimeStamp(0), 0s }));
+				REQUIRE(values1.size() == 50);
+				REQUIRE(values2.size() == 50);
+				for (size_t i = 0; i < 50; ++i)
+				{
+					REQUIRE(values1[i].first == i);
+					REQUIRE(values1[i].second == intToTimeStamp(1000 * (i + 1)));
+					REQUIRE(values2[i].first == 2 * i);
+					REQUIRE(values2[i].second == intToTimeStamp(1000 * (i + 1) + 500));
+				}
+			}
+		}
+
+		WHEN("The log is converted to version 1")
+		{
+			// A version 1 log is a version 2 log with the shorter header and without the index
+			uint64_t shift = 48 - 40;
+			LogHeaderBlock v1Header{ 1, header.pdoDescOffset - shift, header.dataOffset - shift,
+				header.ioMapSize, header.startTime, 0 };
+			Serialized body = readFromFile("Chunklog.ekl", 48, header.indexOffset - 48);
+			{
+				std::ofstream fout("Chunklogv1.ekl", std::ios::binary);
+				Serialized v1HeaderSer = v1Header.getSerializer().serialize(v1Header);
+				fout.write(v1HeaderSer.data, v1HeaderSer.length);
+				fout.write(body.data, body.length);
+			}
+
+			LogCache cache;
+			LogSlaveInformant slaveInformant{ "Chunklogv1.ekl" };
+			LogReader logReader{ "Chunklogv1.ekl", slaveInformant, cache };
+			std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+			THEN("The LogReader still reads all of its data")
+			{
+				REQUIRE(slaveInformant.getSlaveCount() == 2);
+				REQUIRE(slaveInformant.getSlaveInfo(2).getName() == "Slave2");
+				auto values1 = readAll(*logReader.getView(reg1, { intToTimeStamp(0), 0s }));
+				auto values2 = readAll(*logReader.getView(reg2, { intToTimeStamp(0), 0s }));
+				REQUIRE(values1.size() == 50);
+				REQUIRE(values2.size() == 50);
+				REQUIRE(values1.back().first == 49);
+				REQUIRE(values2.back().second == intToTimeStamp(50500));
+			}
+		}
+	}
+}
+
+SCENARIO("The data blocks of a chunk can be encoded compactly", "[Logger]")
+{
+	GIVEN("The data blocks of a chunk with steady and changing data")
+	{
+		constexpr uint64_t ioMapSize = 40;
+		std::vector<Serialized> blocks;
+		for (uint64_t i = 0; i < 200; ++i)
+		{
+			RegisterDataBlock steady{ static_cast<uint16_t>(RegisterEnum::BUILD), 1,
+				1000 * i + 10, 7 };
+			blocks.push_back(steady.getSerializer().serialize(steady));
+			// The timestamps of this register jitter and may even go back
+			RegisterDataBlock changing{
+				static_cast<uint16_t>(RegisterEnum::CONFIGURED_STATION_ADDRESS), 2,
+				1000 * i + 500 + (i % 3) * 7 - 5, (i * i) % 300
+			};
+			blocks.push_back(changing.getSerializer().serialize(changing));
+			ProcessDataBlock processData{ 1000 * i, Serialized(ioMapSize) };
+			processData.data.write<uint32_t>(static_cast<uint32_t>(i / 10), 0);
+			processData.data.write<uint8_t>(static_cast<uint8_t>(i % 2), ioMapSize - 1);
+			processData.data.write<uint8_t>(static_cast<uint8_t>(i % 5), 12);
+			processData.data.write<uint8_t>(static_cast<uint8_t>(i % 7), 14);
+			blocks.push_back(processData.getSerializer().serialize(processData));
+			CycleStatisticBlock cycle{ static_cast<uint16_t>(CycleStatisticType::LOOP_DURATION),
+				1000 * i, static_cast<uint32_t>(20000 + (i * 37) % 500) };
+			blocks.push_back(cycle.getSerializer().serialize(cycle));
+			if (i % 50 == 0)
+			{
+				ErrorBlock error{ 1, "error " + std::to_string(i), 1000 * i + 20, 1, 2 };
+				blocks.push_back(error.getSerializer().serialize(error));
+			}
+		}
+		uint64_t plainLength = 0;
+		for (auto& block : blocks)
+		{
+			plainLength += block.length;
+		}
+		Serialized plain(plainLength);
+		uint64_t offset = 0;
+		for (auto& block : blocks)
+		{
+			memcpy(plain.data + offset, block.data, block.length);
+			offset += block.length;
+		}
+
+		ChunkEncoder encoder{ ioMapSize };
+		REQUIRE(encoder.isEmpty());
+		for (auto& block : blocks)
+		{
+			encoder.addDataBlock(block);
+		}
+		REQUIRE_FALSE(encoder.isEmpty());
+		Serialized encoded = encoder.finish();
+
+		THEN("The encoded chunk is a fraction of the size of the data blocks")
+		{
+			REQUIRE(encoder.isEmpty());
+			REQUIRE(encoded.read<uint32_t>(0) == EncodedChunkBlock::ident);
+			REQUIRE(encoded.read<uint64_t>(12) == encoded.length);
+			REQUIRE(encoded.length * 5 < plainLength);
+		}
+
+		THEN("Decoding it restores the data blocks exactly")
+		{
+			Serialized decoded = EncodedChunkBlock::decode(encoded, ioMapSize);
+			REQUIRE(decoded.length == plainLength);
+			REQUIRE(memcmp(decoded.data, plain.data, plainLength) == 0);
+		}
+
+		THEN("The next chunk is encoded on its own")
+		{
+			encoder.addDataBlock(blocks.back());
+			Serialized next = encoder.finish();
+			Serialized decoded = EncodedChunkBlock::decode(next, ioMapSize);
+			REQUIRE(decoded.length == blocks.back().length);
+			REQUIRE(memcmp(decoded.data, blocks.back().data, decoded.length) == 0);
+		}
+
+		THEN("A damaged encoded chunk is not decoded")
+		{
+			Serialized truncated = encoded.getAt(0, encoded.length - 1);
+			REQUIRE_THROWS(EncodedChunkBlock::decode(truncated, ioMapSize));
+			Serialized copy(encoded.length);
+			memcpy(copy.data, encoded.data, encoded.length);
+			copy.write<uint64_t>(plainLength + 1, 20);
+			REQUIRE_THROWS(EncodedChunkBlock::decode(copy, ioMapSize));
+			copy.write<uint64_t>(plainLength, 20);
+			copy.write<uint32_t>(0x80000000, 0);
+			REQUIRE_THROWS(EncodedChunkBlock::decode(copy, ioMapSize));
+		}
+	}
+}
+
+SCENARIO("Logs can be written with encoded chunks", "[Logger]")
+{
+	GIVEN("A Logger that encodes chunks and a Reader with process and register data")
+	{
+		DataReaderMock reader{ SlaveInformantMock{ 1, 3 } };
+		PDO pdo = PDO(1, "PDO1", EtherCATDataTypeEnum::INTEGER16, 0, PDODirection::INPUT);
+		reader.slaveInformant.feedSlaveInfo(1,
+		    SlaveInfo(1, "Slave1", std::vector<PDO>{ pdo }, {}, ESIData{}, {},
+		        std::array<unsigned int, 4>{ 0, 0, 0, 0 }));
+		Register reg = Register(1, RegisterEnum::BUILD);
+		reader.appendPDOToIOMap(pdo);
+		for (uint64_t i = 0; i < 100; ++i)
+		{
+			reader.feedPDOData({ { pdo, i / 10 } }, intToTimeStamp(1000 * (i + 1)));
+			reader.feedRegister(reg, intToTimeStamp(1000 * (i + 1) + 500), i < 50 ? 3 : i);
+			std::array<uint32_t, cycleStatisticTypeCount> measurement{};
+			measurement[static_cast<size_t>(CycleStatisticType::CYCLE_PERIOD)] = 1000000;
+			measurement[static_cast<size_t>(CycleStatisticType::LOOP_DURATION)]
+			    = static_cast<uint32_t>(20000 + (i * 37) % 500);
+			reader.feedCycleMeasurement(measurement, intToTimeStamp(1000 * (i + 1)));
+		}
+		CycleStatistic loopDuration(CycleStatisticType::LOOP_DURATION);
+		LogCache errorCache;
+		errorCache.postError(ErrorMessage("Something broke", ErrorSeverity::MEDIUM),
+		    intToTimeStamp(20500));
+		for (bool encode : { false, true })
+		{
+			Logger logger{ reader.slaveInformant, reader, errorCache.getErrors(),
+				encode ? "Encodedlog.ekl" : "Plainlog.ekl" };
+			logger.setChunkSize(512);
+			logger.setEncodeChunks(encode);
+			logger.startLog(intToTimeStamp(0));
+			REQUIRE_THROWS(logger.setEncodeChunks(!encode));
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+			logger.stopLog();
+		}
+
+		SlaveInformantMock si{ 0, 3 };
+		LogBusInfo bi;
+		ParsingContext pc(si, bi);
+		Serialized headerSer = readFromFile("Encodedlog.ekl", 0, 48);
+		LogHeaderBlock header = LogHeaderBlock::serializer.parseSerialized(headerSer, pc);
+
+		THEN("The log has version 3 and is smaller than the plain log")
+		{
+			REQUIRE(header.version == LogHeaderBlock::encodedVersion);
+			REQUIRE(header.indexOffset != 0);
+			REQUIRE(std::filesystem::file_size("Encodedlog.ekl") * 2
+			    < std::filesystem::file_size("Plainlog.ekl"));
+		}
+
+		WHEN("LogReaders read both logs")
+		{
+			LogCache plainCache;
+			LogSlaveInformant plainInformant{ "Plainlog.ekl" };
+			LogReader plain{ "Plainlog.ekl", plainInformant, plainCache };
+			LogCache completeCache;
+			LogSlaveInformant completeInformant{ "Encodedlog.ekl" };
+			LogReader complete{ "Encodedlog.ekl", completeInformant, completeCache };
+			LogCache windowedCache;
+			LogSlaveInformant windowedInformant{ "Encodedlog.ekl" };
+			LogReader windowed{ "Encodedlog.ekl", windowedInformant, windowedCache,
+				[](int, std::string) {}, LogLoading::WINDOWED };
+			std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+			THEN("They read the same data")
+			{
+				auto registerValues = readAll(*plain.getView(reg, { intToTimeStamp(0), 0s }));
+				REQUIRE(registerValues.size() == 100);
+				REQUIRE(registerValues
+				    == readAll(*complete.getView(reg, { intToTimeStamp(0), 0s })));
+				REQUIRE(registerValues
+				    == readAll(*windowed.getView(reg, { intToTimeStamp(0), 0s })));
+				auto pdoValues = readAll(*plain.getView(pdo, { intToTimeStamp(0), 0s }));
+				REQUIRE(pdoValues.size() == 100);
+				REQUIRE(pdoValues == readAll(*complete.getView(pdo, { intToTimeStamp(0), 0s })));
+				REQUIRE(pdoValues == readAll(*windowed.getView(pdo, { intToTimeStamp(0), 0s })));
+				auto cycleValues
+				    = readAll(*plain.getView(loopDuration, { intToTimeStamp(0), 0s }));
+				REQUIRE(cycleValues.size() == 100);
+				REQUIRE(cycleValues
+				    == readAll(*complete.getView(loopDuration, { intToTimeStamp(0), 0s })));
+				auto errors = windowedCache.getErrors();
+				REQUIRE_FALSE(errors->isEmpty());
+				REQUIRE((**errors).getValue().getMessage() == "Something broke");
+			}
+		}
+
+		WHEN("The index of the log is lost")
+		{
+			Serialized body = readFromFile("Encodedlog.ekl", 0, header.indexOffset);
+			body.write<uint64_t>(0, LogHeaderBlock::indexOffsetPosition);
+			{
+				std::ofstream fout("Unindexedlog.ekl", std::ios::binary);
+				fout.write(body.data, body.length);
+			}
+			LogCache cache;
+			LogSlaveInformant slaveInformant{ "Unindexedlog.ekl" };
+			LogReader logReader{ "Unindexedlog.ekl", slaveInformant, cache };
+			std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+			THEN("The LogReader still decodes the chunks one after the other")
+			{
+				auto values = readAll(*logReader.getView(reg, { intToTimeStamp(0), 0s }));
+				REQUIRE(values.size() == 100);
+				REQUIRE(values.back() == std::make_pair(99.0, intToTimeStamp(100500)));
+			}
+		}
+	}
+}